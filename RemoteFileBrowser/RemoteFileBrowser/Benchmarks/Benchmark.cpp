@@ -0,0 +1,249 @@
+#include "PrecompiledHeader.h"
+
+#if _BENCHMARKBUILD
+
+#include "Benchmark.h"
+#include "Utilities\Tracing.h"
+
+using namespace std;
+using namespace Utilities;
+
+struct RegisteredBenchmark
+{
+	string name;
+	Benchmark::BenchmarkFunction function;
+};
+
+struct BenchmarkResult
+{
+	string name;
+	uint64_t iterations;
+	double medianNanoseconds;
+	double minNanoseconds;
+	double maxNanoseconds;
+	double bytesPerSecond;
+	double itemsPerSecond;
+};
+
+// Registrations run during static initialization of other translation units, so the list can't be a plain global
+static vector<RegisteredBenchmark>& GetRegisteredBenchmarks()
+{
+	static vector<RegisteredBenchmark> s_Benchmarks;
+	return s_Benchmarks;
+}
+
+static const void* volatile s_UsedValue;
+
+void Benchmark::UseValue(const void* value)
+{
+	s_UsedValue = value;
+	_ReadWriteBarrier();
+}
+
+Benchmark::Registration::Registration(const char* name, BenchmarkFunction function)
+{
+	// Identifiers can't contain slashes, so Encoding_EncodeUrl_PlainName is reported as Encoding/EncodeUrl/PlainName
+	RegisteredBenchmark benchmark = { name, function };
+	replace(begin(benchmark.name), end(benchmark.name), '_', '/');
+	GetRegisteredBenchmarks().push_back(benchmark);
+}
+
+Benchmark::Options::Options() :
+	outputPath(L"BenchmarkResults.json"), minTimeMilliseconds(250), repetitions(5)
+{
+}
+
+Benchmark::State::State(uint64_t iterations) :
+	m_Iterations(iterations), m_IterationsLeft(iterations), m_StartTicks(0), m_ElapsedTicks(0), m_BytesProcessed(0), m_ItemsProcessed(0), m_SkipReason(nullptr)
+{
+}
+
+void Benchmark::State::PauseTiming()
+{
+	if (m_StartTicks != 0)
+	{
+		m_ElapsedTicks += Tracing::GetTicks() - m_StartTicks;
+		m_StartTicks = 0;
+	}
+}
+
+void Benchmark::State::ResumeTiming()
+{
+	m_StartTicks = Tracing::GetTicks();
+}
+
+static uint64_t GetTimerFrequency()
+{
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	return frequency.QuadPart;
+}
+
+static uint64_t RunIterations(const RegisteredBenchmark& benchmark, uint64_t iterations, uint64_t& bytesProcessed, uint64_t& itemsProcessed, const char*& skipReason)
+{
+	Benchmark::State state(iterations);
+	benchmark.function(state);
+
+	bytesProcessed = state.GetBytesProcessed();
+	itemsProcessed = state.GetItemsProcessed();
+	skipReason = state.GetSkipReason();
+	return state.GetElapsedTicks();
+}
+
+// Returns 0 if the benchmark skipped itself
+static uint64_t CalibrateIterationCount(const RegisteredBenchmark& benchmark, uint64_t minTicks, const char*& skipReason)
+{
+	// Grow the iteration count until a single run takes at least minTicks, overshooting a bit so that the measured runs clear it too
+	const uint64_t kMaxIterations = 1000000000;
+	uint64_t iterations = 1;
+
+	for (;;)
+	{
+		uint64_t bytesProcessed, itemsProcessed;
+		auto elapsedTicks = RunIterations(benchmark, iterations, bytesProcessed, itemsProcessed, skipReason);
+
+		if (skipReason != nullptr)
+		{
+			return 0;
+		}
+
+		if (elapsedTicks >= minTicks || iterations >= kMaxIterations)
+		{
+			return iterations;
+		}
+
+		auto predictedIterations = static_cast<uint64_t>(1.4 * iterations * minTicks / max<uint64_t>(elapsedTicks, 1));
+		iterations = min(max(predictedIterations, iterations + 1), min(10 * iterations, kMaxIterations));
+	}
+}
+
+static bool RunBenchmark(const RegisteredBenchmark& benchmark, const Benchmark::Options& options, uint64_t timerFrequency, BenchmarkResult& result, const char*& skipReason)
+{
+	auto iterations = CalibrateIterationCount(benchmark, options.minTimeMilliseconds * timerFrequency / 1000, skipReason);
+
+	if (iterations == 0)
+	{
+		return false;
+	}
+
+	uint64_t bytesProcessed = 0, itemsProcessed = 0;
+	vector<double> nanosecondsPerIteration;
+
+	for (int i = 0; i < options.repetitions; i++)
+	{
+		auto elapsedTicks = RunIterations(benchmark, iterations, bytesProcessed, itemsProcessed, skipReason);
+		nanosecondsPerIteration.push_back(1e9 * elapsedTicks / timerFrequency / iterations);
+	}
+
+	sort(begin(nanosecondsPerIteration), end(nanosecondsPerIteration));
+
+	result.name = benchmark.name;
+	result.iterations = iterations;
+	result.medianNanoseconds = nanosecondsPerIteration[nanosecondsPerIteration.size() / 2];
+	result.minNanoseconds = nanosecondsPerIteration.front();
+	result.maxNanoseconds = nanosecondsPerIteration.back();
+	result.bytesPerSecond = bytesProcessed * 1e9 / result.medianNanoseconds;
+	result.itemsPerSecond = itemsProcessed * 1e9 / result.medianNanoseconds;
+	return true;
+}
+
+static const char* GetPlatformName()
+{
+#if _M_X64
+	return "x64";
+#elif _M_ARM
+	return "ARM";
+#else
+	return "Win32";
+#endif
+}
+
+static bool WriteResults(const wstring& path, const vector<BenchmarkResult>& results, uint64_t timerFrequency)
+{
+	SYSTEMTIME time;
+	GetSystemTime(&time);
+
+	char dateBuffer[32];
+	sprintf_s(dateBuffer, "%04u-%02u-%02uT%02u:%02u:%02uZ", time.wYear, time.wMonth, time.wDay, time.wHour, time.wMinute, time.wSecond);
+
+	stringstream output;
+	output.setf(ios::fixed);
+	output.precision(3);
+
+	output << "{\n\t\"context\": {\n"
+		<< "\t\t\"date\": \"" << dateBuffer << "\",\n"
+		<< "\t\t\"platform\": \"" << GetPlatformName() << "\",\n"
+		<< "\t\t\"logical_processors\": " << thread::hardware_concurrency() << ",\n"
+		<< "\t\t\"timer_frequency\": " << timerFrequency << "\n"
+		<< "\t},\n\t\"benchmarks\": [";
+
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const auto& result = results[i];
+
+		output << (i == 0 ? "\n" : ",\n")
+			<< "\t\t{ \"name\": \"" << result.name << "\""
+			<< ", \"iterations\": " << result.iterations
+			<< ", \"median_ns\": " << result.medianNanoseconds
+			<< ", \"min_ns\": " << result.minNanoseconds
+			<< ", \"max_ns\": " << result.maxNanoseconds
+			<< ", \"bytes_per_second\": " << result.bytesPerSecond
+			<< ", \"items_per_second\": " << result.itemsPerSecond << " }";
+	}
+
+	output << "\n\t]\n}\n";
+
+	auto json = output.str();
+	auto fileHandle = FileSystem::CreateFilePortable(path, GENERIC_WRITE, 0, CREATE_ALWAYS);
+
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		Logging::Error(GetLastError(), "Failed to create benchmark results file \"", Encoding::Utf16ToUtf8(path), "\": ");
+		return false;
+	}
+
+	DWORD bytesWritten;
+	auto result = WriteFile(fileHandle, json.data(), static_cast<DWORD>(json.length()), &bytesWritten, nullptr);
+	Logging::LogErrorIfFailed(result == FALSE, "Failed to write benchmark results file: ");
+
+	CloseHandle(fileHandle);
+	return result != FALSE && bytesWritten == json.length();
+}
+
+int Benchmark::RunRegisteredBenchmarks(const Options& options)
+{
+	auto timerFrequency = GetTimerFrequency();
+	vector<BenchmarkResult> results;
+
+	printf("%-56s %14s %14s %14s\n", "Benchmark", "Median ns", "MB/s", "Items/s");
+
+	for (const auto& benchmark : GetRegisteredBenchmarks())
+	{
+		if (!options.filter.empty() && benchmark.name.find(options.filter) == string::npos)
+		{
+			continue;
+		}
+
+		BenchmarkResult result;
+		const char* skipReason;
+
+		if (!RunBenchmark(benchmark, options, timerFrequency, result, skipReason))
+		{
+			printf("%-56s skipped: %s\n", benchmark.name.c_str(), skipReason);
+			continue;
+		}
+
+		results.push_back(result);
+		printf("%-56s %14.1f %14.1f %14.0f\n", result.name.c_str(), result.medianNanoseconds, result.bytesPerSecond / (1024 * 1024), result.itemsPerSecond);
+	}
+
+	if (!WriteResults(options.outputPath, results, timerFrequency))
+	{
+		return 1;
+	}
+
+	printf("\nResults written to %s\n", Encoding::Utf16ToUtf8(options.outputPath).c_str());
+	return 0;
+}
+
+#endif // _BENCHMARKBUILD
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+
+// Minimal microbenchmark harness for the Benchmark configuration.
+// Benchmarks register themselves with the BENCHMARK macro and time their body with a State::KeepRunning() loop:
+//
+//	BENCHMARK(Encoding_EncodeUrl)
+//	{
+//		while (state.KeepRunning())
+//		{
+//			...
+//		}
+//	}
+
+namespace Benchmark
+{
+	class State
+	{
+	private:
+		uint64_t m_Iterations;
+		uint64_t m_IterationsLeft;
+		uint64_t m_StartTicks;
+		uint64_t m_ElapsedTicks;
+		uint64_t m_BytesProcessed;
+		uint64_t m_ItemsProcessed;
+		const char* m_SkipReason;
+
+	public:
+		State(uint64_t iterations);
+
+		State(const State&) = delete;
+		State& operator=(const State&) = delete;
+
+		inline bool KeepRunning()
+		{
+			if (m_IterationsLeft > 0)
+			{
+				if (m_IterationsLeft == m_Iterations)
+				{
+					ResumeTiming();
+				}
+
+				m_IterationsLeft--;
+				return true;
+			}
+
+			PauseTiming();
+			return false;
+		}
+
+		// Excludes per iteration setup (like refilling a container that the benchmarked function consumes) from the measurement
+		void PauseTiming();
+		void ResumeTiming();
+
+		// Per iteration amounts, used to report throughput
+		inline void SetBytesProcessed(uint64_t bytes) { m_BytesProcessed = bytes; }
+		inline void SetItemsProcessed(uint64_t items) { m_ItemsProcessed = items; }
+
+		// For benchmarks that can't run on this machine, like ones for instruction sets the CPU lacks. Call before KeepRunning()
+		inline void Skip(const char* reason) { m_SkipReason = reason; m_IterationsLeft = 0; }
+
+		inline uint64_t GetIterations() const { return m_Iterations; }
+		inline uint64_t GetElapsedTicks() const { return m_ElapsedTicks; }
+		inline uint64_t GetBytesProcessed() const { return m_BytesProcessed; }
+		inline uint64_t GetItemsProcessed() const { return m_ItemsProcessed; }
+		inline const char* GetSkipReason() const { return m_SkipReason; }
+	};
+
+	typedef void (*BenchmarkFunction)(State& state);
+
+	struct Registration
+	{
+		Registration(const char* name, BenchmarkFunction function);
+	};
+
+	struct Options
+	{
+		std::string filter;
+		std::wstring outputPath;
+		uint64_t minTimeMilliseconds;
+		int repetitions;
+
+		Options();
+	};
+
+	int RunRegisteredBenchmarks(const Options& options);
+
+	// Keeps the optimizer from discarding a computed value
+	void UseValue(const void* value);
+
+	template <typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+		UseValue(&value);
+	}
+};
+
+#define BENCHMARK(name) \
+	static void name(Benchmark::State& state); \
+	static Benchmark::Registration s_##name##Registration(#name, &name); \
+	static void name(Benchmark::State& state)
\ No newline at end of file
@@ -0,0 +1,203 @@
+#include "PrecompiledHeader.h"
+
+#if _BENCHMARKBUILD
+
+#include "BenchmarkData.h"
+
+using namespace std;
+using namespace Utilities;
+
+static const char* const kWords[] =
+{
+	"Report", "Holiday", "IMG", "Invoice", "Project", "Backup", "Notes", "Screenshot", "Thesis", "Draft",
+	"Final", "Music", "Podcast", "Episode", "Setup", "Nuotraukos", "Season", "Archive", "Budget", "Presentation",
+	"\xc4\x84\xc5\xbeuolas", "\xc5\xbdiema", "\xc5\xa0vent\xc4\x97s",	// Lithuanian
+	"\xd0\x94\xd0\xbe\xd0\xba\xd1\x83\xd0\xbc\xd0\xb5\xd0\xbd\xd1\x82\xd1\x8b",	// Russian
+	"\xe5\x86\x99\xe7\x9c\x9f"	// Japanese
+};
+
+static const char* const kSeparators[] = { " ", "_", "-", " (" };
+
+static const char* const kExtensions[] = { ".jpg", ".png", ".pdf", ".docx", ".mp3", ".mkv", ".zip", ".txt", ".cpp", ".xlsx" };
+
+template <typename T, size_t Length>
+static inline const T& PickRandom(mt19937& random, const T (&items)[Length])
+{
+	return items[uniform_int_distribution<size_t>(0, Length - 1)(random)];
+}
+
+static string GenerateName(mt19937& random, bool withExtension)
+{
+	string name = PickRandom(random, kWords);
+	string separator = PickRandom(random, kSeparators);
+
+	name += separator;
+	name += to_string(uniform_int_distribution<int>(1, 2014)(random));
+
+	if (separator == " (")
+	{
+		name += ')';
+	}
+
+	if (withExtension)
+	{
+		name += PickRandom(random, kExtensions);
+	}
+
+	return name;
+}
+
+vector<string> BenchmarkData::GenerateFileNames(size_t count, uint32_t seed)
+{
+	mt19937 random(seed);
+	vector<string> names;
+
+	names.reserve(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		names.push_back(GenerateName(random, true));
+	}
+
+	return names;
+}
+
+vector<string> BenchmarkData::GeneratePaths(size_t count, uint32_t seed)
+{
+	mt19937 random(seed);
+	vector<string> paths;
+
+	paths.reserve(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		string path = "C:\\Users\\Public\\Documents";
+		auto depth = uniform_int_distribution<int>(1, 6)(random);
+
+		for (int j = 0; j < depth; j++)
+		{
+			path += '\\';
+			path += GenerateName(random, false);
+		}
+
+		path += '\\';
+		path += GenerateName(random, true);
+		paths.push_back(std::move(path));
+	}
+
+	return paths;
+}
+
+vector<FileSystem::FileInfo> BenchmarkData::GenerateFolderContents(size_t count, uint32_t seed)
+{
+	mt19937 random(seed);
+	vector<FileSystem::FileInfo> files;
+
+	files.reserve(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		auto isDirectory = uniform_int_distribution<int>(0, 4)(random) == 0;
+		auto fileSize = isDirectory ? 0 : static_cast<uint64_t>(exp2(uniform_real_distribution<double>(0.0, 32.0)(random)));
+
+		char dateModified[32];
+		sprintf_s(dateModified, "%04d-%02d-%02d %02d:%02d",
+			uniform_int_distribution<int>(2005, 2014)(random), uniform_int_distribution<int>(1, 12)(random), uniform_int_distribution<int>(1, 28)(random),
+			uniform_int_distribution<int>(0, 23)(random), uniform_int_distribution<int>(0, 59)(random));
+
+		files.emplace_back(GenerateName(random, !isDirectory), isDirectory ? FileSystem::FileStatus::Directory : FileSystem::FileStatus::File, string(dateModified), fileSize);
+	}
+
+	return files;
+}
+
+string BenchmarkData::GenerateBinaryData(size_t length, uint32_t seed)
+{
+	mt19937 random(seed);
+	string data;
+
+	data.resize(length);
+
+	for (auto& c : data)
+	{
+		c = static_cast<char>(random());
+	}
+
+	return data;
+}
+
+static const char* const kBrowserRequests[] =
+{
+	// Chrome on Windows
+	"GET /Music/Lietuvi%C5%A1ki%20dainos/ HTTP/1.1\r\n"
+	"Host: 192.168.1.20:8080\r\n"
+	"Connection: keep-alive\r\n"
+	"Cache-Control: max-age=0\r\n"
+	"Upgrade-Insecure-Requests: 1\r\n"
+	"User-Agent: Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0.0.0 Safari/537.36\r\n"
+	"Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,image/apng,*/*;q=0.8,application/signed-exchange;v=b3;q=0.7\r\n"
+	"Referer: http://192.168.1.20:8080/Music/\r\n"
+	"Accept-Encoding: gzip, deflate\r\n"
+	"Accept-Language: lt-LT,lt;q=0.9,en-US;q=0.8,en;q=0.7\r\n"
+	"\r\n",
+
+	// Firefox on Linux
+	"GET /Documents/report%202023.pdf HTTP/1.1\r\n"
+	"Host: 192.168.1.20:8080\r\n"
+	"User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:121.0) Gecko/20100101 Firefox/121.0\r\n"
+	"Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,*/*;q=0.8\r\n"
+	"Accept-Language: en-US,en;q=0.5\r\n"
+	"Accept-Encoding: gzip, deflate\r\n"
+	"Connection: keep-alive\r\n"
+	"Referer: http://192.168.1.20:8080/Documents/\r\n"
+	"Upgrade-Insecure-Requests: 1\r\n"
+	"If-Modified-Since: Tue, 14 Nov 2023 09:12:44 GMT\r\n"
+	"Range: bytes=1048576-\r\n"
+	"\r\n",
+
+	// Safari on iOS
+	"GET /Photos/2023/IMG_4412.JPG HTTP/1.1\r\n"
+	"Host: 192.168.1.20:8080\r\n"
+	"Accept: text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8\r\n"
+	"Accept-Language: en-GB,en;q=0.9\r\n"
+	"Connection: keep-alive\r\n"
+	"Accept-Encoding: gzip, deflate\r\n"
+	"User-Agent: Mozilla/5.0 (iPhone; CPU iPhone OS 17_2 like Mac OS X) AppleWebKit/605.1.15 (KHTML, like Gecko) Version/17.2 Mobile/15E148 Safari/604.1\r\n"
+	"Referer: http://192.168.1.20:8080/Photos/2023/\r\n"
+	"\r\n",
+
+	// Edge on Windows, with a session cookie
+	"GET /%D0%92%D0%B8%D0%B4%D0%B5%D0%BE/ HTTP/1.1\r\n"
+	"Host: fileshare.local\r\n"
+	"Connection: keep-alive\r\n"
+	"sec-ch-ua: \"Not_A Brand\";v=\"8\", \"Chromium\";v=\"120\", \"Microsoft Edge\";v=\"120\"\r\n"
+	"sec-ch-ua-mobile: ?0\r\n"
+	"sec-ch-ua-platform: \"Windows\"\r\n"
+	"Upgrade-Insecure-Requests: 1\r\n"
+	"User-Agent: Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/120.0.0.0 Safari/537.36 Edg/120.0.0.0\r\n"
+	"Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/webp,image/apng,*/*;q=0.8,application/signed-exchange;v=b3;q=0.7\r\n"
+	"Sec-Fetch-Site: same-origin\r\n"
+	"Sec-Fetch-Mode: navigate\r\n"
+	"Sec-Fetch-User: ?1\r\n"
+	"Sec-Fetch-Dest: document\r\n"
+	"Referer: http://fileshare.local/\r\n"
+	"Accept-Encoding: gzip, deflate, br\r\n"
+	"Accept-Language: en-US,en;q=0.9\r\n"
+	"Cookie: session=5f2b9c0e8a7d4c1b9e3f6a2d; theme=dark\r\n"
+	"If-None-Match: \"1d9a3c7e5b2f\"\r\n"
+	"\r\n",
+
+	// curl
+	"GET /Downloads/setup.zip HTTP/1.1\r\n"
+	"Host: 192.168.1.20:8080\r\n"
+	"User-Agent: curl/8.4.0\r\n"
+	"Accept: */*\r\n"
+	"\r\n"
+};
+
+vector<string> BenchmarkData::GetBrowserRequests()
+{
+	return vector<string>(begin(kBrowserRequests), end(kBrowserRequests));
+}
+
+#endif // _BENCHMARKBUILD
\ No newline at end of file
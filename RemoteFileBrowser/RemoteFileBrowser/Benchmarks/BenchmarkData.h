@@ -0,0 +1,15 @@
+#pragma once
+
+// Deterministic input generators, so that results stay comparable between builds.
+// Names mix ASCII with Lithuanian, Cyrillic and Japanese words the way a real shared folder does
+
+namespace BenchmarkData
+{
+	std::vector<std::string> GenerateFileNames(size_t count, uint32_t seed = 42);
+	std::vector<std::string> GeneratePaths(size_t count, uint32_t seed = 42);
+	std::vector<Utilities::FileSystem::FileInfo> GenerateFolderContents(size_t count, uint32_t seed = 42);
+	std::string GenerateBinaryData(size_t length, uint32_t seed = 42);
+
+	// Request headers as sent by desktop and mobile browsers and curl, captured against this server
+	std::vector<std::string> GetBrowserRequests();
+};
\ No newline at end of file
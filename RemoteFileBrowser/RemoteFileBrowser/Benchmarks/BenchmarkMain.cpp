@@ -0,0 +1,130 @@
+#include "PrecompiledHeader.h"
+
+#if _BENCHMARKBUILD
+
+#include "Benchmark.h"
+#include "LoadTest.h"
+#include "Communication\SearchIndex.h"
+#include "Utilities\Initializer.h"
+
+using namespace std;
+using namespace Utilities;
+
+static bool ParseOption(const wstring& argument, const wchar_t* name, wstring& value)
+{
+	auto nameLength = wcslen(name);
+
+	if (argument.compare(0, nameLength, name) != 0)
+	{
+		return false;
+	}
+
+	value = argument.substr(nameLength);
+	return true;
+}
+
+static void PrintUsage()
+{
+	printf("Usage:\n"
+		"\tRemoteFileBrowser.exe [--filter=<substring>] [--out=<results.json>] [--min-time=<milliseconds>] [--repetitions=<count>]\n"
+		"\tRemoteFileBrowser.exe --load-test [--connections=<count>] [--duration=<seconds>] [--mix=<listing>:<small>:<large>]\n"
+		"\t\t[--folders=<count>] [--files-per-folder=<count>] [--port=<port>] [--out=<results.json>]\n");
+}
+
+static int RunLoadTest(int argc, wchar_t* argv[])
+{
+	LoadTest::Options options;
+
+	for (int i = 2; i < argc; i++)
+	{
+		wstring argument = argv[i];
+		wstring value;
+
+		if (ParseOption(argument, L"--connections=", value))
+		{
+			options.connections = max(1, _wtoi(value.c_str()));
+		}
+		else if (ParseOption(argument, L"--duration=", value))
+		{
+			options.durationSeconds = max(1, _wtoi(value.c_str()));
+		}
+		else if (ParseOption(argument, L"--mix=", value))
+		{
+			if (swscanf_s(value.c_str(), L"%d:%d:%d", &options.listingWeight, &options.smallFileWeight, &options.largeFileWeight) != 3)
+			{
+				PrintUsage();
+				return 1;
+			}
+		}
+		else if (ParseOption(argument, L"--folders=", value))
+		{
+			options.folderCount = max(1, _wtoi(value.c_str()));
+		}
+		else if (ParseOption(argument, L"--files-per-folder=", value))
+		{
+			options.filesPerFolder = max(1, _wtoi(value.c_str()));
+		}
+		else if (ParseOption(argument, L"--port=", value))
+		{
+			options.port = static_cast<uint16_t>(_wtoi(value.c_str()));
+		}
+		else if (ParseOption(argument, L"--out=", value))
+		{
+			options.outputPath = value;
+		}
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	return LoadTest::Run(options);
+}
+
+int wmain(int argc, wchar_t* argv[])
+{
+	Initializer initializer;
+
+	// Otherwise every synthetic tree a benchmark shares gets crawled in the background while it's being measured
+	SearchIndex::SetEnabled(false);
+
+	if (argc > 1 && wcscmp(argv[1], L"--load-test") == 0)
+	{
+		return RunLoadTest(argc, argv);
+	}
+
+	Benchmark::Options options;
+
+	for (int i = 1; i < argc; i++)
+	{
+		wstring argument = argv[i];
+		wstring value;
+
+		if (ParseOption(argument, L"--filter=", value))
+		{
+			options.filter = Encoding::Utf16ToUtf8(value);
+		}
+		else if (ParseOption(argument, L"--out=", value))
+		{
+			options.outputPath = value;
+		}
+		else if (ParseOption(argument, L"--min-time=", value))
+		{
+			options.minTimeMilliseconds = max(1, _wtoi(value.c_str()));
+		}
+		else if (ParseOption(argument, L"--repetitions=", value))
+		{
+			options.repetitions = max(1, _wtoi(value.c_str()));
+		}
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	return Benchmark::RunRegisteredBenchmarks(options);
+}
+
+#endif // _BENCHMARKBUILD
\ No newline at end of file
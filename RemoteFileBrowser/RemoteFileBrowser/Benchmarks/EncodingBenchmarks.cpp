@@ -0,0 +1,543 @@
+#include "PrecompiledHeader.h"
+
+#if _BENCHMARKBUILD
+
+#include "Benchmark.h"
+#include "BenchmarkData.h"
+#include "Utilities\Base64.h"
+#include "Utilities\Escaping.h"
+#include "Utilities\Transcoding.h"
+
+using namespace std;
+using namespace Utilities;
+
+static const size_t kInputCount = 1000;
+
+static bool IsAscii(const string& str)
+{
+	return all_of(begin(str), end(str), [](char c) { return static_cast<uint8_t>(c) < 0x80; });
+}
+
+static vector<string> GenerateAsciiPaths(size_t count)
+{
+	auto paths = BenchmarkData::GeneratePaths(8 * count);
+	Algorithms::FilterVector(paths, &IsAscii);
+	paths.resize(min(paths.size(), count));
+	return paths;
+}
+
+static vector<wstring> ToUtf16(const vector<string>& strings)
+{
+	vector<wstring> result;
+
+	for (const auto& str : strings)
+	{
+		result.push_back(Encoding::Utf8ToUtf16(str));
+	}
+
+	return result;
+}
+
+template <typename String>
+static uint64_t GetTotalLength(const vector<String>& strings)
+{
+	uint64_t length = 0;
+
+	for (const auto& str : strings)
+	{
+		length += str.length() * sizeof(str[0]);
+	}
+
+	return length;
+}
+
+// Utf8ToUtf16
+
+static void BenchmarkUtf8ToUtf16(Benchmark::State& state, const vector<string>& inputs)
+{
+	while (state.KeepRunning())
+	{
+		for (const auto& input : inputs)
+		{
+			auto result = Encoding::Utf8ToUtf16(input);
+			Benchmark::DoNotOptimize(result);
+		}
+	}
+
+	state.SetBytesProcessed(GetTotalLength(inputs));
+	state.SetItemsProcessed(inputs.size());
+}
+
+BENCHMARK(Encoding_Utf8ToUtf16_AsciiPaths)
+{
+	BenchmarkUtf8ToUtf16(state, GenerateAsciiPaths(kInputCount));
+}
+
+BENCHMARK(Encoding_Utf8ToUtf16_MixedPaths)
+{
+	BenchmarkUtf8ToUtf16(state, BenchmarkData::GeneratePaths(kInputCount));
+}
+
+BENCHMARK(Encoding_Utf8ToUtf16_FileNames)
+{
+	BenchmarkUtf8ToUtf16(state, BenchmarkData::GenerateFileNames(kInputCount));
+}
+
+BENCHMARK(Encoding_Utf8ToUtf16Inline_MixedPaths)
+{
+	auto inputs = BenchmarkData::GeneratePaths(kInputCount);
+	vector<wchar_t> buffer(4096);
+
+	while (state.KeepRunning())
+	{
+		for (const auto& input : inputs)
+		{
+			auto length = Encoding::Utf8ToUtf16Inline(input, buffer.data(), buffer.size());
+			Benchmark::DoNotOptimize(length);
+		}
+	}
+
+	state.SetBytesProcessed(GetTotalLength(inputs));
+	state.SetItemsProcessed(inputs.size());
+}
+
+// Utf16ToUtf8
+
+static void BenchmarkUtf16ToUtf8(Benchmark::State& state, const vector<wstring>& inputs)
+{
+	while (state.KeepRunning())
+	{
+		for (const auto& input : inputs)
+		{
+			auto result = Encoding::Utf16ToUtf8(input);
+			Benchmark::DoNotOptimize(result);
+		}
+	}
+
+	state.SetBytesProcessed(GetTotalLength(inputs));
+	state.SetItemsProcessed(inputs.size());
+}
+
+BENCHMARK(Encoding_Utf16ToUtf8_AsciiPaths)
+{
+	BenchmarkUtf16ToUtf8(state, ToUtf16(GenerateAsciiPaths(kInputCount)));
+}
+
+BENCHMARK(Encoding_Utf16ToUtf8_MixedPaths)
+{
+	BenchmarkUtf16ToUtf8(state, ToUtf16(BenchmarkData::GeneratePaths(kInputCount)));
+}
+
+BENCHMARK(Encoding_Utf16ToUtf8_FileNames)
+{
+	BenchmarkUtf16ToUtf8(state, ToUtf16(BenchmarkData::GenerateFileNames(kInputCount)));
+}
+
+BENCHMARK(Encoding_Utf16ToUtf8Inline_MixedPaths)
+{
+	auto inputs = ToUtf16(BenchmarkData::GeneratePaths(kInputCount));
+	vector<char> buffer(4096);
+
+	while (state.KeepRunning())
+	{
+		for (const auto& input : inputs)
+		{
+			auto length = Encoding::Utf16ToUtf8Inline(input, buffer.data(), buffer.size());
+			Benchmark::DoNotOptimize(length);
+		}
+	}
+
+	state.SetBytesProcessed(GetTotalLength(inputs));
+	state.SetItemsProcessed(inputs.size());
+}
+
+// Transcoding kernels on each instruction set, compared with the Windows conversion functions they replaced
+
+static size_t Utf8ToUtf16Windows(const char* str, size_t strLength, wchar_t* destination, size_t destinationLength)
+{
+	return MultiByteToWideChar(CP_UTF8, 0, str, static_cast<int>(strLength), destination, static_cast<int>(destinationLength));
+}
+
+static size_t Utf16ToUtf8Windows(const wchar_t* wstr, size_t wstrLength, char* destination, size_t destinationLength)
+{
+	return WideCharToMultiByte(CP_UTF8, 0, wstr, static_cast<int>(wstrLength), destination, static_cast<int>(destinationLength), nullptr, nullptr);
+}
+
+static vector<string> GenerateLongText()
+{
+	// One 64 KB string, to show throughput once call overhead no longer matters
+	string text;
+
+	for (const auto& path : GenerateAsciiPaths(kInputCount))
+	{
+		text += path;
+		text += ' ';
+
+		if (text.length() >= 64 * 1024)
+		{
+			break;
+		}
+	}
+
+	return vector<string>(1, text);
+}
+
+static void BenchmarkUtf8ToUtf16Kernel(Benchmark::State& state, Simd::InstructionSet instructionSet, const vector<string>& inputs)
+{
+	auto kernel = Transcoding::GetUtf8ToUtf16(instructionSet);
+
+	if (kernel == nullptr || !Simd::IsSupported(instructionSet))
+	{
+		state.Skip("instruction set not supported");
+		return;
+	}
+
+	vector<wchar_t> buffer(128 * 1024);
+
+	while (state.KeepRunning())
+	{
+		for (const auto& input : inputs)
+		{
+			auto length = kernel(input.c_str(), input.length(), buffer.data(), buffer.size());
+			Benchmark::DoNotOptimize(length);
+		}
+	}
+
+	state.SetBytesProcessed(GetTotalLength(inputs));
+	state.SetItemsProcessed(inputs.size());
+}
+
+static void BenchmarkUtf16ToUtf8Kernel(Benchmark::State& state, Simd::InstructionSet instructionSet, const vector<wstring>& inputs)
+{
+	auto kernel = Transcoding::GetUtf16ToUtf8(instructionSet);
+
+	if (kernel == nullptr || !Simd::IsSupported(instructionSet))
+	{
+		state.Skip("instruction set not supported");
+		return;
+	}
+
+	vector<char> buffer(256 * 1024);
+
+	while (state.KeepRunning())
+	{
+		for (const auto& input : inputs)
+		{
+			auto length = kernel(input.c_str(), input.length(), buffer.data(), buffer.size());
+			Benchmark::DoNotOptimize(length);
+		}
+	}
+
+	state.SetBytesProcessed(GetTotalLength(inputs));
+	state.SetItemsProcessed(inputs.size());
+}
+
+static void BenchmarkUtf8ToUtf16Windows(Benchmark::State& state, const vector<string>& inputs)
+{
+	vector<wchar_t> buffer(128 * 1024);
+
+	while (state.KeepRunning())
+	{
+		for (const auto& input : inputs)
+		{
+			auto length = Utf8ToUtf16Windows(input.c_str(), input.length(), buffer.data(), buffer.size());
+			Benchmark::DoNotOptimize(length);
+		}
+	}
+
+	state.SetBytesProcessed(GetTotalLength(inputs));
+	state.SetItemsProcessed(inputs.size());
+}
+
+static void BenchmarkUtf16ToUtf8Windows(Benchmark::State& state, const vector<wstring>& inputs)
+{
+	vector<char> buffer(256 * 1024);
+
+	while (state.KeepRunning())
+	{
+		for (const auto& input : inputs)
+		{
+			auto length = Utf16ToUtf8Windows(input.c_str(), input.length(), buffer.data(), buffer.size());
+			Benchmark::DoNotOptimize(length);
+		}
+	}
+
+	state.SetBytesProcessed(GetTotalLength(inputs));
+	state.SetItemsProcessed(inputs.size());
+}
+
+#define TRANSCODING_BENCHMARKS(inputName, generateInputs) \
+	BENCHMARK(Transcoding_Utf8ToUtf16_Windows_##inputName) { BenchmarkUtf8ToUtf16Windows(state, generateInputs); } \
+	BENCHMARK(Transcoding_Utf8ToUtf16_Scalar_##inputName) { BenchmarkUtf8ToUtf16Kernel(state, Simd::InstructionSet::Scalar, generateInputs); } \
+	BENCHMARK(Transcoding_Utf8ToUtf16_SSE2_##inputName) { BenchmarkUtf8ToUtf16Kernel(state, Simd::InstructionSet::Sse2, generateInputs); } \
+	BENCHMARK(Transcoding_Utf8ToUtf16_AVX2_##inputName) { BenchmarkUtf8ToUtf16Kernel(state, Simd::InstructionSet::Avx2, generateInputs); } \
+	BENCHMARK(Transcoding_Utf8ToUtf16_NEON_##inputName) { BenchmarkUtf8ToUtf16Kernel(state, Simd::InstructionSet::Neon, generateInputs); } \
+	BENCHMARK(Transcoding_Utf16ToUtf8_Windows_##inputName) { BenchmarkUtf16ToUtf8Windows(state, ToUtf16(generateInputs)); } \
+	BENCHMARK(Transcoding_Utf16ToUtf8_Scalar_##inputName) { BenchmarkUtf16ToUtf8Kernel(state, Simd::InstructionSet::Scalar, ToUtf16(generateInputs)); } \
+	BENCHMARK(Transcoding_Utf16ToUtf8_SSE2_##inputName) { BenchmarkUtf16ToUtf8Kernel(state, Simd::InstructionSet::Sse2, ToUtf16(generateInputs)); } \
+	BENCHMARK(Transcoding_Utf16ToUtf8_AVX2_##inputName) { BenchmarkUtf16ToUtf8Kernel(state, Simd::InstructionSet::Avx2, ToUtf16(generateInputs)); } \
+	BENCHMARK(Transcoding_Utf16ToUtf8_NEON_##inputName) { BenchmarkUtf16ToUtf8Kernel(state, Simd::InstructionSet::Neon, ToUtf16(generateInputs)); }
+
+TRANSCODING_BENCHMARKS(AsciiPaths, GenerateAsciiPaths(kInputCount))
+TRANSCODING_BENCHMARKS(MixedPaths, BenchmarkData::GeneratePaths(kInputCount))
+TRANSCODING_BENCHMARKS(FileNames, BenchmarkData::GenerateFileNames(kInputCount))
+TRANSCODING_BENCHMARKS(Text64KB, GenerateLongText())
+
+#undef TRANSCODING_BENCHMARKS
+
+// URL encoding. The inline functions work in place, so each iteration first copies the input into a preallocated string
+
+static void BenchmarkInPlace(Benchmark::State& state, const vector<string>& inputs, void (*function)(string&))
+{
+	string buffer;
+	buffer.reserve(16 * 1024);
+
+	while (state.KeepRunning())
+	{
+		for (const auto& input : inputs)
+		{
+			buffer.assign(input);
+			function(buffer);
+			Benchmark::DoNotOptimize(buffer);
+		}
+	}
+
+	state.SetBytesProcessed(GetTotalLength(inputs));
+	state.SetItemsProcessed(inputs.size());
+}
+
+static vector<string> GenerateRequestUrls(vector<string> paths)
+{
+	// Paths as they show up in GET requests: forward slashes, percent encoded
+	for (auto& path : paths)
+	{
+		replace(begin(path), end(path), '\\', '/');
+		Encoding::EncodeUrlInline(path);
+	}
+
+	return paths;
+}
+
+BENCHMARK(Encoding_DecodeUrlInline_AsciiPaths)
+{
+	BenchmarkInPlace(state, GenerateRequestUrls(GenerateAsciiPaths(kInputCount)), &Encoding::DecodeUrlInline);
+}
+
+BENCHMARK(Encoding_DecodeUrlInline_MixedPaths)
+{
+	BenchmarkInPlace(state, GenerateRequestUrls(BenchmarkData::GeneratePaths(kInputCount)), &Encoding::DecodeUrlInline);
+}
+
+BENCHMARK(Encoding_EncodeUrlInline_FileNames)
+{
+	BenchmarkInPlace(state, BenchmarkData::GenerateFileNames(kInputCount), &Encoding::EncodeUrlInline);
+}
+
+BENCHMARK(Encoding_EncodeUrlInline_MixedPaths)
+{
+	BenchmarkInPlace(state, BenchmarkData::GeneratePaths(kInputCount), &Encoding::EncodeUrlInline);
+}
+
+BENCHMARK(Encoding_EscapeHtml_FileNames)
+{
+	auto inputs = BenchmarkData::GenerateFileNames(kInputCount);
+	string buffer;
+	buffer.reserve(16 * 1024);
+
+	while (state.KeepRunning())
+	{
+		for (const auto& input : inputs)
+		{
+			buffer.clear();
+			Encoding::AppendEscapedHtml(buffer, input);
+			Benchmark::DoNotOptimize(buffer);
+		}
+	}
+
+	state.SetBytesProcessed(GetTotalLength(inputs));
+	state.SetItemsProcessed(inputs.size());
+}
+
+// Special character scanners on each instruction set. Scanning the text counts every special character, like the encoders do
+
+static void BenchmarkFind(Benchmark::State& state, Escaping::FindFunction (*getKernel)(Simd::InstructionSet), Simd::InstructionSet instructionSet, const vector<string>& inputs)
+{
+	auto kernel = getKernel(instructionSet);
+
+	if (kernel == nullptr || !Simd::IsSupported(instructionSet))
+	{
+		state.Skip("instruction set not supported");
+		return;
+	}
+
+	while (state.KeepRunning())
+	{
+		size_t specialCount = 0;
+
+		for (const auto& input : inputs)
+		{
+			for (size_t i = kernel(input.c_str(), input.length()); i < input.length(); i += 1 + kernel(input.c_str() + i + 1, input.length() - i - 1))
+			{
+				specialCount++;
+			}
+		}
+
+		Benchmark::DoNotOptimize(specialCount);
+	}
+
+	state.SetBytesProcessed(GetTotalLength(inputs));
+	state.SetItemsProcessed(inputs.size());
+}
+
+#define ESCAPING_BENCHMARKS(kernelName, inputName, generateInputs) \
+	BENCHMARK(Escaping_##kernelName##_Scalar_##inputName) { BenchmarkFind(state, &Escaping::Get##kernelName, Simd::InstructionSet::Scalar, generateInputs); } \
+	BENCHMARK(Escaping_##kernelName##_SSE2_##inputName) { BenchmarkFind(state, &Escaping::Get##kernelName, Simd::InstructionSet::Sse2, generateInputs); } \
+	BENCHMARK(Escaping_##kernelName##_AVX2_##inputName) { BenchmarkFind(state, &Escaping::Get##kernelName, Simd::InstructionSet::Avx2, generateInputs); } \
+	BENCHMARK(Escaping_##kernelName##_NEON_##inputName) { BenchmarkFind(state, &Escaping::Get##kernelName, Simd::InstructionSet::Neon, generateInputs); }
+
+ESCAPING_BENCHMARKS(FindUrlDecodeSpecial, RequestUrls, GenerateRequestUrls(BenchmarkData::GeneratePaths(kInputCount)))
+ESCAPING_BENCHMARKS(FindUrlEncodeSpecial, FileNames, BenchmarkData::GenerateFileNames(kInputCount))
+ESCAPING_BENCHMARKS(FindHtmlSpecial, FileNames, BenchmarkData::GenerateFileNames(kInputCount))
+ESCAPING_BENCHMARKS(FindHtmlSpecial, Text64KB, GenerateLongText())
+ESCAPING_BENCHMARKS(FindHeaderDelimiter, BrowserRequests, BenchmarkData::GetBrowserRequests())
+
+#undef ESCAPING_BENCHMARKS
+
+// Base64
+
+static void BenchmarkEncodeBase64(Benchmark::State& state, size_t dataLength)
+{
+	auto data = BenchmarkData::GenerateBinaryData(dataLength);
+	string buffer;
+	buffer.reserve(2 * dataLength);
+
+	while (state.KeepRunning())
+	{
+		buffer.assign(data);
+		Encoding::EncodeBase64Inline(buffer);
+		Benchmark::DoNotOptimize(buffer);
+	}
+
+	state.SetBytesProcessed(dataLength);
+	state.SetItemsProcessed(1);
+}
+
+BENCHMARK(Encoding_EncodeBase64Inline_MacAddress)
+{
+	BenchmarkEncodeBase64(state, 6);	// What GetUniqueSystemId encodes
+}
+
+BENCHMARK(Encoding_EncodeBase64Inline_1KB)
+{
+	BenchmarkEncodeBase64(state, 1024);
+}
+
+BENCHMARK(Encoding_EncodeBase64Inline_64KB)
+{
+	BenchmarkEncodeBase64(state, 64 * 1024);
+}
+
+// Buffer API, on the best instruction set
+
+static void BenchmarkBase64Encode(Benchmark::State& state, size_t dataLength)
+{
+	auto data = BenchmarkData::GenerateBinaryData(dataLength);
+	vector<char> encoded(Base64::GetEncodedLength(dataLength));
+
+	while (state.KeepRunning())
+	{
+		Benchmark::DoNotOptimize(Base64::Encode(data.data(), data.length(), encoded.data()));
+	}
+
+	state.SetBytesProcessed(dataLength);
+	state.SetItemsProcessed(1);
+}
+
+static void BenchmarkBase64Decode(Benchmark::State& state, size_t dataLength)
+{
+	auto encoded = Encoding::EncodeBase64(BenchmarkData::GenerateBinaryData(dataLength));
+	vector<uint8_t> decoded(Base64::GetMaxDecodedLength(encoded.length()));
+	size_t decodedLength;
+
+	while (state.KeepRunning())
+	{
+		Benchmark::DoNotOptimize(Base64::Decode(encoded.data(), encoded.length(), decoded.data(), decodedLength));
+	}
+
+	state.SetBytesProcessed(dataLength);
+	state.SetItemsProcessed(1);
+}
+
+BENCHMARK(Base64_Encode_16B) { BenchmarkBase64Encode(state, 16); }
+BENCHMARK(Base64_Encode_1KB) { BenchmarkBase64Encode(state, 1024); }
+BENCHMARK(Base64_Encode_1MB) { BenchmarkBase64Encode(state, 1024 * 1024); }
+BENCHMARK(Base64_Decode_16B) { BenchmarkBase64Decode(state, 16); }
+BENCHMARK(Base64_Decode_1KB) { BenchmarkBase64Decode(state, 1024); }
+BENCHMARK(Base64_Decode_1MB) { BenchmarkBase64Decode(state, 1024 * 1024); }
+
+// Kernels on each instruction set. They only take whole groups, so the sizes are rounded down to a multiple of 3 bytes
+
+static void BenchmarkBase64EncodeKernel(Benchmark::State& state, Simd::InstructionSet instructionSet, size_t dataLength)
+{
+	auto kernel = Base64::GetEncode(instructionSet);
+
+	if (kernel == nullptr || !Simd::IsSupported(instructionSet))
+	{
+		state.Skip("instruction set not supported");
+		return;
+	}
+
+	dataLength -= dataLength % 3;
+	auto data = BenchmarkData::GenerateBinaryData(dataLength);
+	vector<char> encoded(Base64::GetEncodedLength(dataLength));
+
+	while (state.KeepRunning())
+	{
+		kernel(reinterpret_cast<const uint8_t*>(data.data()), dataLength, encoded.data());
+		Benchmark::DoNotOptimize(encoded);
+	}
+
+	state.SetBytesProcessed(dataLength);
+	state.SetItemsProcessed(1);
+}
+
+static void BenchmarkBase64DecodeKernel(Benchmark::State& state, Simd::InstructionSet instructionSet, size_t dataLength)
+{
+	auto kernel = Base64::GetDecode(instructionSet);
+
+	if (kernel == nullptr || !Simd::IsSupported(instructionSet))
+	{
+		state.Skip("instruction set not supported");
+		return;
+	}
+
+	dataLength -= dataLength % 3;
+	auto encoded = Encoding::EncodeBase64(BenchmarkData::GenerateBinaryData(dataLength));
+	vector<uint8_t> decoded(dataLength);
+
+	while (state.KeepRunning())
+	{
+		Benchmark::DoNotOptimize(kernel(encoded.data(), encoded.length(), decoded.data()));
+	}
+
+	state.SetBytesProcessed(dataLength);
+	state.SetItemsProcessed(1);
+}
+
+#define BASE64_BENCHMARKS(sizeName, dataLength) \
+	BENCHMARK(Base64_EncodeKernel_Scalar_##sizeName) { BenchmarkBase64EncodeKernel(state, Simd::InstructionSet::Scalar, dataLength); } \
+	BENCHMARK(Base64_EncodeKernel_SSSE3_##sizeName) { BenchmarkBase64EncodeKernel(state, Simd::InstructionSet::Ssse3, dataLength); } \
+	BENCHMARK(Base64_EncodeKernel_AVX2_##sizeName) { BenchmarkBase64EncodeKernel(state, Simd::InstructionSet::Avx2, dataLength); } \
+	BENCHMARK(Base64_EncodeKernel_NEON_##sizeName) { BenchmarkBase64EncodeKernel(state, Simd::InstructionSet::Neon, dataLength); } \
+	BENCHMARK(Base64_DecodeKernel_Scalar_##sizeName) { BenchmarkBase64DecodeKernel(state, Simd::InstructionSet::Scalar, dataLength); } \
+	BENCHMARK(Base64_DecodeKernel_SSSE3_##sizeName) { BenchmarkBase64DecodeKernel(state, Simd::InstructionSet::Ssse3, dataLength); } \
+	BENCHMARK(Base64_DecodeKernel_AVX2_##sizeName) { BenchmarkBase64DecodeKernel(state, Simd::InstructionSet::Avx2, dataLength); } \
+	BENCHMARK(Base64_DecodeKernel_NEON_##sizeName) { BenchmarkBase64DecodeKernel(state, Simd::InstructionSet::Neon, dataLength); }
+
+BASE64_BENCHMARKS(16B, 16)
+BASE64_BENCHMARKS(1KB, 1024)
+BASE64_BENCHMARKS(1MB, 1024 * 1024)
+
+#undef BASE64_BENCHMARKS
+
+#endif // _BENCHMARKBUILD
\ No newline at end of file
@@ -0,0 +1,211 @@
+#include "PrecompiledHeader.h"
+
+#if _BENCHMARKBUILD
+
+#include "Benchmark.h"
+#include "BenchmarkData.h"
+#include "Utilities\ReadaheadRing.h"
+#include "Utilities\SyntheticFileSystemProvider.h"
+
+using namespace std;
+using namespace Utilities;
+
+static const size_t kInputCount = 1000;
+
+// Path helpers
+
+BENCHMARK(FileSystem_CombinePaths_Child)
+{
+	auto paths = BenchmarkData::GeneratePaths(kInputCount);
+	vector<pair<string, string>> inputs;
+
+	for (const auto& path : paths)
+	{
+		auto separator = path.find_last_of('\\');
+		inputs.emplace_back(path.substr(0, separator), path.substr(separator + 1));
+	}
+
+	while (state.KeepRunning())
+	{
+		for (const auto& input : inputs)
+		{
+			auto combined = FileSystem::CombinePaths(input.first, input.second);
+			Benchmark::DoNotOptimize(combined);
+		}
+	}
+
+	state.SetItemsProcessed(inputs.size());
+}
+
+BENCHMARK(FileSystem_CombinePaths_Parent)
+{
+	auto paths = BenchmarkData::GeneratePaths(kInputCount);
+
+	while (state.KeepRunning())
+	{
+		for (const auto& path : paths)
+		{
+			auto combined = FileSystem::CombinePaths(path, "..");
+			Benchmark::DoNotOptimize(combined);
+		}
+	}
+
+	state.SetItemsProcessed(paths.size());
+}
+
+BENCHMARK(FileSystem_RemoveLastPathComponentInline)
+{
+	auto paths = BenchmarkData::GeneratePaths(kInputCount);
+	string buffer;
+	buffer.reserve(4096);
+
+	while (state.KeepRunning())
+	{
+		for (const auto& path : paths)
+		{
+			buffer.assign(path);
+			FileSystem::RemoveLastPathComponentInline(buffer);
+			Benchmark::DoNotOptimize(buffer);
+		}
+	}
+
+	state.SetItemsProcessed(paths.size());
+}
+
+BENCHMARK(String_PathHasher_Paths)
+{
+	auto paths = BenchmarkData::GeneratePaths(kInputCount);
+	uint64_t totalLength = 0;
+	String::PathHasher hasher;
+
+	for (const auto& path : paths)
+	{
+		totalLength += path.length();
+	}
+
+	while (state.KeepRunning())
+	{
+		size_t combinedHash = 0;
+
+		for (const auto& path : paths)
+		{
+			combinedHash ^= hasher(path);
+		}
+
+		Benchmark::DoNotOptimize(combinedHash);
+	}
+
+	state.SetBytesProcessed(totalLength);
+	state.SetItemsProcessed(paths.size());
+}
+
+// Listings
+
+static void BenchmarkSortFiles(Benchmark::State& state, size_t fileCount)
+{
+	auto folderContents = BenchmarkData::GenerateFolderContents(fileCount);
+	vector<FileSystem::FileInfo> files;
+
+	while (state.KeepRunning())
+	{
+		// SortFiles sorts in place, so restore the unsorted order outside of the measurement
+		state.PauseTiming();
+		files.clear();
+
+		for (const auto& file : folderContents)
+		{
+			files.emplace_back(file.fileName, file.fileStatus, file.dateModified, file.fileSize);
+		}
+
+		state.ResumeTiming();
+
+		FileSystem::SortFiles(files);
+		Benchmark::DoNotOptimize(files);
+	}
+
+	state.SetItemsProcessed(fileCount);
+}
+
+BENCHMARK(FileSystem_SortFiles_100)
+{
+	BenchmarkSortFiles(state, 100);
+}
+
+BENCHMARK(FileSystem_SortFiles_10000)
+{
+	BenchmarkSortFiles(state, 10000);
+}
+
+BENCHMARK(FileSystem_FormatFileSizeString)
+{
+	auto folderContents = BenchmarkData::GenerateFolderContents(kInputCount);
+
+	while (state.KeepRunning())
+	{
+		for (const auto& file : folderContents)
+		{
+			auto sizeString = FileSystem::FormatFileSizeString(file.fileSize);
+			Benchmark::DoNotOptimize(sizeString);
+		}
+	}
+
+	state.SetItemsProcessed(folderContents.size());
+}
+
+// Streaming from a synthetic backend that behaves like a network share: 2 ms per read, and 50 MB/s within a read
+
+static void BenchmarkReadaheadRing(Benchmark::State& state, uint32_t maxReaders)
+{
+	const uint64_t kFileSize = 256 * 1024 * 1024;
+
+	SyntheticFileSystemProvider::Parameters parameters;
+	parameters.maxDepth = 0;
+	parameters.minFanOut = 1;
+	parameters.maxFanOut = 1;
+	parameters.minFileSize = kFileSize;
+	parameters.maxFileSize = kFileSize;
+	parameters.readLatencyMicroseconds = 2000;
+	parameters.readBytesPerSecond = 50 * 1024 * 1024;
+	SyntheticFileSystemProvider provider(parameters);
+
+	auto files = provider.EnumerateFiles(parameters.rootPath);
+	auto filePath = parameters.rootPath + L"\\" + Encoding::Utf8ToUtf16(files[0].fileName);
+
+	auto originalMaxReaders = ReadaheadRing::GetMaxReaders();
+	ReadaheadRing::SetMaxReaders(maxReaders);
+	FileSystemProvider::SetCurrent(&provider);
+
+	while (state.KeepRunning())
+	{
+		StreamableFile file(filePath);
+		ReadaheadRing ring(file);
+
+		for (;;)
+		{
+			auto chunk = ring.AcquireChunk();
+			Benchmark::DoNotOptimize(chunk);
+			ring.ReleaseChunk();
+
+			if (chunk.isLast)
+			{
+				break;
+			}
+		}
+	}
+
+	FileSystemProvider::SetCurrent(nullptr);
+	ReadaheadRing::SetMaxReaders(originalMaxReaders);
+	state.SetBytesProcessed(kFileSize);
+}
+
+BENCHMARK(FileSystem_ReadaheadRing_HighLatency_SingleReader)
+{
+	BenchmarkReadaheadRing(state, 1);
+}
+
+BENCHMARK(FileSystem_ReadaheadRing_HighLatency_ParallelReaders)
+{
+	BenchmarkReadaheadRing(state, ReadaheadRing::kMaxReaders);
+}
+
+#endif // _BENCHMARKBUILD
\ No newline at end of file
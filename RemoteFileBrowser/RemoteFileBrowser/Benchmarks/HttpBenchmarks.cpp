@@ -0,0 +1,110 @@
+#include "PrecompiledHeader.h"
+
+#if _BENCHMARKBUILD
+
+#include "Benchmark.h"
+#include "BenchmarkData.h"
+#include "Http\HeaderIndex.h"
+
+using namespace std;
+using namespace Utilities;
+
+// Request header parsing throughput over captured browser requests
+
+static uint64_t GetTotalLength(const vector<string>& requests)
+{
+	uint64_t totalLength = 0;
+
+	for (const auto& request : requests)
+	{
+		totalLength += request.length();
+	}
+
+	return totalLength;
+}
+
+// What Server::ReportUserAgent used to do: copy every field into a map to read one of them
+static string FindUserAgentWithMap(const string& request)
+{
+	map<string, string> fields;
+	auto position = request.find('\n') + 1;
+
+	for (;;)
+	{
+		auto colon = request.find(':', position);
+		auto lineEnd = request.find('\r', colon);
+
+		if (colon == string::npos || lineEnd == string::npos)
+		{
+			break;
+		}
+
+		fields.emplace(request.substr(position, colon - position), request.substr(colon + 2, lineEnd - colon - 2));
+		position = lineEnd + 2;
+	}
+
+	return fields["User-Agent"];
+}
+
+BENCHMARK(Http_ParseHeader_Map_BrowserRequests)
+{
+	auto requests = BenchmarkData::GetBrowserRequests();
+
+	while (state.KeepRunning())
+	{
+		for (const auto& request : requests)
+		{
+			Benchmark::DoNotOptimize(FindUserAgentWithMap(request));
+		}
+	}
+
+	state.SetBytesProcessed(GetTotalLength(requests));
+	state.SetItemsProcessed(requests.size());
+}
+
+BENCHMARK(Http_ParseHeader_HeaderIndex_BrowserRequests)
+{
+	auto requests = BenchmarkData::GetBrowserRequests();
+	Http::HeaderIndex header;
+
+	while (state.KeepRunning())
+	{
+		for (const auto& request : requests)
+		{
+			header.Parse(request.data(), request.length());
+			Benchmark::DoNotOptimize(header.Find(Http::KnownHeader::UserAgent));
+		}
+	}
+
+	state.SetBytesProcessed(GetTotalLength(requests));
+	state.SetItemsProcessed(requests.size());
+}
+
+BENCHMARK(Http_LookupKnownHeader_BrowserRequests)
+{
+	auto requests = BenchmarkData::GetBrowserRequests();
+	Http::HeaderIndex header;
+	vector<StringView> names;
+
+	for (const auto& request : requests)
+	{
+		header.Parse(request.data(), request.length());
+
+		for (int i = 0; i < header.GetFieldCount(); i++)
+		{
+			names.push_back(header.GetField(i).name);
+		}
+	}
+
+	while (state.KeepRunning())
+	{
+		for (const auto& name : names)
+		{
+			Benchmark::DoNotOptimize(Http::HeaderIndex::LookupKnownHeader(name));
+		}
+	}
+
+	state.SetItemsProcessed(names.size());
+}
+
+#endif // _BENCHMARKBUILD
\ No newline at end of file
@@ -0,0 +1,530 @@
+#include "PrecompiledHeader.h"
+
+#if _BENCHMARKBUILD
+
+#include "Benchmark.h"
+#include "BenchmarkData.h"
+#include "Communication\FileBrowserResponseHandler.h"
+#include "Communication\FolderSizes.h"
+#include "Communication\MetadataIndex.h"
+#include "Communication\SharedFiles.h"
+#include "Utilities\SyntheticFileSystemProvider.h"
+
+using namespace std;
+using namespace Utilities;
+
+// Listing pipeline scaling over flat synthetic directories, so no disk or file system cache is involved
+
+static const char kSyntheticRoot[] = "S:\\Synthetic\\";
+
+static SyntheticFileSystemProvider::Parameters MakeFlatDirectoryParameters(uint32_t entryCount)
+{
+	SyntheticFileSystemProvider::Parameters parameters;
+	parameters.rootPath = Encoding::Utf8ToUtf16(kSyntheticRoot);
+	parameters.maxDepth = 0;
+	parameters.minFanOut = entryCount;
+	parameters.maxFanOut = entryCount;
+	return parameters;
+}
+
+static void BenchmarkEnumerateFiles(Benchmark::State& state, uint32_t entryCount)
+{
+	SyntheticFileSystemProvider provider(MakeFlatDirectoryParameters(entryCount));
+	FileSystemProvider::SetCurrent(&provider);
+
+	auto path = provider.GetParameters().rootPath;
+
+	while (state.KeepRunning())
+	{
+		auto files = FileSystem::EnumerateFiles(path);
+		Benchmark::DoNotOptimize(files);
+	}
+
+	FileSystemProvider::SetCurrent(nullptr);
+	state.SetItemsProcessed(entryCount);
+}
+
+// Every shareEvery-th file is shared individually, 0 shares the whole folder
+static void BenchmarkGetFolderContents(Benchmark::State& state, uint32_t entryCount, uint32_t shareEvery)
+{
+	SyntheticFileSystemProvider provider(MakeFlatDirectoryParameters(entryCount));
+	SharedFiles::FileSet fullySharedFolders, partiallySharedFolders, files;
+
+	if (shareEvery == 0)
+	{
+		fullySharedFolders.insert(kSyntheticRoot);
+	}
+	else
+	{
+		partiallySharedFolders.insert(kSyntheticRoot);
+		auto folderContents = provider.EnumerateFiles(provider.GetParameters().rootPath);
+
+		for (size_t i = 0; i < folderContents.size(); i += shareEvery)
+		{
+			files.insert(FileSystem::CombinePaths(kSyntheticRoot, folderContents[i].fileName));
+		}
+	}
+
+	SharedFiles::SetSharedFiles(std::move(fullySharedFolders), std::move(partiallySharedFolders), std::move(files));
+	FileSystemProvider::SetCurrent(&provider);
+
+	while (state.KeepRunning())
+	{
+		auto folderContents = SharedFiles::GetFolderContents(kSyntheticRoot);
+		Benchmark::DoNotOptimize(folderContents);
+	}
+
+	FileSystemProvider::SetCurrent(nullptr);
+	SharedFiles::SetSharedFiles(SharedFiles::FileSet(), SharedFiles::FileSet(), SharedFiles::FileSet());
+	state.SetItemsProcessed(entryCount);
+}
+
+BENCHMARK(Listing_EnumerateFiles_1K)
+{
+	BenchmarkEnumerateFiles(state, 1000);
+}
+
+BENCHMARK(Listing_EnumerateFiles_100K)
+{
+	BenchmarkEnumerateFiles(state, 100000);
+}
+
+BENCHMARK(Listing_EnumerateFiles_1M)
+{
+	BenchmarkEnumerateFiles(state, 1000000);
+}
+
+BENCHMARK(Listing_GetFolderContents_FullyShared_1K)
+{
+	BenchmarkGetFolderContents(state, 1000, 0);
+}
+
+BENCHMARK(Listing_GetFolderContents_FullyShared_100K)
+{
+	BenchmarkGetFolderContents(state, 100000, 0);
+}
+
+BENCHMARK(Listing_GetFolderContents_FullyShared_1M)
+{
+	BenchmarkGetFolderContents(state, 1000000, 0);
+}
+
+BENCHMARK(Listing_GetFolderContents_Filtered_1K)
+{
+	BenchmarkGetFolderContents(state, 1000, 100);
+}
+
+BENCHMARK(Listing_GetFolderContents_Filtered_100K)
+{
+	BenchmarkGetFolderContents(state, 100000, 100);
+}
+
+BENCHMARK(Listing_GetFolderContents_Filtered_1M)
+{
+	BenchmarkGetFolderContents(state, 1000000, 100);
+}
+
+// Row rendering. The stream version is how rows were rendered before AppendDirectoryRows, kept as the baseline
+
+static const char kRenderedDirectory[] = "C:\\Users\\Public\\Documents\\";
+
+static void RenderRowsWithStream(stringstream& html, const string& directoryPath, const vector<FileSystem::FileInfo>& files)
+{
+	for (auto& file : files)
+	{
+		string fileType;
+
+		if (file.fileStatus != FileSystem::FileStatus::Directory)
+		{
+			fileType = file.fileName.substr(file.fileName.find_last_of('.') + 1);
+		}
+
+		auto filePath = FileSystem::CombinePaths(directoryPath, file.fileName);
+		Encoding::EncodeUrlInline(filePath);
+
+		string fileSize;
+
+		if (file.fileSize > 0)
+		{
+			fileSize = FileSystem::FormatFileSizeString(file.fileSize);
+		}
+
+		html << "<tr>"
+					"<td><a href=\"/" << filePath << "\">" << file.fileName << "</a></td>"
+					"<td>" << fileType << "</td>"
+					"<td>" << fileSize << "</td>"
+					"<td>" << file.dateModified << "</td>"
+				"</tr>";
+	}
+}
+
+static void BenchmarkRenderRowsWithStream(Benchmark::State& state, size_t rowCount)
+{
+	auto files = BenchmarkData::GenerateFolderContents(rowCount);
+
+	while (state.KeepRunning())
+	{
+		stringstream html;
+		RenderRowsWithStream(html, kRenderedDirectory, files);
+		auto result = html.str();
+		Benchmark::DoNotOptimize(result);
+	}
+
+	state.SetItemsProcessed(rowCount);
+}
+
+static void BenchmarkRenderRows(Benchmark::State& state, size_t rowCount)
+{
+	auto files = BenchmarkData::GenerateFolderContents(rowCount);
+
+	while (state.KeepRunning())
+	{
+		string html;
+		FileBrowserResponseHandler::AppendDirectoryRows(html, kRenderedDirectory, files);
+		Benchmark::DoNotOptimize(html);
+	}
+
+	state.SetItemsProcessed(rowCount);
+}
+
+BENCHMARK(Listing_RenderRows_Stream_1K)
+{
+	BenchmarkRenderRowsWithStream(state, 1000);
+}
+
+BENCHMARK(Listing_RenderRows_Stream_100K)
+{
+	BenchmarkRenderRowsWithStream(state, 100000);
+}
+
+BENCHMARK(Listing_RenderRows_1K)
+{
+	BenchmarkRenderRows(state, 1000);
+}
+
+BENCHMARK(Listing_RenderRows_100K)
+{
+	BenchmarkRenderRows(state, 100000);
+}
+
+// Enumerating a real directory on the system drive. The directory is created in the temporary directory on first use and left there,
+// since creating its files takes much longer than all the runs. Warm runs list it straight from the file system cache.
+// Cold runs empty the cache before every listing, which needs an elevated process, and are skipped otherwise.
+// The FindFirstFileEx version is how directories were enumerated before the bulk queries, kept as the baseline
+
+static const uint32_t kDiskDirectoryEntryCount = 500000;
+
+// NtSetSystemInformation and its memory list commands aren't in the SDK headers
+typedef LONG (NTAPI *NtSetSystemInformationFunction)(int systemInformationClass, void* systemInformation, ULONG systemInformationLength);
+
+static const int kSystemMemoryListInformation = 80;
+static const int kMemoryPurgeStandbyList = 4;
+
+static const NtSetSystemInformationFunction s_NtSetSystemInformation =
+	reinterpret_cast<NtSetSystemInformationFunction>(GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "NtSetSystemInformation"));
+
+static wstring s_DiskDirectoryPath;
+
+static bool CreateDiskDirectory()
+{
+	if (!s_DiskDirectoryPath.empty())
+	{
+		return true;
+	}
+
+	wchar_t tempPath[MAX_PATH];
+	auto tempPathLength = GetTempPathW(MAX_PATH, tempPath);
+
+	if (tempPathLength == 0 || tempPathLength > MAX_PATH)
+	{
+		return false;
+	}
+
+	auto directoryPath = wstring(tempPath) + L"RemoteFileBrowserListingBenchmark";
+	auto completionMarkerPath = directoryPath + L".complete";
+
+	if (GetFileAttributesW(completionMarkerPath.c_str()) == INVALID_FILE_ATTRIBUTES)
+	{
+		Logging::Log("Creating ", to_string(kDiskDirectoryEntryCount), " files in \"", Encoding::Utf16ToUtf8(directoryPath), "\".");
+		CreateDirectoryW(directoryPath.c_str(), nullptr);
+
+		// Prefix names with their index, since the generated ones can repeat
+		auto fileNames = BenchmarkData::GenerateFileNames(kDiskDirectoryEntryCount);
+
+		for (uint32_t i = 0; i < kDiskDirectoryEntryCount; i++)
+		{
+			auto filePath = directoryPath + L"\\" + to_wstring(i) + L" " + Encoding::Utf8ToUtf16(fileNames[i]);
+			auto fileHandle = FileSystem::CreateFilePortable(filePath, GENERIC_WRITE, 0, CREATE_ALWAYS);
+
+			if (fileHandle == INVALID_HANDLE_VALUE)
+			{
+				Logging::Error(GetLastError(), "Failed to create listing benchmark file \"", Encoding::Utf16ToUtf8(filePath), "\": ");
+				return false;
+			}
+
+			CloseHandle(fileHandle);
+		}
+
+		auto markerHandle = FileSystem::CreateFilePortable(completionMarkerPath, GENERIC_WRITE, 0, CREATE_ALWAYS);
+
+		if (markerHandle != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(markerHandle);
+		}
+	}
+
+	s_DiskDirectoryPath = directoryPath;
+	return true;
+}
+
+static bool EnablePrivilege(const wchar_t* privilegeName)
+{
+	HANDLE token;
+
+	if (OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES, &token) == FALSE)
+	{
+		return false;
+	}
+
+	TOKEN_PRIVILEGES privileges;
+	privileges.PrivilegeCount = 1;
+	privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+
+	// AdjustTokenPrivileges succeeds without enabling privileges the token doesn't have, and says so through last error only
+	auto succeeded = LookupPrivilegeValueW(nullptr, privilegeName, &privileges.Privileges[0].Luid) != FALSE &&
+		AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) != FALSE &&
+		GetLastError() == ERROR_SUCCESS;
+
+	CloseHandle(token);
+	return succeeded;
+}
+
+// Trims the system cache working set, which moves its pages (file system metadata among them) to the standby list, and then purges that
+static bool EmptyFileSystemCache()
+{
+	if (s_NtSetSystemInformation == nullptr || SetSystemFileCacheSize(static_cast<SIZE_T>(-1), static_cast<SIZE_T>(-1), 0) == FALSE)
+	{
+		return false;
+	}
+
+	int command = kMemoryPurgeStandbyList;
+	return s_NtSetSystemInformation(kSystemMemoryListInformation, &command, sizeof(command)) >= 0;
+}
+
+static vector<FileSystem::FileInfo> EnumerateFilesWithFindFile(const wstring& path)
+{
+	vector<FileSystem::FileInfo> result;
+	auto searchPattern = path + L"\\*.*";
+
+	WIN32_FIND_DATA findData;
+	auto findHandle = FindFirstFileExW(searchPattern.c_str(), FindExInfoBasic, &findData, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+
+	if (findHandle == INVALID_HANDLE_VALUE)
+	{
+		return result;
+	}
+
+	do
+	{
+		if (wcscmp(findData.cFileName, L".") == 0 || wcscmp(findData.cFileName, L"..") == 0)
+			continue;
+
+		auto fileStatus = (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0 ? FileSystem::FileStatus::Directory : FileSystem::FileStatus::File;
+		auto fileSize = (static_cast<uint64_t>(findData.nFileSizeHigh) << 32) | findData.nFileSizeLow;
+
+		result.emplace_back(Encoding::Utf16ToUtf8(findData.cFileName), fileStatus, FileSystem::FormatFileTime(findData.ftLastWriteTime), fileSize);
+	}
+	while (FindNextFileW(findHandle, &findData) != FALSE);
+
+	FindClose(findHandle);
+	return result;
+}
+
+static void BenchmarkEnumerateDiskFiles(Benchmark::State& state, bool useFindFile, bool isCold)
+{
+	if (!CreateDiskDirectory())
+	{
+		state.Skip("the benchmark directory couldn't be created");
+		return;
+	}
+
+	if (isCold && (!EnablePrivilege(SE_INCREASE_QUOTA_NAME) || !EnablePrivilege(SE_PROF_SINGLE_PROCESS_NAME) || !EmptyFileSystemCache()))
+	{
+		state.Skip("emptying the file system cache needs an elevated process");
+		return;
+	}
+
+	while (state.KeepRunning())
+	{
+		if (isCold)
+		{
+			state.PauseTiming();
+			EmptyFileSystemCache();
+			state.ResumeTiming();
+		}
+
+		auto files = useFindFile ? EnumerateFilesWithFindFile(s_DiskDirectoryPath) : FileSystem::EnumerateFiles(s_DiskDirectoryPath);
+		Benchmark::DoNotOptimize(files);
+	}
+
+	state.SetItemsProcessed(kDiskDirectoryEntryCount);
+}
+
+BENCHMARK(Listing_EnumerateDiskFiles_FindFile_500K_Warm)
+{
+	BenchmarkEnumerateDiskFiles(state, true, false);
+}
+
+BENCHMARK(Listing_EnumerateDiskFiles_500K_Warm)
+{
+	BenchmarkEnumerateDiskFiles(state, false, false);
+}
+
+BENCHMARK(Listing_EnumerateDiskFiles_FindFile_500K_Cold)
+{
+	BenchmarkEnumerateDiskFiles(state, true, true);
+}
+
+BENCHMARK(Listing_EnumerateDiskFiles_500K_Cold)
+{
+	BenchmarkEnumerateDiskFiles(state, false, true);
+}
+
+// Folder sizes over a synthetic tree of about 12K folders and 1.4M files, where every enumeration waits 200 us like a network share would
+
+static void BenchmarkFolderSizes(Benchmark::State& state, bool changeOneFolder)
+{
+	SyntheticFileSystemProvider::Parameters parameters;
+	parameters.rootPath = Encoding::Utf8ToUtf16(kSyntheticRoot);
+	parameters.maxDepth = 3;
+	parameters.minFanOut = 100;
+	parameters.maxFanOut = 140;
+	parameters.enumerationLatencyMicroseconds = 200;
+	SyntheticFileSystemProvider provider(parameters);
+
+	SharedFiles::FileSet fullySharedFolders;
+	fullySharedFolders.insert(kSyntheticRoot);
+	SharedFiles::SetSharedFiles(std::move(fullySharedFolders), SharedFiles::FileSet(), SharedFiles::FileSet());
+	FileSystemProvider::SetCurrent(&provider);
+
+	// The first folder at the bottom of the tree is the one that changes
+	string changedFolder = kSyntheticRoot;
+
+	for (;;)
+	{
+		auto files = FileSystem::EnumerateFiles(Encoding::Utf8ToUtf16(changedFolder));
+		auto firstFolder = find_if(files.begin(), files.end(), [](const FileSystem::FileInfo& file) { return file.fileStatus == FileSystem::FileStatus::Directory; });
+
+		if (firstFolder == files.end())
+		{
+			break;
+		}
+
+		changedFolder = FileSystem::CombinePaths(changedFolder, firstFolder->fileName);
+	}
+
+	FolderSizes::Totals totals;
+	FolderSizes::Compute(kSyntheticRoot, totals, CancellationToken::None());
+
+	while (state.KeepRunning())
+	{
+		state.PauseTiming();
+
+		if (changeOneFolder)
+		{
+			FolderSizes::Invalidate(changedFolder);
+		}
+		else
+		{
+			FolderSizes::Clear();
+		}
+
+		state.ResumeTiming();
+
+		FolderSizes::Compute(kSyntheticRoot, totals, CancellationToken::None());
+		Benchmark::DoNotOptimize(totals);
+	}
+
+	FileSystemProvider::SetCurrent(nullptr);
+	SharedFiles::SetSharedFiles(SharedFiles::FileSet(), SharedFiles::FileSet(), SharedFiles::FileSet());
+	state.SetItemsProcessed(totals.fileCount);
+}
+
+BENCHMARK(Listing_FolderSizes_1M_Cold)
+{
+	BenchmarkFolderSizes(state, false);
+}
+
+BENCHMARK(Listing_FolderSizes_1M_AfterChange)
+{
+	BenchmarkFolderSizes(state, true);
+}
+
+// Listings of a directory whose enumeration takes as long as one on a network share, with and without the metadata index
+
+static void BenchmarkIndexedFolderContents(Benchmark::State& state, bool useIndex)
+{
+	const uint32_t kEntryCount = 100000;
+
+	auto parameters = MakeFlatDirectoryParameters(kEntryCount);
+	parameters.enumerationLatencyMicroseconds = 20000;
+	SyntheticFileSystemProvider provider(parameters);
+
+	SharedFiles::FileSet fullySharedFolders;
+	fullySharedFolders.insert(kSyntheticRoot);
+	SharedFiles::SetSharedFiles(std::move(fullySharedFolders), SharedFiles::FileSet(), SharedFiles::FileSet());
+	FileSystemProvider::SetCurrent(&provider);
+
+	wstring indexPath;
+
+	if (useIndex)
+	{
+		wchar_t tempPath[MAX_PATH + 1];
+		auto tempPathLength = GetTempPathW(MAX_PATH, tempPath);
+
+		if (tempPathLength == 0 || tempPathLength > MAX_PATH)
+		{
+			FileSystemProvider::SetCurrent(nullptr);
+			SharedFiles::SetSharedFiles(SharedFiles::FileSet(), SharedFiles::FileSet(), SharedFiles::FileSet());
+			state.Skip("failed to get the temp directory");
+			return;
+		}
+
+		indexPath = wstring(tempPath) + L"RemoteFileBrowserListingBenchmarks.index";
+		DeleteFileW(indexPath.c_str());
+
+		// Reopening after the first listing makes the rest come from the mapped file rather than pending changes
+		MetadataIndex::Open(indexPath);
+		SharedFiles::GetFolderContents(kSyntheticRoot);
+		MetadataIndex::Close();
+		MetadataIndex::Open(indexPath);
+	}
+
+	while (state.KeepRunning())
+	{
+		auto folderContents = SharedFiles::GetFolderContents(kSyntheticRoot);
+		Benchmark::DoNotOptimize(folderContents);
+	}
+
+	if (useIndex)
+	{
+		MetadataIndex::Close();
+		DeleteFileW(indexPath.c_str());
+	}
+
+	FileSystemProvider::SetCurrent(nullptr);
+	SharedFiles::SetSharedFiles(SharedFiles::FileSet(), SharedFiles::FileSet(), SharedFiles::FileSet());
+	state.SetItemsProcessed(kEntryCount);
+}
+
+BENCHMARK(Listing_GetFolderContents_Enumerated_100K_HighLatency)
+{
+	BenchmarkIndexedFolderContents(state, false);
+}
+
+BENCHMARK(Listing_GetFolderContents_Indexed_100K_HighLatency)
+{
+	BenchmarkIndexedFolderContents(state, true);
+}
+
+#endif // _BENCHMARKBUILD
\ No newline at end of file
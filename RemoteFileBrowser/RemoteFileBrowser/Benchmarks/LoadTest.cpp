@@ -0,0 +1,457 @@
+#include "PrecompiledHeader.h"
+
+#if _BENCHMARKBUILD
+
+#include "BenchmarkData.h"
+#include "LoadTest.h"
+#include "Communication\RequestRouter.h"
+#include "Communication\SharedFiles.h"
+#include "Http\Server.h"
+#include "Tcp\Listener.h"
+#include "Utilities\Metrics.h"
+
+using namespace std;
+using namespace Utilities;
+
+enum class RequestType
+{
+	Listing,
+	SmallFile,
+	LargeFile,
+	Count
+};
+
+static const int kRequestTypeCount = static_cast<int>(RequestType::Count);
+static const char* const kRequestTypeNames[kRequestTypeCount] = { "listing", "small_file", "large_file" };
+
+struct SyntheticTree
+{
+	wstring rootPath;
+	vector<wstring> folders;
+	vector<wstring> files;
+	vector<string> urls[kRequestTypeCount];
+};
+
+struct RequestStatistics
+{
+	Metrics::LatencyHistogram latency;
+	atomic<uint64_t> bytesReceived;
+	atomic<uint64_t> errors;
+
+	RequestStatistics()
+	{
+		bytesReceived = 0;
+		errors = 0;
+	}
+};
+
+LoadTest::Options::Options() :
+	connections(64), durationSeconds(30), port(18883),
+	listingWeight(70), smallFileWeight(25), largeFileWeight(5),
+	folderCount(32), filesPerFolder(128), largeFileCount(4), smallFileSize(16 * 1024), largeFileSize(64 * 1024 * 1024),
+	outputPath(L"LoadTestResults.json")
+{
+}
+
+// Synthetic tree
+
+static string PathToUrl(const wstring& path)
+{
+	// The same form FileBrowserResponseHandler uses for its links
+	return "/" + Encoding::EncodeUrl(Encoding::Utf16ToUtf8(path));
+}
+
+static bool WriteSyntheticFile(const wstring& path, const string& contents, uint64_t fileSize)
+{
+	auto fileHandle = FileSystem::CreateFilePortable(path, GENERIC_WRITE, 0, CREATE_ALWAYS);
+
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		Logging::Error(GetLastError(), "Failed to create load test file \"", Encoding::Utf16ToUtf8(path), "\": ");
+		return false;
+	}
+
+	bool succeeded = true;
+
+	for (uint64_t written = 0; written < fileSize && succeeded; written += contents.length())
+	{
+		auto length = static_cast<DWORD>(min<uint64_t>(contents.length(), fileSize - written));
+		DWORD bytesWritten;
+
+		succeeded = WriteFile(fileHandle, contents.data(), length, &bytesWritten, nullptr) != FALSE && bytesWritten == length;
+		Logging::LogErrorIfFailed(!succeeded, "Failed to write load test file: ");
+	}
+
+	CloseHandle(fileHandle);
+	return succeeded;
+}
+
+static bool CreateSyntheticTree(const LoadTest::Options& options, SyntheticTree& tree)
+{
+	wchar_t tempPath[MAX_PATH];
+	auto tempPathLength = GetTempPathW(MAX_PATH, tempPath);
+	Logging::LogFatalErrorIfFailed(tempPathLength == 0 || tempPathLength > MAX_PATH, "Failed to get temporary directory path: ");
+
+	tree.rootPath = wstring(tempPath) + L"RemoteFileBrowserLoadTest";
+	CreateDirectoryW(tree.rootPath.c_str(), nullptr);
+
+	auto folderNames = BenchmarkData::GenerateFileNames(options.folderCount, 1);
+	auto fileNames = BenchmarkData::GenerateFileNames(options.folderCount * options.filesPerFolder, 2);
+	auto smallFileContents = BenchmarkData::GenerateBinaryData(options.smallFileSize, 3);
+	auto largeFileContents = BenchmarkData::GenerateBinaryData(1024 * 1024, 4);
+
+	Logging::Log("Creating load test tree in \"", Encoding::Utf16ToUtf8(tree.rootPath), "\".");
+
+	for (int i = 0; i < options.folderCount; i++)
+	{
+		// Prefix names with their index, since the generated ones can repeat
+		auto folderPath = tree.rootPath + L"\\" + to_wstring(i) + L" " + Encoding::Utf8ToUtf16(folderNames[i]);
+
+		if (CreateDirectoryW(folderPath.c_str(), nullptr) == FALSE && GetLastError() != ERROR_ALREADY_EXISTS)
+		{
+			Logging::Error(GetLastError(), "Failed to create load test folder \"", Encoding::Utf16ToUtf8(folderPath), "\": ");
+			return false;
+		}
+
+		tree.folders.push_back(folderPath);
+		tree.urls[static_cast<int>(RequestType::Listing)].push_back(PathToUrl(folderPath));
+
+		for (int j = 0; j < options.filesPerFolder; j++)
+		{
+			auto filePath = folderPath + L"\\" + to_wstring(j) + L" " + Encoding::Utf8ToUtf16(fileNames[i * options.filesPerFolder + j]);
+
+			if (!WriteSyntheticFile(filePath, smallFileContents, options.smallFileSize))
+			{
+				return false;
+			}
+
+			tree.files.push_back(filePath);
+			tree.urls[static_cast<int>(RequestType::SmallFile)].push_back(PathToUrl(filePath));
+		}
+	}
+
+	for (int i = 0; i < options.largeFileCount; i++)
+	{
+		auto filePath = tree.rootPath + L"\\Large file " + to_wstring(i) + L".bin";
+
+		if (!WriteSyntheticFile(filePath, largeFileContents, options.largeFileSize))
+		{
+			return false;
+		}
+
+		tree.files.push_back(filePath);
+		tree.urls[static_cast<int>(RequestType::LargeFile)].push_back(PathToUrl(filePath));
+	}
+
+	for (int i = 0; i < kRequestTypeCount; i++)
+	{
+		if (tree.urls[i].empty())
+		{
+			Logging::Log("Load test tree has no targets for ", kRequestTypeNames[i], " requests.");
+			return false;
+		}
+	}
+
+	SharedFiles::FileSet fullySharedFolders;
+	fullySharedFolders.insert(Encoding::Utf16ToUtf8(tree.rootPath));
+	SharedFiles::SetSharedFiles(std::move(fullySharedFolders), SharedFiles::FileSet(), SharedFiles::FileSet());
+
+	return true;
+}
+
+static void DeleteSyntheticTree(const SyntheticTree& tree)
+{
+	for (const auto& file : tree.files)
+	{
+		DeleteFileW(file.c_str());
+	}
+
+	for (const auto& folder : tree.folders)
+	{
+		RemoveDirectoryW(folder.c_str());
+	}
+
+	RemoveDirectoryW(tree.rootPath.c_str());
+}
+
+// Client
+
+static SOCKET ConnectToServer(uint16_t port)
+{
+	auto clientSocket = socket(AF_INET6, SOCK_STREAM, IPPROTO_TCP);
+
+	if (clientSocket == INVALID_SOCKET)
+	{
+		return INVALID_SOCKET;
+	}
+
+	DWORD timeout = 30000;	// Don't let a lost response hang the run
+	setsockopt(clientSocket, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+
+	sockaddr_in6 serverAddress;
+	ZeroMemory(&serverAddress, sizeof(serverAddress));
+
+	serverAddress.sin6_family = AF_INET6;
+	serverAddress.sin6_addr.s6_addr[15] = 1;	// ::1
+	serverAddress.sin6_port = htons(port);
+
+	if (connect(clientSocket, reinterpret_cast<sockaddr*>(&serverAddress), sizeof(serverAddress)) == SOCKET_ERROR)
+	{
+		closesocket(clientSocket);
+		return INVALID_SOCKET;
+	}
+
+	return clientSocket;
+}
+
+// Sends a GET request and reads the whole response. Returns the number of bytes received, or 0 on failure
+static uint64_t ExecuteRequest(SOCKET clientSocket, const string& url, vector<char>& buffer)
+{
+	auto request = "GET " + url + " HTTP/1.1\r\nHost: localhost\r\nUser-Agent: RemoteFileBrowserLoadTest\r\n\r\n";
+
+	if (send(clientSocket, request.data(), static_cast<int>(request.length()), 0) != static_cast<int>(request.length()))
+	{
+		return 0;
+	}
+
+	// Read until the end of the header
+
+	size_t received = 0;
+	const char* headerEnd = nullptr;
+
+	while (headerEnd == nullptr)
+	{
+		if (received == buffer.size())
+		{
+			return 0;
+		}
+
+		auto result = recv(clientSocket, buffer.data() + received, static_cast<int>(buffer.size() - received), 0);
+
+		if (result <= 0)
+		{
+			return 0;
+		}
+
+		received += result;
+
+		const char kHeaderTerminator[] = "\r\n\r\n";
+		auto terminator = search(buffer.data(), buffer.data() + received, kHeaderTerminator, kHeaderTerminator + 4);
+
+		if (terminator != buffer.data() + received)
+		{
+			headerEnd = terminator + 4;
+		}
+	}
+
+	string header(buffer.data(), headerEnd - buffer.data());
+
+	if (header.compare(0, 12, "HTTP/1.1 200") != 0)
+	{
+		return 0;
+	}
+
+	const char kContentLength[] = "Content-Length: ";
+	auto contentLengthPosition = header.find(kContentLength);
+
+	if (contentLengthPosition == string::npos)
+	{
+		return 0;
+	}
+
+	auto contentLength = _strtoui64(header.c_str() + contentLengthPosition + sizeof(kContentLength) - 1, nullptr, 10);
+	uint64_t bodyReceived = buffer.data() + received - headerEnd;
+
+	// Drain the body
+
+	while (bodyReceived < contentLength)
+	{
+		auto length = static_cast<int>(min<uint64_t>(buffer.size(), contentLength - bodyReceived));
+		auto result = recv(clientSocket, buffer.data(), length, 0);
+
+		if (result <= 0)
+		{
+			return 0;
+		}
+
+		bodyReceived += result;
+	}
+
+	return header.length() + bodyReceived;
+}
+
+static void RunClient(const LoadTest::Options& options, const SyntheticTree& tree, uint32_t seed, const volatile bool& running, RequestStatistics (&statistics)[kRequestTypeCount])
+{
+	mt19937 random(seed);
+	discrete_distribution<int> requestTypeDistribution({ options.listingWeight, options.smallFileWeight, options.largeFileWeight });
+	vector<char> buffer(64 * 1024);
+	auto clientSocket = INVALID_SOCKET;
+
+	while (running)
+	{
+		if (clientSocket == INVALID_SOCKET)
+		{
+			clientSocket = ConnectToServer(options.port);
+
+			if (clientSocket == INVALID_SOCKET)
+			{
+				Utilities::System::Sleep(10);
+				continue;
+			}
+		}
+
+		auto requestType = requestTypeDistribution(random);
+		const auto& urls = tree.urls[requestType];
+		const auto& url = urls[uniform_int_distribution<size_t>(0, urls.size() - 1)(random)];
+
+		auto startTime = Utilities::System::GetMicroseconds();
+		auto bytesReceived = ExecuteRequest(clientSocket, url, buffer);
+		auto endTime = Utilities::System::GetMicroseconds();
+
+		if (bytesReceived > 0)
+		{
+			statistics[requestType].latency.Record(endTime - startTime);
+			statistics[requestType].bytesReceived += bytesReceived;
+		}
+		else if (running)
+		{
+			// The connection is in an unknown state after a failure, so start over with a new one
+			statistics[requestType].errors++;
+			closesocket(clientSocket);
+			clientSocket = INVALID_SOCKET;
+		}
+	}
+
+	if (clientSocket != INVALID_SOCKET)
+	{
+		closesocket(clientSocket);
+	}
+}
+
+// Reporting
+
+static bool WriteResults(const LoadTest::Options& options, const RequestStatistics (&statistics)[kRequestTypeCount], double elapsedSeconds)
+{
+	stringstream output;
+	output.setf(ios::fixed);
+	output.precision(3);
+
+	output << "{\n\t\"config\": {"
+		<< " \"connections\": " << options.connections
+		<< ", \"duration_seconds\": " << elapsedSeconds
+		<< ", \"mix\": [" << options.listingWeight << ", " << options.smallFileWeight << ", " << options.largeFileWeight << "]"
+		<< ", \"folders\": " << options.folderCount
+		<< ", \"files_per_folder\": " << options.filesPerFolder
+		<< ", \"small_file_size\": " << options.smallFileSize
+		<< ", \"large_file_size\": " << options.largeFileSize << " },\n"
+		<< "\t\"results\": [";
+
+	printf("%-12s %10s %8s %12s %12s %10s %10s %10s\n", "Type", "Requests", "Errors", "Requests/s", "MB/s", "p50 us", "p99 us", "p999 us");
+
+	for (int i = 0; i < kRequestTypeCount; i++)
+	{
+		const auto& latency = statistics[i].latency;
+		auto requests = latency.GetCount();
+		auto requestsPerSecond = requests / elapsedSeconds;
+		auto bytesPerSecond = statistics[i].bytesReceived.load() / elapsedSeconds;
+		auto p50 = latency.GetValueAtQuantile(0.5);
+		auto p99 = latency.GetValueAtQuantile(0.99);
+		auto p999 = latency.GetValueAtQuantile(0.999);
+
+		printf("%-12s %10llu %8llu %12.1f %12.1f %10llu %10llu %10llu\n", kRequestTypeNames[i], requests, statistics[i].errors.load(),
+			requestsPerSecond, bytesPerSecond / (1024 * 1024), p50, p99, p999);
+
+		output << (i == 0 ? "\n" : ",\n")
+			<< "\t\t{ \"type\": \"" << kRequestTypeNames[i] << "\""
+			<< ", \"requests\": " << requests
+			<< ", \"errors\": " << statistics[i].errors.load()
+			<< ", \"requests_per_second\": " << requestsPerSecond
+			<< ", \"bytes_per_second\": " << bytesPerSecond
+			<< ", \"p50_us\": " << p50
+			<< ", \"p99_us\": " << p99
+			<< ", \"p999_us\": " << p999 << " }";
+	}
+
+	output << "\n\t]\n}\n";
+
+	auto json = output.str();
+	auto fileHandle = FileSystem::CreateFilePortable(options.outputPath, GENERIC_WRITE, 0, CREATE_ALWAYS);
+
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		Logging::Error(GetLastError(), "Failed to create load test results file \"", Encoding::Utf16ToUtf8(options.outputPath), "\": ");
+		return false;
+	}
+
+	DWORD bytesWritten;
+	auto result = WriteFile(fileHandle, json.data(), static_cast<DWORD>(json.length()), &bytesWritten, nullptr);
+	Logging::LogErrorIfFailed(result == FALSE, "Failed to write load test results file: ");
+
+	CloseHandle(fileHandle);
+	return result != FALSE && bytesWritten == json.length();
+}
+
+int LoadTest::Run(const Options& options)
+{
+	SyntheticTree tree;
+
+	if (!CreateSyntheticTree(options, tree))
+	{
+		DeleteSyntheticTree(tree);
+		return 1;
+	}
+
+	IN6_ADDR loopbackAddress;
+	ZeroMemory(&loopbackAddress, sizeof(loopbackAddress));
+	loopbackAddress.s6_addr[15] = 1;
+
+	Tcp::Listener listener(true);
+	listener.RunAsync(loopbackAddress, htons(options.port), [](SOCKET incomingSocket, sockaddr_in6 clientAddress)
+	{
+		Http::Server::StartServiceClient(incomingSocket, clientAddress, &RequestRouter::ExecuteRequest);
+	});
+
+	printf("Running %d connections for %d seconds against http://[::1]:%u/\n\n", options.connections, options.durationSeconds, options.port);
+
+	RequestStatistics statistics[kRequestTypeCount];
+	volatile bool running = true;
+	vector<thread> clients;
+	auto startTime = Utilities::System::GetMicroseconds();
+
+	for (int i = 0; i < options.connections; i++)
+	{
+		clients.emplace_back([&options, &tree, i, &running, &statistics]()
+		{
+			RunClient(options, tree, i, running, statistics);
+		});
+	}
+
+	Utilities::System::Sleep(options.durationSeconds * 1000);
+	running = false;
+
+	for (auto& client : clients)
+	{
+		client.join();
+	}
+
+	auto elapsedSeconds = (Utilities::System::GetMicroseconds() - startTime) / 1e6;
+	listener.Stop();
+
+	// Connection threads are detached; let them notice the closed sockets and release the files before deleting the tree
+	for (int i = 0; i < 100 && Metrics::GetValue(Metrics::Gauge::ActiveConnections) > 0; i++)
+	{
+		Utilities::System::Sleep(100);
+	}
+
+	auto succeeded = WriteResults(options, statistics, elapsedSeconds);
+	DeleteSyntheticTree(tree);
+
+	if (succeeded)
+	{
+		printf("\nResults written to %s\n", Encoding::Utf16ToUtf8(options.outputPath).c_str());
+	}
+
+	return succeeded ? 0 : 1;
+}
+
+#endif // _BENCHMARKBUILD
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+// End to end load test: serves a synthetic shared tree from an in-process Http::Server on loopback
+// and drives it with a weighted mix of listing, small file and large file requests over keep-alive connections
+
+namespace LoadTest
+{
+	struct Options
+	{
+		int connections;
+		int durationSeconds;
+		uint16_t port;
+
+		// Relative weights of each request type in the mix
+		int listingWeight;
+		int smallFileWeight;
+		int largeFileWeight;
+
+		// Shape of the synthetic tree
+		int folderCount;
+		int filesPerFolder;
+		int largeFileCount;
+		uint32_t smallFileSize;
+		uint32_t largeFileSize;
+
+		std::wstring outputPath;
+
+		Options();
+	};
+
+	int Run(const Options& options);
+};
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include "PrecompiledHeader.h"
+
+#if _BENCHMARKBUILD
+
+#include "Benchmark.h"
+#include "Communication\SearchIndex.h"
+#include "Communication\SharedFiles.h"
+#include "Utilities\SyntheticFileSystemProvider.h"
+
+using namespace std;
+using namespace Utilities;
+
+// Filename search over a synthetic tree of about 12K folders and 1.4M files
+
+static const char kSyntheticRoot[] = "S:\\Synthetic\\";
+
+static SyntheticFileSystemProvider::Parameters MakeTreeParameters()
+{
+	SyntheticFileSystemProvider::Parameters parameters;
+	parameters.rootPath = Encoding::Utf8ToUtf16(kSyntheticRoot);
+	parameters.maxDepth = 3;
+	parameters.minFanOut = 100;
+	parameters.maxFanOut = 140;
+	return parameters;
+}
+
+static void ShareSyntheticRoot()
+{
+	SharedFiles::FileSet fullySharedFolders;
+	fullySharedFolders.insert(kSyntheticRoot);
+	SharedFiles::SetSharedFiles(std::move(fullySharedFolders), SharedFiles::FileSet(), SharedFiles::FileSet());
+}
+
+// Crawling the tree and building the postings lists from it. The index is off in benchmark runs unless a benchmark turns it on
+BENCHMARK(Search_BuildIndex_1M)
+{
+	SyntheticFileSystemProvider provider(MakeTreeParameters());
+	FileSystemProvider::SetCurrent(&provider);
+	ShareSyntheticRoot();
+
+	uint64_t entryCount = 0;
+
+	while (state.KeepRunning())
+	{
+		SearchIndex::SetEnabled(true);
+		SearchIndex::WaitUntilIdle();
+
+		state.PauseTiming();
+		entryCount = SearchIndex::GetStatistics().entryCount;
+		SearchIndex::SetEnabled(false);
+		state.ResumeTiming();
+	}
+
+	FileSystemProvider::SetCurrent(nullptr);
+	SharedFiles::SetSharedFiles(SharedFiles::FileSet(), SharedFiles::FileSet(), SharedFiles::FileSet());
+	state.SetItemsProcessed(entryCount);
+}
+
+// Queries that only a few names match, and ones that match so many that ranking is capped
+static void BenchmarkSearch(Benchmark::State& state, const char* const* queries, size_t queryCount, SearchIndex::QueryType queryType)
+{
+	SyntheticFileSystemProvider provider(MakeTreeParameters());
+	FileSystemProvider::SetCurrent(&provider);
+	ShareSyntheticRoot();
+
+	SearchIndex::SetEnabled(true);
+	SearchIndex::WaitUntilIdle();
+
+	while (state.KeepRunning())
+	{
+		for (size_t i = 0; i < queryCount; i++)
+		{
+			auto results = SearchIndex::Search(queries[i], queryType, 100);
+			Benchmark::DoNotOptimize(results);
+		}
+	}
+
+	SearchIndex::SetEnabled(false);
+	FileSystemProvider::SetCurrent(nullptr);
+	SharedFiles::SetSharedFiles(SharedFiles::FileSet(), SharedFiles::FileSet(), SharedFiles::FileSet());
+	state.SetItemsProcessed(queryCount);
+}
+
+static const char* const kSelectiveQueries[] = { "qzx", "abcd", "Xq 1", "zz 12", "e 123." };
+static const char* const kBroadQueries[] = { ".pdf", " 1", "a" };
+
+BENCHMARK(Search_Substring_Selective_1M)
+{
+	BenchmarkSearch(state, kSelectiveQueries, sizeof(kSelectiveQueries) / sizeof(kSelectiveQueries[0]), SearchIndex::QueryType::Substring);
+}
+
+BENCHMARK(Search_Substring_Broad_1M)
+{
+	BenchmarkSearch(state, kBroadQueries, sizeof(kBroadQueries) / sizeof(kBroadQueries[0]), SearchIndex::QueryType::Substring);
+}
+
+BENCHMARK(Search_Prefix_Selective_1M)
+{
+	BenchmarkSearch(state, kSelectiveQueries, sizeof(kSelectiveQueries) / sizeof(kSelectiveQueries[0]), SearchIndex::QueryType::Prefix);
+}
+
+#endif
\ No newline at end of file
@@ -4,24 +4,140 @@
 namespace AssetDatabase
 {
 	using namespace std;
-	using namespace Utilities;
 
-	static vector<uint8_t> s_ScriptsFile;
-	static vector<uint8_t> s_StyleFile;
+	struct EmbeddedAsset
+	{
+		const char* name;
+		const uint8_t* data;
+		size_t size;
+		const uint8_t* gzipData;
+		size_t gzipSize;
+	};
+
+#include "Resources\EmbeddedAssets.inl"
+
+	struct Asset
+	{
+		string name;
+		string fingerprintedName;
+		string url;
+		AssetResponses plainResponses;
+		AssetResponses fingerprintedResponses;
+	};
+
+	static vector<Asset> s_Assets;
+
+	static const char* GetContentType(const string& name)
+	{
+		auto extension = name.substr(name.find_last_of('.') + 1);
+
+		if (extension == "js")
+		{
+			return "application/javascript";
+		}
+
+		if (extension == "css")
+		{
+			return "text/css";
+		}
+
+		return "application/octet-stream";
+	}
+
+	// 64-bit FNV-1a. It only has to tell versions of the same asset apart
+	static string HashContent(const uint8_t* data, size_t size)
+	{
+		uint64_t hash = 14695981039346656037ull;
+
+		for (size_t i = 0; i < size; i++)
+		{
+			hash = (hash ^ data[i]) * 1099511628211ull;
+		}
+
+		char hex[17];
+		sprintf_s(hex, "%016llx", hash);
+		return hex;
+	}
+
+	// Sent as HTTP/1.1 whatever the request said, which HTTP/1.0 clients accept too
+	static string FormResponse(const char* contentType, const char* cacheControl, const char* contentEncoding, const uint8_t* body, size_t bodyLength)
+	{
+		stringstream header;
+
+		header << "HTTP/1.1 200 OK\r\n";
+		header << "Content-Type: " << contentType << "\r\n";
+		header << "Content-Length: " << bodyLength << "\r\n";
+		header << "Cache-Control: " << cacheControl << "\r\n";
+		header << "Vary: Accept-Encoding\r\n";
+
+		if (contentEncoding != nullptr)
+		{
+			header << "Content-Encoding: " << contentEncoding << "\r\n";
+		}
+
+		header << "\r\n";
+
+		auto response = header.str();
+		response.append(reinterpret_cast<const char*>(body), bodyLength);
+		return response;
+	}
+
+	static AssetResponses FormResponses(const EmbeddedAsset& embeddedAsset, const char* cacheControl)
+	{
+		auto contentType = GetContentType(embeddedAsset.name);
+		AssetResponses responses;
+
+		responses.identity = FormResponse(contentType, cacheControl, nullptr, embeddedAsset.data, embeddedAsset.size);
+		responses.gzip = FormResponse(contentType, cacheControl, "gzip", embeddedAsset.gzipData, embeddedAsset.gzipSize);
+		return responses;
+	}
 
 	void Initialize()
 	{
-		s_ScriptsFile = FileSystem::ReadFileToVector(L"Resources\\scripts.js");
-		s_StyleFile = FileSystem::ReadFileToVector(L"Resources\\style.css");
+		for (const auto& embeddedAsset : kEmbeddedAssets)
+		{
+			Asset asset;
+			asset.name = embeddedAsset.name;
+
+			auto extensionStart = asset.name.find_last_of('.');
+			asset.fingerprintedName = asset.name.substr(0, extensionStart) + '.' + HashContent(embeddedAsset.data, embeddedAsset.size) + asset.name.substr(extensionStart);
+			asset.url = '/' + asset.fingerprintedName;
+
+			asset.plainResponses = FormResponses(embeddedAsset, "no-cache");
+			asset.fingerprintedResponses = FormResponses(embeddedAsset, "public, max-age=31536000, immutable");
+			s_Assets.push_back(asset);
+		}
 	}
 
-	const std::vector<uint8_t>& GetScriptsFile()
+	const AssetResponses* Find(const std::string& name)
 	{
-		return s_ScriptsFile;
+		for (const auto& asset : s_Assets)
+		{
+			if (name == asset.fingerprintedName)
+			{
+				return &asset.fingerprintedResponses;
+			}
+
+			if (name == asset.name)
+			{
+				return &asset.plainResponses;
+			}
+		}
+
+		return nullptr;
 	}
 
-	const std::vector<uint8_t>& GetStyleFile()
+	const std::string& GetUrl(const std::string& name)
 	{
-		return s_StyleFile;
+		for (const auto& asset : s_Assets)
+		{
+			if (name == asset.name)
+			{
+				return asset.url;
+			}
+		}
+
+		Assert(false);
+		return s_Assets.front().url;
 	}
 }
\ No newline at end of file
@@ -1,10 +1,21 @@
 #pragma once
 
+// Web assets embedded into the binary by Resources\EmbedAssets.ps1, served from whole prebuilt responses.
+// Each one is reachable under a fingerprinted name that carries a hash of its content, which browsers may cache forever,
+// and under its plain name, which they have to revalidate
 namespace AssetDatabase
 {
+	struct AssetResponses
+	{
+		std::string identity;
+		std::string gzip;
+	};
+
 	void Initialize();
 
-	const std::vector<uint8_t>& GetScriptsFile();
-	const std::vector<uint8_t>& GetStyleFile();
-};
+	// nullptr if there's no asset by that name
+	const AssetResponses* Find(const std::string& name);
 
+	// Fingerprinted URL to link to an asset by
+	const std::string& GetUrl(const std::string& name);
+};
\ No newline at end of file
@@ -1,6 +1,6 @@
 #include "PrecompiledHeader.h"
 #include "ClientServerConnection.h"
-#include "FileBrowserResponseHandler.h"
+#include "RequestRouter.h"
 #include "Http\Server.h"
 #include "Http\RestCommunicator.h"
 #include "Tcp\Listener.h"
@@ -39,7 +39,7 @@ void ClientServerConnection::Create(SOCKET connectionSocket, string&& hostname)
 	Tcp::Listener listener;
 	listener.RunAsync(socketAddress.sin6_addr, socketAddress.sin6_port, [](SOCKET incomingSocket, sockaddr_in6 clientAddress)
 	{
-		Http::Server::StartServiceClient(incomingSocket, clientAddress, &FileBrowserResponseHandler::ExecuteRequest);
+		Http::Server::StartServiceClient(incomingSocket, clientAddress, &RequestRouter::ExecuteRequest);
 	});
 
 	// Receive client IPs
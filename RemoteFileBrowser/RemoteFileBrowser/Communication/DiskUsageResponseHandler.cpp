@@ -0,0 +1,45 @@
+#include "PrecompiledHeader.h"
+#include "DiskUsageResponseHandler.h"
+#include "FolderSizes.h"
+#include "SharedFiles.h"
+#include "Http\ResponseWriter.h"
+#include "Utilities\Metrics.h"
+
+using namespace std;
+using namespace Utilities;
+
+void DiskUsageResponseHandler::ExecuteRequest(SOCKET clientSocket, const string& folderPath, const string& httpVersion, Http::RequestContext& context)
+{
+	Http::ResponseWriter writer(clientSocket, context);
+
+	if (folderPath.length() > MAX_PATH - 4 || !SharedFiles::IsFolderVisible(folderPath))
+	{
+		Metrics::Increment(Metrics::Counter::NotFoundResponses);
+		auto httpHeader = httpVersion + " 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+		writer.Send(httpHeader.c_str(), httpHeader.length(), true);
+		return;
+	}
+
+	FolderSizes::Totals totals;
+
+	if (!FolderSizes::Compute(folderPath, totals, context.cancellationToken))
+	{
+		return;
+	}
+
+	string body = "{\"path\":\"";
+	Encoding::AppendEscapedJson(body, folderPath);
+	body += "\",\"size\":" + to_string(totals.size);
+	body += ",\"files\":" + to_string(totals.fileCount);
+	body += ",\"folders\":" + to_string(totals.folderCount) + "}";
+
+	stringstream headerStream;
+	headerStream << httpVersion << " 200 OK\r\n";
+	headerStream << "Content-Type: application/json\r\n";
+	headerStream << "Cache-Control: no-cache\r\n";
+	headerStream << "Content-Length: " << body.length() << "\r\n\r\n";
+
+	auto header = headerStream.str();
+	WSABUF buffers[] = { Http::ResponseWriter::MakeBuffer(header.data(), header.length()), Http::ResponseWriter::MakeBuffer(body.data(), body.length()) };
+	writer.Send(buffers, sizeof(buffers) / sizeof(buffers[0]), true);
+}
\ No newline at end of file
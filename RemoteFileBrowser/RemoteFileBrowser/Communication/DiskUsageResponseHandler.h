@@ -0,0 +1,9 @@
+#pragma once
+
+#include "Http\RequestContext.h"
+
+// Recursive size of a shared folder as JSON, for requests like /du/C:/Folder
+namespace DiskUsageResponseHandler
+{
+	void ExecuteRequest(SOCKET clientSocket, const std::string& folderPath, const std::string& httpVersion, Http::RequestContext& context);
+};
\ No newline at end of file
@@ -1,25 +1,33 @@
 #include "PrecompiledHeader.h"
 #include "AssetDatabase.h"
 #include "FileBrowserResponseHandler.h"
+#include "FolderSizes.h"
+#include "ListingCoalescer.h"
+#include "NegativeLookupCache.h"
+#include "SearchIndex.h"
 #include "SharedFiles.h"
-#include "Utilities\StreamableFile.h"
-#include "Utilities\Event.h"
+#include "Utilities\FileCache.h"
+#include "Utilities\ReadaheadRing.h"
+#include "Utilities\Metrics.h"
+#include "Utilities\Tracing.h"
 
 using namespace std;
 using namespace Utilities;
 
-void FileBrowserResponseHandler::ExecuteRequest(SOCKET clientSocket, const string& requestedPath, const string& httpVersion)
+void FileBrowserResponseHandler::ExecuteRequest(SOCKET clientSocket, const string& requestedPath, const string& httpVersion, Http::RequestContext& context)
 {
-	FileBrowserResponseHandler handler(clientSocket, requestedPath, httpVersion);
+	FileBrowserResponseHandler handler(clientSocket, requestedPath, httpVersion, context);
 	handler.Execute();
 }
 
-FileBrowserResponseHandler::FileBrowserResponseHandler(SOCKET clientSocket, const string& requestedPath, const string& httpVersion) :
+FileBrowserResponseHandler::FileBrowserResponseHandler(SOCKET clientSocket, const string& requestedPath, const string& httpVersion, Http::RequestContext& context) :
 	m_ClientSocket(clientSocket),
 	m_HttpVersion(httpVersion),
 	m_RequestedPath(requestedPath), 
-	m_FileStatus(FileSystem::QueryFileStatus(Encoding::Utf8ToUtf16(requestedPath))),
-	m_ErrorCode(ERROR_SUCCESS)
+	m_FileStatus(FileSystem::FileStatus::Directory),		// The system volumes, unless the path names something
+	m_ErrorCode(ERROR_SUCCESS),
+	m_Context(context),
+	m_Writer(clientSocket, context)
 {
 	Logging::Log("Requested path: \"", requestedPath, "\".");
 }
@@ -28,37 +36,71 @@ void FileBrowserResponseHandler::Execute()
 {
 	if (m_RequestedPath.length() > 1 && m_RequestedPath[1] != ':')
 	{
+		Metrics::Increment(Metrics::Counter::BuiltinAssetRequests);
 		SendBuiltinFile();
 		return;
 	}
 
+	if (!m_RequestedPath.empty())
+	{
+		// Paths that can't be served whatever is on the disk are turned away before looking there
+		if (!SharedFiles::IsFileShared(m_RequestedPath) && !SharedFiles::IsFolderVisible(m_RequestedPath))
+		{
+			SendNotFoundResponse();
+			return;
+		}
+
+		m_FileStatus = NegativeLookupCache::QueryFileStatus(m_RequestedPath);
+
+		if (m_FileStatus == FileSystem::FileStatus::FileNotFound)
+		{
+			SendNotFoundResponse();
+			return;
+		}
+	}
+
 	if (m_FileStatus == FileSystem::FileStatus::File)
 	{
+		Metrics::Increment(Metrics::Counter::FileRequests);
 		SendFileResponse();
 	}
 	else
 	{
+		Metrics::Increment(Metrics::Counter::ListingRequests);
 		SendHtmlResponse();
 	}
 }
 
-bool FileBrowserResponseHandler::SendData(const char* data, size_t length) const
+// The header, if any, goes out with the first slice
+bool FileBrowserResponseHandler::SendShapedData(const string& header, const char* data, size_t length, bool isLastWrite, BandwidthShaper::Stream& stream) const
 {
-	Assert(length < static_cast<size_t>(numeric_limits<int>::max()));
-	auto sendResult = send(m_ClientSocket, data, static_cast<int>(length), 0);
+	WSABUF buffers[] = { Http::ResponseWriter::MakeBuffer(header.data(), header.length()), WSABUF() };
+	DWORD headerCount = header.empty() ? 0 : 1;
 
-	if (sendResult == SOCKET_ERROR)
+	while (length > 0)
 	{
-		Logging::Error(WSAGetLastError(), "Failed to send response: ");
+		auto sliceLength = stream.Acquire(length, m_Context.cancellationToken);
+		buffers[1] = Http::ResponseWriter::MakeBuffer(data, sliceLength);
+
+		if (!m_Writer.Send(buffers + 1 - headerCount, headerCount + 1, isLastWrite && sliceLength == length))
+		{
+			return false;
+		}
+
+		headerCount = 0;
+		data += sliceLength;
+		length -= sliceLength;
 	}
 
-	return sendResult == static_cast<int>(length);
+	return true;
 }
 
 void FileBrowserResponseHandler::SendNotFoundResponse() const
 {
-	auto httpHeader = m_HttpVersion + " 404 Not Found\r\n";
-	SendData(httpHeader.c_str(), httpHeader.length());
+	Metrics::Increment(Metrics::Counter::NotFoundResponses);
+
+	auto httpHeader = m_HttpVersion + " 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+	m_Writer.Send(httpHeader.c_str(), httpHeader.length(), true);
 }
 
 void FileBrowserResponseHandler::SendFileResponse() const
@@ -71,141 +113,208 @@ void FileBrowserResponseHandler::SendFileResponse() const
 
 	try
 	{
-		StreamFile();
+		StreamableFile file(Encoding::Utf8ToUtf16(m_RequestedPath));
+
+		if (!SendFileThroughCache(file))
+		{
+			StreamFile(file);
+		}
+
 		return;
 	}
 	catch (exception)
 	{
-		// StreamFile will throw exception on failure
+		// StreamableFile will throw exception on failure
 
 		Logging::Error(GetLastError(), "Failed to send file \"", m_RequestedPath, "\": ");
-		closesocket(m_ClientSocket);
+		shutdown(m_ClientSocket, SD_BOTH);	// The connection owner closes it once it notices
 
 		SetLastError(ERROR_SUCCESS);
 	}
 }
 
+// Assets come with their whole response prebuilt, so they go out with a single write
 void FileBrowserResponseHandler::SendBuiltinFile() const
 {
-	stringstream httpResponse;
-	string contentType;
-	size_t contentLength;
-	const char* data;
+	auto asset = AssetDatabase::Find(m_RequestedPath);
 
-	if (m_RequestedPath == "scripts.js")
+	if (asset == nullptr)
 	{
-		auto& file = AssetDatabase::GetScriptsFile();
-		contentLength = file.size();
-		data = reinterpret_cast<const char*>(file.data());
-		contentType = "application/javascript";
+		SendNotFoundResponse();
+		return;
 	}
-	else if (m_RequestedPath == "style.css")
+
+	auto& response = m_Context.acceptsGzip ? asset->gzip : asset->identity;
+	m_Writer.Send(response.data(), response.length(), true);
+}
+
+// Small, popular files are served from memory, together with their header in a single write unless shaping slices them.
+// Returns false if the file isn't cached and isn't worth caching yet
+bool FileBrowserResponseHandler::SendFileThroughCache(StreamableFile& file) const
+{
+	FileSystemProvider::File::Version version;
+
+	if (!file.GetVersion(version))
 	{
-		auto& file = AssetDatabase::GetStyleFile();
-		contentLength = file.size();
-		data = reinterpret_cast<const char*>(file.data());
-		contentType = "text/css";
+		SetLastError(ERROR_SUCCESS);
+		return false;
 	}
-	else
+
+	auto contents = FileCache::Find(m_RequestedPath, version);
+
+	if (contents == nullptr)
 	{
-		SendNotFoundResponse();
-		return;
+		if (!FileCache::ShouldAdmit(m_RequestedPath, file.GetFileSize()))
+		{
+			return false;
+		}
+
+		auto fileContents = make_shared<vector<char>>(static_cast<size_t>(file.GetFileSize()));
+		size_t position = 0;
+
+		while (!file.IsEndOfFile())
+		{
+			int bytesRead;
+			file.ReadNextChunk(fileContents->data() + position, bytesRead);
+			position += bytesRead;
+		}
+
+		contents = fileContents;
+		FileCache::Insert(m_RequestedPath, version, contents);
 	}
 
-	auto header = FormHttpHeaderForFile(contentType, m_RequestedPath, contentLength);
-	SendData(header.c_str(), header.length());
-	SendData(data, contentLength);
+	Metrics::ScopedGauge activeDownload(Metrics::Gauge::ActiveDownloads);
+	BandwidthShaper::Stream shapedStream(GetClientAddress());
+
+	auto httpHeader = FormHttpHeaderForFile("application/force-download", GetRequestedFileName(), contents->size());
+	SendShapedData(httpHeader, contents->data(), contents->size(), true, shapedStream);
+	return true;
 }
 
-void FileBrowserResponseHandler::StreamFile() const
+void FileBrowserResponseHandler::StreamFile(StreamableFile& file) const
 {
-	StreamableFile file(Encoding::Utf8ToUtf16(m_RequestedPath));
+	Metrics::ScopedGauge activeDownload(Metrics::Gauge::ActiveDownloads);
+	BandwidthShaper::Stream shapedStream(GetClientAddress());
+
+	// Form the header, which goes out with the first chunk
 
-	// Form and send the header
+	auto httpHeader = FormHttpHeaderForFile("application/force-download", GetRequestedFileName(), file.GetFileSize());
 
-	auto fileName = m_RequestedPath.substr(m_RequestedPath.find_last_of('\\') + 1);
-	auto httpHeader = FormHttpHeaderForFile("application/force-download", fileName, file.GetFileSize());
+	if (file.IsEndOfFile())
+	{
+		m_Writer.Send(httpHeader.c_str(), httpHeader.length(), true);
+		return;
+	}
 
-	SendData(httpHeader.c_str(), httpHeader.length());
+	// Huge files can skip the file system cache, if so configured, and then don't get mapped either
+	auto isUnbuffered = false;
 
-	// Stream the file
+	if (StreamableFile::ShouldBypassCache(file.GetFileSize()))
+	{
+		isUnbuffered = file.BypassCache();
 
-	int bytesRead = 0;
-	const int kBufferCount = 2;
-	unique_ptr<char[]> buffers[kBufferCount];
+		if (!isUnbuffered)
+		{
+			Logging::Error(GetLastError(), "Failed to bypass the file system cache for \"", m_RequestedPath, "\": ");
+			SetLastError(ERROR_SUCCESS);
+		}
+	}
 
-	for (auto& buffer : buffers)
+	if (!isUnbuffered && file.GetFileSize() >= StreamableFile::kMinMappedFileSize && SendMappedFile(file, httpHeader, shapedStream))
 	{
-		buffer = unique_ptr<char[]>(new char[StreamableFile::kMaxChunkSize]);
+		return;
 	}
 
-	int currentBufferIndex = 1;
-	char* volatile currentBuffer;
-	volatile int currentDataLength;
-	volatile bool doneReading = false;
-	volatile bool doneSending = false;
-	bool failed = false;
+	// Stream the file, reading ahead while sending
 
-	Event dataReadyEvent(false),
-		  bufferPtrReadEvent(false);
+	ReadaheadRing ring(file);
 
-	thread sendingThread([this, &currentBuffer, &currentDataLength, &doneReading, &doneSending, &dataReadyEvent, &bufferPtrReadEvent]()
+	for (;;)
 	{
-		for (;;)
+		auto chunk = ring.AcquireChunk();
+		auto sent = SendShapedData(httpHeader, chunk.data, chunk.length, chunk.isLast, shapedStream);
+		ring.ReleaseChunk();
+
+		if (!sent)
 		{
-			dataReadyEvent.Wait();
+			Logging::Log("Stopped streaming \"", m_RequestedPath, "\", the client is gone.");
+			return;
+		}
 
-			if (doneReading)
-			{
-				return;
-			}
+		if (chunk.isLast)
+		{
+			return;
+		}
 
-			auto dataPtr = currentBuffer;
-			auto length = currentDataLength;
+		httpHeader.clear();
+	}
+}
 
-			bufferPtrReadEvent.Set();
+// Sends straight from mapped views, mapping the next chunk, which prefetches it, while the current one goes out.
+// Returns false, with nothing sent, if the file can't be mapped
+bool FileBrowserResponseHandler::SendMappedFile(StreamableFile& file, string& httpHeader, BandwidthShaper::Stream& shapedStream) const
+{
+	uint32_t length;
+	auto view = file.MapNextChunk(length);
 
-			if (!SendData(dataPtr, currentDataLength))
+	if (view == nullptr)
+	{
+		Logging::Error(GetLastError(), "Failed to map \"", m_RequestedPath, "\", reading it instead: ");
+		SetLastError(ERROR_SUCCESS);
+		return false;
+	}
+
+	for (;;)
+	{
+		auto isLastChunk = file.IsEndOfFile();
+		FileSystemProvider::File::View nextView;
+		uint32_t nextLength = 0;
+
+		if (!isLastChunk)
+		{
+			nextView = file.MapNextChunk(nextLength);
+
+			if (nextView == nullptr)
 			{
-				bufferPtrReadEvent.Set();
-				doneSending = true;
-				return;
+				throw exception();	// Too late to fall back, the header promised the whole file
 			}
 		}
-	});
 
-	while (!file.IsEndOfFile())
-	{
-		try
+		if (!SendShapedData(httpHeader, view.get(), length, isLastChunk, shapedStream))
 		{
-			file.ReadNextChunk(buffers[currentBufferIndex].get(), bytesRead);
+			Logging::Log("Stopped streaming \"", m_RequestedPath, "\", the client is gone.");
+			return true;
+		}
 
-			currentBuffer = buffers[currentBufferIndex].get();
-			currentDataLength = bytesRead;
+		if (isLastChunk)
+		{
+			return true;
+		}
 
-			dataReadyEvent.Set();
-			
-			const DWORD kTimeout = 30000;	// 30 seconds
-			if (!bufferPtrReadEvent.Wait(kTimeout))	// Throw exception if the other thread fails to second data within 30 seconds
-				throw exception();	// This usually happens when browser cancels download but doesn't close the socket
+		httpHeader.clear();
+		view = std::move(nextView);
+		length = nextLength;
+	}
+}
 
-			if (doneSending)
-				break;
+string FileBrowserResponseHandler::GetRequestedFileName() const
+{
+	return m_RequestedPath.substr(m_RequestedPath.find_last_of('\\') + 1);
+}
 
-			currentBufferIndex = (currentBufferIndex + 1) % kBufferCount;
-		}
-		catch (exception)
-		{
-			doneReading = true;
-			dataReadyEvent.Set();
-			sendingThread.join();
-			throw;
-		}
+IN6_ADDR FileBrowserResponseHandler::GetClientAddress() const
+{
+	sockaddr_in6 address;
+	int addressLength = sizeof(address);
+	ZeroMemory(&address, sizeof(address));
+
+	// Clients we can't identify share a single bucket
+	if (getpeername(m_ClientSocket, reinterpret_cast<sockaddr*>(&address), &addressLength) == SOCKET_ERROR)
+	{
+		Logging::Error(WSAGetLastError(), "Failed to get the client address: ");
 	}
 
-	doneReading = true;
-	dataReadyEvent.Set();
-	sendingThread.join();
+	return address.sin6_addr;
 }
 
 string FileBrowserResponseHandler::FormHttpHeaderForFile(const string& contentType, const string& fileName, uint64_t fileSize) const
@@ -220,14 +329,33 @@ string FileBrowserResponseHandler::FormHttpHeaderForFile(const string& contentTy
 	return httpHeader.str();
 }
 
+// Pages only depend on the path, so concurrent requests for the same one share a single rendering.
+// A page cut short by its client going away isn't shared
 void FileBrowserResponseHandler::SendHtmlResponse() const
 {
-	auto response = FormHtmlResponse();
-	SendData(response.data(), static_cast<int>(response.length()));
+	auto html = ListingCoalescer::Render(m_RequestedPath, [this]() -> ListingCoalescer::Listing
+	{
+		auto html = make_shared<string>(FormHtmlResponse());
+
+		if (m_Context.cancellationToken.IsCancelled())
+		{
+			return nullptr;
+		}
+
+		return html;
+	});
+
+	if (html != nullptr && !m_Context.cancellationToken.IsCancelled())
+	{
+		auto header = FormHttpHeaderForHtml(html->length());
+		WSABUF buffers[] = { Http::ResponseWriter::MakeBuffer(header.data(), header.length()), Http::ResponseWriter::MakeBuffer(html->data(), html->length()) };
+		m_Writer.Send(buffers, sizeof(buffers) / sizeof(buffers[0]), true);
+	}
 }
 
 string FileBrowserResponseHandler::FormHtmlResponse() const
 {
+	TRACE_SCOPE("FileBrowserResponseHandler::FormHtmlResponse");
 	stringstream html;
 
 	html << "<!DOCTYPE html>"
@@ -238,33 +366,33 @@ string FileBrowserResponseHandler::FormHtmlResponse() const
 
 	html << "</html>";
 
-	return WrapHtmlInHttpHeader(html.str());
+	return html.str();
 }
 
-string FileBrowserResponseHandler::WrapHtmlInHttpHeader(const string& html) const
+string FileBrowserResponseHandler::FormHttpHeaderForHtml(size_t htmlLength) const
 {
-	stringstream httpResponse;
+	stringstream httpHeader;
 
-	httpResponse << m_HttpVersion << " 200 OK\r\n";
-	httpResponse << "Content-Type: text/html; charset=utf-8\r\n";
-	httpResponse << "Content-Length: " << html.length() << "\r\n\r\n";
-	httpResponse << html;
+	httpHeader << m_HttpVersion << " 200 OK\r\n";
+	httpHeader << "Content-Type: text/html; charset=utf-8\r\n";
+	httpHeader << "Content-Length: " << htmlLength << "\r\n\r\n";
 
-	return httpResponse.str();
+	return httpHeader.str();
 }
 
 void FileBrowserResponseHandler::FormHtmlResponseHead(stringstream& html) const
 {
 	html << "<head>"
-				"<title>HTTP File Browser - " << m_RequestedPath << "</title>"
+				"<title>HTTP File Browser - " << Encoding::EscapeHtml(m_RequestedPath) << "</title>"
 				"<meta charset=\"utf-8\" />"
-				"<link rel=\"stylesheet\" type=\"text/css\" href=\"/style.css\" />"
-				"<script src=\"/scripts.js\"></script>"
+				"<link rel=\"stylesheet\" type=\"text/css\" href=\"" << AssetDatabase::GetUrl("style.css") << "\" />"
+				"<script src=\"" << AssetDatabase::GetUrl("scripts.js") << "\"></script>"
 			"</head>";
 }
 
 void FileBrowserResponseHandler::FormHtmlResponseBody(stringstream& html) const
 {
+	TRACE_SCOPE("FileBrowserResponseHandler::FormHtmlResponseBody");
 	auto upPath = Utilities::FileSystem::RemoveLastPathComponent(m_RequestedPath);
 	Utilities::Encoding::EncodeUrlInline(upPath);
 
@@ -272,7 +400,7 @@ void FileBrowserResponseHandler::FormHtmlResponseBody(stringstream& html) const
 				"<h1>HTTP File Browser</h1>"
 				"<br/>"
 				"<a href=/" << upPath << "><h2>Go up</h2></a>"
-				"<h2>File system at path \"" << m_RequestedPath << "\":</h2>"
+				"<h2>File system at path \"" << Encoding::EscapeHtml(m_RequestedPath) << "\":</h2>"
 				"<br/>"
 				"<br/>";
 
@@ -295,10 +423,6 @@ void FileBrowserResponseHandler::GenerateHtmlBodyContent(stringstream& html) con
 			GenerateHtmlBodyContentAccessDenied(html);
 			break;
 
-		case FileSystem::FileStatus::FileNotFound:
-			GenerateHtmlBodyContentFileNotFound(html);
-			break;
-
 		case FileSystem::FileStatus::Directory:
 			GenerateHtmlBodyContentOfDirectory(html);
 			break;
@@ -311,7 +435,7 @@ void FileBrowserResponseHandler::GenerateHtmlBodyContent(stringstream& html) con
 
 void FileBrowserResponseHandler::GenerateHtmlBodyContentError(stringstream& html, const string& errorMessage) const
 {
-	html << "<font color=\"red\">" << errorMessage << "</font>";
+	html << "<font color=\"red\">" << Encoding::EscapeHtml(errorMessage) << "</font>";
 	html << "<br/><br/>";
 	html << "<a href=\"/\">Return to homepage</a>";
 }
@@ -322,14 +446,9 @@ void FileBrowserResponseHandler::GenerateHtmlBodyContentAccessDenied(stringstrea
 	GenerateHtmlBodyContentError(html, errorMessage);
 }
 
-void FileBrowserResponseHandler::GenerateHtmlBodyContentFileNotFound(stringstream& html) const
-{
-	auto errorMessage = "Error: \"" + m_RequestedPath + "\" does not exist.";
-	GenerateHtmlBodyContentError(html, errorMessage);
-}
-
 void FileBrowserResponseHandler::GenerateHtmlBodyContentOfDirectory(stringstream& html) const
 {
+	TRACE_SCOPE("FileBrowserResponseHandler::GenerateHtmlBodyContentOfDirectory");
 	using namespace Utilities::FileSystem;
 
 	if (m_RequestedPath.length() > MAX_PATH - 4)
@@ -345,10 +464,17 @@ void FileBrowserResponseHandler::GenerateHtmlBodyContentOfDirectory(stringstream
 		return;
 	}
 
-	auto files = SharedFiles::GetFolderContents(m_RequestedPath);
+	auto files = SharedFiles::GetFolderContents(m_RequestedPath, m_Context.cancellationToken);
+
+	if (m_Context.cancellationToken.IsCancelled())
+	{
+		return;
+	}
 
 	if (files.size() > 0)
 	{
+		SearchIndex::Update(m_RequestedPath, files);
+		AddFolderSizes(m_RequestedPath, files);
 		html << "<table class=sortable>";
 
 		html << "<tr>"
@@ -358,43 +484,9 @@ void FileBrowserResponseHandler::GenerateHtmlBodyContentOfDirectory(stringstream
 					"<th>Date modified</th>"
 				"</tr>";
 
-		for (auto& file : files)
-		{
-			string filePath;
-			string fileType;
-
-			// Figure out file type
-
-			if (file.fileStatus == FileStatus::Directory)
-			{
-				fileType = "";
-			}
-			else
-			{
-				fileType = file.fileName.substr(file.fileName.find_last_of('.') + 1);
-			}
-
-			// Prepare file path for the hyperlink
-
-			filePath = CombinePaths(m_RequestedPath, file.fileName);
-			Encoding::EncodeUrlInline(filePath);
-			
-			// Format file size
-
-			string fileSize;
-
-			if (file.fileSize > 0)
-			{
-				fileSize = FormatFileSizeString(file.fileSize);
-			}
-
-			html << "<tr>"
-						"<td><a href=\"/" << filePath << "\">" << file.fileName << "</a></td>"
-						"<td>" << fileType << "</td>"
-						"<td>" << fileSize << "</td>"
-						"<td>" << file.dateModified << "</td>"
-					"</tr>";
-		}
+		string rows;
+		AppendDirectoryRows(rows, m_RequestedPath, files);
+		html.write(rows.data(), rows.size());
 
 		html << "</table>";
 	}
@@ -415,8 +507,71 @@ void FileBrowserResponseHandler::GenerateHtmlBodyContentOfDirectory(stringstream
 	}
 }
 
+// Folders get the totals that are cached, and the rest are walked in the background for the next time they're listed
+void FileBrowserResponseHandler::AddFolderSizes(const string& directoryPath, vector<FileSystem::FileInfo>& files)
+{
+	using namespace Utilities::FileSystem;
+	FolderSizes::Update(directoryPath, files);
+
+	for (auto& file : files)
+	{
+		if (file.fileStatus != FileStatus::Directory)
+		{
+			continue;
+		}
+
+		auto folderPath = CombinePaths(directoryPath, file.fileName);
+		FolderSizes::Totals totals;
+
+		if (FolderSizes::Find(folderPath, totals))
+		{
+			file.fileSize = totals.size;
+		}
+		else
+		{
+			FolderSizes::ComputeInBackground(folderPath);
+		}
+	}
+}
+
+void FileBrowserResponseHandler::AppendDirectoryRows(string& html, const string& directoryPath, const vector<FileSystem::FileInfo>& files)
+{
+	TRACE_SCOPE("FileBrowserResponseHandler::AppendDirectoryRows");
+	using namespace Utilities::FileSystem;
+
+	// Rows are appended to one string instead of going through a stream, and names are escaped in runs between special characters
+	html.reserve(html.size() + files.size() * 256);
+
+	for (auto& file : files)
+	{
+		html.append("<tr><td><a href=\"/");
+		Encoding::AppendEncodedUrl(html, CombinePaths(directoryPath, file.fileName));
+		html.append("\">");
+		Encoding::AppendEscapedHtml(html, file.fileName);
+		html.append("</a></td><td>");
+
+		if (file.fileStatus != FileStatus::Directory)
+		{
+			auto extensionStart = file.fileName.find_last_of('.') + 1;
+			Encoding::AppendEscapedHtml(html, file.fileName.c_str() + extensionStart, file.fileName.length() - extensionStart);
+		}
+
+		html.append("</td><td>");
+
+		if (file.fileSize > 0)
+		{
+			html.append(FormatFileSizeString(file.fileSize));
+		}
+
+		html.append("</td><td>");
+		html.append(file.dateModified);
+		html.append("</td></tr>");
+	}
+}
+
 void FileBrowserResponseHandler::GenerateHtmlBodyContentOfSystemVolumes(stringstream& html) const
 {
+	TRACE_SCOPE("FileBrowserResponseHandler::GenerateHtmlBodyContentOfSystemVolumes");
 	html << "<table>";
 
 	for (const auto& file : SharedFiles::GetVolumes())
@@ -1,5 +1,10 @@
 #pragma once
 
+#include "Http\ResponseWriter.h"
+#include "Utilities\BandwidthShaper.h"
+
+class StreamableFile;
+
 class FileBrowserResponseHandler
 {
 private:
@@ -8,23 +13,29 @@ private:
 	const std::string& m_RequestedPath;
 	Utilities::FileSystem::FileStatus m_FileStatus;
 	int m_ErrorCode;
+	Http::RequestContext& m_Context;
+	Http::ResponseWriter m_Writer;
 
 private:
-	FileBrowserResponseHandler(SOCKET clientSocket, const std::string& requestedPath, const std::string& httpVersion);
+	FileBrowserResponseHandler(SOCKET clientSocket, const std::string& requestedPath, const std::string& httpVersion, Http::RequestContext& context);
 	void Execute();
 
-	bool SendData(const char* data, size_t length) const;
+	bool SendShapedData(const std::string& header, const char* data, size_t length, bool isLastWrite, BandwidthShaper::Stream& stream) const;
 	void SendNotFoundResponse() const;
 
 	void SendFileResponse() const;
 	void SendBuiltinFile() const;
-	void StreamFile() const;
+	bool SendFileThroughCache(StreamableFile& file) const;
+	void StreamFile(StreamableFile& file) const;
+	bool SendMappedFile(StreamableFile& file, std::string& httpHeader, BandwidthShaper::Stream& shapedStream) const;
+	std::string GetRequestedFileName() const;
+	IN6_ADDR GetClientAddress() const;
 
 	std::string FormHttpHeaderForFile(const std::string& contentType, const std::string& fileName, uint64_t fileLength) const;
 
 	void SendHtmlResponse() const;
 	std::string FormHtmlResponse() const;
-	std::string WrapHtmlInHttpHeader(const std::string& html) const;
+	std::string FormHttpHeaderForHtml(size_t htmlLength) const;
 
 	void FormHtmlResponseHead(std::stringstream& html) const;
 	void FormHtmlResponseBody(std::stringstream& html) const;
@@ -32,10 +43,15 @@ private:
 
 	void GenerateHtmlBodyContentAccessDenied(std::stringstream& html) const;
 	void GenerateHtmlBodyContentError(std::stringstream& html, const std::string& errorMessage) const;
-	void GenerateHtmlBodyContentFileNotFound(std::stringstream& html) const;
 	void GenerateHtmlBodyContentOfDirectory(std::stringstream& html) const;
 	void GenerateHtmlBodyContentOfSystemVolumes(std::stringstream& html) const;
 
 public:
-	static void ExecuteRequest(SOCKET clientSocket, const std::string& requestedPath, const std::string& httpVersion);
+	static void ExecuteRequest(SOCKET clientSocket, const std::string& requestedPath, const std::string& httpVersion, Http::RequestContext& context);
+
+	// Fills in the sizes of the folders among freshly enumerated directory contents
+	static void AddFolderSizes(const std::string& directoryPath, std::vector<Utilities::FileSystem::FileInfo>& files);
+
+	// Table rows of a directory listing
+	static void AppendDirectoryRows(std::string& html, const std::string& directoryPath, const std::vector<Utilities::FileSystem::FileInfo>& files);
 };
\ No newline at end of file
@@ -0,0 +1,453 @@
+#include "PrecompiledHeader.h"
+#include "FolderSizes.h"
+#include "SharedFiles.h"
+#include "Utilities\CriticalSection.h"
+#include "Utilities\Event.h"
+#include "Utilities\WorkStealingPool.h"
+
+using namespace std;
+using namespace Utilities;
+
+// Walking is mostly waiting for the disk, so a few more walkers than cores still help on storage that queues requests well
+static const uint32_t kMinWorkerCount = 2;
+static const uint32_t kMaxWorkerCount = 8;
+
+static const size_t kMaxDirectoryCount = 1024 * 1024;		// Beyond that the cache starts over
+static const uint64_t kMaxEntryAgeMicroseconds = 10 * 60 * 1000 * 1000ull;
+static const size_t kMaxBackgroundWalkCount = 16;
+
+struct DirectoryContents
+{
+	uint64_t fileSize;
+	uint64_t fileCount;
+	vector<string> subfolderNames;
+
+	inline bool operator==(const DirectoryContents& other) const
+	{
+		return fileSize == other.fileSize && fileCount == other.fileCount && subfolderNames == other.subfolderNames;
+	}
+};
+
+struct DirectoryEntry
+{
+	DirectoryContents contents;
+	uint64_t updateTime;
+	bool hasTotals;
+	FolderSizes::Totals totals;
+};
+
+struct Walk
+{
+	WorkStealingPool& pool;
+	const CancellationToken& cancellationToken;
+	uint64_t generation;
+	function<void()> completionCallback;
+	Event doneEvent;
+	FolderSizes::Totals totals;
+
+	inline Walk(WorkStealingPool& pool, const CancellationToken& cancellationToken, uint64_t generation, function<void()>&& completionCallback) :
+		pool(pool), cancellationToken(cancellationToken), generation(generation), completionCallback(std::move(completionCallback)), doneEvent(true)
+	{
+	}
+
+	Walk(const Walk&) = delete;
+	Walk& operator=(const Walk&) = delete;
+};
+
+// A directory being walked. It's done once its own contents are read and all of its uncached subfolders are done
+struct WalkNode
+{
+	string path;
+	shared_ptr<WalkNode> parent;
+	atomic<uint32_t> pendingCount;
+	atomic<uint64_t> size;
+	atomic<uint64_t> fileCount;
+	atomic<uint64_t> folderCount;
+
+	inline WalkNode(string&& path, const shared_ptr<WalkNode>& parent) :
+		path(std::move(path)), parent(parent), pendingCount(1), size(0), fileCount(0), folderCount(0)
+	{
+	}
+
+	WalkNode(const WalkNode&) = delete;
+	WalkNode& operator=(const WalkNode&) = delete;
+};
+
+static CriticalSection s_CriticalSection;
+static unordered_map<string, DirectoryEntry, String::PathHasher, String::PathComparer> s_Directories;
+static uint64_t s_Generation;		// Bumped by every invalidation, so walks that read before one don't cache what they found
+static unordered_set<string, String::PathHasher, String::PathComparer> s_BackgroundWalks;
+static bool s_AreBackgroundWalksEnabled = true;
+static unique_ptr<WorkStealingPool> s_Pool;
+static unique_ptr<CancellationToken> s_ShutdownToken;
+
+// Keys have no trailing separator, except for drive roots
+static string NormalizePath(const string& path)
+{
+	auto length = path.length();
+
+	while (length > 3 && path[length - 1] == '\\')
+	{
+		length--;
+	}
+
+	return path.substr(0, length);
+}
+
+static inline bool IsFresh(const DirectoryEntry& entry, uint64_t now)
+{
+	return now - entry.updateTime < kMaxEntryAgeMicroseconds;
+}
+
+static DirectoryContents MakeContents(const vector<FileSystem::FileInfo>& files)
+{
+	DirectoryContents contents = { 0, 0 };
+
+	for (const auto& file : files)
+	{
+		if (file.fileStatus == FileSystem::FileStatus::Directory)
+		{
+			contents.subfolderNames.push_back(file.fileName);
+		}
+		else
+		{
+			contents.fileSize += file.fileSize;
+			contents.fileCount++;
+		}
+	}
+
+	return contents;
+}
+
+namespace NoLock
+{
+	static void InvalidateAncestors(string path)
+	{
+		for (;;)
+		{
+			FileSystem::RemoveLastPathComponentInline(path);
+
+			if (path.empty())
+			{
+				return;
+			}
+
+			auto entry = s_Directories.find(NormalizePath(path));
+
+			if (entry != s_Directories.end())
+			{
+				entry->second.hasTotals = false;
+			}
+		}
+	}
+
+	static DirectoryEntry& GetEntryForInsertion(const string& path)
+	{
+		if (s_Directories.size() >= kMaxDirectoryCount && s_Directories.find(path) == s_Directories.end())
+		{
+			s_Directories.clear();
+		}
+
+		return s_Directories[path];
+	}
+}
+
+static bool FindContents(const string& path, DirectoryContents& contents)
+{
+	auto now = System::GetMicroseconds();
+	CriticalSection::Lock lock(s_CriticalSection);
+	auto entry = s_Directories.find(path);
+
+	if (entry == s_Directories.end() || !IsFresh(entry->second, now))
+	{
+		return false;
+	}
+
+	contents = entry->second.contents;
+	return true;
+}
+
+static void StoreContents(const string& path, DirectoryContents&& contents, uint64_t generation)
+{
+	auto now = System::GetMicroseconds();
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	if (generation != s_Generation)
+	{
+		return;
+	}
+
+	auto& entry = NoLock::GetEntryForInsertion(path);
+	entry.contents = std::move(contents);
+	entry.updateTime = now;
+	entry.hasTotals = false;
+}
+
+static void StoreTotals(const string& path, const FolderSizes::Totals& totals, uint64_t generation)
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	if (generation != s_Generation)
+	{
+		return;
+	}
+
+	auto entry = s_Directories.find(path);
+
+	if (entry != s_Directories.end())
+	{
+		entry->second.totals = totals;
+		entry->second.hasTotals = true;
+	}
+}
+
+// Finishing the last subfolder of a deep chain can finish all of its ancestors, hence the loop
+static void CompleteNode(const shared_ptr<Walk>& walk, shared_ptr<WalkNode> node)
+{
+	while (--node->pendingCount == 0)
+	{
+		FolderSizes::Totals totals = { node->size, node->fileCount, node->folderCount };
+
+		if (!walk->cancellationToken.IsCancelled())
+		{
+			StoreTotals(node->path, totals, walk->generation);
+		}
+
+		if (node->parent == nullptr)
+		{
+			walk->totals = totals;
+
+			if (walk->completionCallback != nullptr)
+			{
+				walk->completionCallback();
+			}
+
+			walk->doneEvent.Set();
+			return;
+		}
+
+		node->parent->size += totals.size;
+		node->parent->fileCount += totals.fileCount;
+		node->parent->folderCount += totals.folderCount;
+		node = node->parent;
+	}
+}
+
+static void VisitDirectory(const shared_ptr<Walk>& walk, const shared_ptr<WalkNode>& node)
+{
+	if (!walk->cancellationToken.IsCancelled())
+	{
+		DirectoryContents contents;
+
+		if (!FindContents(node->path, contents))
+		{
+			contents = MakeContents(SharedFiles::GetFolderContents(node->path, walk->cancellationToken));
+
+			if (!walk->cancellationToken.IsCancelled())
+			{
+				StoreContents(node->path, DirectoryContents(contents), walk->generation);
+			}
+		}
+
+		node->size += contents.fileSize;
+		node->fileCount += contents.fileCount;
+		node->folderCount += contents.subfolderNames.size();
+
+		for (const auto& subfolderName : contents.subfolderNames)
+		{
+			auto subfolderPath = FileSystem::CombinePaths(node->path, subfolderName);
+			FolderSizes::Totals totals;
+
+			if (FolderSizes::Find(subfolderPath, totals))
+			{
+				node->size += totals.size;
+				node->fileCount += totals.fileCount;
+				node->folderCount += totals.folderCount;
+				continue;
+			}
+
+			auto subfolderNode = make_shared<WalkNode>(std::move(subfolderPath), node);
+			node->pendingCount++;
+
+			walk->pool.Submit([walk, subfolderNode]()
+			{
+				VisitDirectory(walk, subfolderNode);
+			});
+		}
+	}
+
+	CompleteNode(walk, node);
+}
+
+static shared_ptr<Walk> StartWalk(const string& path, const CancellationToken& cancellationToken, function<void()>&& completionCallback)
+{
+	shared_ptr<Walk> walk;
+
+	{
+		CriticalSection::Lock lock(s_CriticalSection);
+
+		if (s_Pool == nullptr)
+		{
+			return nullptr;
+		}
+
+		walk = make_shared<Walk>(*s_Pool, cancellationToken, s_Generation, std::move(completionCallback));
+	}
+
+	auto root = make_shared<WalkNode>(string(path), nullptr);
+
+	walk->pool.Submit([walk, root]()
+	{
+		VisitDirectory(walk, root);
+	});
+
+	return walk;
+}
+
+void FolderSizes::Initialize()
+{
+	auto workerCount = max(kMinWorkerCount, min(thread::hardware_concurrency(), kMaxWorkerCount));
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	Assert(s_Pool == nullptr);
+	s_ShutdownToken.reset(new CancellationToken);
+	s_Pool.reset(new WorkStealingPool(workerCount));
+}
+
+// Walks still running wind down quickly once cancelled, and the pool waits for them
+void FolderSizes::Shutdown()
+{
+	unique_ptr<WorkStealingPool> pool;
+
+	{
+		CriticalSection::Lock lock(s_CriticalSection);
+
+		if (s_ShutdownToken != nullptr)
+		{
+			s_ShutdownToken->Cancel();
+		}
+
+		pool = std::move(s_Pool);
+	}
+
+	pool.reset();
+
+	CriticalSection::Lock lock(s_CriticalSection);
+	s_BackgroundWalks.clear();
+}
+
+bool FolderSizes::Find(const string& path, Totals& totals)
+{
+	auto now = System::GetMicroseconds();
+	CriticalSection::Lock lock(s_CriticalSection);
+	auto entry = s_Directories.find(NormalizePath(path));
+
+	if (entry == s_Directories.end() || !entry->second.hasTotals || !IsFresh(entry->second, now))
+	{
+		return false;
+	}
+
+	totals = entry->second.totals;
+	return true;
+}
+
+bool FolderSizes::Compute(const string& path, Totals& totals, const CancellationToken& cancellationToken)
+{
+	auto key = NormalizePath(path);
+
+	if (Find(key, totals))
+	{
+		return true;
+	}
+
+	auto walk = StartWalk(key, cancellationToken, nullptr);
+
+	if (walk == nullptr)
+	{
+		return false;
+	}
+
+	walk->doneEvent.Wait();
+
+	if (cancellationToken.IsCancelled())
+	{
+		return false;
+	}
+
+	totals = walk->totals;
+	return true;
+}
+
+void FolderSizes::ComputeInBackground(const string& path)
+{
+	auto key = NormalizePath(path);
+
+	{
+		CriticalSection::Lock lock(s_CriticalSection);
+
+		if (!s_AreBackgroundWalksEnabled || s_Pool == nullptr || s_BackgroundWalks.size() >= kMaxBackgroundWalkCount)
+		{
+			return;
+		}
+
+		if (!s_BackgroundWalks.insert(key).second)
+		{
+			return;
+		}
+	}
+
+	// Only shutdown cancels background walks, and it waits for them, so the token outlives the walk
+	StartWalk(key, *s_ShutdownToken, [key]()
+	{
+		CriticalSection::Lock lock(s_CriticalSection);
+		s_BackgroundWalks.erase(key);
+	});
+}
+
+void FolderSizes::SetBackgroundWalksEnabled(bool enabled)
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+	s_AreBackgroundWalksEnabled = enabled;
+}
+
+void FolderSizes::Update(const string& path, const vector<FileSystem::FileInfo>& contents)
+{
+	auto key = NormalizePath(path);
+	auto newContents = MakeContents(contents);
+	auto now = System::GetMicroseconds();
+
+	CriticalSection::Lock lock(s_CriticalSection);
+	auto entry = s_Directories.find(key);
+
+	if (entry != s_Directories.end() && entry->second.contents == newContents)
+	{
+		entry->second.updateTime = now;
+		return;
+	}
+
+	s_Generation++;
+	NoLock::InvalidateAncestors(key);
+
+	auto& newEntry = NoLock::GetEntryForInsertion(key);
+	newEntry.contents = std::move(newContents);
+	newEntry.updateTime = now;
+	newEntry.hasTotals = false;
+}
+
+void FolderSizes::Invalidate(const string& path)
+{
+	auto key = NormalizePath(path);
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	s_Generation++;
+	s_Directories.erase(key);
+	NoLock::InvalidateAncestors(key);
+}
+
+void FolderSizes::Clear()
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	s_Generation++;
+	s_Directories.clear();
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+// Recursive sizes of shared folders, counting only what SharedFiles lets clients see. Walks run on a work-stealing pool,
+// one task per directory, and every directory they pass through keeps its own contents (the size and count of its files,
+// and its subfolder names) and its totals in a cache. Invalidating a directory only drops its own entry and the totals of
+// its ancestors, so the next walk re-reads just that directory and re-adds the cached totals of everything next to it.
+// Listings refresh the contents of the directory they list, which invalidates it when something changed. Entries also
+// expire after a while, for changes nobody lists, and the whole cache goes when shares change.
+
+namespace FolderSizes
+{
+	struct Totals
+	{
+		uint64_t size;
+		uint64_t fileCount;
+		uint64_t folderCount;	// Not counting the folder itself
+	};
+
+	void Initialize();
+	void Shutdown();
+
+	// Cached totals only, doesn't touch the disk
+	bool Find(const std::string& path, Totals& totals);
+
+	// Walks whatever isn't cached, waiting for it. Returns false if cancelled
+	bool Compute(const std::string& path, Totals& totals, const CancellationToken& cancellationToken);
+
+	// Starts a walk, unless one for the path is already running or too many are. Does nothing while background walks are off
+	void ComputeInBackground(const std::string& path);
+
+	// Whether listings start walks for the folders they show without cached totals. On by default
+	void SetBackgroundWalksEnabled(bool enabled);
+
+	// Freshly enumerated, visible contents of a directory
+	void Update(const std::string& path, const std::vector<Utilities::FileSystem::FileInfo>& contents);
+
+	void Invalidate(const std::string& path);
+	void Clear();
+};
\ No newline at end of file
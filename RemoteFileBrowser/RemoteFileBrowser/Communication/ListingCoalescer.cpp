@@ -0,0 +1,97 @@
+#include "PrecompiledHeader.h"
+#include "ListingCoalescer.h"
+#include "Utilities\CriticalSection.h"
+#include "Utilities\Event.h"
+#include "Utilities\Metrics.h"
+
+using namespace std;
+
+struct Flight
+{
+	Event doneEvent;
+	ListingCoalescer::Listing result;
+	uint32_t waitingRequestCount;
+
+	inline Flight() :
+		doneEvent(true), waitingRequestCount(0)
+	{
+	}
+
+	Flight(const Flight&) = delete;
+	Flight& operator=(const Flight&) = delete;
+};
+
+static CriticalSection s_CriticalSection;
+static unordered_map<string, shared_ptr<Flight>> s_Flights;
+
+static void Land(const string& key, const shared_ptr<Flight>& flight, const ListingCoalescer::Listing& result)
+{
+	{
+		CriticalSection::Lock lock(s_CriticalSection);
+		s_Flights.erase(key);
+	}
+
+	flight->result = result;
+	flight->doneEvent.Set();
+}
+
+ListingCoalescer::Listing ListingCoalescer::Render(const string& key, const function<Listing()>& render)
+{
+	for (;;)
+	{
+		shared_ptr<Flight> flight;
+		bool isLeader;
+
+		{
+			CriticalSection::Lock lock(s_CriticalSection);
+			auto& registeredFlight = s_Flights[key];
+
+			isLeader = registeredFlight == nullptr;
+
+			if (isLeader)
+			{
+				registeredFlight = make_shared<Flight>();
+			}
+			else
+			{
+				registeredFlight->waitingRequestCount++;
+			}
+
+			flight = registeredFlight;
+		}
+
+		if (isLeader)
+		{
+			Listing result;
+
+			try
+			{
+				result = render();
+			}
+			catch (...)
+			{
+				Land(key, flight, nullptr);
+				throw;
+			}
+
+			Land(key, flight, result);
+			return result;
+		}
+
+		flight->doneEvent.Wait();
+
+		if (flight->result != nullptr)
+		{
+			Metrics::Increment(Metrics::Counter::CoalescedListingRequests);
+			return flight->result;
+		}
+	}
+}
+
+uint32_t ListingCoalescer::GetWaitingRequestCount(const string& key)
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+	auto flight = s_Flights.find(key);
+
+	return flight != s_Flights.end() ? flight->second->waitingRequestCount : 0;
+}
\ No newline at end of file
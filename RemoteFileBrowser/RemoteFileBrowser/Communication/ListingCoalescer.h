@@ -0,0 +1,17 @@
+#pragma once
+
+// Identical listing requests that arrive while one is being rendered, as when a link to a big folder goes out to a team,
+// wait for that rendering and share its result instead of each enumerating, sorting and rendering the folder again.
+// Results are immutable and reference counted, so every request sends from the same buffer.
+
+namespace ListingCoalescer
+{
+	typedef std::shared_ptr<const std::string> Listing;
+
+	// Calls render unless a request with the same key is already rendering, in which case it returns that request's result.
+	// render returns nullptr when its request was cancelled partway, and then waiting requests render for themselves
+	Listing Render(const std::string& key, const std::function<Listing()>& render);
+
+	// Requests waiting for the rendering with the given key, 0 if there's none
+	uint32_t GetWaitingRequestCount(const std::string& key);
+};
\ No newline at end of file
@@ -0,0 +1,608 @@
+#include "PrecompiledHeader.h"
+#include "MetadataIndex.h"
+#include "Utilities\CriticalSection.h"
+#include "Utilities\Metrics.h"
+
+using namespace std;
+using namespace Utilities;
+using namespace Utilities::FileSystem;
+
+// The file is read in place, so everything in it is naturally aligned: a header, directory records sorted by path hash,
+// entry records grouped by directory, and the strings both point into. Entries keep their dates formatted, since listings
+// show them that way, and the few distinct ones are stored once
+static const uint32_t kFileMagic = 0x49424652;		// "RFBI"
+static const uint32_t kFileVersion = 1;
+
+struct FileHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t directoryCount;
+	uint64_t entryCount;
+	uint64_t stringBytes;
+};
+
+struct DirectoryRecord
+{
+	uint64_t pathHash;
+	uint64_t lastWriteTime;
+	uint32_t pathOffset;
+	uint32_t pathLength;
+	uint32_t firstEntry;
+	uint32_t entryCount;
+};
+
+struct EntryRecord
+{
+	uint64_t size;
+	uint32_t nameOffset;
+	uint32_t nameLength;
+	uint32_t dateOffset;
+	uint16_t dateLength;
+	uint8_t isDirectory;
+	uint8_t reserved;
+};
+
+// Beyond this many entries, newly enumerated directories aren't indexed until the index is closed and merged
+static const size_t kMaxChangedEntryCount = 4 * 1024 * 1024;
+
+// Same as String::PathHasher, but stable across builds, since it's stored
+static uint64_t HashPath(const char* path, size_t length)
+{
+	if (length > 0 && path[length - 1] == '\\')
+	{
+		length--;
+	}
+
+	uint64_t hash = 14695981039346656037ull;
+
+	for (size_t i = 0; i < length; i++)
+	{
+		hash = (hash ^ static_cast<uint8_t>(tolower(path[i]))) * 1099511628211ull;
+	}
+
+	return hash;
+}
+
+static void CopyFiles(const vector<FileInfo>& files, vector<FileInfo>& copy)
+{
+	copy.clear();
+	copy.reserve(files.size());
+
+	for (const auto& file : files)
+	{
+		copy.emplace_back(file.fileName, file.fileStatus, file.dateModified, file.fileSize);
+	}
+}
+
+class MappedIndex
+{
+private:
+	HANDLE m_FileHandle;
+	HANDLE m_MappingHandle;
+	const char* m_Data;
+
+	const FileHeader* m_Header;
+	const DirectoryRecord* m_Directories;
+	const EntryRecord* m_Entries;
+	const char* m_Strings;
+
+	inline bool IsStringInRange(uint32_t offset, uint32_t length) const
+	{
+		return static_cast<uint64_t>(offset) + length <= m_Header->stringBytes;
+	}
+
+	MappedIndex(HANDLE fileHandle, HANDLE mappingHandle, const char* data) :
+		m_FileHandle(fileHandle), m_MappingHandle(mappingHandle), m_Data(data),
+		m_Header(reinterpret_cast<const FileHeader*>(data)),
+		m_Directories(reinterpret_cast<const DirectoryRecord*>(data + sizeof(FileHeader))),
+		m_Entries(reinterpret_cast<const EntryRecord*>(m_Directories + m_Header->directoryCount)),
+		m_Strings(reinterpret_cast<const char*>(m_Entries + m_Header->entryCount))
+	{
+	}
+
+public:
+	~MappedIndex()
+	{
+		UnmapViewOfFile(m_Data);
+		CloseHandle(m_MappingHandle);
+		CloseHandle(m_FileHandle);
+	}
+
+	MappedIndex(const MappedIndex&) = delete;
+	MappedIndex& operator=(const MappedIndex&) = delete;
+
+	// Returns nullptr if there's no index at the path, or it isn't one this version can read
+	static shared_ptr<MappedIndex> Map(const wstring& path)
+	{
+		auto fileHandle = CreateFilePortable(path, GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS);
+
+		if (fileHandle == INVALID_HANDLE_VALUE)
+		{
+			return nullptr;
+		}
+
+		uint64_t fileSize;
+
+		if (!GetFileSizeFromHandle(fileHandle, fileSize) || fileSize < sizeof(FileHeader) || fileSize > numeric_limits<size_t>::max())
+		{
+			CloseHandle(fileHandle);
+			return nullptr;
+		}
+
+#if !PHONE
+		auto mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+#else
+		auto mappingHandle = CreateFileMappingFromApp(fileHandle, nullptr, PAGE_READONLY, 0, nullptr);
+#endif
+
+		if (mappingHandle == nullptr)
+		{
+			CloseHandle(fileHandle);
+			return nullptr;
+		}
+
+#if !PHONE
+		auto data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+#else
+		auto data = static_cast<const char*>(MapViewOfFileFromApp(mappingHandle, FILE_MAP_READ, 0, 0));
+#endif
+
+		if (data == nullptr)
+		{
+			CloseHandle(mappingHandle);
+			CloseHandle(fileHandle);
+			return nullptr;
+		}
+
+		// Counts are checked one at a time, so a corrupt one can't overflow the total
+		auto header = reinterpret_cast<const FileHeader*>(data);
+		auto bytesLeft = fileSize - sizeof(FileHeader);
+		auto isValid = header->magic == kFileMagic && header->version == kFileVersion &&
+			header->directoryCount <= bytesLeft / sizeof(DirectoryRecord) &&
+			header->entryCount <= (bytesLeft - header->directoryCount * sizeof(DirectoryRecord)) / sizeof(EntryRecord) &&
+			header->stringBytes == bytesLeft - header->directoryCount * sizeof(DirectoryRecord) - header->entryCount * sizeof(EntryRecord);
+
+		if (!isValid)
+		{
+			UnmapViewOfFile(data);
+			CloseHandle(mappingHandle);
+			CloseHandle(fileHandle);
+			return nullptr;
+		}
+
+		return shared_ptr<MappedIndex>(new MappedIndex(fileHandle, mappingHandle, data));
+	}
+
+	inline uint64_t GetDirectoryCount() const { return m_Header->directoryCount; }
+	inline const DirectoryRecord& GetDirectory(uint64_t index) const { return m_Directories[index]; }
+
+	string GetPath(const DirectoryRecord& directory) const
+	{
+		if (!IsStringInRange(directory.pathOffset, directory.pathLength))
+		{
+			return string();
+		}
+
+		return string(m_Strings + directory.pathOffset, directory.pathLength);
+	}
+
+	const DirectoryRecord* FindDirectory(const string& path) const
+	{
+		auto pathHash = HashPath(path.c_str(), path.length());
+		auto end = m_Directories + m_Header->directoryCount;
+
+		auto directory = lower_bound(m_Directories, end, pathHash, [](const DirectoryRecord& record, uint64_t hash)
+		{
+			return record.pathHash < hash;
+		});
+
+		for (; directory != end && directory->pathHash == pathHash; directory++)
+		{
+			if (String::PathComparer()(GetPath(*directory), path))
+			{
+				return directory;
+			}
+		}
+
+		return nullptr;
+	}
+
+	// Returns false if the records are corrupt
+	bool ReadEntries(const DirectoryRecord& directory, vector<FileInfo>& files) const
+	{
+		if (static_cast<uint64_t>(directory.firstEntry) + directory.entryCount > m_Header->entryCount)
+		{
+			return false;
+		}
+
+		files.clear();
+		files.reserve(directory.entryCount);
+
+		for (uint32_t i = 0; i < directory.entryCount; i++)
+		{
+			const auto& entry = m_Entries[directory.firstEntry + i];
+
+			if (!IsStringInRange(entry.nameOffset, entry.nameLength) || !IsStringInRange(entry.dateOffset, entry.dateLength))
+			{
+				return false;
+			}
+
+			files.emplace_back(string(m_Strings + entry.nameOffset, entry.nameLength), entry.isDirectory != 0 ? FileStatus::Directory : FileStatus::File,
+				string(m_Strings + entry.dateOffset, entry.dateLength), entry.size);
+		}
+
+		return true;
+	}
+};
+
+// Directories enumerated or invalidated since the file was mapped, which take precedence over it
+struct ChangedDirectory
+{
+	bool isInvalidated;
+	uint64_t lastWriteTime;
+	vector<FileInfo> files;
+
+	inline ChangedDirectory() :
+		isInvalidated(false), lastWriteTime(0)
+	{
+	}
+
+	inline ChangedDirectory(ChangedDirectory&& other) :
+		isInvalidated(other.isInvalidated), lastWriteTime(other.lastWriteTime), files(std::move(other.files))
+	{
+	}
+
+	ChangedDirectory(const ChangedDirectory&) = delete;
+	ChangedDirectory& operator=(const ChangedDirectory&) = delete;
+};
+
+static CriticalSection s_CriticalSection;
+static bool s_IsOpen;
+static wstring s_IndexPath;
+static shared_ptr<MappedIndex> s_MappedIndex;
+static unordered_map<string, ChangedDirectory, String::PathHasher, String::PathComparer> s_ChangedDirectories;
+static size_t s_ChangedEntryCount;
+static vector<string> s_InvalidatedFolders;		// Everything under these lost change notifications
+
+namespace NoLock
+{
+	static bool IsInInvalidatedFolder(const string& path)
+	{
+		for (const auto& folderPath : s_InvalidatedFolders)
+		{
+			if (IsInFolder(path, folderPath))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	static ChangedDirectory& ChangeDirectory(const string& path)
+	{
+		auto& directory = s_ChangedDirectories[path];
+		s_ChangedEntryCount -= directory.files.size();
+		return directory;
+	}
+
+	static void InvalidateFolder(const string& folderPath)
+	{
+		for (auto it = s_ChangedDirectories.begin(); it != s_ChangedDirectories.end();)
+		{
+			if (IsInFolder(it->first, folderPath))
+			{
+				s_ChangedEntryCount -= it->second.files.size();
+				it = s_ChangedDirectories.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		// Watchers that keep overflowing report the same folders over and over, so only what isn't covered yet gets added
+		if (IsInInvalidatedFolder(folderPath))
+		{
+			return;
+		}
+
+		s_InvalidatedFolders.erase(remove_if(s_InvalidatedFolders.begin(), s_InvalidatedFolders.end(), [&folderPath](const string& invalidatedFolder)
+		{
+			return IsInFolder(invalidatedFolder, folderPath);
+		}), s_InvalidatedFolders.end());
+
+		s_InvalidatedFolders.push_back(folderPath);
+	}
+
+	static bool WriteIndex(const wstring& path, const vector<char>& contents)
+	{
+		auto fileHandle = CreateFilePortable(path, GENERIC_WRITE, 0, CREATE_ALWAYS, FILE_FLAG_SEQUENTIAL_SCAN);
+
+		if (fileHandle == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		const size_t kMaxWriteSize = 16 * 1024 * 1024;
+		size_t offset = 0;
+		auto result = true;
+
+		while (result && offset < contents.size())
+		{
+			auto writeSize = static_cast<DWORD>(min(contents.size() - offset, kMaxWriteSize));
+			DWORD bytesWritten;
+
+			result = WriteFile(fileHandle, contents.data() + offset, writeSize, &bytesWritten, nullptr) != FALSE && bytesWritten == writeSize;
+			offset += writeSize;
+		}
+
+		result = result && FlushFileBuffers(fileHandle) != FALSE;
+
+		auto lastError = GetLastError();
+		CloseHandle(fileHandle);
+		SetLastError(lastError);
+		return result;
+	}
+
+	// Merges the changed directories with what's still valid in the mapped file, into a new file that replaces it
+	static void Save()
+	{
+		struct SavedDirectory
+		{
+			uint64_t pathHash;
+			const string* path;
+			uint64_t lastWriteTime;
+			const vector<FileInfo>* files;
+		};
+
+		vector<SavedDirectory> directories;
+		vector<string> mappedPaths;
+		vector<vector<FileInfo>> mappedFiles;
+
+		for (const auto& directory : s_ChangedDirectories)
+		{
+			if (!directory.second.isInvalidated)
+			{
+				SavedDirectory savedDirectory = { HashPath(directory.first.c_str(), directory.first.length()), &directory.first, directory.second.lastWriteTime, &directory.second.files };
+				directories.push_back(savedDirectory);
+			}
+		}
+
+		if (s_MappedIndex != nullptr)
+		{
+			auto directoryCount = s_MappedIndex->GetDirectoryCount();
+			mappedPaths.reserve(static_cast<size_t>(directoryCount));
+			mappedFiles.reserve(static_cast<size_t>(directoryCount));
+
+			for (uint64_t i = 0; i < directoryCount; i++)
+			{
+				const auto& directory = s_MappedIndex->GetDirectory(i);
+				auto path = s_MappedIndex->GetPath(directory);
+				vector<FileInfo> files;
+
+				if (path.empty() || s_ChangedDirectories.find(path) != s_ChangedDirectories.end() || IsInInvalidatedFolder(path) || !s_MappedIndex->ReadEntries(directory, files))
+				{
+					continue;
+				}
+
+				mappedPaths.push_back(std::move(path));
+				mappedFiles.push_back(std::move(files));
+
+				SavedDirectory savedDirectory = { directory.pathHash, &mappedPaths.back(), directory.lastWriteTime, &mappedFiles.back() };
+				directories.push_back(savedDirectory);
+			}
+		}
+
+		sort(directories.begin(), directories.end(), [](const SavedDirectory& left, const SavedDirectory& right)
+		{
+			return left.pathHash < right.pathHash;
+		});
+
+		// Lay out the records and the strings separately, then put them together
+		vector<DirectoryRecord> directoryRecords;
+		vector<EntryRecord> entryRecords;
+		string strings;
+		unordered_map<string, uint32_t> dateOffsets;
+
+		directoryRecords.reserve(directories.size());
+
+		auto appendString = [&strings](const string& str) -> uint32_t
+		{
+			auto offset = static_cast<uint32_t>(strings.length());
+			strings.append(str);
+			return offset;
+		};
+
+		for (const auto& directory : directories)
+		{
+			if (strings.length() + directory.path->length() > numeric_limits<uint32_t>::max() || entryRecords.size() + directory.files->size() > numeric_limits<uint32_t>::max())
+			{
+				Logging::Log("Metadata index is too big, leaving out the rest of its directories.");
+				break;
+			}
+
+			DirectoryRecord directoryRecord = { directory.pathHash, directory.lastWriteTime, appendString(*directory.path),
+				static_cast<uint32_t>(directory.path->length()), static_cast<uint32_t>(entryRecords.size()), static_cast<uint32_t>(directory.files->size()) };
+			directoryRecords.push_back(directoryRecord);
+
+			for (const auto& file : *directory.files)
+			{
+				auto dateOffset = dateOffsets.find(file.dateModified);
+
+				if (dateOffset == dateOffsets.end())
+				{
+					dateOffset = dateOffsets.insert(make_pair(file.dateModified, appendString(file.dateModified))).first;
+				}
+
+				EntryRecord entryRecord = { file.fileSize, appendString(file.fileName), static_cast<uint32_t>(file.fileName.length()),
+					dateOffset->second, static_cast<uint16_t>(file.dateModified.length()), file.fileStatus == FileStatus::Directory, 0 };
+				entryRecords.push_back(entryRecord);
+			}
+		}
+
+		FileHeader header = { kFileMagic, kFileVersion, directoryRecords.size(), entryRecords.size(), strings.length() };
+		vector<char> contents;
+		contents.reserve(sizeof(header) + directoryRecords.size() * sizeof(DirectoryRecord) + entryRecords.size() * sizeof(EntryRecord) + strings.length());
+
+		auto append = [&contents](const void* data, size_t length)
+		{
+			contents.insert(contents.end(), static_cast<const char*>(data), static_cast<const char*>(data) + length);
+		};
+
+		append(&header, sizeof(header));
+		append(directoryRecords.data(), directoryRecords.size() * sizeof(DirectoryRecord));
+		append(entryRecords.data(), entryRecords.size() * sizeof(EntryRecord));
+		append(strings.data(), strings.length());
+
+		// Windows doesn't replace files that are mapped
+		auto temporaryPath = s_IndexPath + L".tmp";
+		s_MappedIndex = nullptr;
+
+		if (!WriteIndex(temporaryPath, contents))
+		{
+			Logging::Error(GetLastError(), "Failed to write metadata index \"", Encoding::Utf16ToUtf8(temporaryPath), "\": ");
+			DeleteFileW(temporaryPath.c_str());
+			return;
+		}
+
+		if (MoveFileExW(temporaryPath.c_str(), s_IndexPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) == FALSE)
+		{
+			Logging::Error(GetLastError(), "Failed to replace metadata index \"", Encoding::Utf16ToUtf8(s_IndexPath), "\": ");
+			DeleteFileW(temporaryPath.c_str());
+		}
+	}
+}
+
+void MetadataIndex::Open(const wstring& indexPath)
+{
+	Close();
+
+	auto mappedIndex = MappedIndex::Map(indexPath);
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	s_IsOpen = true;
+	s_IndexPath = indexPath;
+	s_MappedIndex = mappedIndex;
+}
+
+void MetadataIndex::Close()
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	if (!s_IsOpen)
+	{
+		return;
+	}
+
+	if (!s_ChangedDirectories.empty() || !s_InvalidatedFolders.empty())
+	{
+		NoLock::Save();
+	}
+
+	s_IsOpen = false;
+	s_MappedIndex = nullptr;
+	s_ChangedDirectories.clear();
+	s_ChangedEntryCount = 0;
+	s_InvalidatedFolders.clear();
+}
+
+bool MetadataIndex::IsOpen()
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+	return s_IsOpen;
+}
+
+bool MetadataIndex::Find(const string& path, uint64_t lastWriteTime, vector<FileInfo>& contents)
+{
+	shared_ptr<MappedIndex> mappedIndex;
+
+	{
+		CriticalSection::Lock lock(s_CriticalSection);
+
+		if (!s_IsOpen)
+		{
+			return false;
+		}
+
+		auto changedDirectory = s_ChangedDirectories.find(path);
+
+		if (changedDirectory != s_ChangedDirectories.end())
+		{
+			if (changedDirectory->second.isInvalidated || changedDirectory->second.lastWriteTime != lastWriteTime)
+			{
+				Metrics::Increment(Metrics::Counter::MetadataIndexMisses);
+				return false;
+			}
+
+			CopyFiles(changedDirectory->second.files, contents);
+			Metrics::Increment(Metrics::Counter::MetadataIndexHits);
+			return true;
+		}
+
+		if (!NoLock::IsInInvalidatedFolder(path))
+		{
+			mappedIndex = s_MappedIndex;
+		}
+	}
+
+	// The mapping stays valid for as long as it's referenced, so it's read without holding the lock
+	const DirectoryRecord* directory = nullptr;
+
+	if (mappedIndex != nullptr)
+	{
+		directory = mappedIndex->FindDirectory(path);
+	}
+
+	if (directory == nullptr || directory->lastWriteTime != lastWriteTime || !mappedIndex->ReadEntries(*directory, contents))
+	{
+		Metrics::Increment(Metrics::Counter::MetadataIndexMisses);
+		return false;
+	}
+
+	Metrics::Increment(Metrics::Counter::MetadataIndexHits);
+	return true;
+}
+
+void MetadataIndex::Store(const string& path, uint64_t lastWriteTime, const vector<FileInfo>& contents)
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	if (!s_IsOpen || s_ChangedEntryCount + contents.size() > kMaxChangedEntryCount)
+	{
+		return;
+	}
+
+	auto& directory = NoLock::ChangeDirectory(path);
+	directory.isInvalidated = false;
+	directory.lastWriteTime = lastWriteTime;
+	CopyFiles(contents, directory.files);
+	s_ChangedEntryCount += contents.size();
+}
+
+void MetadataIndex::Invalidate(const string& path)
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	if (!s_IsOpen)
+	{
+		return;
+	}
+
+	auto& directory = NoLock::ChangeDirectory(path);
+	directory.isInvalidated = true;
+	directory.files.clear();
+}
+
+void MetadataIndex::InvalidateFolder(const string& folderPath)
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	if (!s_IsOpen)
+	{
+		return;
+	}
+
+	NoLock::InvalidateFolder(folderPath);
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+
+// Optional index of what shared directories contain, kept in a file that's mapped on the next start, so listings after a
+// restart don't have to go to the disk. Every directory keeps its entries sorted the way listings show them, along with the
+// last write time it had before it was enumerated. Lookups compare that against its current one, which catches entries added,
+// removed or renamed while the server wasn't running. While it runs, change notifications on the shared folders also catch
+// files that change size. Whatever changes stays in memory until the index is closed, which merges it into a new file.
+
+namespace MetadataIndex
+{
+	// Maps the index at the path, or starts an empty one if there's none or it can't be read. Closes the open one first
+	void Open(const std::wstring& indexPath);
+
+	// Writes the changes to the file. Does nothing if no index is open
+	void Close();
+
+	bool IsOpen();
+
+	// Sorted entries of the directory, if they were indexed at the last write time it has now
+	bool Find(const std::string& path, uint64_t lastWriteTime, std::vector<Utilities::FileSystem::FileInfo>& contents);
+
+	// Sorted entries of the directory, enumerated after it had the last write time
+	void Store(const std::string& path, uint64_t lastWriteTime, const std::vector<Utilities::FileSystem::FileInfo>& contents);
+
+	void Invalidate(const std::string& path);
+
+	// Everything under the folder, for when its change notifications were lost
+	void InvalidateFolder(const std::string& folderPath);
+};
\ No newline at end of file
@@ -0,0 +1,22 @@
+#include "PrecompiledHeader.h"
+#include "MetricsResponseHandler.h"
+#include "Http\ResponseWriter.h"
+#include "Utilities\Metrics.h"
+
+using namespace std;
+using namespace Utilities;
+
+void MetricsResponseHandler::ExecuteRequest(SOCKET clientSocket, const string& httpVersion, Http::RequestContext& context)
+{
+	auto body = Metrics::FormatPrometheusText();
+
+	stringstream headerStream;
+	headerStream << httpVersion << " 200 OK\r\n";
+	headerStream << "Content-Type: text/plain; version=0.0.4\r\n";
+	headerStream << "Cache-Control: no-cache\r\n";
+	headerStream << "Content-Length: " << body.length() << "\r\n\r\n";
+
+	auto header = headerStream.str();
+	WSABUF buffers[] = { Http::ResponseWriter::MakeBuffer(header.data(), header.length()), Http::ResponseWriter::MakeBuffer(body.data(), body.length()) };
+	Http::ResponseWriter(clientSocket, context).Send(buffers, sizeof(buffers) / sizeof(buffers[0]), true);
+}
\ No newline at end of file
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "Http\RequestContext.h"
+
+namespace MetricsResponseHandler
+{
+	void ExecuteRequest(SOCKET clientSocket, const std::string& httpVersion, Http::RequestContext& context);
+};
\ No newline at end of file
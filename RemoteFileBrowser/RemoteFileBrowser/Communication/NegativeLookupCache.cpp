@@ -0,0 +1,105 @@
+#include "PrecompiledHeader.h"
+#include "NegativeLookupCache.h"
+#include "Utilities\CriticalSection.h"
+#include "Utilities\Metrics.h"
+
+using namespace std;
+using namespace Utilities;
+
+static const uint64_t kTimeToLiveMicroseconds = 5 * 1000 * 1000;
+
+struct CacheEntry
+{
+	string path;
+	FileSystem::FileStatus fileStatus;
+	uint64_t expirationTime;
+};
+
+// Oldest first. Every entry lives equally long, so that's also the order they expire in
+typedef list<CacheEntry> EntryList;
+
+static CriticalSection s_CriticalSection;
+static EntryList s_Entries;
+static unordered_map<string, EntryList::iterator, String::PathHasher, String::PathComparer> s_EntryIndex;
+
+static void RemoveOldestEntry()
+{
+	s_EntryIndex.erase(s_Entries.front().path);
+	s_Entries.pop_front();
+}
+
+bool NegativeLookupCache::Find(const string& path, FileSystem::FileStatus& fileStatus)
+{
+	auto now = System::GetMicroseconds();
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	while (!s_Entries.empty() && s_Entries.front().expirationTime <= now)
+	{
+		RemoveOldestEntry();
+	}
+
+	auto entry = s_EntryIndex.find(path);
+
+	if (entry == s_EntryIndex.end())
+	{
+		Metrics::Increment(Metrics::Counter::NegativeLookupCacheMisses);
+		return false;
+	}
+
+	Metrics::Increment(Metrics::Counter::NegativeLookupCacheHits);
+	fileStatus = entry->second->fileStatus;
+	return true;
+}
+
+void NegativeLookupCache::Insert(const string& path, FileSystem::FileStatus fileStatus)
+{
+	Assert(fileStatus == FileSystem::FileStatus::FileNotFound || fileStatus == FileSystem::FileStatus::AccessDenied);
+
+	auto expirationTime = System::GetMicroseconds() + kTimeToLiveMicroseconds;
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	// Another request may have cached it in the meantime
+	auto existingEntry = s_EntryIndex.find(path);
+
+	if (existingEntry != s_EntryIndex.end())
+	{
+		s_Entries.erase(existingEntry->second);
+		s_EntryIndex.erase(existingEntry);
+	}
+
+	if (s_Entries.size() == NegativeLookupCache::kCapacity)
+	{
+		RemoveOldestEntry();
+	}
+
+	CacheEntry entry = { path, fileStatus, expirationTime };
+	s_Entries.push_back(entry);
+	s_EntryIndex.emplace(path, prev(s_Entries.end()));
+}
+
+FileSystem::FileStatus NegativeLookupCache::QueryFileStatus(const string& path)
+{
+	FileSystem::FileStatus fileStatus;
+
+	if (Find(path, fileStatus))
+	{
+		return fileStatus;
+	}
+
+	fileStatus = FileSystem::QueryFileStatus(Encoding::Utf8ToUtf16(path));
+
+	if (fileStatus == FileSystem::FileStatus::FileNotFound || fileStatus == FileSystem::FileStatus::AccessDenied)
+	{
+		Insert(path, fileStatus);
+	}
+
+	return fileStatus;
+}
+
+void NegativeLookupCache::Clear()
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	s_EntryIndex.clear();
+	s_Entries.clear();
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+// Shared paths that recently turned out not to exist or not to be accessible, so requests for them that keep coming
+// (from crawlers and stale bookmarks) get answered without touching the disk. Entries expire after a few seconds,
+// in case the path gets created, and the oldest ones make room once the cache is full. Changing shares empties it.
+
+namespace NegativeLookupCache
+{
+	static const size_t kCapacity = 4096;
+
+	// Returns false unless the path is cached, in which case fileStatus says why it can't be served
+	bool Find(const std::string& path, Utilities::FileSystem::FileStatus& fileStatus);
+
+	// Only for FileNotFound and AccessDenied
+	void Insert(const std::string& path, Utilities::FileSystem::FileStatus fileStatus);
+
+	// Queries the disk only if the path isn't cached, and caches it if it can't be served
+	Utilities::FileSystem::FileStatus QueryFileStatus(const std::string& path);
+
+	void Clear();
+};
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include "PrecompiledHeader.h"
+#include "DiskUsageResponseHandler.h"
+#include "FileBrowserResponseHandler.h"
+#include "MetricsResponseHandler.h"
+#include "NegativeLookupCache.h"
+#include "RequestRouter.h"
+#include "SearchResponseHandler.h"
+#include "SharedFiles.h"
+
+using namespace Utilities;
+
+void RequestRouter::ExecuteRequest(SOCKET clientSocket, const std::string& requestedPath, const std::string& httpVersion, Http::RequestContext& context)
+{
+	// Shared paths always start with a drive letter, so these can't shadow them
+	if (requestedPath == "metrics")
+	{
+		MetricsResponseHandler::ExecuteRequest(clientSocket, httpVersion, context);
+		return;
+	}
+
+	if (requestedPath.compare(0, 3, "du\\") == 0)
+	{
+		DiskUsageResponseHandler::ExecuteRequest(clientSocket, requestedPath.substr(3), httpVersion, context);
+		return;
+	}
+
+	if (requestedPath.compare(0, 7, "search?") == 0)
+	{
+		SearchResponseHandler::ExecuteRequest(clientSocket, requestedPath.substr(7), httpVersion, context);
+		return;
+	}
+
+	FileBrowserResponseHandler::ExecuteRequest(clientSocket, requestedPath, httpVersion, context);
+}
+
+// Only files that can be downloaded are worth a status query, and paths known to be missing don't need one.
+// Disk usage can walk a whole tree, so it doesn't get to hold up listings either
+Http::RequestLane RequestRouter::ClassifyRequest(const std::string& requestedPath)
+{
+	if (requestedPath.compare(0, 3, "du\\") == 0)
+	{
+		return Http::RequestLane::Bulk;
+	}
+
+	if (requestedPath.length() < 2 || requestedPath[1] != ':' || !SharedFiles::IsFileShared(requestedPath))
+	{
+		return Http::RequestLane::Interactive;
+	}
+
+	return NegativeLookupCache::QueryFileStatus(requestedPath) == FileSystem::FileStatus::File ? Http::RequestLane::Bulk : Http::RequestLane::Interactive;
+}
\ No newline at end of file
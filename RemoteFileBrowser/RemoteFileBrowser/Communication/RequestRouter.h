@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Http\RequestContext.h"
+#include "Http\RequestScheduler.h"
+
+namespace RequestRouter
+{
+	// Dispatches internal endpoints, and hands everything else to FileBrowserResponseHandler
+	void ExecuteRequest(SOCKET clientSocket, const std::string& requestedPath, const std::string& httpVersion, Http::RequestContext& context);
+
+	// Downloads and disk usage go to the bulk lane, everything else is served from memory or a single enumeration
+	Http::RequestLane ClassifyRequest(const std::string& requestedPath);
+};
\ No newline at end of file
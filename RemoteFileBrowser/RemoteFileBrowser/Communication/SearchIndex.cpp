@@ -0,0 +1,1508 @@
+#include "PrecompiledHeader.h"
+#include "SearchIndex.h"
+#include "SharedFiles.h"
+#include "Utilities\CriticalSection.h"
+#include "Utilities\Event.h"
+#include "Utilities\Metrics.h"
+#include "Utilities\WorkStealingPool.h"
+
+using namespace std;
+using namespace Utilities;
+
+// Crawling is mostly waiting for the disk, like walking folder sizes, and merges split their work over the same workers
+static const uint32_t kMinWorkerCount = 2;
+static const uint32_t kMaxWorkerCount = 8;
+
+static const uint32_t kNoEntry = 0xFFFFFFFF;
+static const size_t kMaxNameLength = 0xFFFF;
+static const size_t kMaxNamePoolSize = 0xFFFFFFFF;
+static const size_t kMaxQueryLength = 1024;
+static const size_t kMaxMatchCount = 50000;					// Queries rank this many matches at most
+static const uint64_t kMinPendingPostingCount = 1024 * 1024;	// Pending postings merge once there are this many, and an eighth of the merged ones
+static const uint32_t kChunkSize = 64 * 1024;					// Entries looked at under the lock at a time by merges and scanning queries
+
+static const uint8_t kIsLive = 1;
+static const uint8_t kIsDirectory = 2;
+
+static const uint8_t kExactMatch = 0;
+static const uint8_t kPrefixMatch = 1;
+static const uint8_t kWordMatch = 2;
+static const uint8_t kSubstringMatch = 3;
+static const uint8_t kNoMatch = 4;
+
+// Shared folders that crawls start from take the first entries, one for each, and have no parent or name. Children of an
+// entry are chained through their next sibling. Removed entries are reused, and their names stay in the pool until a merge repacks it
+struct Entry
+{
+	uint32_t parent;
+	uint32_t firstChild;
+	uint32_t nextSibling;
+	uint32_t nameOffset;
+	uint16_t nameLength;
+	uint8_t flags;
+	uint8_t reserved;
+};
+
+static_assert(sizeof(Entry) == 20, "Entries are meant to stay small");
+
+// Lists hold entries in increasing order, the first one as it is and the rest as the difference from the one before
+struct PostingList
+{
+	uint32_t gram;
+	uint32_t count;
+	uint64_t offset;
+};
+
+struct Postings
+{
+	vector<PostingList> lists;		// Sorted by gram
+	vector<uint8_t> bytes;
+	uint64_t postingCount;
+
+	inline Postings() :
+		postingCount(0)
+	{
+	}
+
+	inline const PostingList* Find(uint32_t gram) const
+	{
+		auto list = lower_bound(lists.begin(), lists.end(), gram, [](const PostingList& left, uint32_t right) { return left.gram < right; });
+		return list != lists.end() && list->gram == gram ? &*list : nullptr;
+	}
+
+	inline void Swap(Postings& other)
+	{
+		lists.swap(other.lists);
+		bytes.swap(other.bytes);
+		swap(postingCount, other.postingCount);
+	}
+
+	Postings(const Postings&) = delete;
+	Postings& operator=(const Postings&) = delete;
+};
+
+typedef unordered_map<uint32_t, vector<uint32_t>> PendingPostings;
+
+struct Match
+{
+	uint32_t entry;
+	uint16_t nameLength;
+	uint8_t rank;
+};
+
+struct GramList
+{
+	uint32_t gram;
+	uint32_t count;
+	uint32_t lastEntry;
+	vector<uint8_t> bytes;
+
+	inline GramList(uint32_t gram) :
+		gram(gram), count(0), lastEntry(0)
+	{
+	}
+
+	inline GramList(GramList&& other) :
+		gram(other.gram), count(other.count), lastEntry(other.lastEntry), bytes(std::move(other.bytes))
+	{
+	}
+
+	inline GramList& operator=(GramList&& other)
+	{
+		gram = other.gram;
+		count = other.count;
+		lastEntry = other.lastEntry;
+		bytes = std::move(other.bytes);
+		return *this;
+	}
+
+	GramList(const GramList&) = delete;
+	GramList& operator=(const GramList&) = delete;
+};
+
+// Lists of one range of entries
+struct MergePartition
+{
+	unordered_map<uint32_t, uint32_t> listIndices;
+	vector<GramList> lists;
+};
+
+struct Merge
+{
+	uint64_t generation;
+	uint32_t entryCount;
+	vector<MergePartition> partitions;
+	atomic<uint32_t> pendingPartitionCount;
+	atomic<bool> isAbandoned;
+
+	inline Merge(uint64_t generation, uint32_t entryCount, uint32_t partitionCount) :
+		generation(generation), entryCount(entryCount), partitions(partitionCount), pendingPartitionCount(partitionCount), isAbandoned(false)
+	{
+	}
+
+	Merge(const Merge&) = delete;
+	Merge& operator=(const Merge&) = delete;
+};
+
+struct CrawlTarget
+{
+	uint32_t entry;
+	string path;
+};
+
+static CriticalSection s_CriticalSection;
+static bool s_IsEnabled = true;
+static vector<string> s_Roots;				// Shared folders that no other shared folder contains
+static vector<Entry> s_Entries;
+static vector<char> s_Names;
+static vector<uint32_t> s_FreeEntries;
+static uint64_t s_LiveEntryCount;			// Not counting the roots
+static uint64_t s_GarbageNameBytes;
+static uint64_t s_Generation;				// Bumped whenever the index starts over, so tasks from before leave it alone
+static bool s_IsPosting;					// New names get pending postings once the first merge starts
+static bool s_HasPostings;					// Queries use postings once it's done
+static bool s_IsMerging;
+static Postings s_Postings;
+static PendingPostings s_PendingPostings;
+static PendingPostings s_MergingPostings;	// Pending when the running merge started, so it might not have seen their entries
+static uint64_t s_PendingPostingCount;
+static uint64_t s_MergingPostingCount;
+static uint32_t s_ActiveCrawlCount;
+static unordered_set<string, String::PathHasher, String::PathComparer> s_QueuedRefreshes;
+static unique_ptr<WorkStealingPool> s_Pool;
+static unique_ptr<CancellationToken> s_ShutdownToken;
+static Event s_IdleEvent(true);
+static SearchIndex::Statistics s_PublishedStatistics;
+
+static void CrawlDirectory(uint64_t generation, uint32_t entry, const string& path, bool isRecursive, const CancellationToken& cancellationToken);
+static void BuildPartition(const shared_ptr<Merge>& merge, uint32_t partitionIndex);
+
+static inline uint8_t FoldCase(char c)
+{
+	return c >= 'A' && c <= 'Z' ? static_cast<uint8_t>(c - 'A' + 'a') : static_cast<uint8_t>(c);
+}
+
+static inline bool IsAlphanumeric(char c)
+{
+	return c >= 'a' && c <= 'z' || c >= 'A' && c <= 'Z' || c >= '0' && c <= '9' || static_cast<uint8_t>(c) >= 0x80;
+}
+
+// Matches that start after a separator or where camel case starts a new word, like "Report" in "MonthlyReport"
+static inline bool IsWordStart(const char* name, size_t position)
+{
+	auto previous = name[position - 1];
+	auto current = name[position];
+	return !IsAlphanumeric(previous) || previous >= 'a' && previous <= 'z' && current >= 'A' && current <= 'Z';
+}
+
+// Trigrams are three lowercased bytes. The first one, two and three bytes of a name make grams of their own too,
+// with their length on top, which is what prefix queries look up
+template <typename Callback>
+static inline void ForEachGram(const char* name, size_t length, Callback&& callback)
+{
+	uint32_t packed = 0;
+
+	for (size_t i = 0; i < length; i++)
+	{
+		packed = ((packed << 8) | FoldCase(name[i])) & 0xFFFFFF;
+
+		if (i < 3)
+		{
+			callback(static_cast<uint32_t>(i + 1) << 24 | packed << (8 * (2 - i)));
+		}
+
+		if (i >= 2)
+		{
+			callback(packed);
+		}
+	}
+}
+
+static vector<uint32_t> GetQueryGrams(const string& foldedQuery, bool isPrefix)
+{
+	vector<uint32_t> grams;
+
+	if (isPrefix)
+	{
+		auto prefixLength = min<size_t>(foldedQuery.length(), 3);
+		uint32_t packed = 0;
+
+		for (size_t i = 0; i < prefixLength; i++)
+		{
+			packed = (packed << 8) | static_cast<uint8_t>(foldedQuery[i]);
+		}
+
+		grams.push_back(static_cast<uint32_t>(prefixLength) << 24 | packed << (8 * (3 - prefixLength)));
+	}
+
+	for (size_t i = 0; i + 2 < foldedQuery.length(); i++)
+	{
+		grams.push_back(static_cast<uint8_t>(foldedQuery[i]) << 16 | static_cast<uint8_t>(foldedQuery[i + 1]) << 8 | static_cast<uint8_t>(foldedQuery[i + 2]));
+	}
+
+	sort(grams.begin(), grams.end());
+	grams.erase(unique(grams.begin(), grams.end()), grams.end());
+	return grams;
+}
+
+// Prefix queries only tell exact names from prefixes. Substring queries keep looking for a match at the start of a word
+static uint8_t RankMatch(const char* name, size_t nameLength, const string& foldedQuery, bool isPrefix)
+{
+	auto queryLength = foldedQuery.length();
+	auto rank = kNoMatch;
+
+	for (size_t position = 0; position + queryLength <= nameLength; position++)
+	{
+		if (FoldCase(name[position]) != static_cast<uint8_t>(foldedQuery[0]))
+		{
+			if (isPrefix)
+			{
+				break;
+			}
+
+			continue;
+		}
+
+		size_t i = 1;
+
+		while (i < queryLength && FoldCase(name[position + i]) == static_cast<uint8_t>(foldedQuery[i]))
+		{
+			i++;
+		}
+
+		if (i < queryLength)
+		{
+			if (isPrefix)
+			{
+				break;
+			}
+
+			continue;
+		}
+
+		if (position == 0)
+		{
+			return nameLength == queryLength ? kExactMatch : kPrefixMatch;
+		}
+
+		if (IsWordStart(name, position))
+		{
+			return kWordMatch;
+		}
+
+		rank = kSubstringMatch;
+	}
+
+	return rank;
+}
+
+static inline void AppendVarint(vector<uint8_t>& bytes, uint32_t value)
+{
+	while (value >= 0x80)
+	{
+		bytes.push_back(static_cast<uint8_t>(value | 0x80));
+		value >>= 7;
+	}
+
+	bytes.push_back(static_cast<uint8_t>(value));
+}
+
+static inline uint32_t ReadVarint(const uint8_t*& data)
+{
+	uint32_t value = 0;
+
+	for (int shift = 0;; shift += 7)
+	{
+		auto byte = *data++;
+		value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+
+		if (byte < 0x80)
+		{
+			return value;
+		}
+	}
+}
+
+class PostingCursor
+{
+private:
+	const uint8_t* m_Data;
+	uint32_t m_Remaining;
+	uint32_t m_Entry;
+
+public:
+	inline PostingCursor(const Postings& postings, const PostingList& list) :
+		m_Data(postings.bytes.data() + list.offset), m_Remaining(list.count), m_Entry(0)
+	{
+	}
+
+	inline bool Next(uint32_t& entry)
+	{
+		if (m_Remaining == 0)
+		{
+			return false;
+		}
+
+		m_Remaining--;
+		m_Entry += ReadVarint(m_Data);
+		entry = m_Entry;
+		return true;
+	}
+};
+
+static inline bool IsIdle()
+{
+	return s_ActiveCrawlCount == 0 && !s_IsMerging;
+}
+
+namespace NoLock
+{
+	static inline string GetName(const Entry& entry)
+	{
+		return string(s_Names.data() + entry.nameOffset, entry.nameLength);
+	}
+
+	static string GetPath(uint32_t entry)
+	{
+		vector<uint32_t> chain;
+
+		while (s_Entries[entry].parent != kNoEntry)
+		{
+			chain.push_back(entry);
+			entry = s_Entries[entry].parent;
+		}
+
+		auto path = s_Roots[entry];
+
+		for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+		{
+			path = FileSystem::CombinePaths(path, GetName(s_Entries[*it]));
+		}
+
+		return path;
+	}
+
+	static uint32_t FindChildDirectory(uint32_t parent, const char* name, size_t nameLength)
+	{
+		for (auto child = s_Entries[parent].firstChild; child != kNoEntry; child = s_Entries[child].nextSibling)
+		{
+			const auto& entry = s_Entries[child];
+
+			if ((entry.flags & kIsDirectory) != 0 && entry.nameLength == nameLength && _strnicmp(s_Names.data() + entry.nameOffset, name, nameLength) == 0)
+			{
+				return child;
+			}
+		}
+
+		return kNoEntry;
+	}
+
+	// Goes down from the root the path is in, one component at a time
+	static uint32_t FindDirectory(const string& path)
+	{
+		for (uint32_t root = 0; root < s_Roots.size(); root++)
+		{
+			if (!FileSystem::IsInFolder(path, s_Roots[root]))
+			{
+				continue;
+			}
+
+			auto directory = root;
+			auto position = String::PathLength(s_Roots[root]);
+
+			while (directory != kNoEntry && position < path.length())
+			{
+				if (path[position] == '\\')
+				{
+					position++;
+					continue;
+				}
+
+				auto componentEnd = path.find('\\', position);
+
+				if (componentEnd == string::npos)
+				{
+					componentEnd = path.length();
+				}
+
+				directory = FindChildDirectory(directory, path.c_str() + position, componentEnd - position);
+				position = componentEnd;
+			}
+
+			return directory;
+		}
+
+		return kNoEntry;
+	}
+
+	// Crawls remember the entry of their directory, which is still it unless the directory was removed since
+	static uint32_t FindDirectory(uint32_t entry, const string& path)
+	{
+		if (entry < s_Entries.size() && (s_Entries[entry].flags & (kIsLive | kIsDirectory)) == (kIsLive | kIsDirectory) &&
+			String::PathComparer()(GetPath(entry), path))
+		{
+			return entry;
+		}
+
+		return FindDirectory(path);
+	}
+
+	static void UpdateIdleEvent()
+	{
+		if (IsIdle())
+		{
+			s_IdleEvent.Set();
+		}
+		else
+		{
+			s_IdleEvent.Reset();
+		}
+	}
+
+	static SearchIndex::Statistics GetStatistics()
+	{
+		static const size_t kPendingListOverhead = sizeof(PendingPostings::value_type) + 2 * sizeof(void*);
+
+		SearchIndex::Statistics statistics;
+		statistics.entryCount = s_LiveEntryCount;
+		statistics.entryBytes = s_Entries.capacity() * sizeof(Entry) + s_FreeEntries.capacity() * sizeof(uint32_t);
+		statistics.nameBytes = s_Names.capacity();
+		statistics.postingCount = s_Postings.postingCount;
+		statistics.postingBytes = s_Postings.bytes.capacity() + s_Postings.lists.capacity() * sizeof(PostingList);
+		statistics.pendingPostingBytes = (s_PendingPostingCount + s_MergingPostingCount) * sizeof(uint32_t) +
+			(s_PendingPostings.size() + s_MergingPostings.size()) * kPendingListOverhead +
+			(s_PendingPostings.bucket_count() + s_MergingPostings.bucket_count()) * sizeof(void*);
+		return statistics;
+	}
+
+	static void PublishStatistics()
+	{
+		auto statistics = GetStatistics();
+
+		Metrics::Add(Metrics::Gauge::SearchIndexEntries, static_cast<int64_t>(statistics.entryCount - s_PublishedStatistics.entryCount));
+		Metrics::Add(Metrics::Gauge::SearchIndexEntryBytes, static_cast<int64_t>(statistics.entryBytes - s_PublishedStatistics.entryBytes));
+		Metrics::Add(Metrics::Gauge::SearchIndexNameBytes, static_cast<int64_t>(statistics.nameBytes - s_PublishedStatistics.nameBytes));
+		Metrics::Add(Metrics::Gauge::SearchIndexPostingBytes, static_cast<int64_t>(statistics.postingBytes - s_PublishedStatistics.postingBytes));
+		Metrics::Add(Metrics::Gauge::SearchIndexPendingPostingBytes, static_cast<int64_t>(statistics.pendingPostingBytes - s_PublishedStatistics.pendingPostingBytes));
+
+		s_PublishedStatistics = statistics;
+	}
+
+	static void AddPendingPostings(uint32_t entry)
+	{
+		const auto& indexEntry = s_Entries[entry];
+		vector<uint32_t> grams;
+		grams.reserve(indexEntry.nameLength + 3);
+
+		ForEachGram(s_Names.data() + indexEntry.nameOffset, indexEntry.nameLength, [&grams](uint32_t gram)
+		{
+			grams.push_back(gram);
+		});
+
+		sort(grams.begin(), grams.end());
+		grams.erase(unique(grams.begin(), grams.end()), grams.end());
+
+		for (auto gram : grams)
+		{
+			s_PendingPostings[gram].push_back(entry);
+		}
+
+		s_PendingPostingCount += grams.size();
+	}
+
+	static uint32_t AddEntry(uint32_t parent, const string& name, bool isDirectory)
+	{
+		if (name.empty() || name.length() > kMaxNameLength || s_Names.size() + name.length() > kMaxNamePoolSize)
+		{
+			return kNoEntry;
+		}
+
+		uint32_t entry;
+
+		if (!s_FreeEntries.empty())
+		{
+			entry = s_FreeEntries.back();
+			s_FreeEntries.pop_back();
+		}
+		else
+		{
+			if (s_Entries.size() >= kNoEntry)
+			{
+				return kNoEntry;
+			}
+
+			entry = static_cast<uint32_t>(s_Entries.size());
+			s_Entries.emplace_back();
+		}
+
+		auto& indexEntry = s_Entries[entry];
+		indexEntry.parent = parent;
+		indexEntry.firstChild = kNoEntry;
+		indexEntry.nextSibling = kNoEntry;
+		indexEntry.nameOffset = static_cast<uint32_t>(s_Names.size());
+		indexEntry.nameLength = static_cast<uint16_t>(name.length());
+		indexEntry.flags = isDirectory ? kIsLive | kIsDirectory : kIsLive;
+		indexEntry.reserved = 0;
+
+		s_Names.insert(s_Names.end(), name.begin(), name.end());
+		s_LiveEntryCount++;
+
+		if (s_IsPosting)
+		{
+			AddPendingPostings(entry);
+		}
+
+		return entry;
+	}
+
+	// Along with everything under it. Leaves unlinking it from its parent to the caller
+	static void RemoveEntry(uint32_t entry)
+	{
+		vector<uint32_t> removedEntries(1, entry);
+
+		while (!removedEntries.empty())
+		{
+			auto removedEntry = removedEntries.back();
+			removedEntries.pop_back();
+
+			auto& indexEntry = s_Entries[removedEntry];
+
+			for (auto child = indexEntry.firstChild; child != kNoEntry; child = s_Entries[child].nextSibling)
+			{
+				removedEntries.push_back(child);
+			}
+
+			indexEntry.flags = 0;
+			indexEntry.firstChild = kNoEntry;
+			s_GarbageNameBytes += indexEntry.nameLength;
+			s_LiveEntryCount--;
+			s_FreeEntries.push_back(removedEntry);
+		}
+	}
+
+	// Makes the children of the directory match its listing, and returns the folders to crawl next:
+	// the new ones, or all of them when recursing
+	static vector<CrawlTarget> ReplaceChildren(uint32_t directory, const string& path, const vector<FileSystem::FileInfo>& contents, bool isRecursive)
+	{
+		vector<CrawlTarget> crawlTargets;
+		unordered_map<string, uint32_t> oldChildren;
+
+		for (auto child = s_Entries[directory].firstChild; child != kNoEntry; child = s_Entries[child].nextSibling)
+		{
+			oldChildren.emplace(GetName(s_Entries[child]), child);
+		}
+
+		auto firstChild = kNoEntry;
+
+		for (const auto& file : contents)
+		{
+			auto isDirectory = file.fileStatus == FileSystem::FileStatus::Directory;
+			auto child = kNoEntry;
+			auto isNew = true;
+
+			if (!oldChildren.empty())
+			{
+				auto oldChild = oldChildren.find(file.fileName);
+
+				if (oldChild != oldChildren.end() && ((s_Entries[oldChild->second].flags & kIsDirectory) != 0) == isDirectory)
+				{
+					child = oldChild->second;
+					isNew = false;
+					oldChildren.erase(oldChild);
+				}
+			}
+
+			if (child == kNoEntry)
+			{
+				child = AddEntry(directory, file.fileName, isDirectory);
+
+				if (child == kNoEntry)
+				{
+					continue;
+				}
+			}
+
+			s_Entries[child].nextSibling = firstChild;
+			firstChild = child;
+
+			if (isDirectory && (isNew || isRecursive))
+			{
+				CrawlTarget crawlTarget = { child, FileSystem::CombinePaths(path, file.fileName) };
+				crawlTargets.push_back(std::move(crawlTarget));
+			}
+		}
+
+		for (const auto& oldChild : oldChildren)
+		{
+			RemoveEntry(oldChild.second);
+		}
+
+		s_Entries[directory].firstChild = firstChild;
+		return crawlTargets;
+	}
+
+	static void QueueCrawl(uint32_t entry, const string& path, bool isRecursive)
+	{
+		if (s_Pool == nullptr)
+		{
+			return;
+		}
+
+		// Shutdown destroys the pool, which waits for the crawl, before it destroys the token
+		auto generation = s_Generation;
+		auto cancellationToken = s_ShutdownToken.get();
+
+		s_ActiveCrawlCount++;
+		UpdateIdleEvent();
+
+		s_Pool->Submit([generation, entry, path, isRecursive, cancellationToken]()
+		{
+			CrawlDirectory(generation, entry, path, isRecursive, *cancellationToken);
+		});
+	}
+
+	static void RepackNames()
+	{
+		vector<char> names;
+		names.reserve(s_Names.size() - static_cast<size_t>(s_GarbageNameBytes));
+
+		for (auto& entry : s_Entries)
+		{
+			if ((entry.flags & kIsLive) != 0 && entry.nameLength > 0)
+			{
+				auto nameOffset = names.size();
+				names.insert(names.end(), s_Names.data() + entry.nameOffset, s_Names.data() + entry.nameOffset + entry.nameLength);
+				entry.nameOffset = static_cast<uint32_t>(nameOffset);
+			}
+		}
+
+		s_Names.swap(names);
+		s_GarbageNameBytes = 0;
+		s_Entries.shrink_to_fit();
+	}
+
+	// Pending postings from before go to the side, where queries still find them until the merge is done
+	static void StartMerge()
+	{
+		if (s_Pool == nullptr)
+		{
+			return;
+		}
+
+		Assert(!s_IsMerging && s_MergingPostings.empty());
+
+		if (!s_HasPostings || s_GarbageNameBytes > s_Names.size() / 2)
+		{
+			RepackNames();
+		}
+
+		s_IsPosting = true;
+		s_IsMerging = true;
+		s_MergingPostings.swap(s_PendingPostings);
+		s_MergingPostingCount = s_PendingPostingCount;
+		s_PendingPostingCount = 0;
+		UpdateIdleEvent();
+
+		auto partitionCount = s_Pool->GetWorkerCount();
+		auto merge = make_shared<Merge>(s_Generation, static_cast<uint32_t>(s_Entries.size()), partitionCount);
+
+		for (uint32_t i = 0; i < partitionCount; i++)
+		{
+			s_Pool->Submit([merge, i]()
+			{
+				BuildPartition(merge, i);
+			});
+		}
+	}
+
+	static void MergeIfNeeded()
+	{
+		if (s_IsPosting && !s_IsMerging && s_PendingPostingCount >= max(kMinPendingPostingCount, s_Postings.postingCount / 8))
+		{
+			StartMerge();
+		}
+	}
+
+	static void UpdateDirectory(uint32_t directory, const string& path, const vector<FileSystem::FileInfo>& contents, bool isRecursive)
+	{
+		auto crawlTargets = ReplaceChildren(directory, path, contents, isRecursive);
+
+		for (const auto& crawlTarget : crawlTargets)
+		{
+			QueueCrawl(crawlTarget.entry, crawlTarget.path, isRecursive);
+		}
+
+		MergeIfNeeded();
+		PublishStatistics();
+	}
+
+	static void FinishCrawl()
+	{
+		Assert(s_ActiveCrawlCount > 0);
+		s_ActiveCrawlCount--;
+
+		// The first crawl is done, so it's time to build the lists
+		if (s_ActiveCrawlCount == 0 && !s_IsPosting)
+		{
+			StartMerge();
+		}
+
+		UpdateIdleEvent();
+	}
+
+	static void Reset()
+	{
+		s_Generation++;
+
+		vector<Entry>().swap(s_Entries);
+		vector<char>().swap(s_Names);
+		vector<uint32_t>().swap(s_FreeEntries);
+		s_LiveEntryCount = 0;
+		s_GarbageNameBytes = 0;
+
+		Postings postings;
+		s_Postings.Swap(postings);
+		PendingPostings().swap(s_PendingPostings);
+		PendingPostings().swap(s_MergingPostings);
+		s_PendingPostingCount = 0;
+		s_MergingPostingCount = 0;
+
+		s_IsPosting = false;
+		s_HasPostings = false;
+		s_IsMerging = false;
+		s_ActiveCrawlCount = 0;
+		s_QueuedRefreshes.clear();
+
+		UpdateIdleEvent();
+		PublishStatistics();
+	}
+
+	static void StartCrawl()
+	{
+		Reset();
+
+		if (!s_IsEnabled || s_Pool == nullptr)
+		{
+			return;
+		}
+
+		for (size_t i = 0; i < s_Roots.size(); i++)
+		{
+			Entry root = { kNoEntry, kNoEntry, kNoEntry, 0, 0, kIsLive | kIsDirectory, 0 };
+			s_Entries.push_back(root);
+		}
+
+		for (uint32_t root = 0; root < s_Roots.size(); root++)
+		{
+			QueueCrawl(root, s_Roots[root], false);
+		}
+	}
+
+	// Adds the entry if it matches. Returns false once there are as many matches as queries rank
+	static inline bool AddMatch(uint32_t entry, const string& foldedQuery, bool isPrefix, uint8_t minRank, vector<Match>& matches)
+	{
+		if (entry >= s_Entries.size())
+		{
+			return true;
+		}
+
+		const auto& indexEntry = s_Entries[entry];
+
+		if ((indexEntry.flags & kIsLive) == 0 || indexEntry.parent == kNoEntry)
+		{
+			return true;
+		}
+
+		auto rank = RankMatch(s_Names.data() + indexEntry.nameOffset, indexEntry.nameLength, foldedQuery, isPrefix);
+
+		if (rank == kNoMatch || rank < minRank)
+		{
+			return true;
+		}
+
+		Match match = { entry, indexEntry.nameLength, rank };
+		matches.push_back(match);
+		return matches.size() < kMaxMatchCount;
+	}
+
+	// Entries in all of the grams' lists, as far as the two rarest ones tell, plus the pending entries in the rarest pending list.
+	// An entry's postings are either all merged or all pending, so lists pending on their own can't be missing any of them.
+	// Returns false once the callback does
+	template <typename Callback>
+	static bool ForEachCandidate(const vector<uint32_t>& grams, Callback&& callback)
+	{
+		const PostingList* rarestList = nullptr;
+		const PostingList* secondRarestList = nullptr;
+		auto isMissingList = false;
+
+		for (auto gram : grams)
+		{
+			auto list = s_Postings.Find(gram);
+
+			if (list == nullptr)
+			{
+				isMissingList = true;
+				break;
+			}
+
+			if (rarestList == nullptr || list->count < rarestList->count)
+			{
+				secondRarestList = rarestList;
+				rarestList = list;
+			}
+			else if (secondRarestList == nullptr || list->count < secondRarestList->count)
+			{
+				secondRarestList = list;
+			}
+		}
+
+		if (!isMissingList && rarestList != nullptr)
+		{
+			PostingCursor candidates(s_Postings, *rarestList);
+			uint32_t candidate;
+
+			if (secondRarestList == nullptr)
+			{
+				while (candidates.Next(candidate))
+				{
+					if (!callback(candidate))
+					{
+						return false;
+					}
+				}
+			}
+			else
+			{
+				PostingCursor filter(s_Postings, *secondRarestList);
+				uint32_t filterEntry;
+				auto hasFilterEntry = filter.Next(filterEntry);
+
+				while (hasFilterEntry && candidates.Next(candidate))
+				{
+					while (hasFilterEntry && filterEntry < candidate)
+					{
+						hasFilterEntry = filter.Next(filterEntry);
+					}
+
+					if (hasFilterEntry && filterEntry == candidate && !callback(candidate))
+					{
+						return false;
+					}
+				}
+			}
+		}
+
+		const PendingPostings* pendingPostings[] = { &s_MergingPostings, &s_PendingPostings };
+
+		for (auto postings : pendingPostings)
+		{
+			const vector<uint32_t>* rarestPendingList = nullptr;
+
+			for (auto gram : grams)
+			{
+				auto list = postings->find(gram);
+
+				if (list == postings->end())
+				{
+					rarestPendingList = nullptr;
+					break;
+				}
+
+				if (rarestPendingList == nullptr || list->second.size() < rarestPendingList->size())
+				{
+					rarestPendingList = &list->second;
+				}
+			}
+
+			if (rarestPendingList == nullptr)
+			{
+				continue;
+			}
+
+			for (auto candidate : *rarestPendingList)
+			{
+				if (!callback(candidate))
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	// Prefix matches are found first, so they make it into the ranking even when there are too many matches
+	static bool FindMatches(const string& foldedQuery, bool isPrefix, vector<Match>& matches)
+	{
+		auto addMatch = [&foldedQuery, &matches](bool isPrefix, uint8_t minRank)
+		{
+			return [&foldedQuery, &matches, isPrefix, minRank](uint32_t entry)
+			{
+				return AddMatch(entry, foldedQuery, isPrefix, minRank, matches);
+			};
+		};
+
+		if (!ForEachCandidate(GetQueryGrams(foldedQuery, true), addMatch(true, kExactMatch)))
+		{
+			return false;
+		}
+
+		return isPrefix || ForEachCandidate(GetQueryGrams(foldedQuery, false), addMatch(false, kWordMatch));
+	}
+}
+
+// Before the first merge there are no lists, so queries check every name, a chunk at a time so crawls can go on meanwhile
+static bool ScanMatches(const string& foldedQuery, bool isPrefix, vector<Match>& matches)
+{
+	for (uint32_t chunkBegin = 0;; chunkBegin += kChunkSize)
+	{
+		CriticalSection::Lock lock(s_CriticalSection);
+		auto entryCount = static_cast<uint32_t>(s_Entries.size());
+
+		if (chunkBegin >= entryCount)
+		{
+			return true;
+		}
+
+		auto chunkEnd = chunkBegin + min(kChunkSize, entryCount - chunkBegin);
+
+		for (auto entry = chunkBegin; entry < chunkEnd; entry++)
+		{
+			if (!NoLock::AddMatch(entry, foldedQuery, isPrefix, kExactMatch, matches))
+			{
+				return false;
+			}
+		}
+	}
+}
+
+static void CrawlDirectory(uint64_t generation, uint32_t entry, const string& path, bool isRecursive, const CancellationToken& cancellationToken)
+{
+	{
+		CriticalSection::Lock lock(s_CriticalSection);
+
+		// Crawls from before started over are no longer counted
+		if (generation != s_Generation)
+		{
+			return;
+		}
+
+		s_QueuedRefreshes.erase(path);
+	}
+
+	auto contents = SharedFiles::GetFolderContents(path, cancellationToken);
+	auto isListed = !contents.empty() || GetLastError() == ERROR_SUCCESS;
+
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	if (generation != s_Generation)
+	{
+		return;
+	}
+
+	// A directory that can't be listed for now keeps what it had
+	if (isListed && !cancellationToken.IsCancelled())
+	{
+		auto directory = NoLock::FindDirectory(entry, path);
+
+		if (directory != kNoEntry)
+		{
+			NoLock::UpdateDirectory(directory, path, contents, isRecursive);
+		}
+	}
+
+	NoLock::FinishCrawl();
+}
+
+// Postings hold the gram above the entry. They're made in order of entries, so a stable sort by gram leaves them sorted by both.
+// Grams take 26 bits, which three 9 bit digits cover
+static void SortPostingsByGram(vector<uint64_t>& postings, vector<uint64_t>& scratch)
+{
+	static const int kDigitBits = 9;
+	static const uint32_t kDigitCount = 1 << kDigitBits;
+
+	scratch.resize(postings.size());
+
+	for (int shift = 32; shift < 32 + 3 * kDigitBits; shift += kDigitBits)
+	{
+		size_t offsets[kDigitCount] = {};
+
+		for (auto posting : postings)
+		{
+			offsets[(posting >> shift) & (kDigitCount - 1)]++;
+		}
+
+		size_t offset = 0;
+
+		for (auto& digitOffset : offsets)
+		{
+			auto digitCount = digitOffset;
+			digitOffset = offset;
+			offset += digitCount;
+		}
+
+		for (auto posting : postings)
+		{
+			scratch[offsets[(posting >> shift) & (kDigitCount - 1)]++] = posting;
+		}
+
+		postings.swap(scratch);
+	}
+}
+
+// Postings of a chunk are sorted by gram, then entry, so each gram's list is looked up once per chunk rather than once per posting
+static void AddPostings(MergePartition& partition, const vector<uint64_t>& postings)
+{
+	for (size_t i = 0; i < postings.size();)
+	{
+		auto gram = static_cast<uint32_t>(postings[i] >> 32);
+		auto listIndex = partition.listIndices.find(gram);
+
+		if (listIndex == partition.listIndices.end())
+		{
+			listIndex = partition.listIndices.emplace(gram, static_cast<uint32_t>(partition.lists.size())).first;
+			partition.lists.emplace_back(gram);
+		}
+
+		auto& list = partition.lists[listIndex->second];
+
+		for (; i < postings.size() && static_cast<uint32_t>(postings[i] >> 32) == gram; i++)
+		{
+			auto entry = static_cast<uint32_t>(postings[i]);
+
+			if (list.count > 0 && list.lastEntry == entry)
+			{
+				continue;
+			}
+
+			AppendVarint(list.bytes, entry - list.lastEntry);
+			list.lastEntry = entry;
+			list.count++;
+		}
+	}
+}
+
+// Partitions cover consecutive ranges of entries, so each gram's lists from all of them just follow each other,
+// once the first entry of each is stored as the difference from the last one before it
+static void CompleteMerge(const shared_ptr<Merge>& merge)
+{
+	struct ListReference
+	{
+		uint32_t gram;
+		uint32_t partitionIndex;
+		uint32_t listIndex;
+	};
+
+	Postings postings;
+
+	if (!merge->isAbandoned)
+	{
+		vector<ListReference> listReferences;
+		size_t byteCount = 0;
+
+		for (uint32_t i = 0; i < merge->partitions.size(); i++)
+		{
+			const auto& lists = merge->partitions[i].lists;
+
+			for (uint32_t j = 0; j < lists.size(); j++)
+			{
+				ListReference listReference = { lists[j].gram, i, j };
+				listReferences.push_back(listReference);
+				byteCount += lists[j].bytes.size();
+			}
+		}
+
+		sort(listReferences.begin(), listReferences.end(), [](const ListReference& left, const ListReference& right)
+		{
+			return left.gram < right.gram || left.gram == right.gram && left.partitionIndex < right.partitionIndex;
+		});
+
+		postings.bytes.reserve(byteCount);
+
+		for (size_t i = 0; i < listReferences.size();)
+		{
+			PostingList postingList = { listReferences[i].gram, 0, postings.bytes.size() };
+			uint32_t lastEntry = 0;
+
+			for (; i < listReferences.size() && listReferences[i].gram == postingList.gram; i++)
+			{
+				auto& list = merge->partitions[listReferences[i].partitionIndex].lists[listReferences[i].listIndex];
+				const uint8_t* data = list.bytes.data();
+				const uint8_t* dataEnd = data + list.bytes.size();
+				auto firstEntry = ReadVarint(data);
+
+				AppendVarint(postings.bytes, firstEntry - lastEntry);
+				postings.bytes.insert(postings.bytes.end(), data, dataEnd);
+				postingList.count += list.count;
+				lastEntry = list.lastEntry;
+
+				vector<uint8_t>().swap(list.bytes);
+			}
+
+			postings.lists.push_back(postingList);
+			postings.postingCount += postingList.count;
+		}
+
+		postings.lists.shrink_to_fit();
+	}
+
+	// Merged postings go away once the lock is released
+	PendingPostings mergedPostings;
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	// Starting over already dropped everything this merge was for
+	if (merge->isAbandoned || merge->generation != s_Generation)
+	{
+		return;
+	}
+
+	s_Postings.Swap(postings);
+	s_MergingPostings.swap(mergedPostings);
+	s_MergingPostingCount = 0;
+	s_HasPostings = true;
+	s_IsMerging = false;
+
+	NoLock::MergeIfNeeded();
+	NoLock::PublishStatistics();
+	NoLock::UpdateIdleEvent();
+}
+
+// Names are copied out a chunk at a time, so the lock isn't held while they're split into grams.
+// Whatever changes after being copied has pending postings
+static void BuildPartition(const shared_ptr<Merge>& merge, uint32_t partitionIndex)
+{
+	auto& partition = merge->partitions[partitionIndex];
+	auto partitionCount = static_cast<uint64_t>(merge->partitions.size());
+	auto partitionBegin = static_cast<uint32_t>(merge->entryCount * partitionIndex / partitionCount);
+	auto partitionEnd = static_cast<uint32_t>(merge->entryCount * (partitionIndex + 1) / partitionCount);
+
+	vector<char> names;
+	vector<uint32_t> entries;
+	vector<size_t> nameEnds;
+	vector<uint64_t> postings;
+	vector<uint64_t> sortScratch;
+
+	for (auto chunkBegin = partitionBegin; chunkBegin < partitionEnd && !merge->isAbandoned;)
+	{
+		auto chunkEnd = chunkBegin + min(kChunkSize, partitionEnd - chunkBegin);
+		names.clear();
+		entries.clear();
+		nameEnds.clear();
+
+		{
+			CriticalSection::Lock lock(s_CriticalSection);
+
+			if (merge->generation != s_Generation)
+			{
+				merge->isAbandoned = true;
+				break;
+			}
+
+			for (auto entry = chunkBegin; entry < chunkEnd; entry++)
+			{
+				const auto& indexEntry = s_Entries[entry];
+
+				if ((indexEntry.flags & kIsLive) != 0 && indexEntry.parent != kNoEntry)
+				{
+					names.insert(names.end(), s_Names.data() + indexEntry.nameOffset, s_Names.data() + indexEntry.nameOffset + indexEntry.nameLength);
+					entries.push_back(entry);
+					nameEnds.push_back(names.size());
+				}
+			}
+		}
+
+		size_t nameBegin = 0;
+		postings.clear();
+
+		for (size_t i = 0; i < entries.size(); i++)
+		{
+			auto entry = entries[i];
+
+			ForEachGram(names.data() + nameBegin, nameEnds[i] - nameBegin, [&postings, entry](uint32_t gram)
+			{
+				postings.push_back(static_cast<uint64_t>(gram) << 32 | entry);
+			});
+
+			nameBegin = nameEnds[i];
+		}
+
+		SortPostingsByGram(postings, sortScratch);
+		AddPostings(partition, postings);
+
+		chunkBegin = chunkEnd;
+	}
+
+	if (--merge->pendingPartitionCount == 0)
+	{
+		CompleteMerge(merge);
+	}
+}
+
+// Folders under other shared folders are crawled from those
+static vector<string> FindRoots(const vector<string>& fullySharedFolders, const vector<string>& partiallySharedFolders)
+{
+	SharedFiles::FileSet folders(fullySharedFolders.begin(), fullySharedFolders.end());
+	folders.insert(partiallySharedFolders.begin(), partiallySharedFolders.end());
+
+	vector<string> roots;
+
+	for (const auto& folder : folders)
+	{
+		auto ancestor = folder;
+		auto isNested = false;
+
+		for (;;)
+		{
+			FileSystem::RemoveLastPathComponentInline(ancestor);
+
+			if (ancestor.empty())
+			{
+				break;
+			}
+
+			if (folders.find(ancestor) != folders.end())
+			{
+				isNested = true;
+				break;
+			}
+		}
+
+		if (!isNested)
+		{
+			roots.push_back(folder);
+		}
+	}
+
+	sort(roots.begin(), roots.end());
+	return roots;
+}
+
+void SearchIndex::Initialize()
+{
+	auto workerCount = max(kMinWorkerCount, min(thread::hardware_concurrency(), kMaxWorkerCount));
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	Assert(s_Pool == nullptr);
+	s_ShutdownToken.reset(new CancellationToken);
+	s_Pool.reset(new WorkStealingPool(workerCount));
+	NoLock::StartCrawl();
+}
+
+// Crawls and merges that are still queued see that the index started over, and leave right away
+void SearchIndex::Shutdown()
+{
+	unique_ptr<WorkStealingPool> pool;
+
+	{
+		CriticalSection::Lock lock(s_CriticalSection);
+
+		if (s_ShutdownToken != nullptr)
+		{
+			s_ShutdownToken->Cancel();
+		}
+
+		NoLock::Reset();
+		pool = std::move(s_Pool);
+	}
+
+	pool.reset();
+
+	CriticalSection::Lock lock(s_CriticalSection);
+	s_ShutdownToken.reset();
+}
+
+void SearchIndex::SetEnabled(bool enabled)
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	if (s_IsEnabled == enabled)
+	{
+		return;
+	}
+
+	s_IsEnabled = enabled;
+	NoLock::StartCrawl();
+}
+
+// With the same roots, only what's visible in them may have changed, so the entries stay and get rescanned instead
+void SearchIndex::SetSharedFolders(vector<string>&& fullySharedFolders, vector<string>&& partiallySharedFolders)
+{
+	auto roots = FindRoots(fullySharedFolders, partiallySharedFolders);
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	if (roots == s_Roots && s_IsPosting)
+	{
+		for (uint32_t root = 0; root < s_Roots.size(); root++)
+		{
+			NoLock::QueueCrawl(root, s_Roots[root], true);
+		}
+
+		return;
+	}
+
+	s_Roots = std::move(roots);
+	NoLock::StartCrawl();
+}
+
+void SearchIndex::Update(const string& path, const vector<FileSystem::FileInfo>& contents)
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	if (!s_IsEnabled || s_Pool == nullptr)
+	{
+		return;
+	}
+
+	auto directory = NoLock::FindDirectory(path);
+
+	if (directory != kNoEntry)
+	{
+		NoLock::UpdateDirectory(directory, path, contents, false);
+	}
+}
+
+// A burst of changes in one directory lists it again once
+void SearchIndex::Invalidate(const string& path)
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	if (!s_IsEnabled || s_Pool == nullptr)
+	{
+		return;
+	}
+
+	auto directory = NoLock::FindDirectory(path);
+
+	if (directory != kNoEntry && s_QueuedRefreshes.insert(path).second)
+	{
+		NoLock::QueueCrawl(directory, path, false);
+	}
+}
+
+void SearchIndex::Rescan(const string& folderPath)
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	if (!s_IsEnabled || s_Pool == nullptr)
+	{
+		return;
+	}
+
+	auto directory = NoLock::FindDirectory(folderPath);
+
+	if (directory != kNoEntry)
+	{
+		NoLock::QueueCrawl(directory, folderPath, true);
+	}
+}
+
+SearchIndex::Results SearchIndex::Search(const string& query, QueryType queryType, size_t maxResultCount)
+{
+	Results results;
+	results.matchCount = 0;
+	results.isTruncated = false;
+	results.isIndexing = false;
+
+	if (query.empty() || query.length() > kMaxQueryLength)
+	{
+		return results;
+	}
+
+	string foldedQuery;
+	foldedQuery.reserve(query.length());
+
+	for (auto c : query)
+	{
+		foldedQuery += static_cast<char>(FoldCase(c));
+	}
+
+	auto isPrefix = queryType == QueryType::Prefix || foldedQuery.length() < 3;
+	vector<Match> matches;
+	bool hasPostings;
+
+	{
+		CriticalSection::Lock lock(s_CriticalSection);
+		hasPostings = s_HasPostings;
+		results.isIndexing = !s_HasPostings && !IsIdle();
+
+		if (hasPostings)
+		{
+			results.isTruncated = !NoLock::FindMatches(foldedQuery, isPrefix, matches);
+		}
+	}
+
+	if (!hasPostings)
+	{
+		results.isTruncated = !ScanMatches(foldedQuery, isPrefix, matches);
+	}
+
+	// Entries with both merged and pending postings can come up twice
+	sort(matches.begin(), matches.end(), [](const Match& left, const Match& right) { return left.entry < right.entry; });
+	matches.erase(unique(matches.begin(), matches.end(), [](const Match& left, const Match& right) { return left.entry == right.entry; }), matches.end());
+
+	auto resultCount = min(maxResultCount, matches.size());
+
+	partial_sort(matches.begin(), matches.begin() + resultCount, matches.end(), [](const Match& left, const Match& right)
+	{
+		if (left.rank != right.rank)
+		{
+			return left.rank < right.rank;
+		}
+
+		if (left.nameLength != right.nameLength)
+		{
+			return left.nameLength < right.nameLength;
+		}
+
+		return left.entry < right.entry;
+	});
+
+	results.matchCount = matches.size();
+	results.results.reserve(resultCount);
+
+	// Scanning queries let go of the lock in between, so entries are checked again
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	for (size_t i = 0; i < resultCount; i++)
+	{
+		auto entry = matches[i].entry;
+
+		if (entry >= s_Entries.size())
+		{
+			continue;
+		}
+
+		const auto& indexEntry = s_Entries[entry];
+
+		if ((indexEntry.flags & kIsLive) == 0 || indexEntry.parent == kNoEntry ||
+			RankMatch(s_Names.data() + indexEntry.nameOffset, indexEntry.nameLength, foldedQuery, isPrefix) == kNoMatch)
+		{
+			continue;
+		}
+
+		Result result = { NoLock::GetPath(entry), NoLock::GetName(indexEntry), (indexEntry.flags & kIsDirectory) != 0 };
+		results.results.push_back(std::move(result));
+	}
+
+	return results;
+}
+
+void SearchIndex::WaitUntilIdle()
+{
+	{
+		CriticalSection::Lock lock(s_CriticalSection);
+
+		if (IsIdle())
+		{
+			return;
+		}
+	}
+
+	s_IdleEvent.Wait();
+}
+
+SearchIndex::Statistics SearchIndex::GetStatistics()
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+	return NoLock::GetStatistics();
+}
\ No newline at end of file
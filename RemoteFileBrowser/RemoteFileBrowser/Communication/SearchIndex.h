@@ -0,0 +1,70 @@
+#pragma once
+
+// Finds shared files and folders by name. Every name visible under the shared folders is kept in memory in one string pool,
+// with a 20 byte entry pointing at it and at its parent folder, and postings lists map the trigrams of lowercased names, along
+// with their first one to three characters, to the entries that contain them. Lists are delta and varint encoded, so most
+// postings take a byte or two. Queries intersect the lists of the rarest trigrams and check the names they lead to.
+//
+// Shared folders are crawled in parallel on a work-stealing pool, and the lists are built from the crawled names once the crawl
+// is done. Until then, queries check every name. Listings, change notifications and crawls of changed directories keep entries
+// current afterwards, and postings for new names go to small pending lists, which get merged into the encoded ones once there are
+// enough of them. Removed names leave stale postings behind until then, which the name check filters out.
+
+namespace SearchIndex
+{
+	enum class QueryType
+	{
+		Substring,
+		Prefix			// Queries shorter than a trigram always match like this
+	};
+
+	struct Result
+	{
+		std::string path;
+		std::string name;
+		bool isDirectory;
+	};
+
+	struct Results
+	{
+		std::vector<Result> results;	// Exact names first, then prefixes, then matches at the start of a word, then the rest, shorter names first
+		size_t matchCount;				// How many were ranked
+		bool isTruncated;				// Whether there were more matches than a query ranks
+		bool isIndexing;				// Whether shared folders are still being crawled
+	};
+
+	struct Statistics
+	{
+		uint64_t entryCount;
+		uint64_t entryBytes;
+		uint64_t nameBytes;
+		uint64_t postingCount;
+		uint64_t postingBytes;			// Encoded lists and the table of them
+		uint64_t pendingPostingBytes;	// Estimated, including the hash table
+	};
+
+	void Initialize();
+	void Shutdown();
+
+	// On by default. Turning it off drops the index
+	void SetEnabled(bool enabled);
+
+	// Crawls the folders again in the background. The index starts over unless they still come down to the same topmost folders
+	void SetSharedFolders(std::vector<std::string>&& fullySharedFolders, std::vector<std::string>&& partiallySharedFolders);
+
+	// Freshly listed, visible contents of a directory. New folders among them get crawled
+	void Update(const std::string& path, const std::vector<Utilities::FileSystem::FileInfo>& contents);
+
+	// Lists the directory again in the background
+	void Invalidate(const std::string& path);
+
+	// Crawls the folder again in the background, with everything under it
+	void Rescan(const std::string& folderPath);
+
+	Results Search(const std::string& query, QueryType queryType, size_t maxResultCount);
+
+	// Waits for crawls and merges that are running, or were started by then
+	void WaitUntilIdle();
+
+	Statistics GetStatistics();
+};
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include "PrecompiledHeader.h"
+#include "Http\ResponseWriter.h"
+#include "SearchIndex.h"
+#include "SearchResponseHandler.h"
+#include "SharedFiles.h"
+#include "Utilities\Metrics.h"
+
+using namespace std;
+using namespace Utilities;
+
+static const size_t kMaxResultCount = 1000;
+static const size_t kMaxQueryLength = 1024;
+static const size_t kResultsPerWrite = 128;
+
+// The request target is decoded before it gets here, so everything after the parameter name is the query, '&' included
+static bool ParseQuery(const string& queryString, string& query, SearchIndex::QueryType& queryType)
+{
+	if (queryString.compare(0, 2, "q=") == 0)
+	{
+		query = queryString.substr(2);
+		queryType = SearchIndex::QueryType::Substring;
+	}
+	else if (queryString.compare(0, 7, "prefix=") == 0)
+	{
+		query = queryString.substr(7);
+		queryType = SearchIndex::QueryType::Prefix;
+	}
+	else
+	{
+		return false;
+	}
+
+	return !query.empty() && query.length() <= kMaxQueryLength;
+}
+
+static void AppendResult(string& output, const SearchIndex::Result& result)
+{
+	output += "{\"path\":\"";
+	Encoding::AppendEscapedJson(output, result.path);
+	output += "\",\"name\":\"";
+	Encoding::AppendEscapedJson(output, result.name);
+	output += result.isDirectory ? "\",\"folder\":true}" : "\",\"folder\":false}";
+}
+
+// HTTP/1.1 clients get the results a batch per chunk, as they're formatted. HTTP/1.0 ones get them until the connection closes
+class ResultStream
+{
+private:
+	Http::ResponseWriter m_Writer;
+	Http::RequestContext& m_Context;
+	bool m_IsChunked;
+
+public:
+	ResultStream(SOCKET clientSocket, Http::RequestContext& context, bool isChunked) :
+		m_Writer(clientSocket, context), m_Context(context), m_IsChunked(isChunked)
+	{
+	}
+
+	ResultStream(const ResultStream&) = delete;
+	ResultStream& operator=(const ResultStream&) = delete;
+
+	bool Send(const string& header, const string& data, bool isLastWrite)
+	{
+		char chunkSize[16];
+		auto chunkSizeLength = m_IsChunked ? sprintf_s(chunkSize, "%llx\r\n", static_cast<unsigned long long>(data.length())) : 0;
+		static const char kChunkEnd[] = "\r\n0\r\n\r\n";
+
+		WSABUF buffers[4];
+		DWORD bufferCount = 0;
+
+		if (!header.empty())
+		{
+			buffers[bufferCount++] = Http::ResponseWriter::MakeBuffer(header.data(), header.length());
+		}
+
+		if (chunkSizeLength > 0)
+		{
+			buffers[bufferCount++] = Http::ResponseWriter::MakeBuffer(chunkSize, chunkSizeLength);
+		}
+
+		buffers[bufferCount++] = Http::ResponseWriter::MakeBuffer(data.data(), data.length());
+
+		if (m_IsChunked)
+		{
+			// Chunk data ends with a line break, and the last one is followed by the empty chunk
+			buffers[bufferCount++] = Http::ResponseWriter::MakeBuffer(kChunkEnd, isLastWrite ? sizeof(kChunkEnd) - 1 : 2);
+		}
+
+		if (!m_Writer.Send(buffers, bufferCount, isLastWrite))
+		{
+			return false;
+		}
+
+		// There's no other way to tell where the response ends
+		if (isLastWrite && !m_IsChunked)
+		{
+			m_Context.cancellationToken.Cancel();
+		}
+
+		return true;
+	}
+};
+
+void SearchResponseHandler::ExecuteRequest(SOCKET clientSocket, const string& queryString, const string& httpVersion, Http::RequestContext& context)
+{
+	string query;
+	SearchIndex::QueryType queryType;
+
+	if (!ParseQuery(queryString, query, queryType))
+	{
+		auto httpHeader = httpVersion + " 400 Bad Request\r\nContent-Length: 0\r\n\r\n";
+		Http::ResponseWriter(clientSocket, context).Send(httpHeader.c_str(), httpHeader.length(), true);
+		return;
+	}
+
+	SearchIndex::Results results;
+
+	{
+		Metrics::ScopedTimer timer(Metrics::Histogram::SearchDuration);
+		results = SearchIndex::Search(query, queryType, kMaxResultCount);
+	}
+
+	auto isChunked = httpVersion != "HTTP/1.0";
+
+	stringstream header;
+	header << httpVersion << " 200 OK\r\n";
+	header << "Content-Type: application/json\r\n";
+	header << "Cache-Control: no-cache\r\n";
+	header << (isChunked ? "Transfer-Encoding: chunked\r\n\r\n" : "Connection: close\r\n\r\n");
+
+	string data = "{\"query\":\"";
+	Encoding::AppendEscapedJson(data, query);
+	data += "\",\"matches\":" + to_string(results.matchCount);
+	data += results.isTruncated ? ",\"truncated\":true" : ",\"truncated\":false";
+	data += results.isIndexing ? ",\"indexing\":true" : ",\"indexing\":false";
+	data += ",\"results\":[";
+
+	ResultStream stream(clientSocket, context, isChunked);
+	auto pendingHeader = header.str();
+	size_t resultsInWrite = 0;
+	auto isFirstResult = true;
+
+	for (const auto& result : results.results)
+	{
+		// Shares may have changed since the index last saw the folder
+		if (result.isDirectory ? !SharedFiles::IsFolderVisible(result.path) : !SharedFiles::IsFileShared(result.path))
+		{
+			continue;
+		}
+
+		if (!isFirstResult)
+		{
+			data += ',';
+		}
+
+		AppendResult(data, result);
+		isFirstResult = false;
+
+		if (++resultsInWrite == kResultsPerWrite)
+		{
+			if (!stream.Send(pendingHeader, data, false))
+			{
+				return;
+			}
+
+			pendingHeader.clear();
+			data.clear();
+			resultsInWrite = 0;
+		}
+	}
+
+	data += "]}";
+	stream.Send(pendingHeader, data, true);
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "Http\RequestContext.h"
+
+// Shared files and folders whose names match a query, as JSON, for requests like /search?q=report or /search?prefix=IMG_
+namespace SearchResponseHandler
+{
+	void ExecuteRequest(SOCKET clientSocket, const std::string& queryString, const std::string& httpVersion, Http::RequestContext& context);
+};
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "PrecompiledHeader.h"
+#include "FolderSizes.h"
+#include "MetadataIndex.h"
+#include "SearchIndex.h"
+#include "ShareWatchers.h"
+#include "Utilities\CriticalSection.h"
+#include "Utilities\FileSystemProvider.h"
+
+using namespace std;
+using namespace Utilities;
+
+typedef unique_ptr<FileSystemProvider::ChangeWatcher> Watcher;
+
+static CriticalSection s_CriticalSection;
+static vector<Watcher> s_Watchers;
+
+// A changed entry invalidates the directory it's in, along with the folder sizes it adds up into
+static void OnChange(const string& folderPath, const wstring& changedPath)
+{
+	if (changedPath.empty())
+	{
+		MetadataIndex::InvalidateFolder(folderPath);
+		FolderSizes::Clear();
+		SearchIndex::Rescan(folderPath);
+		return;
+	}
+
+	auto directoryPath = FileSystem::RemoveLastPathComponent(Encoding::Utf16ToUtf8(changedPath));
+	MetadataIndex::Invalidate(directoryPath);
+	FolderSizes::Invalidate(directoryPath);
+	SearchIndex::Invalidate(directoryPath);
+}
+
+static vector<Watcher> CreateWatchers(const vector<string>& fullySharedFolders, const vector<string>& partiallySharedFolders)
+{
+	vector<Watcher> watchers;
+	auto& provider = FileSystemProvider::GetCurrent();
+
+	auto watch = [&watchers, &provider](const string& folderPath, bool watchSubtree)
+	{
+		auto watcher = provider.WatchChanges(Encoding::Utf8ToUtf16(folderPath), watchSubtree, [folderPath](const wstring& changedPath)
+		{
+			OnChange(folderPath, changedPath);
+		});
+
+		if (watcher != nullptr)
+		{
+			watchers.push_back(std::move(watcher));
+		}
+	};
+
+	for (const auto& folderPath : fullySharedFolders)
+	{
+		watch(folderPath, true);
+	}
+
+	for (const auto& folderPath : partiallySharedFolders)
+	{
+		watch(folderPath, false);
+	}
+
+	return watchers;
+}
+
+// Destroying a watcher waits for its callback, so old watchers go only after the lock is released
+static void ReplaceWatchers(vector<Watcher>&& watchers)
+{
+	vector<Watcher> oldWatchers;
+
+	CriticalSection::Lock lock(s_CriticalSection);
+	oldWatchers.swap(s_Watchers);
+	s_Watchers = std::move(watchers);
+}
+
+void ShareWatchers::SetSharedFolders(const vector<string>& fullySharedFolders, const vector<string>& partiallySharedFolders)
+{
+	ReplaceWatchers(CreateWatchers(fullySharedFolders, partiallySharedFolders));
+}
+
+void ShareWatchers::Shutdown()
+{
+	ReplaceWatchers(vector<Watcher>());
+}
\ No newline at end of file
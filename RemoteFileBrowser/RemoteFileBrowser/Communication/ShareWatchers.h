@@ -0,0 +1,10 @@
+#pragma once
+
+// Change notifications on the shared folders, which keep what's cached about them in step with the disk. Fully shared
+// folders are watched with their subfolders, partially shared ones only by themselves
+
+namespace ShareWatchers
+{
+	void SetSharedFolders(const std::vector<std::string>& fullySharedFolders, const std::vector<std::string>& partiallySharedFolders);
+	void Shutdown();
+};
\ No newline at end of file
@@ -1,6 +1,13 @@
 #include "PrecompiledHeader.h"
+#include "FolderSizes.h"
+#include "MetadataIndex.h"
+#include "NegativeLookupCache.h"
+#include "SearchIndex.h"
+#include "ShareWatchers.h"
 #include "SharedFiles.h"
 #include "Utilities\CriticalSection.h"
+#include "Utilities\Metrics.h"
+#include "Utilities\Tracing.h"
 
 static SharedFiles::FileSet s_FullySharedFolders;
 static SharedFiles::FileSet s_PartiallySharedFolders;
@@ -14,6 +21,14 @@ void SharedFiles::SetSharedFiles(FileSet&& fullySharedFolders, FileSet&& partial
 	s_FullySharedFolders = fullySharedFolders;
 	s_PartiallySharedFolders = partiallySharedFolders;
 	s_Files = files;
+
+	NegativeLookupCache::Clear();
+	FolderSizes::Clear();
+
+	std::vector<std::string> fullySharedFolderList(s_FullySharedFolders.begin(), s_FullySharedFolders.end());
+	std::vector<std::string> partiallySharedFolderList(s_PartiallySharedFolders.begin(), s_PartiallySharedFolders.end());
+	ShareWatchers::SetSharedFolders(fullySharedFolderList, partiallySharedFolderList);
+	SearchIndex::SetSharedFolders(std::move(fullySharedFolderList), std::move(partiallySharedFolderList));
 }
 
 namespace NoLock
@@ -57,41 +72,71 @@ namespace NoLock
 
 	static inline void FilterFolderContents(const std::string& basePath, std::vector<Utilities::FileSystem::FileInfo>& folderContents)
 	{
+		TRACE_SCOPE("SharedFiles::FilterFolderContents");
 		using namespace Utilities::FileSystem;
 
-		Utilities::Algorithms::FilterVector(folderContents, [&basePath](const FileInfo& fileInfo)
+		// Keeps the order, since the contents come sorted
+		auto isHidden = [&basePath](const FileInfo& fileInfo)
 		{
 			if (fileInfo.fileStatus == FileStatus::Directory)
-				return IsFolderVisible(CombinePaths(basePath, fileInfo.fileName));
+				return !IsFolderVisible(CombinePaths(basePath, fileInfo.fileName));
 		
-			return IsFileShared(CombinePaths(basePath, fileInfo.fileName));
-		});
+			return !IsFileShared(CombinePaths(basePath, fileInfo.fileName));
+		};
+
+		folderContents.erase(std::remove_if(folderContents.begin(), folderContents.end(), isHidden), folderContents.end());
 	}
 }
 
 bool SharedFiles::IsFileShared(const std::string& path)
 {
+	Metrics::Increment(Metrics::Counter::SharedFileLookups);
 	CriticalSection::Lock lock(s_CriticalSection);
 	return NoLock::IsFileShared(path);
 }
 
 bool SharedFiles::IsFolderVisible(const std::string& path)
 {
+	Metrics::Increment(Metrics::Counter::SharedFolderLookups);
 	CriticalSection::Lock lock(s_CriticalSection);
 	return NoLock::IsFolderVisible(path);
 }
 
-std::vector<Utilities::FileSystem::FileInfo> SharedFiles::GetFolderContents(const std::string& path)
+std::vector<Utilities::FileSystem::FileInfo> SharedFiles::GetFolderContents(const std::string& path, const CancellationToken& cancellationToken)
 {
 	using namespace Utilities::FileSystem;
-	CriticalSection::Lock lock(s_CriticalSection);
+	std::vector<FileInfo> folderContents;
+	auto widePath = Utilities::Encoding::Utf8ToUtf16(path);
+
+	// The index is checked against the last write time from before enumerating, so changes made meanwhile fail the next check
+	uint64_t lastWriteTime;
+	auto isIndexed = MetadataIndex::IsOpen() && QueryLastWriteTime(widePath, lastWriteTime);
+	DWORD enumerationError = ERROR_SUCCESS;
+
+	// Enumerating doesn't touch the share sets, and folder size walks enumerate from many threads at once
+	if (!isIndexed || !MetadataIndex::Find(path, lastWriteTime, folderContents))
+	{
+		{
+			Metrics::ScopedTimer enumerationTimer(Metrics::Histogram::EnumerationDuration);
+			folderContents = EnumerateFiles(widePath, cancellationToken);
+			enumerationError = folderContents.empty() ? GetLastError() : ERROR_SUCCESS;
+		}
 
-	auto folderContents = EnumerateFiles(Utilities::Encoding::Utf8ToUtf16(path));
+		SortFiles(folderContents);
+
+		if (isIndexed && enumerationError == ERROR_SUCCESS && !cancellationToken.IsCancelled())
+			MetadataIndex::Store(path, lastWriteTime, folderContents);
+	}
 
-	if (!NoLock::IsFolderFullyShared(path))
-		NoLock::FilterFolderContents(path, folderContents);
+	{
+		CriticalSection::Lock lock(s_CriticalSection);
+
+		if (!NoLock::IsFolderFullyShared(path))
+			NoLock::FilterFolderContents(path, folderContents);
+	}
 
-	SortFiles(folderContents);
+	// Listings tell an empty folder from one that couldn't be enumerated by the last error
+	SetLastError(enumerationError);
 	return folderContents;
 }
 
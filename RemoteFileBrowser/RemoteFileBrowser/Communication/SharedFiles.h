@@ -7,7 +7,7 @@ namespace SharedFiles
 	void SetSharedFiles(FileSet&& fullySharedFolders, FileSet&& partiallySharedFolders, FileSet&& files);
 	bool IsFileShared(const std::string& path);
 	bool IsFolderVisible(const std::string& path);
-	std::vector<Utilities::FileSystem::FileInfo> GetFolderContents(const std::string& path);
+	std::vector<Utilities::FileSystem::FileInfo> GetFolderContents(const std::string& path, const CancellationToken& cancellationToken = CancellationToken::None());
 	std::vector<std::string> GetVolumes();
 };
 
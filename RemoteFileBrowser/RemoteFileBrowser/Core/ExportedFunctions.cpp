@@ -1,9 +1,17 @@
 #include "PrecompiledHeader.h"
-#include "Communication\FileBrowserResponseHandler.h"
+#include "Communication\FolderSizes.h"
+#include "Communication\MetadataIndex.h"
+#include "Communication\RequestRouter.h"
+#include "Communication\SearchIndex.h"
 #include "Communication\SharedFiles.h"
 #include "Http\Server.h"
 #include "Tcp\Listener.h"
+#include "Utilities\BandwidthShaper.h"
+#include "Utilities\FileCache.h"
 #include "Utilities\Initializer.h"
+#include "Utilities\ReadaheadRing.h"
+#include "Utilities\StreamableFile.h"
+#include "Utilities\Tracing.h"
 
 #define EXPORT extern "C" __declspec(dllexport)
 
@@ -167,9 +175,32 @@ EXPORT void __stdcall SetSharedFiles(const SharedFilesInterop& sharedFiles)
 	SharedFiles::SetSharedFiles(std::move(fullySharedFolders), std::move(partiallySharedFolders), std::move(files));
 }
 
+static Http::RequestScheduler::Settings s_RequestSchedulerSettings;
+
+// Only takes effect if called before the first StartSharingFiles
+EXPORT void __stdcall SetRequestSchedulerLimits(int interactiveWorkerCount, int interactiveQueueDepth, int bulkWorkerCount, int bulkQueueDepth)
+{
+	auto& interactive = s_RequestSchedulerSettings.lanes[static_cast<int>(Http::RequestLane::Interactive)];
+	interactive.workerCount = interactiveWorkerCount;
+	interactive.queueDepth = interactiveQueueDepth;
+
+	auto& bulk = s_RequestSchedulerSettings.lanes[static_cast<int>(Http::RequestLane::Bulk)];
+	bulk.workerCount = bulkWorkerCount;
+	bulk.queueDepth = bulkQueueDepth;
+}
+
+// Only takes effect if called before the first StartSharingFiles. A minimum send rate of 0 turns that check off
+EXPORT void __stdcall SetConnectionTimeouts(int headerTimeoutSeconds, int idleTimeoutSeconds, int minSendRate, int sendRateWindowSeconds)
+{
+	s_RequestSchedulerSettings.headerTimeoutSeconds = headerTimeoutSeconds;
+	s_RequestSchedulerSettings.idleTimeoutSeconds = idleTimeoutSeconds;
+	s_RequestSchedulerSettings.minSendRate = minSendRate;
+	s_RequestSchedulerSettings.sendRateWindowSeconds = sendRateWindowSeconds;
+}
+
 static void InitializeLazy()
 {
-	static Initializer initializerContext;
+	static Initializer initializerContext(s_RequestSchedulerSettings);
 }
 
 EXPORT Tcp::Listener* __stdcall StartSharingFiles(const SharedFilesInterop& sharedFiles)
@@ -182,7 +213,7 @@ EXPORT Tcp::Listener* __stdcall StartSharingFiles(const SharedFilesInterop& shar
 
 	listener->RunAsync(anyAddress, htons(18882), [](SOCKET incomingSocket, sockaddr_in6 clientAddress)
 	{
-		Http::Server::StartServiceClient(incomingSocket, clientAddress, &FileBrowserResponseHandler::ExecuteRequest);
+		Http::Server::StartServiceClient(incomingSocket, clientAddress, &RequestRouter::ExecuteRequest);
 	});
 
 	return listener;
@@ -193,3 +224,73 @@ EXPORT void __stdcall StopSharingFiles(Tcp::Listener*& listener)
 	delete listener;
 	listener = nullptr;
 }
+
+// Bytes per second, 0 for unlimited. Applies to downloads already in progress too
+EXPORT void __stdcall SetBandwidthLimits(uint64_t global, uint64_t perClient, uint64_t perConnection)
+{
+	BandwidthShaper::Limits limits;
+	limits.global = global;
+	limits.perClient = perClient;
+	limits.perConnection = perConnection;
+	BandwidthShaper::SetLimits(limits);
+}
+
+// A memory budget of 0 turns the file cache off. Lowering it evicts right away
+EXPORT void __stdcall SetFileCacheLimits(uint64_t memoryBudget, uint64_t maxFileSize, int minRequestCount)
+{
+	FileCache::Settings settings;
+	settings.memoryBudget = memoryBudget;
+	settings.maxFileSize = maxFileSize;
+	settings.minRequestCount = minRequestCount;
+	FileCache::SetSettings(settings);
+}
+
+// Downloads of files at least this big bypass the file system cache, so they don't evict the rest of it. 0 turns that off
+EXPORT void __stdcall SetUnbufferedStreamingThreshold(uint64_t minFileSize)
+{
+	StreamableFile::SetMinUnbufferedFileSize(minFileSize);
+}
+
+// How many reads of upcoming ranges a download may have in flight at once, for storage with high latency per read.
+// Downloads start with one and add more while that raises their throughput. 1 turns parallel reads off
+EXPORT void __stdcall SetMaxParallelReads(int maxReads)
+{
+	ReadaheadRing::SetMaxReaders(static_cast<uint32_t>(max(maxReads, 1)));
+}
+
+// Whether listings walk the folders they show to fill in their sizes. Sizes already known are shown either way
+EXPORT void __stdcall SetFolderSizesInListings(bool enabled)
+{
+	FolderSizes::SetBackgroundWalksEnabled(enabled);
+}
+
+// File that keeps the contents of shared directories across restarts, so listings don't wait for the disk after one.
+// Null or empty turns the index off. What changed is written to the file when the index is turned off or the server stops
+EXPORT void __stdcall SetMetadataIndexPath(const wchar_t* indexPath)
+{
+	if (indexPath == nullptr || *indexPath == L'\0')
+	{
+		MetadataIndex::Close();
+	}
+	else
+	{
+		MetadataIndex::Open(indexPath);
+	}
+}
+
+// Whether shared folders are crawled into an in-memory index of their names, which /search queries. On by default.
+// Turning it off frees the index, and turning it back on crawls the shared folders again
+EXPORT void __stdcall SetSearchIndexEnabled(bool enabled)
+{
+	SearchIndex::SetEnabled(enabled);
+}
+
+EXPORT void __stdcall SetTracingEnabled(bool enabled)
+{
+	Tracing::SetEnabled(enabled);
+}
+
+EXPORT bool __stdcall DumpTrace(const wchar_t* path)
+{
+	return Tracing::DumpToFile(path);
+}
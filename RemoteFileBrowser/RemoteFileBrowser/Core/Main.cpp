@@ -1,6 +1,6 @@
 #include "PrecompiledHeader.h"
 #include "Communication\ClientServerConnection.h"
-#include "Communication\FileBrowserResponseHandler.h"
+#include "Communication\RequestRouter.h"
 #include "Http\Server.h"
 #include "Tcp\Client.h"
 #include "Tcp\Listener.h"
@@ -18,7 +18,7 @@ int CALLBACK wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmd
 
 	listener.RunAsync(INADDR_ANY, htons(18882), [](SOCKET incomingSocket, sockaddr_in clientAddress)
 	{
-		Http::Server::StartServiceClient(incomingSocket, clientAddress, &FileBrowserResponseHandler::ExecuteRequest);
+		Http::Server::StartServiceClient(incomingSocket, clientAddress, &RequestRouter::ExecuteRequest);
 	});
 
 	// Wait indefinitely
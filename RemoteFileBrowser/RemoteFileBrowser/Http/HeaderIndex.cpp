@@ -0,0 +1,233 @@
+#include "PrecompiledHeader.h"
+#include "HeaderIndex.h"
+#include "Utilities\Escaping.h"
+
+using namespace std;
+using namespace Http;
+using namespace Utilities;
+
+static const StringView kKnownHeaderNames[static_cast<int>(KnownHeader::Count)] =
+{
+	"Accept",
+	"Accept-Encoding",
+	"Accept-Language",
+	"Authorization",
+	"Cache-Control",
+	"Connection",
+	"Content-Length",
+	"Content-Type",
+	"Cookie",
+	"Host",
+	"If-Modified-Since",
+	"If-None-Match",
+	"If-Range",
+	"Range",
+	"Referer",
+	"Transfer-Encoding",
+	"Upgrade-Insecure-Requests",
+	"User-Agent"
+};
+
+// The hash mixes the length with the second and the second to last characters, lowercased, and has no collisions
+// between the names above. Adding a name means searching for new multipliers (or a bigger table) that keep it that way
+static const int kKnownHeaderSlotCount = 32;
+
+static const KnownHeader kKnownHeaderSlots[kKnownHeaderSlotCount] =
+{
+	KnownHeader::AcceptEncoding, KnownHeader::UpgradeInsecureRequests, KnownHeader::Unknown, KnownHeader::TransferEncoding,
+	KnownHeader::IfRange, KnownHeader::Cookie, KnownHeader::Unknown, KnownHeader::ContentLength,
+	KnownHeader::Unknown, KnownHeader::Unknown, KnownHeader::Unknown, KnownHeader::UserAgent,
+	KnownHeader::Unknown, KnownHeader::ContentType, KnownHeader::CacheControl, KnownHeader::Host,
+	KnownHeader::Unknown, KnownHeader::IfNoneMatch, KnownHeader::Unknown, KnownHeader::Accept,
+	KnownHeader::Unknown, KnownHeader::IfModifiedSince, KnownHeader::Range, KnownHeader::Unknown,
+	KnownHeader::Referer, KnownHeader::Unknown, KnownHeader::Authorization, KnownHeader::Unknown,
+	KnownHeader::Unknown, KnownHeader::Connection, KnownHeader::AcceptLanguage, KnownHeader::Unknown
+};
+
+static inline size_t HashHeaderName(StringView name)
+{
+	Assert(name.length() >= 2);
+	auto second = static_cast<uint8_t>(name[1]) | 0x20;
+	auto secondToLast = static_cast<uint8_t>(name[name.length() - 2]) | 0x20;
+	return (name.length() + second * 15 + secondToLast * 14) % kKnownHeaderSlotCount;
+}
+
+static inline bool IsWhitespace(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+static inline StringView Trim(const char* start, const char* end)
+{
+	while (start < end && IsWhitespace(*start))
+	{
+		start++;
+	}
+
+	while (end > start && IsWhitespace(end[-1]))
+	{
+		end--;
+	}
+
+	return StringView(start, end - start);
+}
+
+// Lines are found with memchr, which the CRT already vectorizes. Values often contain ':' (host ports, URLs),
+// so only the field names, which must end at a ':' before the line does, go through the delimiter scanner
+static inline size_t FindLineFeed(const char* data, size_t length, size_t position)
+{
+	auto found = static_cast<const char*>(memchr(data + position, '\n', length - position));
+	return found != nullptr ? static_cast<size_t>(found - data) : length;
+}
+
+HeaderIndex::HeaderIndex() :
+	m_FieldCount(0), m_HeaderLength(0)
+{
+	fill(begin(m_KnownFieldIndices), end(m_KnownFieldIndices), -1);
+}
+
+bool HeaderIndex::Parse(const char* data, size_t length)
+{
+	m_FieldCount = 0;
+	m_HeaderLength = 0;
+	fill(begin(m_KnownFieldIndices), end(m_KnownFieldIndices), -1);
+
+	auto requestLineEnd = FindLineFeed(data, length, 0);
+	m_RequestLine = Trim(data, data + requestLineEnd);
+
+	auto position = requestLineEnd + 1;
+
+	while (position < length)
+	{
+		// An empty line ends the header
+		if (data[position] == '\n' || (data[position] == '\r' && position + 1 < length && data[position + 1] == '\n'))
+		{
+			m_HeaderLength = position + (data[position] == '\r' ? 2 : 1);
+			return true;
+		}
+
+		auto nameEnd = position + Escaping::FindHeaderDelimiter(data + position, length - position);
+
+		if (nameEnd == length || data[nameEnd] != ':' || nameEnd == position)
+		{
+			return false;
+		}
+
+		auto lineEnd = FindLineFeed(data, length, nameEnd + 1);
+
+		if (lineEnd == length || m_FieldCount == kMaxFieldCount)
+		{
+			return false;
+		}
+
+		auto& field = m_Fields[m_FieldCount];
+		field.name = StringView(data + position, nameEnd - position);
+		field.value = Trim(data + nameEnd + 1, data + lineEnd);
+		field.knownHeader = LookupKnownHeader(field.name);
+
+		if (field.knownHeader != KnownHeader::Unknown && m_KnownFieldIndices[static_cast<int>(field.knownHeader)] < 0)
+		{
+			m_KnownFieldIndices[static_cast<int>(field.knownHeader)] = m_FieldCount;
+		}
+
+		m_FieldCount++;
+		position = lineEnd + 1;
+	}
+
+	return false;
+}
+
+StringView HeaderIndex::Find(KnownHeader knownHeader) const
+{
+	Assert(knownHeader != KnownHeader::Unknown);
+	auto index = m_KnownFieldIndices[static_cast<int>(knownHeader)];
+	return index >= 0 ? m_Fields[index].value : StringView();
+}
+
+KnownHeader HeaderIndex::LookupKnownHeader(StringView name)
+{
+	if (name.length() < 2)
+	{
+		return KnownHeader::Unknown;
+	}
+
+	auto knownHeader = kKnownHeaderSlots[HashHeaderName(name)];
+
+	if (knownHeader == KnownHeader::Unknown || !name.EqualsIgnoreCase(kKnownHeaderNames[static_cast<int>(knownHeader)]))
+	{
+		return KnownHeader::Unknown;
+	}
+
+	return knownHeader;
+}
+
+StringView HeaderIndex::GetName(KnownHeader knownHeader)
+{
+	Assert(knownHeader != KnownHeader::Unknown);
+	return kKnownHeaderNames[static_cast<int>(knownHeader)];
+}
+
+// Any quality made of nothing but zeros, like "0" or "0.000"
+static bool IsZeroQuality(StringView parameters)
+{
+	auto position = parameters.find('=');
+	auto name = Trim(parameters.data(), parameters.data() + (position != StringView::npos ? position : parameters.length()));
+
+	if (position == StringView::npos || !name.EqualsIgnoreCase("q"))
+	{
+		return false;
+	}
+
+	auto value = Trim(parameters.data() + position + 1, parameters.data() + parameters.length());
+
+	if (value.empty() || value[0] != '0')
+	{
+		return false;
+	}
+
+	for (size_t i = 1; i < value.length(); i++)
+	{
+		if (value[i] != '0' && value[i] != '.')
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool HeaderIndex::AcceptsEncoding(StringView acceptEncoding, StringView coding)
+{
+	auto isWildcardAccepted = false;
+	size_t position = 0;
+
+	while (position < acceptEncoding.length())
+	{
+		auto elementEnd = acceptEncoding.find(',', position);
+
+		if (elementEnd == StringView::npos)
+		{
+			elementEnd = acceptEncoding.length();
+		}
+
+		auto element = acceptEncoding.substr(position, elementEnd - position);
+		auto parametersStart = element.find(';');
+		auto name = Trim(element.data(), element.data() + (parametersStart != StringView::npos ? parametersStart : element.length()));
+		auto isAccepted = parametersStart == StringView::npos || !IsZeroQuality(element.substr(parametersStart + 1));
+
+		// Naming the coding overrides the wildcard either way
+		if (name.EqualsIgnoreCase(coding))
+		{
+			return isAccepted;
+		}
+
+		if (name == "*")
+		{
+			isWildcardAccepted = isAccepted;
+		}
+
+		position = elementEnd + 1;
+	}
+
+	return isWildcardAccepted;
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Utilities\StringView.h"
+
+namespace Http
+{
+	// Header fields we look up by name. Matching is case-insensitive, through a perfect hash in HeaderIndex.cpp
+	enum class KnownHeader
+	{
+		Accept,
+		AcceptEncoding,
+		AcceptLanguage,
+		Authorization,
+		CacheControl,
+		Connection,
+		ContentLength,
+		ContentType,
+		Cookie,
+		Host,
+		IfModifiedSince,
+		IfNoneMatch,
+		IfRange,
+		Range,
+		Referer,
+		TransferEncoding,
+		UpgradeInsecureRequests,
+		UserAgent,
+		Count,
+		Unknown = Count
+	};
+
+	struct HeaderField
+	{
+		Utilities::StringView name;
+		Utilities::StringView value;	// Without surrounding whitespace
+		KnownHeader knownHeader;
+	};
+
+	// Splits a received request header into its request line and fields without copying anything:
+	// every view points into the buffer passed to Parse, which has to outlive the index.
+	// Lines may end with either CRLF or a bare LF.
+	class HeaderIndex
+	{
+	public:
+		static const int kMaxFieldCount = 64;
+
+	private:
+		Utilities::StringView m_RequestLine;
+		HeaderField m_Fields[kMaxFieldCount];
+		int m_FieldCount;
+		int m_KnownFieldIndices[static_cast<int>(KnownHeader::Count)];
+		size_t m_HeaderLength;
+
+	public:
+		HeaderIndex();
+
+		HeaderIndex(const HeaderIndex&) = delete;
+		HeaderIndex& operator=(const HeaderIndex&) = delete;
+
+		// Returns whether data holds a whole well-formed header. If it doesn't, whatever was indexed
+		// before the end of data or the first malformed line is still available
+		bool Parse(const char* data, size_t length);
+
+		inline Utilities::StringView GetRequestLine() const { return m_RequestLine; }
+		inline int GetFieldCount() const { return m_FieldCount; }
+		inline const HeaderField& GetField(int index) const { Assert(index < m_FieldCount); return m_Fields[index]; }
+
+		// Value of the first field with that name, empty if there's none
+		Utilities::StringView Find(KnownHeader knownHeader) const;
+		inline bool Has(KnownHeader knownHeader) const { return m_KnownFieldIndices[static_cast<int>(knownHeader)] >= 0; }
+
+		// Length up to and including the empty line ending the header, which is where the body starts. 0 until Parse succeeds
+		inline size_t GetHeaderLength() const { return m_HeaderLength; }
+
+		static KnownHeader LookupKnownHeader(Utilities::StringView name);
+		static Utilities::StringView GetName(KnownHeader knownHeader);
+
+		// Whether an Accept-Encoding value allows a content coding: named, or covered by "*", and not with q=0
+		static bool AcceptsEncoding(Utilities::StringView acceptEncoding, Utilities::StringView coding);
+	};
+}
\ No newline at end of file
@@ -1,128 +1,99 @@
 #include "PrecompiledHeader.h"
 #include "Request.h"
+#include "HeaderIndex.h"
 
 using namespace Http;
+using namespace Utilities;
 
 class RequestParser
 {
 private:
 	static const int kBufferLength = 1280;
 	char (&m_Buffer)[kBufferLength];
-	int m_BufferPosition = 0;
+	HeaderIndex m_Header;
 	Request m_Request;
 	int m_BytesReceived;
 	int m_ContentLength = -1;
 
-	inline int FindNextCharacter(char character, int position)
-	{
-		while (position < m_BytesReceived - 1)
-		{
-			if (m_Buffer[position] == character)
-			{
-				return position;
-			}
-
-			position++;
-		}
-
-		return position;
-	}
-
 	RequestParser(char (&buffer)[kBufferLength]) :
 		m_Buffer(buffer)
 	{
 	}
 
 	// <Verb> <Path> <HTTPVERSION>
-	inline bool ParseFirstHeaderLine()
+	inline bool ParseRequestLine()
 	{
-		m_BufferPosition = FindNextCharacter(' ', m_BufferPosition) + 1;
+		auto requestLine = m_Header.GetRequestLine();
+		auto pathStart = requestLine.find(' ');
 
-		if (m_BufferPosition == m_BytesReceived)
+		if (pathStart == StringView::npos)
 			return false;
 
-		if (strncmp(m_Buffer, "POST", 4) == 0)
+		auto verb = requestLine.substr(0, pathStart);
+
+		if (verb == "POST")
 		{
 			m_Request.requestVerb = RequestVerb::POST;
 		}
-		else if (strncmp(m_Buffer, "GET", 3) == 0)
+		else if (verb == "GET")
 		{
 			m_Request.requestVerb = RequestVerb::GET;
 		}
 		else
 		{
-			m_Buffer[m_BufferPosition - 1] = '\0';
-			Utilities::Logging::Log("[ERROR] Unknown HTTP request verb: ", static_cast<char*>(m_Buffer));
+			Utilities::Logging::Log("[ERROR] Unknown HTTP request verb: ", verb.ToString());
 			return false;
 		}
 
-		auto spacePosition = FindNextCharacter(' ', m_BufferPosition);
-		
-		if (spacePosition == m_BytesReceived)
-			return false;
+		auto pathEnd = requestLine.find(' ', pathStart + 1);
 
-		m_Request.requestPath.assign(m_Buffer + m_BufferPosition, m_Buffer + spacePosition);
-		m_BufferPosition = FindNextCharacter('\n', spacePosition + 1) + 1;
+		if (pathEnd == StringView::npos)
+			return false;
 
+		m_Request.requestPath = requestLine.substr(pathStart + 1, pathEnd - pathStart - 1).ToString();
 		return true;
 	}
 
-	inline bool ParseHeaderLine()
+	inline bool ParseHeaderFields()
 	{
-		auto semicolonPosition = FindNextCharacter(':', m_BufferPosition);
+		m_ContentLength = atoi(m_Header.Find(KnownHeader::ContentLength).ToString().c_str());
 
-		if (semicolonPosition > m_BytesReceived - 2)
+		if (m_ContentLength < 1)
 			return false;
 
-		auto newLinePosition = FindNextCharacter('\n', semicolonPosition + 1);
-
-		if (newLinePosition - semicolonPosition < 3)
-			return false;
+		auto contentType = m_Header.Find(KnownHeader::ContentType);
 
-		if (strncmp(m_Buffer + m_BufferPosition, "content-length", semicolonPosition - m_BufferPosition) == 0)
+		if (contentType == "text/html")
 		{
-			m_ContentLength = atoi(m_Buffer + semicolonPosition + 2);
-			if (m_ContentLength < 1)
-				return false;
+			m_Request.contentType = ContentType::HTML;
 		}
-		else if (strncmp(m_Buffer + m_BufferPosition, "content-type", semicolonPosition - m_BufferPosition) == 0)
+		else if (contentType == "application/json")
 		{
-			if (strncmp(m_Buffer + semicolonPosition + 2, "text/html", newLinePosition - semicolonPosition - 2) == 0)
-			{
-				m_Request.contentType = ContentType::HTML;
-			}
-			else if (strncmp(m_Buffer + semicolonPosition + 2, "application/json", newLinePosition - semicolonPosition - 2) == 0)
-			{
-				m_Request.contentType = ContentType::JSON;
-			}
-			else
-			{
-				m_Buffer[newLinePosition] = '\0';
-				Utilities::Logging::Log("[ERROR] Unknown http request content type: ", m_Buffer + semicolonPosition + 2);
-				return false;
-			}
+			m_Request.contentType = ContentType::JSON;
 		}
-		else if (strncmp(m_Buffer + m_BufferPosition, "hostname", semicolonPosition - m_BufferPosition) == 0)
+		else if (!contentType.empty())
 		{
-			m_Request.hostname.assign(m_Buffer + semicolonPosition + 2, m_Buffer + newLinePosition);
+			Utilities::Logging::Log("[ERROR] Unknown http request content type: ", contentType.ToString());
+			return false;
 		}
 
-		m_BufferPosition = newLinePosition + 1;
+		m_Request.hostname = m_Header.Find(KnownHeader::Host).ToString();
 		return true;
 	}
 
 	inline void ParseBody(SOCKET s)
 	{
+		auto bodyPosition = static_cast<int>(m_Header.GetHeaderLength());
 		m_Request.content.resize(m_ContentLength);
 
-		auto bytesLeft = m_BytesReceived - m_BufferPosition;
+		auto bytesLeft = m_BytesReceived - bodyPosition;
 		if (bytesLeft >= m_ContentLength)
 		{
-			memcpy(&m_Request.content[0], m_Buffer + m_BufferPosition, m_ContentLength);
+			memcpy(&m_Request.content[0], m_Buffer + bodyPosition, m_ContentLength);
 			return;
 		}
 
-		memcpy(&m_Request.content[0], m_Buffer + m_BufferPosition, bytesLeft);
+		memcpy(&m_Request.content[0], m_Buffer + bodyPosition, bytesLeft);
 		bytesLeft = m_ContentLength - bytesLeft;
 
 		do
@@ -137,25 +108,13 @@ private:
 	{
 		m_BytesReceived = recv(s, m_Buffer, kBufferLength, 0);
 		
-		if (m_BytesReceived < 1 || !ParseFirstHeaderLine())
+		if (m_BytesReceived < 1 || !m_Header.Parse(m_Buffer, m_BytesReceived) || !ParseRequestLine() || !ParseHeaderFields())
 		{
-			goto fail;
-		}
-
-		while (m_Buffer[m_BufferPosition] != '\n')
-		{
-			if (!ParseHeaderLine())
-			{
-				goto fail;
-			}
+			m_Request = Request();
+			return;
 		}
 
-		m_BufferPosition++;
 		ParseBody(s);
-		return;
-
-	fail:
-		m_Request = Request();
 	}
 
 public:
@@ -0,0 +1,21 @@
+#pragma once
+
+namespace Http
+{
+	// What a connection shares with the handler executing its request
+	struct RequestContext
+	{
+		CancellationToken cancellationToken;	// Cancelled once the client is gone or too slow
+		std::atomic<uint64_t> bytesSent;		// Response bytes handed to the socket, for the minimum send rate
+		bool isNoDelaySet;						// TCP_NODELAY state of the socket, see ResponseWriter
+		bool acceptsGzip;						// Whether the current request's Accept-Encoding allows gzip
+
+		inline RequestContext() :
+			bytesSent(0), isNoDelaySet(false), acceptsGzip(false)
+		{
+		}
+
+		RequestContext(const RequestContext&) = delete;
+		RequestContext& operator=(const RequestContext&) = delete;
+	};
+}
\ No newline at end of file
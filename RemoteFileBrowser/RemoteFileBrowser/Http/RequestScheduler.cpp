@@ -0,0 +1,543 @@
+#include "PrecompiledHeader.h"
+#include "RequestScheduler.h"
+#include "Server.h"
+#include "Utilities\Metrics.h"
+#include "Utilities\TimerWheel.h"
+
+using namespace std;
+using namespace Http;
+using namespace Utilities;
+
+static const int kLaneCount = static_cast<int>(RequestLane::Count);
+static const int kPollIntervalMilliseconds = 16;
+static const uint64_t kTimerTickMicroseconds = kPollIntervalMilliseconds * 1000;
+
+static const Metrics::Counter kShedRequestCounters[kLaneCount] = { Metrics::Counter::ShedInteractiveRequests, Metrics::Counter::ShedBulkRequests };
+static const Metrics::Gauge kQueuedRequestGauges[kLaneCount] = { Metrics::Gauge::QueuedInteractiveRequests, Metrics::Gauge::QueuedBulkRequests };
+static const Metrics::Histogram kQueueTimeHistograms[kLaneCount] = { Metrics::Histogram::InteractiveQueueTime, Metrics::Histogram::BulkQueueTime };
+
+enum class ConnectionState
+{
+	Idle,		// Waiting for a request to start
+	Receiving,	// Part of a request header has arrived
+	Busy		// Its request is queued or executing
+};
+
+// The dispatcher's side of a connection, whose timer is the deadline of its current state.
+// Workers only use the server while its request is queued or executing, everything else belongs to the dispatcher thread.
+// It's also the only one to destroy connections, so they can't go away while it polls them or their timers fire
+struct ScheduledConnection : TimerWheel::Timer
+{
+	unique_ptr<Server> server;
+	ConnectionState state;
+	size_t index;						// In s_Connections
+	bool isWatched;						// Polled for a hang up while busy
+	uint64_t bytesSentBeforeRequest;
+	uint64_t bytesSentAtCheck;			// As of the last send rate check
+
+	ScheduledConnection(unique_ptr<Server>&& server, size_t index) :
+		server(std::move(server)), state(ConnectionState::Idle), index(index), isWatched(false), bytesSentBeforeRequest(0), bytesSentAtCheck(0)
+	{
+	}
+};
+
+struct QueuedRequest
+{
+	ScheduledConnection* connection;
+	uint64_t enqueueTime;
+};
+
+struct Lane
+{
+	CriticalSection criticalSection;
+	deque<QueuedRequest> queue;
+	HANDLE pendingRequests;		// Semaphore counting queued requests
+	vector<thread> workers;
+};
+
+static RequestScheduler::Settings s_Settings;
+static RequestLaneClassifier s_Classifier;
+static Lane s_Lanes[kLaneCount];
+
+static volatile bool s_Running;
+static thread s_DispatcherThread;
+static vector<unique_ptr<ScheduledConnection>> s_Connections;	// Dispatcher's, only cleared after the workers stop
+static CriticalSection s_IncomingConnectionsCriticalSection;
+static vector<unique_ptr<Server>> s_IncomingConnections;
+static vector<ScheduledConnection*> s_ReturnedConnections;		// Handed back by workers
+static SOCKET s_WakeSocket = INVALID_SOCKET;					// Readable while the dispatcher has been woken up
+static atomic<bool> s_IsWakePending;
+
+RequestScheduler::Settings::Settings() :
+	retryAfterSeconds(2), headerTimeoutSeconds(10), idleTimeoutSeconds(60), minSendRate(1024), sendRateWindowSeconds(30)
+{
+	// Listings and assets are mostly CPU bound, downloads mostly wait on the disk and the network
+	auto& interactive = lanes[static_cast<int>(RequestLane::Interactive)];
+	interactive.workerCount = max(2, static_cast<int>(thread::hardware_concurrency()));
+	interactive.queueDepth = 256;
+
+	auto& bulk = lanes[static_cast<int>(RequestLane::Bulk)];
+	bulk.workerCount = 8;
+	bulk.queueDepth = 32;
+}
+
+static inline uint64_t SecondsToMicroseconds(int seconds)
+{
+	return static_cast<uint64_t>(max(0, seconds)) * 1000000;
+}
+
+// WSAPoll only takes sockets, so the dispatcher is woken up by a datagram that a loopback socket sends to itself
+static SOCKET CreateWakeSocket()
+{
+	auto wakeSocket = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+	Logging::LogFatalErrorIfFailed(wakeSocket == INVALID_SOCKET, "Failed to open the dispatcher wake up socket: ");
+
+	u_long nonBlocking = TRUE;
+	auto result = ioctlsocket(wakeSocket, FIONBIO, &nonBlocking);
+	Logging::LogFatalErrorIfFailed(result == SOCKET_ERROR, "Failed to set the dispatcher wake up socket to async mode: ");
+
+	sockaddr_in6 address;
+	ZeroMemory(&address, sizeof(address));
+	address.sin6_family = AF_INET6;
+	address.sin6_addr = in6addr_loopback;
+
+	result = ::bind(wakeSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+	Logging::LogFatalErrorIfFailed(result == SOCKET_ERROR, "Failed to bind the dispatcher wake up socket: ");
+
+	int addressLength = sizeof(address);
+	result = getsockname(wakeSocket, reinterpret_cast<sockaddr*>(&address), &addressLength);
+	Logging::LogFatalErrorIfFailed(result == SOCKET_ERROR, "Failed to get the dispatcher wake up socket address: ");
+
+	result = connect(wakeSocket, reinterpret_cast<sockaddr*>(&address), addressLength);
+	Logging::LogFatalErrorIfFailed(result == SOCKET_ERROR, "Failed to connect the dispatcher wake up socket: ");
+
+	return wakeSocket;
+}
+
+// Only the first wake up since the dispatcher last took connections sends anything
+static void WakeDispatcher()
+{
+	if (s_IsWakePending.exchange(true))
+	{
+		return;
+	}
+
+	char wakeUp = 0;
+	auto result = send(s_WakeSocket, &wakeUp, sizeof(wakeUp), 0);
+	Logging::LogErrorIfFailed(result == SOCKET_ERROR, "Failed to wake up the request dispatcher: ");
+}
+
+static bool Enqueue(RequestLane lane, ScheduledConnection* connection)
+{
+	auto laneIndex = static_cast<int>(lane);
+	auto& laneState = s_Lanes[laneIndex];
+
+	{
+		CriticalSection::Lock lock(laneState.criticalSection);
+
+		if (laneState.queue.size() >= static_cast<size_t>(s_Settings.lanes[laneIndex].queueDepth))
+		{
+			return false;
+		}
+
+		QueuedRequest request = { connection, System::GetMicroseconds() };
+		laneState.queue.push_back(request);
+	}
+
+	Metrics::Increment(kQueuedRequestGauges[laneIndex]);
+	ReleaseSemaphore(laneState.pendingRequests, 1, nullptr);
+	return true;
+}
+
+static void Shed(RequestLane lane, ScheduledConnection* connection)
+{
+	Metrics::Increment(kShedRequestCounters[static_cast<int>(lane)]);
+	connection->server->SendServiceUnavailable(s_Settings.retryAfterSeconds);
+}
+
+static void HandBack(ScheduledConnection* connection)
+{
+	{
+		CriticalSection::Lock lock(s_IncomingConnectionsCriticalSection);
+		s_ReturnedConnections.push_back(connection);
+	}
+
+	WakeDispatcher();
+}
+
+static void RunWorker(RequestLane lane)
+{
+	auto laneIndex = static_cast<int>(lane);
+	auto& laneState = s_Lanes[laneIndex];
+
+	for (;;)
+	{
+		WaitForSingleObjectEx(laneState.pendingRequests, INFINITE, FALSE);
+		QueuedRequest request;
+
+		{
+			CriticalSection::Lock lock(laneState.criticalSection);
+
+			if (laneState.queue.empty())
+			{
+				return;	// Woken up to shut down
+			}
+
+			request = laneState.queue.front();
+			laneState.queue.pop_front();
+		}
+
+		Metrics::Decrement(kQueuedRequestGauges[laneIndex]);
+		Metrics::Record(kQueueTimeHistograms[laneIndex], System::GetMicroseconds() - request.enqueueTime);
+
+		// Requests picked up while shutting down are dropped rather than started, their connections are closed with the rest
+		if (!s_Running)
+		{
+			continue;
+		}
+
+		if (lane == RequestLane::Interactive)
+		{
+			auto targetLane = s_Classifier(request.connection->server->GetRequestedPath());
+
+			if (targetLane != RequestLane::Interactive)
+			{
+				if (!Enqueue(targetLane, request.connection))
+				{
+					Shed(targetLane, request.connection);
+					HandBack(request.connection);
+				}
+
+				continue;
+			}
+		}
+
+		request.connection->server->ExecuteRequest();
+		HandBack(request.connection);
+	}
+}
+
+// Everything below runs on the dispatcher thread
+
+static void Close(ScheduledConnection* connection)
+{
+	auto index = connection->index;
+	s_Connections[index].swap(s_Connections.back());
+	s_Connections[index]->index = index;
+	s_Connections.pop_back();
+}
+
+// Everything starts in the interactive lane: the dispatcher can't afford to find out what the path points to
+static void Admit(ScheduledConnection* connection, TimerWheel& timers, uint64_t now)
+{
+	connection->state = ConnectionState::Busy;
+	connection->isWatched = true;
+	connection->bytesSentBeforeRequest = connection->bytesSentAtCheck = connection->server->GetBytesSent();
+
+	if (s_Settings.minSendRate > 0)
+	{
+		timers.Schedule(*connection, now + SecondsToMicroseconds(s_Settings.sendRateWindowSeconds));
+	}
+	else
+	{
+		connection->Cancel();
+	}
+
+	if (!Enqueue(RequestLane::Interactive, connection))
+	{
+		Shed(RequestLane::Interactive, connection);
+		Close(connection);
+	}
+}
+
+// For connections that aren't busy: starts the next request if it's already buffered, otherwise waits for it.
+// The header deadline starts with a request's first bytes, and more of them trickling in doesn't push it back
+static void Resume(ScheduledConnection* connection, TimerWheel& timers, uint64_t now)
+{
+	auto& server = *connection->server;
+
+	while (server.HasReceivedRequest())
+	{
+		if (server.ParseRequest())
+		{
+			Admit(connection, timers, now);
+			return;
+		}
+	}
+
+	if (!server.HasReceivedData())
+	{
+		connection->state = ConnectionState::Idle;
+		timers.Schedule(*connection, now + SecondsToMicroseconds(s_Settings.idleTimeoutSeconds));
+	}
+	else if (connection->state != ConnectionState::Receiving)
+	{
+		connection->state = ConnectionState::Receiving;
+		timers.Schedule(*connection, now + SecondsToMicroseconds(s_Settings.headerTimeoutSeconds));
+	}
+}
+
+// A busy connection's timer checks the send rate once per window. The window in which a response starts doesn't count,
+// and neither do requests that haven't sent anything yet, as they're still waiting for a worker or working out what to send
+static void CheckSendRate(ScheduledConnection* connection, TimerWheel& timers, uint64_t now)
+{
+	auto bytesSent = connection->server->GetBytesSent();
+	auto minBytesSent = static_cast<uint64_t>(s_Settings.minSendRate) * max(1, s_Settings.sendRateWindowSeconds);
+
+	if (connection->bytesSentAtCheck != connection->bytesSentBeforeRequest && bytesSent - connection->bytesSentAtCheck < minBytesSent)
+	{
+		Metrics::Increment(Metrics::Counter::SendRateTimeouts);
+		Logging::Log("Aborting request for \"", connection->server->GetRequestedPath(), "\": the client is receiving it too slowly.");
+
+		// The worker hands the connection back once the request stops, which closes it
+		connection->server->Abort();
+		return;
+	}
+
+	connection->bytesSentAtCheck = bytesSent;
+	timers.Schedule(*connection, now + SecondsToMicroseconds(s_Settings.sendRateWindowSeconds));
+}
+
+static void OnTimeout(ScheduledConnection* connection, TimerWheel& timers, uint64_t now)
+{
+	switch (connection->state)
+	{
+	case ConnectionState::Idle:
+		Metrics::Increment(Metrics::Counter::IdleTimeouts);
+		Close(connection);
+		break;
+
+	case ConnectionState::Receiving:
+		Metrics::Increment(Metrics::Counter::HeaderTimeouts);
+		Close(connection);
+		break;
+
+	case ConnectionState::Busy:
+		CheckSendRate(connection, timers, now);
+		break;
+	}
+}
+
+static void DrainWakeSocket()
+{
+	char buffer[64];
+
+	while (recv(s_WakeSocket, buffer, sizeof(buffer), 0) > 0)
+	{
+	}
+}
+
+static void TakeConnections(TimerWheel& timers, uint64_t now, vector<unique_ptr<Server>>& incomingConnections, vector<ScheduledConnection*>& returnedConnections)
+{
+	// Cleared before taking them, so anything added after this wakes the dispatcher up again
+	s_IsWakePending.store(false);
+
+	{
+		CriticalSection::Lock lock(s_IncomingConnectionsCriticalSection);
+		incomingConnections.swap(s_IncomingConnections);
+		returnedConnections.swap(s_ReturnedConnections);
+	}
+
+	for (auto& server : incomingConnections)
+	{
+		s_Connections.emplace_back(new ScheduledConnection(std::move(server), s_Connections.size()));
+		Resume(s_Connections.back().get(), timers, now);
+	}
+
+	for (auto connection : returnedConnections)
+	{
+		if (connection->server->IsCancelled())
+		{
+			Close(connection);
+		}
+		else
+		{
+			Resume(connection, timers, now);
+		}
+	}
+
+	incomingConnections.clear();
+	returnedConnections.clear();
+}
+
+static void RunDispatcher()
+{
+	TimerWheel timers(kTimerTickMicroseconds, System::GetMicroseconds());
+	vector<unique_ptr<Server>> incomingConnections;
+	vector<ScheduledConnection*> returnedConnections;
+	vector<ScheduledConnection*> polledConnections;
+	vector<WSAPOLLFD> pollDescriptors;
+
+	while (s_Running)
+	{
+		auto now = System::GetMicroseconds();
+		TakeConnections(timers, now, incomingConnections, returnedConnections);
+		timers.Advance(now);
+
+		while (auto timer = timers.PopExpired())
+		{
+			OnTimeout(static_cast<ScheduledConnection*>(timer), timers, now);
+		}
+
+		polledConnections.clear();
+		pollDescriptors.clear();
+
+		WSAPOLLFD wakeDescriptor = { s_WakeSocket, POLLRDNORM, 0 };
+		pollDescriptors.push_back(wakeDescriptor);
+		polledConnections.push_back(nullptr);
+
+		for (const auto& connection : s_Connections)
+		{
+			if (connection->state != ConnectionState::Busy || connection->isWatched)
+			{
+				WSAPOLLFD pollDescriptor = { connection->server->GetSocket(), POLLRDNORM, 0 };
+				pollDescriptors.push_back(pollDescriptor);
+				polledConnections.push_back(connection.get());
+			}
+		}
+
+		auto readyCount = WSAPoll(pollDescriptors.data(), static_cast<ULONG>(pollDescriptors.size()), kPollIntervalMilliseconds);
+
+		if (readyCount == SOCKET_ERROR)
+		{
+			Logging::Error(WSAGetLastError(), "Failed to poll client connections: ");
+			System::Sleep(kPollIntervalMilliseconds);
+			continue;
+		}
+
+		if (readyCount == 0)
+		{
+			continue;
+		}
+
+		now = System::GetMicroseconds();
+
+		for (size_t i = 0; i < polledConnections.size(); i++)
+		{
+			if (pollDescriptors[i].revents == 0)
+			{
+				continue;
+			}
+
+			auto connection = polledConnections[i];
+
+			// New or handed back connections are taken at the top of the loop
+			if (connection == nullptr)
+			{
+				DrainWakeSocket();
+				continue;
+			}
+
+			// Readiness on a busy connection means the client either hung up or pipelined another request.
+			// Either way there's nothing more to learn from it until the request finishes, so it stops being watched
+			if (connection->state == ConnectionState::Busy)
+			{
+				connection->isWatched = false;
+				connection->server->CheckForDisconnect();
+				continue;
+			}
+
+			// Hang ups and errors are reported as readable too, and show up as a failed receive
+			if (!connection->server->Receive())
+			{
+				Close(connection);
+				continue;
+			}
+
+			Resume(connection, timers, now);
+		}
+	}
+}
+
+void RequestScheduler::Initialize(const Settings& settings, RequestLaneClassifier classifier)
+{
+	Assert(!s_Running);
+
+	s_Settings = settings;
+	s_Classifier = classifier;
+	s_WakeSocket = CreateWakeSocket();
+	s_IsWakePending = false;
+	s_Running = true;
+
+	for (int i = 0; i < kLaneCount; i++)
+	{
+		auto& laneState = s_Lanes[i];
+		auto workerCount = max(1, settings.lanes[i].workerCount);
+
+		laneState.pendingRequests = CreateSemaphoreEx(nullptr, 0, numeric_limits<LONG>::max(), nullptr, 0, SEMAPHORE_MODIFY_STATE | SYNCHRONIZE);
+		Logging::LogFatalErrorIfFailed(laneState.pendingRequests == nullptr, "Failed to create a request queue semaphore: ");
+
+		for (int j = 0; j < workerCount; j++)
+		{
+			laneState.workers.emplace_back(&RunWorker, static_cast<RequestLane>(i));
+		}
+	}
+
+	s_DispatcherThread = thread(&RunDispatcher);
+}
+
+void RequestScheduler::Shutdown()
+{
+	if (!s_Running)
+	{
+		return;
+	}
+
+	s_Running = false;
+	WakeDispatcher();
+	s_DispatcherThread.join();
+
+	// Running requests stop early, so the workers don't have to finish whole downloads first
+	for (const auto& connection : s_Connections)
+	{
+		if (connection->state == ConnectionState::Busy)
+		{
+			connection->server->Abort();
+		}
+	}
+
+	// Interactive workers pass requests on to the bulk lane, so they have to stop first
+	for (auto& laneState : s_Lanes)
+	{
+		{
+			CriticalSection::Lock lock(laneState.criticalSection);
+			Metrics::Add(kQueuedRequestGauges[&laneState - s_Lanes], -static_cast<int64_t>(laneState.queue.size()));
+			laneState.queue.clear();
+		}
+
+		ReleaseSemaphore(laneState.pendingRequests, static_cast<LONG>(laneState.workers.size()), nullptr);
+
+		for (auto& worker : laneState.workers)
+		{
+			worker.join();
+		}
+
+		laneState.workers.clear();
+		CloseHandle(laneState.pendingRequests);
+	}
+
+	s_Connections.clear();
+
+	closesocket(s_WakeSocket);
+	s_WakeSocket = INVALID_SOCKET;
+
+	CriticalSection::Lock lock(s_IncomingConnectionsCriticalSection);
+	s_IncomingConnections.clear();
+	s_ReturnedConnections.clear();
+}
+
+void RequestScheduler::AddConnection(unique_ptr<Server> connection)
+{
+	if (!s_Running)
+	{
+		Logging::Log("Request scheduler isn't running, dropping connection.");
+		return;
+	}
+
+	{
+		CriticalSection::Lock lock(s_IncomingConnectionsCriticalSection);
+		s_IncomingConnections.push_back(std::move(connection));
+	}
+
+	WakeDispatcher();
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+namespace Http
+{
+	class Server;
+
+	// Every lane has its own queue and workers, so a handful of long downloads can't hold up listings
+	enum class RequestLane
+	{
+		Interactive,	// Listings, built-in assets and internal endpoints
+		Bulk,			// File downloads
+		Count
+	};
+
+	// Decides which lane a request belongs to. Runs on an interactive worker, so it may touch the disk
+	typedef std::function<RequestLane(const std::string&)> RequestLaneClassifier;
+
+	// Connections are owned by a single dispatcher thread that polls them for incoming data.
+	// Once a whole request header arrives, the connection is queued for a worker, which executes the request
+	// and hands the connection back. Requests that find their lane's queue full are answered with 503 Service Unavailable.
+	// The dispatcher also keeps a timer per connection, which closes connections that are too slow to send a request header
+	// or sit idle for too long, and aborts responses that the client receives slower than the minimum send rate
+	namespace RequestScheduler
+	{
+		struct LaneLimits
+		{
+			int workerCount;
+			int queueDepth;		// Requests waiting for a worker
+		};
+
+		struct Settings
+		{
+			LaneLimits lanes[static_cast<int>(RequestLane::Count)];
+			int retryAfterSeconds;
+			int headerTimeoutSeconds;	// From the first byte of a request to the end of its header
+			int idleTimeoutSeconds;		// Between requests on a kept alive connection
+			int minSendRate;			// Bytes per second, averaged over sendRateWindowSeconds, once a response starts. 0 turns it off.
+										// Downloads are paced to their share of the bandwidth limits, so keep it well below those
+			int sendRateWindowSeconds;
+
+			Settings();
+		};
+
+		void Initialize(const Settings& settings, RequestLaneClassifier classifier);
+		void Shutdown();
+
+		// Takes ownership of the connection. It's closed right away if the scheduler isn't running
+		void AddConnection(std::unique_ptr<Server> connection);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "PrecompiledHeader.h"
+#include "ResponseWriter.h"
+#include "Utilities\Metrics.h"
+#include "Utilities\Tracing.h"
+
+using namespace std;
+using namespace Http;
+using namespace Utilities;
+
+// The socket's send timeout applies to each call, so big responses go out in pieces that even slow clients finish in time
+static const ULONG kMaxSendLength = 256 * 1024;
+
+ResponseWriter::ResponseWriter(SOCKET socket, RequestContext& context) :
+	m_Socket(socket), m_Context(context)
+{
+}
+
+void ResponseWriter::SetNoDelay(bool noDelay) const
+{
+	if (m_Context.isNoDelaySet == noDelay)
+	{
+		return;
+	}
+
+	BOOL value = noDelay ? TRUE : FALSE;
+	auto result = setsockopt(m_Socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&value), sizeof(value));
+
+	if (result == SOCKET_ERROR)
+	{
+		Logging::Error(WSAGetLastError(), "Failed to set TCP_NODELAY: ");
+		return;
+	}
+
+	m_Context.isNoDelaySet = noDelay;
+}
+
+bool ResponseWriter::Send(WSABUF* buffers, DWORD bufferCount, bool isLastWrite) const
+{
+	TRACE_SCOPE("ResponseWriter::Send");
+	SetNoDelay(isLastWrite);
+
+	for (;;)
+	{
+		if (m_Context.cancellationToken.IsCancelled())
+		{
+			return false;
+		}
+
+		while (bufferCount > 0 && buffers->len == 0)
+		{
+			buffers++;
+			bufferCount--;
+		}
+
+		if (bufferCount == 0)
+		{
+			return true;
+		}
+
+		// Gather up to kMaxSendLength, cutting the last buffer short for the call if needed
+		DWORD gatherCount = 0;
+		ULONG gatherLength = 0;
+		ULONG lastBufferLength = 0;
+
+		while (gatherCount < bufferCount && gatherLength < kMaxSendLength)
+		{
+			lastBufferLength = buffers[gatherCount].len;
+			buffers[gatherCount].len = min(lastBufferLength, kMaxSendLength - gatherLength);
+			gatherLength += buffers[gatherCount].len;
+			gatherCount++;
+		}
+
+		DWORD bytesSent = 0;
+		auto sendResult = WSASend(m_Socket, buffers, gatherCount, &bytesSent, 0, nullptr, nullptr);
+		buffers[gatherCount - 1].len = lastBufferLength;
+
+		if (sendResult == SOCKET_ERROR)
+		{
+			Logging::Error(WSAGetLastError(), "Failed to send response: ");
+			m_Context.cancellationToken.Cancel();
+			return false;
+		}
+
+		Metrics::Increment(Metrics::Counter::BytesSent, bytesSent);
+		m_Context.bytesSent.fetch_add(bytesSent, memory_order_relaxed);
+
+		while (bytesSent > 0)
+		{
+			auto consumed = min(static_cast<ULONG>(bytesSent), buffers->len);
+			buffers->buf += consumed;
+			buffers->len -= consumed;
+			bytesSent -= consumed;
+
+			if (buffers->len == 0)
+			{
+				buffers++;
+				bufferCount--;
+			}
+		}
+	}
+}
\ No newline at end of file
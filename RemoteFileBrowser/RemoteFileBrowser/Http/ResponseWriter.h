@@ -0,0 +1,40 @@
+#pragma once
+
+#include "RequestContext.h"
+
+namespace Http
+{
+	// Sends responses with gathering WSASend calls, so a header leaves in the same segments as its body without being copied next to it.
+	// Nagle's algorithm stays on while a response streams out in several writes, where it merges their partial segments,
+	// and goes off for the last write, so the tail of the response doesn't wait for the client's delayed ACK
+	class ResponseWriter
+	{
+	private:
+		SOCKET m_Socket;
+		RequestContext& m_Context;
+
+		void SetNoDelay(bool noDelay) const;
+
+	public:
+		ResponseWriter(SOCKET socket, RequestContext& context);
+
+		// Advances the buffers past what's been sent. Returns false, and cancels the request, if sending fails
+		bool Send(WSABUF* buffers, DWORD bufferCount, bool isLastWrite) const;
+
+		inline bool Send(const char* data, size_t length, bool isLastWrite) const
+		{
+			auto buffer = MakeBuffer(data, length);
+			return Send(&buffer, 1, isLastWrite);
+		}
+
+		static inline WSABUF MakeBuffer(const char* data, size_t length)
+		{
+			Assert(length <= std::numeric_limits<ULONG>::max());
+
+			WSABUF buffer;
+			buffer.buf = const_cast<char*>(data);
+			buffer.len = static_cast<ULONG>(length);
+			return buffer;
+		}
+	};
+}
\ No newline at end of file
@@ -1,56 +1,93 @@
 #include "PrecompiledHeader.h"
 #include "Server.h"
+#include "HeaderIndex.h"
+#include "RequestScheduler.h"
+#include "Utilities\Tracing.h"
 
 using namespace std;
 using namespace Http;
 using namespace Utilities;
 
-static const int kDataBufferSize = 4096;
-
 void Server::StartServiceClient(SOCKET incomingSocket, sockaddr_in6 clientAddress, HttpRequestExecutionHandler executionHandler)
 {
-	Server serverInstance(incomingSocket, clientAddress, executionHandler);
-	serverInstance.Run();
+	RequestScheduler::AddConnection(unique_ptr<Server>(new Server(incomingSocket, clientAddress, executionHandler)));
 }
 
 Server::Server(SOCKET incomingSocket, sockaddr_in6 clientAddress, HttpRequestExecutionHandler executionHandler) :
-	m_ConnectionSocket(incomingSocket), m_ClientAddress(clientAddress), m_ReceivedData(nullptr), m_HasReportedUserAgent(false), m_ExecutionHandler(executionHandler)
+	m_ActiveConnection(Metrics::Gauge::ActiveConnections), m_ConnectionSocket(incomingSocket), m_ClientAddress(clientAddress),
+	m_BytesReceived(0), m_HasReportedUserAgent(false), m_ExecutionHandler(executionHandler)
 {
+	// A client that stops reading without closing the connection shows up as a send that never finishes
+	auto sendTimeout = kSendTimeoutMilliseconds;
+	auto result = setsockopt(m_ConnectionSocket, SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&sendTimeout), sizeof(sendTimeout));
+	Logging::LogErrorIfFailed(result == SOCKET_ERROR, "Failed to set the send timeout: ");
 }
 
-void Server::Run()
+Server::~Server()
 {
-	char buffer[kDataBufferSize];	// Store on the stack, no need to use heap for such small buffer
+	closesocket(m_ConnectionSocket);
+}
 
-	m_BytesReceived = 1;
-	m_ReceivedData = buffer;
+bool Server::Receive()
+{
+	Assert(m_BytesReceived < kDataBufferSize);
+	auto bytesReceived = recv(m_ConnectionSocket, m_ReceivedData + m_BytesReceived, kDataBufferSize - m_BytesReceived, 0);
 
-	while (m_BytesReceived > 0)
+	if (bytesReceived < 0)
 	{
-		m_BytesReceived = recv(m_ConnectionSocket, buffer, kDataBufferSize, 0);
-
-		if (m_BytesReceived > 0)
-		{
-			HandleRequest();
-		}
-		else if (m_BytesReceived < 0)
-		{
-			ReportConnectionDroppedError();
-		}
+		ReportConnectionDroppedError();
 	}
 
-	closesocket(m_ConnectionSocket);
+	if (bytesReceived <= 0)
+	{
+		return false;
+	}
+
+	m_BytesReceived += bytesReceived;
+	return true;
+}
+
+bool Server::HasReceivedRequest() const
+{
+	if (m_BytesReceived == kDataBufferSize)
+	{
+		return true;
+	}
+
+	HeaderIndex header;
+	return m_BytesReceived > 0 && header.Parse(m_ReceivedData, m_BytesReceived);
+}
+
+void Server::ConsumeReceivedData(int length)
+{
+	Assert(length <= m_BytesReceived);
+	memmove(m_ReceivedData, m_ReceivedData + length, m_BytesReceived - length);
+	m_BytesReceived -= length;
 }
 
-void Server::HandleRequest()
+bool Server::ParseRequest()
 {
-	auto requestType = ParseRequest();
+	TRACE_SCOPE("Server::ParseRequest");
+
+	// A request that doesn't fit in the buffer still gets its request line, and the user agent if it came before the cut
+	HeaderIndex header;
+	auto isComplete = header.Parse(m_ReceivedData, m_BytesReceived);
+
+	if (!m_HasReportedUserAgent)
+	{
+		Logging::Log("Client user agent: ", header.Find(KnownHeader::UserAgent).ToString());
+		m_HasReportedUserAgent = true;
+	}
+
+	auto requestType = header.GetRequestLine().ToString();
+	m_Context.acceptsGzip = HeaderIndex::AcceptsEncoding(header.Find(KnownHeader::AcceptEncoding), "gzip");
+	ConsumeReceivedData(isComplete ? static_cast<int>(header.GetHeaderLength()) : m_BytesReceived);
 
 	// Only 'GET' request is supported
 	if (requestType.length() < 3 || requestType[0] != 'G' && requestType[1] != 'E' && requestType[2] != 'T')
 	{
 		Logging::Log("Unknown request type: ", requestType);
-		return;
+		return false;
 	}
 
 	// Get request looks like this:
@@ -60,88 +97,63 @@ void Server::HandleRequest()
 	// Check whether there's http version specified; if not - request is invalid
 	if (lastSpacePosition == string::npos || lastSpacePosition == requestType.length() - 1)
 	{
-		return;	
+		return false;
 	}
 
 	// Extract and fix up requested path
-	auto requestedPath = Encoding::DecodeUrl(requestType.substr(5, lastSpacePosition - 5));
-	std::replace(begin(requestedPath), end(requestedPath), '/', '\\');
-
-	auto httpVersion = requestType.substr(lastSpacePosition + 1);
+	m_RequestedPath = Encoding::DecodeUrl(requestType.substr(5, lastSpacePosition - 5));
+	std::replace(begin(m_RequestedPath), end(m_RequestedPath), '/', '\\');
 
-	m_ExecutionHandler(m_ConnectionSocket, requestedPath, httpVersion);
+	m_HttpVersion = requestType.substr(lastSpacePosition + 1);
+	return true;
 }
 
-std::string Server::ParseRequest()
+void Server::ExecuteRequest()
 {
-	int position = 0;
-
-	// Parse request type
-
-	int lineFeedPos = FindNextCharacter(position, '\r');
-	string requestType(m_ReceivedData, lineFeedPos);
-
-	// Parse rest of header only if we haven't reported user agent yet
-
-	if (!m_HasReportedUserAgent)
-	{
-		ReportUserAgent(lineFeedPos + 2);
-		m_HasReportedUserAgent = true;
-	}
-
-	return requestType;
+	TRACE_SCOPE("Server::ExecuteRequest");
+	Metrics::ScopedTimer requestTimer(Metrics::Histogram::RequestDuration);
+	m_ExecutionHandler(m_ConnectionSocket, m_RequestedPath, m_HttpVersion, m_Context);
 }
 
-void Server::SendResponse(const string& response)
+void Server::CheckForDisconnect()
 {
-	Assert(response.length() < static_cast<size_t>(std::numeric_limits<int>::max()));
-	auto sendResult = send(m_ConnectionSocket, response.c_str(), static_cast<int>(response.length()), 0);
-	Assert(sendResult != SOCKET_ERROR);
+	char nextByte;
 
-	if (sendResult == SOCKET_ERROR)
+	if (recv(m_ConnectionSocket, &nextByte, 1, MSG_PEEK) > 0)
 	{
-		Logging::Error(WSAGetLastError(), "Failed to send response: ");
+		return;
 	}
+
+	Abort();
 }
 
-int Server::FindNextCharacter(int position, char character)
+void Server::Abort()
 {
-	while (position < m_BytesReceived - 1)
-	{
-		if (m_ReceivedData[position] == character)
-		{
-			return position;
-		}
-
-		position++;
-	}
-
-	return position;
+	m_Context.cancellationToken.Cancel();
+	shutdown(m_ConnectionSocket, SD_BOTH);
 }
 
-void Server::ReportUserAgent(int dataOffset)
+void Server::SendServiceUnavailable(int retryAfterSeconds)
 {
-	map<string, string> httpHeader;
+	m_Context.cancellationToken.Cancel();
 
-	for (;;)
-	{
-		int semicolonPos = FindNextCharacter(dataOffset, ':');
-
-		if (semicolonPos >= m_BytesReceived - 2)
-		{
-			break;
-		}
+	// The connection is closed right after, so it can stay non blocking
+	u_long nonBlocking = TRUE;
+	auto result = ioctlsocket(m_ConnectionSocket, FIONBIO, &nonBlocking);
 
-		auto lineFeedPos = FindNextCharacter(semicolonPos + 2, '\r');
+	if (result == SOCKET_ERROR)
+	{
+		Logging::Error(WSAGetLastError(), "Failed to set the connection to async mode: ");
+		return;
+	}
 
-		string key(m_ReceivedData + dataOffset, semicolonPos - dataOffset);
-		string value(m_ReceivedData + semicolonPos + 2, lineFeedPos - semicolonPos - 2);
+	auto response = m_HttpVersion + " 503 Service Unavailable\r\nRetry-After: " + to_string(retryAfterSeconds) + "\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+	auto sendResult = send(m_ConnectionSocket, response.c_str(), static_cast<int>(response.length()), 0);
 
-		httpHeader.emplace(std::move(key), std::move(value));
-		dataOffset = lineFeedPos + 2;
+	if (sendResult == SOCKET_ERROR && WSAGetLastError() != WSAEWOULDBLOCK)
+	{
+		Logging::Error(WSAGetLastError(), "Failed to send response: ");
 	}
-
-	Logging::Log("Client user agent: ", httpHeader["User-Agent"]);
 }
 
 void Server::ReportConnectionDroppedError()
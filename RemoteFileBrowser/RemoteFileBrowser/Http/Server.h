@@ -1,37 +1,72 @@
 #pragma once
 
+#include "RequestContext.h"
+#include "Utilities\Metrics.h"
+
 namespace Http
 {
 	// 1st arg - client socket
 	// 2nd arg - relative request URL
 	// 3rd arg - http version
-	typedef std::function<void(SOCKET, const std::string&, const std::string&)> HttpRequestExecutionHandler;
+	// 4th arg - request context, to report progress to and check for cancellation
+	typedef std::function<void(SOCKET, const std::string&, const std::string&, RequestContext&)> HttpRequestExecutionHandler;
 
+	// One client connection. RequestScheduler decides when it receives and when its requests execute
 	class Server
 	{
 	private:
+		static const int kDataBufferSize = 4096;
+		static const DWORD kSendTimeoutMilliseconds = 30000;
+
+		Metrics::ScopedGauge m_ActiveConnection;
 		SOCKET m_ConnectionSocket;
 		sockaddr_in6 m_ClientAddress;
+		char m_ReceivedData[kDataBufferSize];
 		int m_BytesReceived;
-		const char* m_ReceivedData;
 		bool m_HasReportedUserAgent;
 		HttpRequestExecutionHandler m_ExecutionHandler;
+		std::string m_RequestedPath;
+		std::string m_HttpVersion;
+		RequestContext m_Context;
 
 	private:
 		Server(SOCKET incomingSocket, sockaddr_in6 clientAddress, HttpRequestExecutionHandler executionHandler);
-		void Run();
-
-		void HandleRequest();
-		std::string ParseRequest();
-		std::string ExecuteRequest(const std::string& requestedPath, const std::string& httpVersion);
-		std::string FormResponseHtml(const std::string& requestedPath);
-		std::string FormFinalResponse(const std::string& html, const std::string& httpVersion);
-		void SendResponse(const std::string& response);
-		int FindNextCharacter(int position, char character);
-		void ReportUserAgent(int dataOffset);
+
+		void ConsumeReceivedData(int length);
 		void ReportConnectionDroppedError();
 
 	public:
+		~Server();
+
+		Server(const Server&) = delete;
+		Server& operator=(const Server&) = delete;
+
+		inline SOCKET GetSocket() const { return m_ConnectionSocket; }
+		inline const std::string& GetRequestedPath() const { return m_RequestedPath; }
+		inline bool IsCancelled() const { return m_Context.cancellationToken.IsCancelled(); }
+		inline bool HasReceivedData() const { return m_BytesReceived > 0; }
+		inline uint64_t GetBytesSent() const { return m_Context.bytesSent.load(std::memory_order_relaxed); }
+
+		// Reads whatever has arrived. Returns false once the connection is closed or broken
+		bool Receive();
+
+		// A whole header, or a full buffer, which is handled with whatever fit in it
+		bool HasReceivedRequest() const;
+
+		// Takes the received request out of the buffer. Returns false if it isn't a request we can serve
+		bool ParseRequest();
+		void ExecuteRequest();
+
+		// Closes the connection from our side as well, so it's dropped once handed back.
+		// Never blocks, as it runs on the dispatcher: if the client isn't taking data, it doesn't get the response either
+		void SendServiceUnavailable(int retryAfterSeconds);
+
+		// Cancels the request and shuts the socket down, so sends blocked on it fail right away
+		void Abort();
+
+		// For when the socket turns readable while a request executes. Aborts if the client hung up rather than sent another request
+		void CheckForDisconnect();
+
 		static void StartServiceClient(SOCKET incomingSocket, sockaddr_in6 clientAddress, HttpRequestExecutionHandler executionHandler);
 	};
 }
\ No newline at end of file
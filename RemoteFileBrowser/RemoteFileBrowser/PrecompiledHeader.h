@@ -9,12 +9,22 @@
 #include <Iphlpapi.h>
 #endif
 
+#if _M_IX86 || _M_X64
+#include <intrin.h>
+#include <immintrin.h>
+#elif _M_ARM || _M_ARM64
+#include <arm_neon.h>
+#endif
+
 #undef min
 #undef max
 
 #include <algorithm>
+#include <atomic>
+#include <deque>
 #include <fstream>
 #include <functional>
+#include <list>
 #include <map>
 #include <memory>
 #include <random>
@@ -0,0 +1,47 @@
+# Embeds the web assets next to this script into EmbeddedAssets.inl, along with their gzip encoded variants.
+# The EmbedAssets target in RemoteFileBrowser.vcxproj runs it before compiling whenever one of them changes
+param([string]$OutputPath = (Join-Path $PSScriptRoot "EmbeddedAssets.inl"))
+
+$assets = @("scripts.js", "style.css")
+
+function Get-Identifier([string]$fileName)
+{
+	$parts = $fileName -split "[^A-Za-z0-9]" | Where-Object { $_ }
+	return "k" + (($parts | ForEach-Object { $_.Substring(0, 1).ToUpper() + $_.Substring(1) }) -join "")
+}
+
+function Format-ByteArray([string]$name, [byte[]]$bytes)
+{
+	$lines = for ($i = 0; $i -lt $bytes.Length; $i += 16)
+	{
+		$end = [Math]::Min($i + 16, $bytes.Length) - 1
+		"`t" + (($bytes[$i..$end] | ForEach-Object { "0x{0:x2}" -f $_ }) -join ", ") + ","
+	}
+
+	return "static const uint8_t $name[] =`n{`n" + ($lines -join "`n") + "`n};`n`n"
+}
+
+function Compress-Gzip([byte[]]$bytes)
+{
+	$output = New-Object System.IO.MemoryStream
+	$gzip = New-Object System.IO.Compression.GZipStream($output, [System.IO.Compression.CompressionMode]::Compress)
+	$gzip.Write($bytes, 0, $bytes.Length)
+	$gzip.Close()
+	return $output.ToArray()
+}
+
+$content = "// Generated by EmbedAssets.ps1 from the files next to it, don't edit by hand`n`n"
+$table = ""
+
+foreach ($asset in $assets)
+{
+	$identifier = Get-Identifier $asset
+	$bytes = [System.IO.File]::ReadAllBytes((Join-Path $PSScriptRoot $asset))
+
+	$content += Format-ByteArray $identifier $bytes
+	$content += Format-ByteArray ($identifier + "Gzip") (Compress-Gzip $bytes)
+	$table += "`t{ `"$asset`", $identifier, sizeof($identifier), $($identifier)Gzip, sizeof($($identifier)Gzip) },`n"
+}
+
+$content += "static const EmbeddedAsset kEmbeddedAssets[] =`n{`n" + $table + "};"
+[System.IO.File]::WriteAllText($OutputPath, $content)
\ No newline at end of file
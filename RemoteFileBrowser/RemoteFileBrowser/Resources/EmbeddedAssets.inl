@@ -0,0 +1,721 @@
+// Generated by EmbedAssets.ps1 from the files next to it, don't edit by hand
+
+static const uint8_t kScriptsJs[] =
+{
+	0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x64, 0x65, 0x61, 0x6e, 0x5f, 0x61, 0x64,
+	0x64, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x28, 0x65, 0x2c, 0x74, 0x2c, 0x6e, 0x29, 0x7b, 0x69, 0x66,
+	0x28, 0x65, 0x2e, 0x61, 0x64, 0x64, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x4c, 0x69, 0x73, 0x74, 0x65,
+	0x6e, 0x65, 0x72, 0x29, 0x7b, 0x65, 0x2e, 0x61, 0x64, 0x64, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x4c,
+	0x69, 0x73, 0x74, 0x65, 0x6e, 0x65, 0x72, 0x28, 0x74, 0x2c, 0x6e, 0x2c, 0x66, 0x61, 0x6c, 0x73,
+	0x65, 0x29, 0x7d, 0x65, 0x6c, 0x73, 0x65, 0x7b, 0x69, 0x66, 0x28, 0x21, 0x6e, 0x2e, 0x24, 0x24,
+	0x67, 0x75, 0x69, 0x64, 0x29, 0x6e, 0x2e, 0x24, 0x24, 0x67, 0x75, 0x69, 0x64, 0x3d, 0x64, 0x65,
+	0x61, 0x6e, 0x5f, 0x61, 0x64, 0x64, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x2e, 0x67, 0x75, 0x69, 0x64,
+	0x2b, 0x2b, 0x3b, 0x69, 0x66, 0x28, 0x21, 0x65, 0x2e, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x73, 0x29,
+	0x65, 0x2e, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x73, 0x3d, 0x7b, 0x7d, 0x3b, 0x76, 0x61, 0x72, 0x20,
+	0x72, 0x3d, 0x65, 0x2e, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x73, 0x5b, 0x74, 0x5d, 0x3b, 0x69, 0x66,
+	0x28, 0x21, 0x72, 0x29, 0x7b, 0x72, 0x3d, 0x65, 0x2e, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x73, 0x5b,
+	0x74, 0x5d, 0x3d, 0x7b, 0x7d, 0x3b, 0x69, 0x66, 0x28, 0x65, 0x5b, 0x22, 0x6f, 0x6e, 0x22, 0x2b,
+	0x74, 0x5d, 0x29, 0x7b, 0x72, 0x5b, 0x30, 0x5d, 0x3d, 0x65, 0x5b, 0x22, 0x6f, 0x6e, 0x22, 0x2b,
+	0x74, 0x5d, 0x7d, 0x7d, 0x72, 0x5b, 0x6e, 0x2e, 0x24, 0x24, 0x67, 0x75, 0x69, 0x64, 0x5d, 0x3d,
+	0x6e, 0x3b, 0x65, 0x5b, 0x22, 0x6f, 0x6e, 0x22, 0x2b, 0x74, 0x5d, 0x3d, 0x68, 0x61, 0x6e, 0x64,
+	0x6c, 0x65, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x7d, 0x7d, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f,
+	0x6e, 0x20, 0x72, 0x65, 0x6d, 0x6f, 0x76, 0x65, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x28, 0x65, 0x2c,
+	0x74, 0x2c, 0x6e, 0x29, 0x7b, 0x69, 0x66, 0x28, 0x65, 0x2e, 0x72, 0x65, 0x6d, 0x6f, 0x76, 0x65,
+	0x45, 0x76, 0x65, 0x6e, 0x74, 0x4c, 0x69, 0x73, 0x74, 0x65, 0x6e, 0x65, 0x72, 0x29, 0x7b, 0x65,
+	0x2e, 0x72, 0x65, 0x6d, 0x6f, 0x76, 0x65, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x4c, 0x69, 0x73, 0x74,
+	0x65, 0x6e, 0x65, 0x72, 0x28, 0x74, 0x2c, 0x6e, 0x2c, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x29, 0x7d,
+	0x65, 0x6c, 0x73, 0x65, 0x7b, 0x69, 0x66, 0x28, 0x65, 0x2e, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x73,
+	0x26, 0x26, 0x65, 0x2e, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x73, 0x5b, 0x74, 0x5d, 0x29, 0x7b, 0x64,
+	0x65, 0x6c, 0x65, 0x74, 0x65, 0x20, 0x65, 0x2e, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x73, 0x5b, 0x74,
+	0x5d, 0x5b, 0x6e, 0x2e, 0x24, 0x24, 0x67, 0x75, 0x69, 0x64, 0x5d, 0x7d, 0x7d, 0x7d, 0x66, 0x75,
+	0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x68, 0x61, 0x6e, 0x64, 0x6c, 0x65, 0x45, 0x76, 0x65,
+	0x6e, 0x74, 0x28, 0x65, 0x29, 0x7b, 0x76, 0x61, 0x72, 0x20, 0x74, 0x3d, 0x74, 0x72, 0x75, 0x65,
+	0x3b, 0x65, 0x3d, 0x65, 0x7c, 0x7c, 0x66, 0x69, 0x78, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x28, 0x28,
+	0x28, 0x74, 0x68, 0x69, 0x73, 0x2e, 0x6f, 0x77, 0x6e, 0x65, 0x72, 0x44, 0x6f, 0x63, 0x75, 0x6d,
+	0x65, 0x6e, 0x74, 0x7c, 0x7c, 0x74, 0x68, 0x69, 0x73, 0x2e, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65,
+	0x6e, 0x74, 0x7c, 0x7c, 0x74, 0x68, 0x69, 0x73, 0x29, 0x2e, 0x70, 0x61, 0x72, 0x65, 0x6e, 0x74,
+	0x57, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x7c, 0x7c, 0x77, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x29, 0x2e,
+	0x65, 0x76, 0x65, 0x6e, 0x74, 0x29, 0x3b, 0x76, 0x61, 0x72, 0x20, 0x6e, 0x3d, 0x74, 0x68, 0x69,
+	0x73, 0x2e, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x73, 0x5b, 0x65, 0x2e, 0x74, 0x79, 0x70, 0x65, 0x5d,
+	0x3b, 0x66, 0x6f, 0x72, 0x28, 0x76, 0x61, 0x72, 0x20, 0x72, 0x20, 0x69, 0x6e, 0x20, 0x6e, 0x29,
+	0x7b, 0x74, 0x68, 0x69, 0x73, 0x2e, 0x24, 0x24, 0x68, 0x61, 0x6e, 0x64, 0x6c, 0x65, 0x45, 0x76,
+	0x65, 0x6e, 0x74, 0x3d, 0x6e, 0x5b, 0x72, 0x5d, 0x3b, 0x69, 0x66, 0x28, 0x74, 0x68, 0x69, 0x73,
+	0x2e, 0x24, 0x24, 0x68, 0x61, 0x6e, 0x64, 0x6c, 0x65, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x28, 0x65,
+	0x29, 0x3d, 0x3d, 0x3d, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x29, 0x7b, 0x74, 0x3d, 0x66, 0x61, 0x6c,
+	0x73, 0x65, 0x7d, 0x7d, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x74, 0x7d, 0x66, 0x75, 0x6e,
+	0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x66, 0x69, 0x78, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x28, 0x65,
+	0x29, 0x7b, 0x65, 0x2e, 0x70, 0x72, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x44, 0x65, 0x66, 0x61, 0x75,
+	0x6c, 0x74, 0x3d, 0x66, 0x69, 0x78, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x2e, 0x70, 0x72, 0x65, 0x76,
+	0x65, 0x6e, 0x74, 0x44, 0x65, 0x66, 0x61, 0x75, 0x6c, 0x74, 0x3b, 0x65, 0x2e, 0x73, 0x74, 0x6f,
+	0x70, 0x50, 0x72, 0x6f, 0x70, 0x61, 0x67, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x66, 0x69, 0x78,
+	0x45, 0x76, 0x65, 0x6e, 0x74, 0x2e, 0x73, 0x74, 0x6f, 0x70, 0x50, 0x72, 0x6f, 0x70, 0x61, 0x67,
+	0x61, 0x74, 0x69, 0x6f, 0x6e, 0x3b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x65, 0x7d, 0x76,
+	0x61, 0x72, 0x20, 0x73, 0x74, 0x49, 0x73, 0x49, 0x45, 0x3d, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x3b,
+	0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x3d, 0x7b, 0x69, 0x6e, 0x69, 0x74, 0x3a,
+	0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x29, 0x7b, 0x69, 0x66, 0x28, 0x61, 0x72,
+	0x67, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x73, 0x2e, 0x63, 0x61, 0x6c, 0x6c, 0x65, 0x65, 0x2e, 0x64,
+	0x6f, 0x6e, 0x65, 0x29, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x3b, 0x61, 0x72, 0x67, 0x75, 0x6d,
+	0x65, 0x6e, 0x74, 0x73, 0x2e, 0x63, 0x61, 0x6c, 0x6c, 0x65, 0x65, 0x2e, 0x64, 0x6f, 0x6e, 0x65,
+	0x3d, 0x74, 0x72, 0x75, 0x65, 0x3b, 0x69, 0x66, 0x28, 0x5f, 0x74, 0x69, 0x6d, 0x65, 0x72, 0x29,
+	0x63, 0x6c, 0x65, 0x61, 0x72, 0x49, 0x6e, 0x74, 0x65, 0x72, 0x76, 0x61, 0x6c, 0x28, 0x5f, 0x74,
+	0x69, 0x6d, 0x65, 0x72, 0x29, 0x3b, 0x69, 0x66, 0x28, 0x21, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65,
+	0x6e, 0x74, 0x2e, 0x63, 0x72, 0x65, 0x61, 0x74, 0x65, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74,
+	0x7c, 0x7c, 0x21, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x67, 0x65, 0x74, 0x45,
+	0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x73, 0x42, 0x79, 0x54, 0x61, 0x67, 0x4e, 0x61, 0x6d, 0x65,
+	0x29, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x3b, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c,
+	0x65, 0x2e, 0x44, 0x41, 0x54, 0x45, 0x5f, 0x52, 0x45, 0x3d, 0x2f, 0x5e, 0x28, 0x5c, 0x64, 0x5c,
+	0x64, 0x3f, 0x29, 0x5b, 0x5c, 0x2f, 0x5c, 0x2e, 0x2d, 0x5d, 0x28, 0x5c, 0x64, 0x5c, 0x64, 0x3f,
+	0x29, 0x5b, 0x5c, 0x2f, 0x5c, 0x2e, 0x2d, 0x5d, 0x28, 0x28, 0x5c, 0x64, 0x5c, 0x64, 0x29, 0x3f,
+	0x5c, 0x64, 0x5c, 0x64, 0x29, 0x24, 0x2f, 0x3b, 0x66, 0x6f, 0x72, 0x45, 0x61, 0x63, 0x68, 0x28,
+	0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x67, 0x65, 0x74, 0x45, 0x6c, 0x65, 0x6d,
+	0x65, 0x6e, 0x74, 0x73, 0x42, 0x79, 0x54, 0x61, 0x67, 0x4e, 0x61, 0x6d, 0x65, 0x28, 0x22, 0x74,
+	0x61, 0x62, 0x6c, 0x65, 0x22, 0x29, 0x2c, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28,
+	0x65, 0x29, 0x7b, 0x69, 0x66, 0x28, 0x65, 0x2e, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x4e, 0x61, 0x6d,
+	0x65, 0x2e, 0x73, 0x65, 0x61, 0x72, 0x63, 0x68, 0x28, 0x2f, 0x5c, 0x62, 0x73, 0x6f, 0x72, 0x74,
+	0x61, 0x62, 0x6c, 0x65, 0x5c, 0x62, 0x2f, 0x29, 0x21, 0x3d, 0x2d, 0x31, 0x29, 0x7b, 0x73, 0x6f,
+	0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x6d, 0x61, 0x6b, 0x65, 0x53, 0x6f, 0x72, 0x74,
+	0x61, 0x62, 0x6c, 0x65, 0x28, 0x65, 0x29, 0x7d, 0x7d, 0x29, 0x7d, 0x2c, 0x6d, 0x61, 0x6b, 0x65,
+	0x53, 0x6f, 0x72, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x3a, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f,
+	0x6e, 0x28, 0x65, 0x29, 0x7b, 0x69, 0x66, 0x28, 0x65, 0x2e, 0x67, 0x65, 0x74, 0x45, 0x6c, 0x65,
+	0x6d, 0x65, 0x6e, 0x74, 0x73, 0x42, 0x79, 0x54, 0x61, 0x67, 0x4e, 0x61, 0x6d, 0x65, 0x28, 0x22,
+	0x74, 0x68, 0x65, 0x61, 0x64, 0x22, 0x29, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3d, 0x3d,
+	0x30, 0x29, 0x7b, 0x74, 0x68, 0x65, 0x3d, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e,
+	0x63, 0x72, 0x65, 0x61, 0x74, 0x65, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x28, 0x22, 0x74,
+	0x68, 0x65, 0x61, 0x64, 0x22, 0x29, 0x3b, 0x74, 0x68, 0x65, 0x2e, 0x61, 0x70, 0x70, 0x65, 0x6e,
+	0x64, 0x43, 0x68, 0x69, 0x6c, 0x64, 0x28, 0x65, 0x2e, 0x72, 0x6f, 0x77, 0x73, 0x5b, 0x30, 0x5d,
+	0x29, 0x3b, 0x65, 0x2e, 0x69, 0x6e, 0x73, 0x65, 0x72, 0x74, 0x42, 0x65, 0x66, 0x6f, 0x72, 0x65,
+	0x28, 0x74, 0x68, 0x65, 0x2c, 0x65, 0x2e, 0x66, 0x69, 0x72, 0x73, 0x74, 0x43, 0x68, 0x69, 0x6c,
+	0x64, 0x29, 0x7d, 0x69, 0x66, 0x28, 0x65, 0x2e, 0x74, 0x48, 0x65, 0x61, 0x64, 0x3d, 0x3d, 0x6e,
+	0x75, 0x6c, 0x6c, 0x29, 0x65, 0x2e, 0x74, 0x48, 0x65, 0x61, 0x64, 0x3d, 0x65, 0x2e, 0x67, 0x65,
+	0x74, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x73, 0x42, 0x79, 0x54, 0x61, 0x67, 0x4e, 0x61,
+	0x6d, 0x65, 0x28, 0x22, 0x74, 0x68, 0x65, 0x61, 0x64, 0x22, 0x29, 0x5b, 0x30, 0x5d, 0x3b, 0x69,
+	0x66, 0x28, 0x65, 0x2e, 0x74, 0x48, 0x65, 0x61, 0x64, 0x2e, 0x72, 0x6f, 0x77, 0x73, 0x2e, 0x6c,
+	0x65, 0x6e, 0x67, 0x74, 0x68, 0x21, 0x3d, 0x31, 0x29, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x3b,
+	0x73, 0x6f, 0x72, 0x74, 0x62, 0x6f, 0x74, 0x74, 0x6f, 0x6d, 0x72, 0x6f, 0x77, 0x73, 0x3d, 0x5b,
+	0x5d, 0x3b, 0x66, 0x6f, 0x72, 0x28, 0x76, 0x61, 0x72, 0x20, 0x74, 0x3d, 0x30, 0x3b, 0x74, 0x3c,
+	0x65, 0x2e, 0x72, 0x6f, 0x77, 0x73, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3b, 0x74, 0x2b,
+	0x2b, 0x29, 0x7b, 0x69, 0x66, 0x28, 0x65, 0x2e, 0x72, 0x6f, 0x77, 0x73, 0x5b, 0x74, 0x5d, 0x2e,
+	0x63, 0x6c, 0x61, 0x73, 0x73, 0x4e, 0x61, 0x6d, 0x65, 0x2e, 0x73, 0x65, 0x61, 0x72, 0x63, 0x68,
+	0x28, 0x2f, 0x5c, 0x62, 0x73, 0x6f, 0x72, 0x74, 0x62, 0x6f, 0x74, 0x74, 0x6f, 0x6d, 0x5c, 0x62,
+	0x2f, 0x29, 0x21, 0x3d, 0x2d, 0x31, 0x29, 0x7b, 0x73, 0x6f, 0x72, 0x74, 0x62, 0x6f, 0x74, 0x74,
+	0x6f, 0x6d, 0x72, 0x6f, 0x77, 0x73, 0x5b, 0x73, 0x6f, 0x72, 0x74, 0x62, 0x6f, 0x74, 0x74, 0x6f,
+	0x6d, 0x72, 0x6f, 0x77, 0x73, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x5d, 0x3d, 0x65, 0x2e,
+	0x72, 0x6f, 0x77, 0x73, 0x5b, 0x74, 0x5d, 0x7d, 0x7d, 0x69, 0x66, 0x28, 0x73, 0x6f, 0x72, 0x74,
+	0x62, 0x6f, 0x74, 0x74, 0x6f, 0x6d, 0x72, 0x6f, 0x77, 0x73, 0x29, 0x7b, 0x69, 0x66, 0x28, 0x65,
+	0x2e, 0x74, 0x46, 0x6f, 0x6f, 0x74, 0x3d, 0x3d, 0x6e, 0x75, 0x6c, 0x6c, 0x29, 0x7b, 0x74, 0x66,
+	0x6f, 0x3d, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x63, 0x72, 0x65, 0x61, 0x74,
+	0x65, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x28, 0x22, 0x74, 0x66, 0x6f, 0x6f, 0x74, 0x22,
+	0x29, 0x3b, 0x65, 0x2e, 0x61, 0x70, 0x70, 0x65, 0x6e, 0x64, 0x43, 0x68, 0x69, 0x6c, 0x64, 0x28,
+	0x74, 0x66, 0x6f, 0x29, 0x7d, 0x66, 0x6f, 0x72, 0x28, 0x76, 0x61, 0x72, 0x20, 0x74, 0x3d, 0x30,
+	0x3b, 0x74, 0x3c, 0x73, 0x6f, 0x72, 0x74, 0x62, 0x6f, 0x74, 0x74, 0x6f, 0x6d, 0x72, 0x6f, 0x77,
+	0x73, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3b, 0x74, 0x2b, 0x2b, 0x29, 0x7b, 0x74, 0x66,
+	0x6f, 0x2e, 0x61, 0x70, 0x70, 0x65, 0x6e, 0x64, 0x43, 0x68, 0x69, 0x6c, 0x64, 0x28, 0x73, 0x6f,
+	0x72, 0x74, 0x62, 0x6f, 0x74, 0x74, 0x6f, 0x6d, 0x72, 0x6f, 0x77, 0x73, 0x5b, 0x74, 0x5d, 0x29,
+	0x7d, 0x64, 0x65, 0x6c, 0x65, 0x74, 0x65, 0x20, 0x73, 0x6f, 0x72, 0x74, 0x62, 0x6f, 0x74, 0x74,
+	0x6f, 0x6d, 0x72, 0x6f, 0x77, 0x73, 0x7d, 0x68, 0x65, 0x61, 0x64, 0x72, 0x6f, 0x77, 0x3d, 0x65,
+	0x2e, 0x74, 0x48, 0x65, 0x61, 0x64, 0x2e, 0x72, 0x6f, 0x77, 0x73, 0x5b, 0x30, 0x5d, 0x2e, 0x63,
+	0x65, 0x6c, 0x6c, 0x73, 0x3b, 0x66, 0x6f, 0x72, 0x28, 0x76, 0x61, 0x72, 0x20, 0x74, 0x3d, 0x30,
+	0x3b, 0x74, 0x3c, 0x68, 0x65, 0x61, 0x64, 0x72, 0x6f, 0x77, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74,
+	0x68, 0x3b, 0x74, 0x2b, 0x2b, 0x29, 0x7b, 0x69, 0x66, 0x28, 0x21, 0x68, 0x65, 0x61, 0x64, 0x72,
+	0x6f, 0x77, 0x5b, 0x74, 0x5d, 0x2e, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x4e, 0x61, 0x6d, 0x65, 0x2e,
+	0x6d, 0x61, 0x74, 0x63, 0x68, 0x28, 0x2f, 0x5c, 0x62, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62,
+	0x6c, 0x65, 0x5f, 0x6e, 0x6f, 0x73, 0x6f, 0x72, 0x74, 0x5c, 0x62, 0x2f, 0x29, 0x29, 0x7b, 0x6d,
+	0x74, 0x63, 0x68, 0x3d, 0x68, 0x65, 0x61, 0x64, 0x72, 0x6f, 0x77, 0x5b, 0x74, 0x5d, 0x2e, 0x63,
+	0x6c, 0x61, 0x73, 0x73, 0x4e, 0x61, 0x6d, 0x65, 0x2e, 0x6d, 0x61, 0x74, 0x63, 0x68, 0x28, 0x2f,
+	0x5c, 0x62, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x28, 0x5b, 0x61, 0x2d,
+	0x7a, 0x30, 0x2d, 0x39, 0x5d, 0x2b, 0x29, 0x5c, 0x62, 0x2f, 0x29, 0x3b, 0x69, 0x66, 0x28, 0x6d,
+	0x74, 0x63, 0x68, 0x29, 0x7b, 0x6f, 0x76, 0x65, 0x72, 0x72, 0x69, 0x64, 0x65, 0x3d, 0x6d, 0x74,
+	0x63, 0x68, 0x5b, 0x31, 0x5d, 0x7d, 0x69, 0x66, 0x28, 0x6d, 0x74, 0x63, 0x68, 0x26, 0x26, 0x74,
+	0x79, 0x70, 0x65, 0x6f, 0x66, 0x20, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5b,
+	0x22, 0x73, 0x6f, 0x72, 0x74, 0x5f, 0x22, 0x2b, 0x6f, 0x76, 0x65, 0x72, 0x72, 0x69, 0x64, 0x65,
+	0x5d, 0x3d, 0x3d, 0x22, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x22, 0x29, 0x7b, 0x68,
+	0x65, 0x61, 0x64, 0x72, 0x6f, 0x77, 0x5b, 0x74, 0x5d, 0x2e, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61,
+	0x62, 0x6c, 0x65, 0x5f, 0x73, 0x6f, 0x72, 0x74, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e,
+	0x3d, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5b, 0x22, 0x73, 0x6f, 0x72, 0x74,
+	0x5f, 0x22, 0x2b, 0x6f, 0x76, 0x65, 0x72, 0x72, 0x69, 0x64, 0x65, 0x5d, 0x7d, 0x65, 0x6c, 0x73,
+	0x65, 0x7b, 0x68, 0x65, 0x61, 0x64, 0x72, 0x6f, 0x77, 0x5b, 0x74, 0x5d, 0x2e, 0x73, 0x6f, 0x72,
+	0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x73, 0x6f, 0x72, 0x74, 0x66, 0x75, 0x6e, 0x63, 0x74,
+	0x69, 0x6f, 0x6e, 0x3d, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x67, 0x75,
+	0x65, 0x73, 0x73, 0x54, 0x79, 0x70, 0x65, 0x28, 0x65, 0x2c, 0x74, 0x29, 0x7d, 0x68, 0x65, 0x61,
+	0x64, 0x72, 0x6f, 0x77, 0x5b, 0x74, 0x5d, 0x2e, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c,
+	0x65, 0x5f, 0x63, 0x6f, 0x6c, 0x75, 0x6d, 0x6e, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x3d, 0x74, 0x3b,
+	0x68, 0x65, 0x61, 0x64, 0x72, 0x6f, 0x77, 0x5b, 0x74, 0x5d, 0x2e, 0x73, 0x6f, 0x72, 0x74, 0x74,
+	0x61, 0x62, 0x6c, 0x65, 0x5f, 0x74, 0x62, 0x6f, 0x64, 0x79, 0x3d, 0x65, 0x2e, 0x74, 0x42, 0x6f,
+	0x64, 0x69, 0x65, 0x73, 0x5b, 0x30, 0x5d, 0x3b, 0x64, 0x65, 0x61, 0x6e, 0x5f, 0x61, 0x64, 0x64,
+	0x45, 0x76, 0x65, 0x6e, 0x74, 0x28, 0x68, 0x65, 0x61, 0x64, 0x72, 0x6f, 0x77, 0x5b, 0x74, 0x5d,
+	0x2c, 0x22, 0x63, 0x6c, 0x69, 0x63, 0x6b, 0x22, 0x2c, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62,
+	0x6c, 0x65, 0x2e, 0x69, 0x6e, 0x6e, 0x65, 0x72, 0x53, 0x6f, 0x72, 0x74, 0x46, 0x75, 0x6e, 0x63,
+	0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x65, 0x29,
+	0x7b, 0x69, 0x66, 0x28, 0x74, 0x68, 0x69, 0x73, 0x2e, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x4e, 0x61,
+	0x6d, 0x65, 0x2e, 0x73, 0x65, 0x61, 0x72, 0x63, 0x68, 0x28, 0x2f, 0x5c, 0x62, 0x73, 0x6f, 0x72,
+	0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x73, 0x6f, 0x72, 0x74, 0x65, 0x64, 0x5c, 0x62, 0x2f,
+	0x29, 0x21, 0x3d, 0x2d, 0x31, 0x29, 0x7b, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65,
+	0x2e, 0x72, 0x65, 0x76, 0x65, 0x72, 0x73, 0x65, 0x28, 0x74, 0x68, 0x69, 0x73, 0x2e, 0x73, 0x6f,
+	0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x74, 0x62, 0x6f, 0x64, 0x79, 0x29, 0x3b, 0x74,
+	0x68, 0x69, 0x73, 0x2e, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x4e, 0x61, 0x6d, 0x65, 0x3d, 0x74, 0x68,
+	0x69, 0x73, 0x2e, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x4e, 0x61, 0x6d, 0x65, 0x2e, 0x72, 0x65, 0x70,
+	0x6c, 0x61, 0x63, 0x65, 0x28, 0x22, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5f,
+	0x73, 0x6f, 0x72, 0x74, 0x65, 0x64, 0x22, 0x2c, 0x22, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62,
+	0x6c, 0x65, 0x5f, 0x73, 0x6f, 0x72, 0x74, 0x65, 0x64, 0x5f, 0x72, 0x65, 0x76, 0x65, 0x72, 0x73,
+	0x65, 0x22, 0x29, 0x3b, 0x74, 0x68, 0x69, 0x73, 0x2e, 0x72, 0x65, 0x6d, 0x6f, 0x76, 0x65, 0x43,
+	0x68, 0x69, 0x6c, 0x64, 0x28, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x67, 0x65,
+	0x74, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x42, 0x79, 0x49, 0x64, 0x28, 0x22, 0x73, 0x6f,
+	0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x73, 0x6f, 0x72, 0x74, 0x66, 0x77, 0x64, 0x69,
+	0x6e, 0x64, 0x22, 0x29, 0x29, 0x3b, 0x73, 0x6f, 0x72, 0x74, 0x72, 0x65, 0x76, 0x69, 0x6e, 0x64,
+	0x3d, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x63, 0x72, 0x65, 0x61, 0x74, 0x65,
+	0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x28, 0x22, 0x73, 0x70, 0x61, 0x6e, 0x22, 0x29, 0x3b,
+	0x73, 0x6f, 0x72, 0x74, 0x72, 0x65, 0x76, 0x69, 0x6e, 0x64, 0x2e, 0x69, 0x64, 0x3d, 0x22, 0x73,
+	0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x73, 0x6f, 0x72, 0x74, 0x72, 0x65, 0x76,
+	0x69, 0x6e, 0x64, 0x22, 0x3b, 0x73, 0x6f, 0x72, 0x74, 0x72, 0x65, 0x76, 0x69, 0x6e, 0x64, 0x2e,
+	0x69, 0x6e, 0x6e, 0x65, 0x72, 0x48, 0x54, 0x4d, 0x4c, 0x3d, 0x73, 0x74, 0x49, 0x73, 0x49, 0x45,
+	0x3f, 0x27, 0x26, 0x6e, 0x62, 0x73, 0x70, 0x3c, 0x66, 0x6f, 0x6e, 0x74, 0x20, 0x66, 0x61, 0x63,
+	0x65, 0x3d, 0x22, 0x77, 0x65, 0x62, 0x64, 0x69, 0x6e, 0x67, 0x73, 0x22, 0x3e, 0x35, 0x3c, 0x2f,
+	0x66, 0x6f, 0x6e, 0x74, 0x3e, 0x27, 0x3a, 0x22, 0x26, 0x6e, 0x62, 0x73, 0x70, 0x3b, 0x26, 0x23,
+	0x78, 0x32, 0x35, 0x42, 0x34, 0x3b, 0x22, 0x3b, 0x74, 0x68, 0x69, 0x73, 0x2e, 0x61, 0x70, 0x70,
+	0x65, 0x6e, 0x64, 0x43, 0x68, 0x69, 0x6c, 0x64, 0x28, 0x73, 0x6f, 0x72, 0x74, 0x72, 0x65, 0x76,
+	0x69, 0x6e, 0x64, 0x29, 0x3b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x7d, 0x69, 0x66, 0x28, 0x74,
+	0x68, 0x69, 0x73, 0x2e, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x4e, 0x61, 0x6d, 0x65, 0x2e, 0x73, 0x65,
+	0x61, 0x72, 0x63, 0x68, 0x28, 0x2f, 0x5c, 0x62, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c,
+	0x65, 0x5f, 0x73, 0x6f, 0x72, 0x74, 0x65, 0x64, 0x5f, 0x72, 0x65, 0x76, 0x65, 0x72, 0x73, 0x65,
+	0x5c, 0x62, 0x2f, 0x29, 0x21, 0x3d, 0x2d, 0x31, 0x29, 0x7b, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61,
+	0x62, 0x6c, 0x65, 0x2e, 0x72, 0x65, 0x76, 0x65, 0x72, 0x73, 0x65, 0x28, 0x74, 0x68, 0x69, 0x73,
+	0x2e, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x74, 0x62, 0x6f, 0x64, 0x79,
+	0x29, 0x3b, 0x74, 0x68, 0x69, 0x73, 0x2e, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x4e, 0x61, 0x6d, 0x65,
+	0x3d, 0x74, 0x68, 0x69, 0x73, 0x2e, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x4e, 0x61, 0x6d, 0x65, 0x2e,
+	0x72, 0x65, 0x70, 0x6c, 0x61, 0x63, 0x65, 0x28, 0x22, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62,
+	0x6c, 0x65, 0x5f, 0x73, 0x6f, 0x72, 0x74, 0x65, 0x64, 0x5f, 0x72, 0x65, 0x76, 0x65, 0x72, 0x73,
+	0x65, 0x22, 0x2c, 0x22, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x73, 0x6f,
+	0x72, 0x74, 0x65, 0x64, 0x22, 0x29, 0x3b, 0x74, 0x68, 0x69, 0x73, 0x2e, 0x72, 0x65, 0x6d, 0x6f,
+	0x76, 0x65, 0x43, 0x68, 0x69, 0x6c, 0x64, 0x28, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74,
+	0x2e, 0x67, 0x65, 0x74, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x42, 0x79, 0x49, 0x64, 0x28,
+	0x22, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x73, 0x6f, 0x72, 0x74, 0x72,
+	0x65, 0x76, 0x69, 0x6e, 0x64, 0x22, 0x29, 0x29, 0x3b, 0x73, 0x6f, 0x72, 0x74, 0x66, 0x77, 0x64,
+	0x69, 0x6e, 0x64, 0x3d, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x63, 0x72, 0x65,
+	0x61, 0x74, 0x65, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x28, 0x22, 0x73, 0x70, 0x61, 0x6e,
+	0x22, 0x29, 0x3b, 0x73, 0x6f, 0x72, 0x74, 0x66, 0x77, 0x64, 0x69, 0x6e, 0x64, 0x2e, 0x69, 0x64,
+	0x3d, 0x22, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x73, 0x6f, 0x72, 0x74,
+	0x66, 0x77, 0x64, 0x69, 0x6e, 0x64, 0x22, 0x3b, 0x73, 0x6f, 0x72, 0x74, 0x66, 0x77, 0x64, 0x69,
+	0x6e, 0x64, 0x2e, 0x69, 0x6e, 0x6e, 0x65, 0x72, 0x48, 0x54, 0x4d, 0x4c, 0x3d, 0x73, 0x74, 0x49,
+	0x73, 0x49, 0x45, 0x3f, 0x27, 0x26, 0x6e, 0x62, 0x73, 0x70, 0x3c, 0x66, 0x6f, 0x6e, 0x74, 0x20,
+	0x66, 0x61, 0x63, 0x65, 0x3d, 0x22, 0x77, 0x65, 0x62, 0x64, 0x69, 0x6e, 0x67, 0x73, 0x22, 0x3e,
+	0x36, 0x3c, 0x2f, 0x66, 0x6f, 0x6e, 0x74, 0x3e, 0x27, 0x3a, 0x22, 0x26, 0x6e, 0x62, 0x73, 0x70,
+	0x3b, 0x26, 0x23, 0x78, 0x32, 0x35, 0x42, 0x45, 0x3b, 0x22, 0x3b, 0x74, 0x68, 0x69, 0x73, 0x2e,
+	0x61, 0x70, 0x70, 0x65, 0x6e, 0x64, 0x43, 0x68, 0x69, 0x6c, 0x64, 0x28, 0x73, 0x6f, 0x72, 0x74,
+	0x66, 0x77, 0x64, 0x69, 0x6e, 0x64, 0x29, 0x3b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x7d, 0x74,
+	0x68, 0x65, 0x61, 0x64, 0x72, 0x6f, 0x77, 0x3d, 0x74, 0x68, 0x69, 0x73, 0x2e, 0x70, 0x61, 0x72,
+	0x65, 0x6e, 0x74, 0x4e, 0x6f, 0x64, 0x65, 0x3b, 0x66, 0x6f, 0x72, 0x45, 0x61, 0x63, 0x68, 0x28,
+	0x74, 0x68, 0x65, 0x61, 0x64, 0x72, 0x6f, 0x77, 0x2e, 0x63, 0x68, 0x69, 0x6c, 0x64, 0x4e, 0x6f,
+	0x64, 0x65, 0x73, 0x2c, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x65, 0x29, 0x7b,
+	0x69, 0x66, 0x28, 0x65, 0x2e, 0x6e, 0x6f, 0x64, 0x65, 0x54, 0x79, 0x70, 0x65, 0x3d, 0x3d, 0x31,
+	0x29, 0x7b, 0x65, 0x2e, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x4e, 0x61, 0x6d, 0x65, 0x3d, 0x65, 0x2e,
+	0x63, 0x6c, 0x61, 0x73, 0x73, 0x4e, 0x61, 0x6d, 0x65, 0x2e, 0x72, 0x65, 0x70, 0x6c, 0x61, 0x63,
+	0x65, 0x28, 0x22, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x73, 0x6f, 0x72,
+	0x74, 0x65, 0x64, 0x5f, 0x72, 0x65, 0x76, 0x65, 0x72, 0x73, 0x65, 0x22, 0x2c, 0x22, 0x22, 0x29,
+	0x3b, 0x65, 0x2e, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x4e, 0x61, 0x6d, 0x65, 0x3d, 0x65, 0x2e, 0x63,
+	0x6c, 0x61, 0x73, 0x73, 0x4e, 0x61, 0x6d, 0x65, 0x2e, 0x72, 0x65, 0x70, 0x6c, 0x61, 0x63, 0x65,
+	0x28, 0x22, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x73, 0x6f, 0x72, 0x74,
+	0x65, 0x64, 0x22, 0x2c, 0x22, 0x22, 0x29, 0x7d, 0x7d, 0x29, 0x3b, 0x73, 0x6f, 0x72, 0x74, 0x66,
+	0x77, 0x64, 0x69, 0x6e, 0x64, 0x3d, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x67,
+	0x65, 0x74, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x42, 0x79, 0x49, 0x64, 0x28, 0x22, 0x73,
+	0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x73, 0x6f, 0x72, 0x74, 0x66, 0x77, 0x64,
+	0x69, 0x6e, 0x64, 0x22, 0x29, 0x3b, 0x69, 0x66, 0x28, 0x73, 0x6f, 0x72, 0x74, 0x66, 0x77, 0x64,
+	0x69, 0x6e, 0x64, 0x29, 0x7b, 0x73, 0x6f, 0x72, 0x74, 0x66, 0x77, 0x64, 0x69, 0x6e, 0x64, 0x2e,
+	0x70, 0x61, 0x72, 0x65, 0x6e, 0x74, 0x4e, 0x6f, 0x64, 0x65, 0x2e, 0x72, 0x65, 0x6d, 0x6f, 0x76,
+	0x65, 0x43, 0x68, 0x69, 0x6c, 0x64, 0x28, 0x73, 0x6f, 0x72, 0x74, 0x66, 0x77, 0x64, 0x69, 0x6e,
+	0x64, 0x29, 0x7d, 0x73, 0x6f, 0x72, 0x74, 0x72, 0x65, 0x76, 0x69, 0x6e, 0x64, 0x3d, 0x64, 0x6f,
+	0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x67, 0x65, 0x74, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e,
+	0x74, 0x42, 0x79, 0x49, 0x64, 0x28, 0x22, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65,
+	0x5f, 0x73, 0x6f, 0x72, 0x74, 0x72, 0x65, 0x76, 0x69, 0x6e, 0x64, 0x22, 0x29, 0x3b, 0x69, 0x66,
+	0x28, 0x73, 0x6f, 0x72, 0x74, 0x72, 0x65, 0x76, 0x69, 0x6e, 0x64, 0x29, 0x7b, 0x73, 0x6f, 0x72,
+	0x74, 0x72, 0x65, 0x76, 0x69, 0x6e, 0x64, 0x2e, 0x70, 0x61, 0x72, 0x65, 0x6e, 0x74, 0x4e, 0x6f,
+	0x64, 0x65, 0x2e, 0x72, 0x65, 0x6d, 0x6f, 0x76, 0x65, 0x43, 0x68, 0x69, 0x6c, 0x64, 0x28, 0x73,
+	0x6f, 0x72, 0x74, 0x72, 0x65, 0x76, 0x69, 0x6e, 0x64, 0x29, 0x7d, 0x74, 0x68, 0x69, 0x73, 0x2e,
+	0x63, 0x6c, 0x61, 0x73, 0x73, 0x4e, 0x61, 0x6d, 0x65, 0x2b, 0x3d, 0x22, 0x20, 0x73, 0x6f, 0x72,
+	0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x73, 0x6f, 0x72, 0x74, 0x65, 0x64, 0x22, 0x3b, 0x73,
+	0x6f, 0x72, 0x74, 0x66, 0x77, 0x64, 0x69, 0x6e, 0x64, 0x3d, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65,
+	0x6e, 0x74, 0x2e, 0x63, 0x72, 0x65, 0x61, 0x74, 0x65, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74,
+	0x28, 0x22, 0x73, 0x70, 0x61, 0x6e, 0x22, 0x29, 0x3b, 0x73, 0x6f, 0x72, 0x74, 0x66, 0x77, 0x64,
+	0x69, 0x6e, 0x64, 0x2e, 0x69, 0x64, 0x3d, 0x22, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c,
+	0x65, 0x5f, 0x73, 0x6f, 0x72, 0x74, 0x66, 0x77, 0x64, 0x69, 0x6e, 0x64, 0x22, 0x3b, 0x73, 0x6f,
+	0x72, 0x74, 0x66, 0x77, 0x64, 0x69, 0x6e, 0x64, 0x2e, 0x69, 0x6e, 0x6e, 0x65, 0x72, 0x48, 0x54,
+	0x4d, 0x4c, 0x3d, 0x73, 0x74, 0x49, 0x73, 0x49, 0x45, 0x3f, 0x27, 0x26, 0x6e, 0x62, 0x73, 0x70,
+	0x3c, 0x66, 0x6f, 0x6e, 0x74, 0x20, 0x66, 0x61, 0x63, 0x65, 0x3d, 0x22, 0x77, 0x65, 0x62, 0x64,
+	0x69, 0x6e, 0x67, 0x73, 0x22, 0x3e, 0x36, 0x3c, 0x2f, 0x66, 0x6f, 0x6e, 0x74, 0x3e, 0x27, 0x3a,
+	0x22, 0x26, 0x6e, 0x62, 0x73, 0x70, 0x3b, 0x26, 0x23, 0x78, 0x32, 0x35, 0x42, 0x45, 0x3b, 0x22,
+	0x3b, 0x74, 0x68, 0x69, 0x73, 0x2e, 0x61, 0x70, 0x70, 0x65, 0x6e, 0x64, 0x43, 0x68, 0x69, 0x6c,
+	0x64, 0x28, 0x73, 0x6f, 0x72, 0x74, 0x66, 0x77, 0x64, 0x69, 0x6e, 0x64, 0x29, 0x3b, 0x72, 0x6f,
+	0x77, 0x5f, 0x61, 0x72, 0x72, 0x61, 0x79, 0x3d, 0x5b, 0x5d, 0x3b, 0x63, 0x6f, 0x6c, 0x3d, 0x74,
+	0x68, 0x69, 0x73, 0x2e, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x63, 0x6f,
+	0x6c, 0x75, 0x6d, 0x6e, 0x69, 0x6e, 0x64, 0x65, 0x78, 0x3b, 0x72, 0x6f, 0x77, 0x73, 0x3d, 0x74,
+	0x68, 0x69, 0x73, 0x2e, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x74, 0x62,
+	0x6f, 0x64, 0x79, 0x2e, 0x72, 0x6f, 0x77, 0x73, 0x3b, 0x66, 0x6f, 0x72, 0x28, 0x76, 0x61, 0x72,
+	0x20, 0x74, 0x3d, 0x30, 0x3b, 0x74, 0x3c, 0x72, 0x6f, 0x77, 0x73, 0x2e, 0x6c, 0x65, 0x6e, 0x67,
+	0x74, 0x68, 0x3b, 0x74, 0x2b, 0x2b, 0x29, 0x7b, 0x72, 0x6f, 0x77, 0x5f, 0x61, 0x72, 0x72, 0x61,
+	0x79, 0x5b, 0x72, 0x6f, 0x77, 0x5f, 0x61, 0x72, 0x72, 0x61, 0x79, 0x2e, 0x6c, 0x65, 0x6e, 0x67,
+	0x74, 0x68, 0x5d, 0x3d, 0x5b, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x67,
+	0x65, 0x74, 0x49, 0x6e, 0x6e, 0x65, 0x72, 0x54, 0x65, 0x78, 0x74, 0x28, 0x72, 0x6f, 0x77, 0x73,
+	0x5b, 0x74, 0x5d, 0x2e, 0x63, 0x65, 0x6c, 0x6c, 0x73, 0x5b, 0x63, 0x6f, 0x6c, 0x5d, 0x29, 0x2c,
+	0x72, 0x6f, 0x77, 0x73, 0x5b, 0x74, 0x5d, 0x5d, 0x7d, 0x72, 0x6f, 0x77, 0x5f, 0x61, 0x72, 0x72,
+	0x61, 0x79, 0x2e, 0x73, 0x6f, 0x72, 0x74, 0x28, 0x74, 0x68, 0x69, 0x73, 0x2e, 0x73, 0x6f, 0x72,
+	0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x73, 0x6f, 0x72, 0x74, 0x66, 0x75, 0x6e, 0x63, 0x74,
+	0x69, 0x6f, 0x6e, 0x29, 0x3b, 0x74, 0x62, 0x3d, 0x74, 0x68, 0x69, 0x73, 0x2e, 0x73, 0x6f, 0x72,
+	0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x74, 0x62, 0x6f, 0x64, 0x79, 0x3b, 0x66, 0x6f, 0x72,
+	0x28, 0x76, 0x61, 0x72, 0x20, 0x74, 0x3d, 0x30, 0x3b, 0x74, 0x3c, 0x72, 0x6f, 0x77, 0x5f, 0x61,
+	0x72, 0x72, 0x61, 0x79, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3b, 0x74, 0x2b, 0x2b, 0x29,
+	0x7b, 0x74, 0x62, 0x2e, 0x61, 0x70, 0x70, 0x65, 0x6e, 0x64, 0x43, 0x68, 0x69, 0x6c, 0x64, 0x28,
+	0x72, 0x6f, 0x77, 0x5f, 0x61, 0x72, 0x72, 0x61, 0x79, 0x5b, 0x74, 0x5d, 0x5b, 0x31, 0x5d, 0x29,
+	0x7d, 0x64, 0x65, 0x6c, 0x65, 0x74, 0x65, 0x20, 0x72, 0x6f, 0x77, 0x5f, 0x61, 0x72, 0x72, 0x61,
+	0x79, 0x7d, 0x29, 0x7d, 0x7d, 0x7d, 0x2c, 0x67, 0x75, 0x65, 0x73, 0x73, 0x54, 0x79, 0x70, 0x65,
+	0x3a, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x65, 0x2c, 0x74, 0x29, 0x7b, 0x73,
+	0x6f, 0x72, 0x74, 0x66, 0x6e, 0x3d, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x2e,
+	0x73, 0x6f, 0x72, 0x74, 0x5f, 0x61, 0x6c, 0x70, 0x68, 0x61, 0x3b, 0x66, 0x6f, 0x72, 0x28, 0x76,
+	0x61, 0x72, 0x20, 0x6e, 0x3d, 0x30, 0x3b, 0x6e, 0x3c, 0x65, 0x2e, 0x74, 0x42, 0x6f, 0x64, 0x69,
+	0x65, 0x73, 0x5b, 0x30, 0x5d, 0x2e, 0x72, 0x6f, 0x77, 0x73, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74,
+	0x68, 0x3b, 0x6e, 0x2b, 0x2b, 0x29, 0x7b, 0x74, 0x65, 0x78, 0x74, 0x3d, 0x73, 0x6f, 0x72, 0x74,
+	0x74, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x67, 0x65, 0x74, 0x49, 0x6e, 0x6e, 0x65, 0x72, 0x54, 0x65,
+	0x78, 0x74, 0x28, 0x65, 0x2e, 0x74, 0x42, 0x6f, 0x64, 0x69, 0x65, 0x73, 0x5b, 0x30, 0x5d, 0x2e,
+	0x72, 0x6f, 0x77, 0x73, 0x5b, 0x6e, 0x5d, 0x2e, 0x63, 0x65, 0x6c, 0x6c, 0x73, 0x5b, 0x74, 0x5d,
+	0x29, 0x3b, 0x69, 0x66, 0x28, 0x74, 0x65, 0x78, 0x74, 0x21, 0x3d, 0x22, 0x22, 0x29, 0x7b, 0x69,
+	0x66, 0x28, 0x74, 0x65, 0x78, 0x74, 0x2e, 0x6d, 0x61, 0x74, 0x63, 0x68, 0x28, 0x2f, 0x5e, 0x2d,
+	0x3f, 0x5b, 0xa3, 0x24, 0xa4, 0x5d, 0x3f, 0x5b, 0x5c, 0x64, 0x2c, 0x2e, 0x5d, 0x2b, 0x25, 0x3f,
+	0x24, 0x2f, 0x29, 0x29, 0x7b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x73, 0x6f, 0x72, 0x74,
+	0x74, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x73, 0x6f, 0x72, 0x74, 0x5f, 0x6e, 0x75, 0x6d, 0x65, 0x72,
+	0x69, 0x63, 0x7d, 0x70, 0x6f, 0x73, 0x73, 0x64, 0x61, 0x74, 0x65, 0x3d, 0x74, 0x65, 0x78, 0x74,
+	0x2e, 0x6d, 0x61, 0x74, 0x63, 0x68, 0x28, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65,
+	0x2e, 0x44, 0x41, 0x54, 0x45, 0x5f, 0x52, 0x45, 0x29, 0x3b, 0x69, 0x66, 0x28, 0x70, 0x6f, 0x73,
+	0x73, 0x64, 0x61, 0x74, 0x65, 0x29, 0x7b, 0x66, 0x69, 0x72, 0x73, 0x74, 0x3d, 0x70, 0x61, 0x72,
+	0x73, 0x65, 0x49, 0x6e, 0x74, 0x28, 0x70, 0x6f, 0x73, 0x73, 0x64, 0x61, 0x74, 0x65, 0x5b, 0x31,
+	0x5d, 0x29, 0x3b, 0x73, 0x65, 0x63, 0x6f, 0x6e, 0x64, 0x3d, 0x70, 0x61, 0x72, 0x73, 0x65, 0x49,
+	0x6e, 0x74, 0x28, 0x70, 0x6f, 0x73, 0x73, 0x64, 0x61, 0x74, 0x65, 0x5b, 0x32, 0x5d, 0x29, 0x3b,
+	0x69, 0x66, 0x28, 0x66, 0x69, 0x72, 0x73, 0x74, 0x3e, 0x31, 0x32, 0x29, 0x7b, 0x72, 0x65, 0x74,
+	0x75, 0x72, 0x6e, 0x20, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x73, 0x6f,
+	0x72, 0x74, 0x5f, 0x64, 0x64, 0x6d, 0x6d, 0x7d, 0x65, 0x6c, 0x73, 0x65, 0x20, 0x69, 0x66, 0x28,
+	0x73, 0x65, 0x63, 0x6f, 0x6e, 0x64, 0x3e, 0x31, 0x32, 0x29, 0x7b, 0x72, 0x65, 0x74, 0x75, 0x72,
+	0x6e, 0x20, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x73, 0x6f, 0x72, 0x74,
+	0x5f, 0x6d, 0x6d, 0x64, 0x64, 0x7d, 0x65, 0x6c, 0x73, 0x65, 0x7b, 0x73, 0x6f, 0x72, 0x74, 0x66,
+	0x6e, 0x3d, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x73, 0x6f, 0x72, 0x74,
+	0x5f, 0x64, 0x64, 0x6d, 0x6d, 0x7d, 0x7d, 0x7d, 0x7d, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20,
+	0x73, 0x6f, 0x72, 0x74, 0x66, 0x6e, 0x7d, 0x2c, 0x67, 0x65, 0x74, 0x49, 0x6e, 0x6e, 0x65, 0x72,
+	0x54, 0x65, 0x78, 0x74, 0x3a, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x65, 0x29,
+	0x7b, 0x69, 0x66, 0x28, 0x21, 0x65, 0x29, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x22, 0x22, 0x3b,
+	0x68, 0x61, 0x73, 0x49, 0x6e, 0x70, 0x75, 0x74, 0x73, 0x3d, 0x74, 0x79, 0x70, 0x65, 0x6f, 0x66,
+	0x20, 0x65, 0x2e, 0x67, 0x65, 0x74, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x73, 0x42, 0x79,
+	0x54, 0x61, 0x67, 0x4e, 0x61, 0x6d, 0x65, 0x3d, 0x3d, 0x22, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69,
+	0x6f, 0x6e, 0x22, 0x26, 0x26, 0x65, 0x2e, 0x67, 0x65, 0x74, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e,
+	0x74, 0x73, 0x42, 0x79, 0x54, 0x61, 0x67, 0x4e, 0x61, 0x6d, 0x65, 0x28, 0x22, 0x69, 0x6e, 0x70,
+	0x75, 0x74, 0x22, 0x29, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3b, 0x69, 0x66, 0x28, 0x65,
+	0x2e, 0x67, 0x65, 0x74, 0x41, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x65, 0x28, 0x22, 0x73,
+	0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x63, 0x75, 0x73, 0x74, 0x6f, 0x6d, 0x6b,
+	0x65, 0x79, 0x22, 0x29, 0x21, 0x3d, 0x6e, 0x75, 0x6c, 0x6c, 0x29, 0x7b, 0x72, 0x65, 0x74, 0x75,
+	0x72, 0x6e, 0x20, 0x65, 0x2e, 0x67, 0x65, 0x74, 0x41, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74,
+	0x65, 0x28, 0x22, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x5f, 0x63, 0x75, 0x73,
+	0x74, 0x6f, 0x6d, 0x6b, 0x65, 0x79, 0x22, 0x29, 0x7d, 0x65, 0x6c, 0x73, 0x65, 0x20, 0x69, 0x66,
+	0x28, 0x74, 0x79, 0x70, 0x65, 0x6f, 0x66, 0x20, 0x65, 0x2e, 0x74, 0x65, 0x78, 0x74, 0x43, 0x6f,
+	0x6e, 0x74, 0x65, 0x6e, 0x74, 0x21, 0x3d, 0x22, 0x75, 0x6e, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x65,
+	0x64, 0x22, 0x26, 0x26, 0x21, 0x68, 0x61, 0x73, 0x49, 0x6e, 0x70, 0x75, 0x74, 0x73, 0x29, 0x7b,
+	0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x65, 0x2e, 0x74, 0x65, 0x78, 0x74, 0x43, 0x6f, 0x6e,
+	0x74, 0x65, 0x6e, 0x74, 0x2e, 0x72, 0x65, 0x70, 0x6c, 0x61, 0x63, 0x65, 0x28, 0x2f, 0x5e, 0x5c,
+	0x73, 0x2b, 0x7c, 0x5c, 0x73, 0x2b, 0x24, 0x2f, 0x67, 0x2c, 0x22, 0x22, 0x29, 0x7d, 0x65, 0x6c,
+	0x73, 0x65, 0x20, 0x69, 0x66, 0x28, 0x74, 0x79, 0x70, 0x65, 0x6f, 0x66, 0x20, 0x65, 0x2e, 0x69,
+	0x6e, 0x6e, 0x65, 0x72, 0x54, 0x65, 0x78, 0x74, 0x21, 0x3d, 0x22, 0x75, 0x6e, 0x64, 0x65, 0x66,
+	0x69, 0x6e, 0x65, 0x64, 0x22, 0x26, 0x26, 0x21, 0x68, 0x61, 0x73, 0x49, 0x6e, 0x70, 0x75, 0x74,
+	0x73, 0x29, 0x7b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x65, 0x2e, 0x69, 0x6e, 0x6e, 0x65,
+	0x72, 0x54, 0x65, 0x78, 0x74, 0x2e, 0x72, 0x65, 0x70, 0x6c, 0x61, 0x63, 0x65, 0x28, 0x2f, 0x5e,
+	0x5c, 0x73, 0x2b, 0x7c, 0x5c, 0x73, 0x2b, 0x24, 0x2f, 0x67, 0x2c, 0x22, 0x22, 0x29, 0x7d, 0x65,
+	0x6c, 0x73, 0x65, 0x20, 0x69, 0x66, 0x28, 0x74, 0x79, 0x70, 0x65, 0x6f, 0x66, 0x20, 0x65, 0x2e,
+	0x74, 0x65, 0x78, 0x74, 0x21, 0x3d, 0x22, 0x75, 0x6e, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x65, 0x64,
+	0x22, 0x26, 0x26, 0x21, 0x68, 0x61, 0x73, 0x49, 0x6e, 0x70, 0x75, 0x74, 0x73, 0x29, 0x7b, 0x72,
+	0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x65, 0x2e, 0x74, 0x65, 0x78, 0x74, 0x2e, 0x72, 0x65, 0x70,
+	0x6c, 0x61, 0x63, 0x65, 0x28, 0x2f, 0x5e, 0x5c, 0x73, 0x2b, 0x7c, 0x5c, 0x73, 0x2b, 0x24, 0x2f,
+	0x67, 0x2c, 0x22, 0x22, 0x29, 0x7d, 0x65, 0x6c, 0x73, 0x65, 0x7b, 0x73, 0x77, 0x69, 0x74, 0x63,
+	0x68, 0x28, 0x65, 0x2e, 0x6e, 0x6f, 0x64, 0x65, 0x54, 0x79, 0x70, 0x65, 0x29, 0x7b, 0x63, 0x61,
+	0x73, 0x65, 0x20, 0x33, 0x3a, 0x69, 0x66, 0x28, 0x65, 0x2e, 0x6e, 0x6f, 0x64, 0x65, 0x4e, 0x61,
+	0x6d, 0x65, 0x2e, 0x74, 0x6f, 0x4c, 0x6f, 0x77, 0x65, 0x72, 0x43, 0x61, 0x73, 0x65, 0x28, 0x29,
+	0x3d, 0x3d, 0x22, 0x69, 0x6e, 0x70, 0x75, 0x74, 0x22, 0x29, 0x7b, 0x72, 0x65, 0x74, 0x75, 0x72,
+	0x6e, 0x20, 0x65, 0x2e, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x2e, 0x72, 0x65, 0x70, 0x6c, 0x61, 0x63,
+	0x65, 0x28, 0x2f, 0x5e, 0x5c, 0x73, 0x2b, 0x7c, 0x5c, 0x73, 0x2b, 0x24, 0x2f, 0x67, 0x2c, 0x22,
+	0x22, 0x29, 0x7d, 0x3b, 0x63, 0x61, 0x73, 0x65, 0x20, 0x34, 0x3a, 0x72, 0x65, 0x74, 0x75, 0x72,
+	0x6e, 0x20, 0x65, 0x2e, 0x6e, 0x6f, 0x64, 0x65, 0x56, 0x61, 0x6c, 0x75, 0x65, 0x2e, 0x72, 0x65,
+	0x70, 0x6c, 0x61, 0x63, 0x65, 0x28, 0x2f, 0x5e, 0x5c, 0x73, 0x2b, 0x7c, 0x5c, 0x73, 0x2b, 0x24,
+	0x2f, 0x67, 0x2c, 0x22, 0x22, 0x29, 0x3b, 0x62, 0x72, 0x65, 0x61, 0x6b, 0x3b, 0x63, 0x61, 0x73,
+	0x65, 0x20, 0x31, 0x3a, 0x63, 0x61, 0x73, 0x65, 0x20, 0x31, 0x31, 0x3a, 0x76, 0x61, 0x72, 0x20,
+	0x74, 0x3d, 0x22, 0x22, 0x3b, 0x66, 0x6f, 0x72, 0x28, 0x76, 0x61, 0x72, 0x20, 0x6e, 0x3d, 0x30,
+	0x3b, 0x6e, 0x3c, 0x65, 0x2e, 0x63, 0x68, 0x69, 0x6c, 0x64, 0x4e, 0x6f, 0x64, 0x65, 0x73, 0x2e,
+	0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3b, 0x6e, 0x2b, 0x2b, 0x29, 0x7b, 0x74, 0x2b, 0x3d, 0x73,
+	0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x67, 0x65, 0x74, 0x49, 0x6e, 0x6e, 0x65,
+	0x72, 0x54, 0x65, 0x78, 0x74, 0x28, 0x65, 0x2e, 0x63, 0x68, 0x69, 0x6c, 0x64, 0x4e, 0x6f, 0x64,
+	0x65, 0x73, 0x5b, 0x6e, 0x5d, 0x29, 0x7d, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x74, 0x2e,
+	0x72, 0x65, 0x70, 0x6c, 0x61, 0x63, 0x65, 0x28, 0x2f, 0x5e, 0x5c, 0x73, 0x2b, 0x7c, 0x5c, 0x73,
+	0x2b, 0x24, 0x2f, 0x67, 0x2c, 0x22, 0x22, 0x29, 0x3b, 0x62, 0x72, 0x65, 0x61, 0x6b, 0x3b, 0x64,
+	0x65, 0x66, 0x61, 0x75, 0x6c, 0x74, 0x3a, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x22, 0x22, 0x7d,
+	0x7d, 0x7d, 0x2c, 0x72, 0x65, 0x76, 0x65, 0x72, 0x73, 0x65, 0x3a, 0x66, 0x75, 0x6e, 0x63, 0x74,
+	0x69, 0x6f, 0x6e, 0x28, 0x65, 0x29, 0x7b, 0x6e, 0x65, 0x77, 0x72, 0x6f, 0x77, 0x73, 0x3d, 0x5b,
+	0x5d, 0x3b, 0x66, 0x6f, 0x72, 0x28, 0x76, 0x61, 0x72, 0x20, 0x74, 0x3d, 0x30, 0x3b, 0x74, 0x3c,
+	0x65, 0x2e, 0x72, 0x6f, 0x77, 0x73, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3b, 0x74, 0x2b,
+	0x2b, 0x29, 0x7b, 0x6e, 0x65, 0x77, 0x72, 0x6f, 0x77, 0x73, 0x5b, 0x6e, 0x65, 0x77, 0x72, 0x6f,
+	0x77, 0x73, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x5d, 0x3d, 0x65, 0x2e, 0x72, 0x6f, 0x77,
+	0x73, 0x5b, 0x74, 0x5d, 0x7d, 0x66, 0x6f, 0x72, 0x28, 0x76, 0x61, 0x72, 0x20, 0x74, 0x3d, 0x6e,
+	0x65, 0x77, 0x72, 0x6f, 0x77, 0x73, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x2d, 0x31, 0x3b,
+	0x74, 0x3e, 0x3d, 0x30, 0x3b, 0x74, 0x2d, 0x2d, 0x29, 0x7b, 0x65, 0x2e, 0x61, 0x70, 0x70, 0x65,
+	0x6e, 0x64, 0x43, 0x68, 0x69, 0x6c, 0x64, 0x28, 0x6e, 0x65, 0x77, 0x72, 0x6f, 0x77, 0x73, 0x5b,
+	0x74, 0x5d, 0x29, 0x7d, 0x64, 0x65, 0x6c, 0x65, 0x74, 0x65, 0x20, 0x6e, 0x65, 0x77, 0x72, 0x6f,
+	0x77, 0x73, 0x7d, 0x2c, 0x73, 0x6f, 0x72, 0x74, 0x5f, 0x6e, 0x75, 0x6d, 0x65, 0x72, 0x69, 0x63,
+	0x3a, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x65, 0x2c, 0x74, 0x29, 0x7b, 0x61,
+	0x61, 0x3d, 0x70, 0x61, 0x72, 0x73, 0x65, 0x46, 0x6c, 0x6f, 0x61, 0x74, 0x28, 0x65, 0x5b, 0x30,
+	0x5d, 0x2e, 0x72, 0x65, 0x70, 0x6c, 0x61, 0x63, 0x65, 0x28, 0x2f, 0x5b, 0x5e, 0x30, 0x2d, 0x39,
+	0x2e, 0x2d, 0x5d, 0x2f, 0x67, 0x2c, 0x22, 0x22, 0x29, 0x29, 0x3b, 0x69, 0x66, 0x28, 0x69, 0x73,
+	0x4e, 0x61, 0x4e, 0x28, 0x61, 0x61, 0x29, 0x29, 0x61, 0x61, 0x3d, 0x30, 0x3b, 0x62, 0x62, 0x3d,
+	0x70, 0x61, 0x72, 0x73, 0x65, 0x46, 0x6c, 0x6f, 0x61, 0x74, 0x28, 0x74, 0x5b, 0x30, 0x5d, 0x2e,
+	0x72, 0x65, 0x70, 0x6c, 0x61, 0x63, 0x65, 0x28, 0x2f, 0x5b, 0x5e, 0x30, 0x2d, 0x39, 0x2e, 0x2d,
+	0x5d, 0x2f, 0x67, 0x2c, 0x22, 0x22, 0x29, 0x29, 0x3b, 0x69, 0x66, 0x28, 0x69, 0x73, 0x4e, 0x61,
+	0x4e, 0x28, 0x62, 0x62, 0x29, 0x29, 0x62, 0x62, 0x3d, 0x30, 0x3b, 0x72, 0x65, 0x74, 0x75, 0x72,
+	0x6e, 0x20, 0x61, 0x61, 0x2d, 0x62, 0x62, 0x7d, 0x2c, 0x73, 0x6f, 0x72, 0x74, 0x5f, 0x61, 0x6c,
+	0x70, 0x68, 0x61, 0x3a, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x65, 0x2c, 0x74,
+	0x29, 0x7b, 0x69, 0x66, 0x28, 0x65, 0x5b, 0x30, 0x5d, 0x3d, 0x3d, 0x74, 0x5b, 0x30, 0x5d, 0x29,
+	0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x30, 0x3b, 0x69, 0x66, 0x28, 0x65, 0x5b, 0x30, 0x5d,
+	0x3c, 0x74, 0x5b, 0x30, 0x5d, 0x29, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x2d, 0x31, 0x3b, 0x72,
+	0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x31, 0x7d, 0x2c, 0x73, 0x6f, 0x72, 0x74, 0x5f, 0x64, 0x64,
+	0x6d, 0x6d, 0x3a, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x65, 0x2c, 0x74, 0x29,
+	0x7b, 0x6d, 0x74, 0x63, 0x68, 0x3d, 0x65, 0x5b, 0x30, 0x5d, 0x2e, 0x6d, 0x61, 0x74, 0x63, 0x68,
+	0x28, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x44, 0x41, 0x54, 0x45, 0x5f,
+	0x52, 0x45, 0x29, 0x3b, 0x79, 0x3d, 0x6d, 0x74, 0x63, 0x68, 0x5b, 0x33, 0x5d, 0x3b, 0x6d, 0x3d,
+	0x6d, 0x74, 0x63, 0x68, 0x5b, 0x32, 0x5d, 0x3b, 0x64, 0x3d, 0x6d, 0x74, 0x63, 0x68, 0x5b, 0x31,
+	0x5d, 0x3b, 0x69, 0x66, 0x28, 0x6d, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3d, 0x3d, 0x31,
+	0x29, 0x6d, 0x3d, 0x22, 0x30, 0x22, 0x2b, 0x6d, 0x3b, 0x69, 0x66, 0x28, 0x64, 0x2e, 0x6c, 0x65,
+	0x6e, 0x67, 0x74, 0x68, 0x3d, 0x3d, 0x31, 0x29, 0x64, 0x3d, 0x22, 0x30, 0x22, 0x2b, 0x64, 0x3b,
+	0x64, 0x74, 0x31, 0x3d, 0x79, 0x2b, 0x6d, 0x2b, 0x64, 0x3b, 0x6d, 0x74, 0x63, 0x68, 0x3d, 0x74,
+	0x5b, 0x30, 0x5d, 0x2e, 0x6d, 0x61, 0x74, 0x63, 0x68, 0x28, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61,
+	0x62, 0x6c, 0x65, 0x2e, 0x44, 0x41, 0x54, 0x45, 0x5f, 0x52, 0x45, 0x29, 0x3b, 0x79, 0x3d, 0x6d,
+	0x74, 0x63, 0x68, 0x5b, 0x33, 0x5d, 0x3b, 0x6d, 0x3d, 0x6d, 0x74, 0x63, 0x68, 0x5b, 0x32, 0x5d,
+	0x3b, 0x64, 0x3d, 0x6d, 0x74, 0x63, 0x68, 0x5b, 0x31, 0x5d, 0x3b, 0x69, 0x66, 0x28, 0x6d, 0x2e,
+	0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3d, 0x3d, 0x31, 0x29, 0x6d, 0x3d, 0x22, 0x30, 0x22, 0x2b,
+	0x6d, 0x3b, 0x69, 0x66, 0x28, 0x64, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3d, 0x3d, 0x31,
+	0x29, 0x64, 0x3d, 0x22, 0x30, 0x22, 0x2b, 0x64, 0x3b, 0x64, 0x74, 0x32, 0x3d, 0x79, 0x2b, 0x6d,
+	0x2b, 0x64, 0x3b, 0x69, 0x66, 0x28, 0x64, 0x74, 0x31, 0x3d, 0x3d, 0x64, 0x74, 0x32, 0x29, 0x72,
+	0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x30, 0x3b, 0x69, 0x66, 0x28, 0x64, 0x74, 0x31, 0x3c, 0x64,
+	0x74, 0x32, 0x29, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x2d, 0x31, 0x3b, 0x72, 0x65, 0x74, 0x75,
+	0x72, 0x6e, 0x20, 0x31, 0x7d, 0x2c, 0x73, 0x6f, 0x72, 0x74, 0x5f, 0x6d, 0x6d, 0x64, 0x64, 0x3a,
+	0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x65, 0x2c, 0x74, 0x29, 0x7b, 0x6d, 0x74,
+	0x63, 0x68, 0x3d, 0x65, 0x5b, 0x30, 0x5d, 0x2e, 0x6d, 0x61, 0x74, 0x63, 0x68, 0x28, 0x73, 0x6f,
+	0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x44, 0x41, 0x54, 0x45, 0x5f, 0x52, 0x45, 0x29,
+	0x3b, 0x79, 0x3d, 0x6d, 0x74, 0x63, 0x68, 0x5b, 0x33, 0x5d, 0x3b, 0x64, 0x3d, 0x6d, 0x74, 0x63,
+	0x68, 0x5b, 0x32, 0x5d, 0x3b, 0x6d, 0x3d, 0x6d, 0x74, 0x63, 0x68, 0x5b, 0x31, 0x5d, 0x3b, 0x69,
+	0x66, 0x28, 0x6d, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3d, 0x3d, 0x31, 0x29, 0x6d, 0x3d,
+	0x22, 0x30, 0x22, 0x2b, 0x6d, 0x3b, 0x69, 0x66, 0x28, 0x64, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74,
+	0x68, 0x3d, 0x3d, 0x31, 0x29, 0x64, 0x3d, 0x22, 0x30, 0x22, 0x2b, 0x64, 0x3b, 0x64, 0x74, 0x31,
+	0x3d, 0x79, 0x2b, 0x6d, 0x2b, 0x64, 0x3b, 0x6d, 0x74, 0x63, 0x68, 0x3d, 0x74, 0x5b, 0x30, 0x5d,
+	0x2e, 0x6d, 0x61, 0x74, 0x63, 0x68, 0x28, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c, 0x65,
+	0x2e, 0x44, 0x41, 0x54, 0x45, 0x5f, 0x52, 0x45, 0x29, 0x3b, 0x79, 0x3d, 0x6d, 0x74, 0x63, 0x68,
+	0x5b, 0x33, 0x5d, 0x3b, 0x64, 0x3d, 0x6d, 0x74, 0x63, 0x68, 0x5b, 0x32, 0x5d, 0x3b, 0x6d, 0x3d,
+	0x6d, 0x74, 0x63, 0x68, 0x5b, 0x31, 0x5d, 0x3b, 0x69, 0x66, 0x28, 0x6d, 0x2e, 0x6c, 0x65, 0x6e,
+	0x67, 0x74, 0x68, 0x3d, 0x3d, 0x31, 0x29, 0x6d, 0x3d, 0x22, 0x30, 0x22, 0x2b, 0x6d, 0x3b, 0x69,
+	0x66, 0x28, 0x64, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3d, 0x3d, 0x31, 0x29, 0x64, 0x3d,
+	0x22, 0x30, 0x22, 0x2b, 0x64, 0x3b, 0x64, 0x74, 0x32, 0x3d, 0x79, 0x2b, 0x6d, 0x2b, 0x64, 0x3b,
+	0x69, 0x66, 0x28, 0x64, 0x74, 0x31, 0x3d, 0x3d, 0x64, 0x74, 0x32, 0x29, 0x72, 0x65, 0x74, 0x75,
+	0x72, 0x6e, 0x20, 0x30, 0x3b, 0x69, 0x66, 0x28, 0x64, 0x74, 0x31, 0x3c, 0x64, 0x74, 0x32, 0x29,
+	0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x2d, 0x31, 0x3b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20,
+	0x31, 0x7d, 0x2c, 0x73, 0x68, 0x61, 0x6b, 0x65, 0x72, 0x5f, 0x73, 0x6f, 0x72, 0x74, 0x3a, 0x66,
+	0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x65, 0x2c, 0x74, 0x29, 0x7b, 0x76, 0x61, 0x72,
+	0x20, 0x6e, 0x3d, 0x30, 0x3b, 0x76, 0x61, 0x72, 0x20, 0x72, 0x3d, 0x65, 0x2e, 0x6c, 0x65, 0x6e,
+	0x67, 0x74, 0x68, 0x2d, 0x31, 0x3b, 0x76, 0x61, 0x72, 0x20, 0x69, 0x3d, 0x74, 0x72, 0x75, 0x65,
+	0x3b, 0x77, 0x68, 0x69, 0x6c, 0x65, 0x28, 0x69, 0x29, 0x7b, 0x69, 0x3d, 0x66, 0x61, 0x6c, 0x73,
+	0x65, 0x3b, 0x66, 0x6f, 0x72, 0x28, 0x76, 0x61, 0x72, 0x20, 0x73, 0x3d, 0x6e, 0x3b, 0x73, 0x3c,
+	0x72, 0x3b, 0x2b, 0x2b, 0x73, 0x29, 0x7b, 0x69, 0x66, 0x28, 0x74, 0x28, 0x65, 0x5b, 0x73, 0x5d,
+	0x2c, 0x65, 0x5b, 0x73, 0x2b, 0x31, 0x5d, 0x29, 0x3e, 0x30, 0x29, 0x7b, 0x76, 0x61, 0x72, 0x20,
+	0x6f, 0x3d, 0x65, 0x5b, 0x73, 0x5d, 0x3b, 0x65, 0x5b, 0x73, 0x5d, 0x3d, 0x65, 0x5b, 0x73, 0x2b,
+	0x31, 0x5d, 0x3b, 0x65, 0x5b, 0x73, 0x2b, 0x31, 0x5d, 0x3d, 0x6f, 0x3b, 0x69, 0x3d, 0x74, 0x72,
+	0x75, 0x65, 0x7d, 0x7d, 0x72, 0x2d, 0x2d, 0x3b, 0x69, 0x66, 0x28, 0x21, 0x69, 0x29, 0x62, 0x72,
+	0x65, 0x61, 0x6b, 0x3b, 0x66, 0x6f, 0x72, 0x28, 0x76, 0x61, 0x72, 0x20, 0x73, 0x3d, 0x72, 0x3b,
+	0x73, 0x3e, 0x6e, 0x3b, 0x2d, 0x2d, 0x73, 0x29, 0x7b, 0x69, 0x66, 0x28, 0x74, 0x28, 0x65, 0x5b,
+	0x73, 0x5d, 0x2c, 0x65, 0x5b, 0x73, 0x2d, 0x31, 0x5d, 0x29, 0x3c, 0x30, 0x29, 0x7b, 0x76, 0x61,
+	0x72, 0x20, 0x6f, 0x3d, 0x65, 0x5b, 0x73, 0x5d, 0x3b, 0x65, 0x5b, 0x73, 0x5d, 0x3d, 0x65, 0x5b,
+	0x73, 0x2d, 0x31, 0x5d, 0x3b, 0x65, 0x5b, 0x73, 0x2d, 0x31, 0x5d, 0x3d, 0x6f, 0x3b, 0x69, 0x3d,
+	0x74, 0x72, 0x75, 0x65, 0x7d, 0x7d, 0x6e, 0x2b, 0x2b, 0x7d, 0x7d, 0x7d, 0x3b, 0x69, 0x66, 0x28,
+	0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x61, 0x64, 0x64, 0x45, 0x76, 0x65, 0x6e,
+	0x74, 0x4c, 0x69, 0x73, 0x74, 0x65, 0x6e, 0x65, 0x72, 0x29, 0x7b, 0x64, 0x6f, 0x63, 0x75, 0x6d,
+	0x65, 0x6e, 0x74, 0x2e, 0x61, 0x64, 0x64, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x4c, 0x69, 0x73, 0x74,
+	0x65, 0x6e, 0x65, 0x72, 0x28, 0x22, 0x44, 0x4f, 0x4d, 0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74,
+	0x4c, 0x6f, 0x61, 0x64, 0x65, 0x64, 0x22, 0x2c, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c,
+	0x65, 0x2e, 0x69, 0x6e, 0x69, 0x74, 0x2c, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x29, 0x7d, 0x69, 0x66,
+	0x28, 0x2f, 0x57, 0x65, 0x62, 0x4b, 0x69, 0x74, 0x2f, 0x69, 0x2e, 0x74, 0x65, 0x73, 0x74, 0x28,
+	0x6e, 0x61, 0x76, 0x69, 0x67, 0x61, 0x74, 0x6f, 0x72, 0x2e, 0x75, 0x73, 0x65, 0x72, 0x41, 0x67,
+	0x65, 0x6e, 0x74, 0x29, 0x29, 0x7b, 0x76, 0x61, 0x72, 0x20, 0x5f, 0x74, 0x69, 0x6d, 0x65, 0x72,
+	0x3d, 0x73, 0x65, 0x74, 0x49, 0x6e, 0x74, 0x65, 0x72, 0x76, 0x61, 0x6c, 0x28, 0x66, 0x75, 0x6e,
+	0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x29, 0x7b, 0x69, 0x66, 0x28, 0x2f, 0x6c, 0x6f, 0x61, 0x64,
+	0x65, 0x64, 0x7c, 0x63, 0x6f, 0x6d, 0x70, 0x6c, 0x65, 0x74, 0x65, 0x2f, 0x2e, 0x74, 0x65, 0x73,
+	0x74, 0x28, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x72, 0x65, 0x61, 0x64, 0x79,
+	0x53, 0x74, 0x61, 0x74, 0x65, 0x29, 0x29, 0x7b, 0x73, 0x6f, 0x72, 0x74, 0x74, 0x61, 0x62, 0x6c,
+	0x65, 0x2e, 0x69, 0x6e, 0x69, 0x74, 0x28, 0x29, 0x7d, 0x7d, 0x2c, 0x31, 0x30, 0x29, 0x7d, 0x77,
+	0x69, 0x6e, 0x64, 0x6f, 0x77, 0x2e, 0x6f, 0x6e, 0x6c, 0x6f, 0x61, 0x64, 0x3d, 0x73, 0x6f, 0x72,
+	0x74, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x2e, 0x69, 0x6e, 0x69, 0x74, 0x3b, 0x64, 0x65, 0x61, 0x6e,
+	0x5f, 0x61, 0x64, 0x64, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x2e, 0x67, 0x75, 0x69, 0x64, 0x3d, 0x31,
+	0x3b, 0x66, 0x69, 0x78, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x2e, 0x70, 0x72, 0x65, 0x76, 0x65, 0x6e,
+	0x74, 0x44, 0x65, 0x66, 0x61, 0x75, 0x6c, 0x74, 0x3d, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f,
+	0x6e, 0x28, 0x29, 0x7b, 0x74, 0x68, 0x69, 0x73, 0x2e, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x56,
+	0x61, 0x6c, 0x75, 0x65, 0x3d, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x7d, 0x3b, 0x66, 0x69, 0x78, 0x45,
+	0x76, 0x65, 0x6e, 0x74, 0x2e, 0x73, 0x74, 0x6f, 0x70, 0x50, 0x72, 0x6f, 0x70, 0x61, 0x67, 0x61,
+	0x74, 0x69, 0x6f, 0x6e, 0x3d, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x29, 0x7b,
+	0x74, 0x68, 0x69, 0x73, 0x2e, 0x63, 0x61, 0x6e, 0x63, 0x65, 0x6c, 0x42, 0x75, 0x62, 0x62, 0x6c,
+	0x65, 0x3d, 0x74, 0x72, 0x75, 0x65, 0x7d, 0x3b, 0x69, 0x66, 0x28, 0x21, 0x41, 0x72, 0x72, 0x61,
+	0x79, 0x2e, 0x66, 0x6f, 0x72, 0x45, 0x61, 0x63, 0x68, 0x29, 0x7b, 0x41, 0x72, 0x72, 0x61, 0x79,
+	0x2e, 0x66, 0x6f, 0x72, 0x45, 0x61, 0x63, 0x68, 0x3d, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f,
+	0x6e, 0x28, 0x65, 0x2c, 0x74, 0x2c, 0x6e, 0x29, 0x7b, 0x66, 0x6f, 0x72, 0x28, 0x76, 0x61, 0x72,
+	0x20, 0x72, 0x3d, 0x30, 0x3b, 0x72, 0x3c, 0x65, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3b,
+	0x72, 0x2b, 0x2b, 0x29, 0x7b, 0x74, 0x2e, 0x63, 0x61, 0x6c, 0x6c, 0x28, 0x6e, 0x2c, 0x65, 0x5b,
+	0x72, 0x5d, 0x2c, 0x72, 0x2c, 0x65, 0x29, 0x7d, 0x7d, 0x7d, 0x46, 0x75, 0x6e, 0x63, 0x74, 0x69,
+	0x6f, 0x6e, 0x2e, 0x70, 0x72, 0x6f, 0x74, 0x6f, 0x74, 0x79, 0x70, 0x65, 0x2e, 0x66, 0x6f, 0x72,
+	0x45, 0x61, 0x63, 0x68, 0x3d, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x65, 0x2c,
+	0x74, 0x2c, 0x6e, 0x29, 0x7b, 0x66, 0x6f, 0x72, 0x28, 0x76, 0x61, 0x72, 0x20, 0x72, 0x20, 0x69,
+	0x6e, 0x20, 0x65, 0x29, 0x7b, 0x69, 0x66, 0x28, 0x74, 0x79, 0x70, 0x65, 0x6f, 0x66, 0x20, 0x74,
+	0x68, 0x69, 0x73, 0x2e, 0x70, 0x72, 0x6f, 0x74, 0x6f, 0x74, 0x79, 0x70, 0x65, 0x5b, 0x72, 0x5d,
+	0x3d, 0x3d, 0x22, 0x75, 0x6e, 0x64, 0x65, 0x66, 0x69, 0x6e, 0x65, 0x64, 0x22, 0x29, 0x7b, 0x74,
+	0x2e, 0x63, 0x61, 0x6c, 0x6c, 0x28, 0x6e, 0x2c, 0x65, 0x5b, 0x72, 0x5d, 0x2c, 0x72, 0x2c, 0x65,
+	0x29, 0x7d, 0x7d, 0x7d, 0x3b, 0x53, 0x74, 0x72, 0x69, 0x6e, 0x67, 0x2e, 0x66, 0x6f, 0x72, 0x45,
+	0x61, 0x63, 0x68, 0x3d, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x65, 0x2c, 0x74,
+	0x2c, 0x6e, 0x29, 0x7b, 0x41, 0x72, 0x72, 0x61, 0x79, 0x2e, 0x66, 0x6f, 0x72, 0x45, 0x61, 0x63,
+	0x68, 0x28, 0x65, 0x2e, 0x73, 0x70, 0x6c, 0x69, 0x74, 0x28, 0x22, 0x22, 0x29, 0x2c, 0x66, 0x75,
+	0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x72, 0x2c, 0x69, 0x29, 0x7b, 0x74, 0x2e, 0x63, 0x61,
+	0x6c, 0x6c, 0x28, 0x6e, 0x2c, 0x72, 0x2c, 0x69, 0x2c, 0x65, 0x29, 0x7d, 0x29, 0x7d, 0x3b, 0x76,
+	0x61, 0x72, 0x20, 0x66, 0x6f, 0x72, 0x45, 0x61, 0x63, 0x68, 0x3d, 0x66, 0x75, 0x6e, 0x63, 0x74,
+	0x69, 0x6f, 0x6e, 0x28, 0x65, 0x2c, 0x74, 0x2c, 0x6e, 0x29, 0x7b, 0x69, 0x66, 0x28, 0x65, 0x29,
+	0x7b, 0x76, 0x61, 0x72, 0x20, 0x72, 0x3d, 0x4f, 0x62, 0x6a, 0x65, 0x63, 0x74, 0x3b, 0x69, 0x66,
+	0x28, 0x65, 0x20, 0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x6f, 0x66, 0x20, 0x46, 0x75,
+	0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x7b, 0x72, 0x3d, 0x46, 0x75, 0x6e, 0x63, 0x74, 0x69,
+	0x6f, 0x6e, 0x7d, 0x65, 0x6c, 0x73, 0x65, 0x20, 0x69, 0x66, 0x28, 0x65, 0x2e, 0x66, 0x6f, 0x72,
+	0x45, 0x61, 0x63, 0x68, 0x20, 0x69, 0x6e, 0x73, 0x74, 0x61, 0x6e, 0x63, 0x65, 0x6f, 0x66, 0x20,
+	0x46, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x29, 0x7b, 0x65, 0x2e, 0x66, 0x6f, 0x72, 0x45,
+	0x61, 0x63, 0x68, 0x28, 0x74, 0x2c, 0x6e, 0x29, 0x3b, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x7d,
+	0x65, 0x6c, 0x73, 0x65, 0x20, 0x69, 0x66, 0x28, 0x74, 0x79, 0x70, 0x65, 0x6f, 0x66, 0x20, 0x65,
+	0x3d, 0x3d, 0x22, 0x73, 0x74, 0x72, 0x69, 0x6e, 0x67, 0x22, 0x29, 0x7b, 0x72, 0x3d, 0x53, 0x74,
+	0x72, 0x69, 0x6e, 0x67, 0x7d, 0x65, 0x6c, 0x73, 0x65, 0x20, 0x69, 0x66, 0x28, 0x74, 0x79, 0x70,
+	0x65, 0x6f, 0x66, 0x20, 0x65, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x3d, 0x3d, 0x22, 0x6e,
+	0x75, 0x6d, 0x62, 0x65, 0x72, 0x22, 0x29, 0x7b, 0x72, 0x3d, 0x41, 0x72, 0x72, 0x61, 0x79, 0x7d,
+	0x72, 0x2e, 0x66, 0x6f, 0x72, 0x45, 0x61, 0x63, 0x68, 0x28, 0x65, 0x2c, 0x74, 0x2c, 0x6e, 0x29,
+	0x7d, 0x7d,
+};
+
+static const uint8_t kScriptsJsGzip[] =
+{
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xd5, 0x59, 0xef, 0x72, 0xdb, 0xb8,
+	0x11, 0x7f, 0x15, 0x99, 0x75, 0x7d, 0xc2, 0x48, 0xa2, 0xa4, 0xdc, 0x5d, 0x67, 0x6a, 0x1a, 0xf6,
+	0xc4, 0x89, 0x33, 0xe7, 0xb9, 0x5c, 0xae, 0xd3, 0x64, 0x7a, 0x1f, 0x64, 0xc5, 0x03, 0x89, 0x90,
+	0xcc, 0x86, 0x02, 0x35, 0x04, 0x64, 0xc5, 0x95, 0xf9, 0x34, 0xed, 0x83, 0x76, 0x17, 0x7f, 0x48,
+	0x90, 0xa2, 0x12, 0x7b, 0xd2, 0xc9, 0x4c, 0x3f, 0xd8, 0x22, 0x16, 0x8b, 0xdd, 0xc5, 0x6f, 0x81,
+	0xdd, 0x05, 0xb0, 0xd8, 0x88, 0xb9, 0x4a, 0x32, 0xd1, 0x89, 0x39, 0x13, 0xb7, 0x2c, 0x8e, 0xaf,
+	0xee, 0xb9, 0x50, 0x5d, 0xde, 0x57, 0x7d, 0x41, 0x76, 0xc9, 0xa2, 0xcb, 0x43, 0x47, 0x7c, 0x9b,
+	0x48, 0xc5, 0x05, 0xcf, 0xc9, 0x6e, 0x9f, 0xd6, 0x05, 0xf6, 0xfe, 0x82, 0xa5, 0x92, 0x93, 0x82,
+	0xc3, 0x7f, 0x1c, 0x79, 0x24, 0xc2, 0xe3, 0xe3, 0xe5, 0x26, 0x89, 0x89, 0xfb, 0xa0, 0x35, 0x25,
+	0x21, 0x92, 0x7a, 0xbd, 0x08, 0x59, 0x79, 0xc8, 0x91, 0x24, 0x89, 0xfb, 0xa0, 0xbb, 0x22, 0xba,
+	0x67, 0x79, 0x27, 0xa7, 0x8e, 0x32, 0x51, 0x53, 0xcd, 0x0a, 0xfa, 0x6b, 0x44, 0xe4, 0x44, 0x3b,
+	0x27, 0x41, 0x26, 0x82, 0x9e, 0x9a, 0x42, 0xf7, 0x64, 0x34, 0xa5, 0x65, 0xbb, 0x28, 0xf2, 0x89,
+	0x33, 0x60, 0x4a, 0x45, 0x54, 0x76, 0xd0, 0x3b, 0x26, 0xe2, 0x94, 0x6b, 0x5b, 0x8a, 0x62, 0xe1,
+	0x80, 0xc8, 0xf9, 0x2a, 0xbb, 0xe7, 0xfb, 0x30, 0x78, 0x74, 0x1f, 0x89, 0x16, 0x72, 0x1b, 0x18,
+	0xce, 0xe0, 0x93, 0x13, 0xcf, 0x74, 0xb2, 0x8b, 0x79, 0xca, 0x15, 0xef, 0x78, 0xb4, 0xca, 0xd6,
+	0xc2, 0x33, 0xca, 0x33, 0xb5, 0xcb, 0xc9, 0x0e, 0x91, 0x51, 0x54, 0xe5, 0x1b, 0x1e, 0x71, 0xca,
+	0x1f, 0x1f, 0x17, 0xc9, 0x67, 0xd3, 0xd7, 0xed, 0xaa, 0xbb, 0x44, 0x86, 0xd9, 0x16, 0xcc, 0x78,
+	0x9d, 0xcd, 0x37, 0x2b, 0x20, 0x3e, 0x3e, 0x6a, 0x5a, 0x5c, 0x6b, 0x92, 0x70, 0xcd, 0x72, 0x68,
+	0xfd, 0x91, 0x88, 0x38, 0xdb, 0x3e, 0x3e, 0x6e, 0xf5, 0x2f, 0x31, 0x76, 0x10, 0x0d, 0xbd, 0xa0,
+	0x7a, 0x9c, 0xb5, 0x8c, 0x87, 0xea, 0x61, 0xcd, 0xa7, 0xd1, 0x22, 0xcb, 0xbb, 0xda, 0x31, 0x9d,
+	0x44, 0x74, 0x00, 0x1b, 0xcd, 0x73, 0x7c, 0xec, 0x19, 0x48, 0xc5, 0x24, 0xd7, 0xae, 0xda, 0xef,
+	0x02, 0xdb, 0x29, 0xa5, 0x06, 0x9a, 0x9d, 0x32, 0x1f, 0xe0, 0x1f, 0xae, 0x36, 0xb9, 0xe8, 0xa8,
+	0x6a, 0xba, 0xe5, 0x7c, 0x38, 0x42, 0xbc, 0xce, 0xb5, 0x0d, 0xaf, 0xf9, 0x82, 0x6d, 0x52, 0x18,
+	0x65, 0x3b, 0x1b, 0xf4, 0x88, 0x87, 0x52, 0x65, 0xeb, 0xbf, 0xe5, 0xd9, 0x9a, 0x2d, 0x19, 0x8a,
+	0xa9, 0x38, 0x1b, 0x1d, 0x91, 0xd5, 0xc8, 0x0b, 0x9c, 0x89, 0x54, 0xd7, 0xf2, 0xfa, 0xca, 0x18,
+	0x13, 0xc9, 0x2c, 0x57, 0x8a, 0xcd, 0x52, 0x4e, 0x77, 0x89, 0x48, 0xd4, 0xa9, 0x33, 0xa9, 0xab,
+	0x57, 0x01, 0xcb, 0x97, 0x1a, 0x43, 0x19, 0xce, 0x59, 0x9a, 0x72, 0x0e, 0xa0, 0x0a, 0x4e, 0x8c,
+	0xb4, 0xa8, 0xb5, 0xd3, 0x38, 0x09, 0x86, 0xde, 0xaa, 0x64, 0x05, 0x2b, 0x66, 0x9e, 0x72, 0x96,
+	0x5f, 0x0b, 0xc5, 0xf3, 0x7b, 0x96, 0x3a, 0xa2, 0x5e, 0xd7, 0xce, 0x3f, 0xe1, 0x3c, 0xe7, 0x4c,
+	0xf1, 0xab, 0x94, 0x1b, 0x6f, 0x55, 0x1d, 0x4b, 0xae, 0x2c, 0x55, 0x5e, 0x3e, 0x7c, 0x60, 0xcb,
+	0x77, 0x6c, 0x55, 0x2a, 0x2f, 0xed, 0x0e, 0x5f, 0xbf, 0xfc, 0x70, 0x75, 0xfb, 0xf7, 0x2b, 0x3a,
+	0xfc, 0xd8, 0xbd, 0x89, 0x6f, 0xe2, 0x0b, 0x32, 0xb9, 0x19, 0xde, 0x84, 0x83, 0x69, 0xa3, 0xa5,
+	0x9b, 0xe4, 0x42, 0xff, 0x3f, 0x1e, 0xa2, 0x5b, 0xaf, 0xd8, 0xfc, 0xae, 0xfb, 0x45, 0x65, 0xdd,
+	0x40, 0xab, 0x08, 0x48, 0xbf, 0x84, 0x85, 0xdb, 0xdd, 0x31, 0x4f, 0x99, 0x94, 0xc8, 0x13, 0x4a,
+	0x98, 0x20, 0x08, 0x1a, 0xde, 0xcc, 0xd0, 0x26, 0xe4, 0xbf, 0x99, 0x0d, 0xc9, 0x11, 0x1d, 0x8c,
+	0xc9, 0xae, 0xb2, 0x72, 0xc5, 0x3e, 0xf1, 0xf7, 0xb6, 0x1f, 0x84, 0x14, 0x05, 0x29, 0xfa, 0x3e,
+	0xed, 0x74, 0x4f, 0xc3, 0x01, 0x83, 0xee, 0x38, 0x8b, 0x03, 0x12, 0xa6, 0x5c, 0x2c, 0xd5, 0x1d,
+	0xa5, 0x23, 0x5c, 0x91, 0x9c, 0xb6, 0x83, 0x59, 0xb2, 0x47, 0xf0, 0x1b, 0xb2, 0xf5, 0x9a, 0x8b,
+	0xf8, 0xd5, 0x5d, 0x92, 0xc6, 0xb8, 0xbd, 0xb3, 0xad, 0x84, 0xb8, 0x41, 0x60, 0x19, 0x25, 0x42,
+	0xf2, 0x5c, 0x5d, 0x72, 0xc0, 0x84, 0xc3, 0x22, 0xe6, 0x7d, 0x1e, 0x2e, 0x92, 0x5c, 0x2a, 0xcd,
+	0x4a, 0x0a, 0x6d, 0x8d, 0xfa, 0x05, 0x04, 0x51, 0x2a, 0x36, 0x69, 0x4a, 0x5c, 0xeb, 0x2b, 0x36,
+	0x82, 0xf4, 0xa8, 0x1a, 0xab, 0x15, 0x5a, 0xb3, 0x8f, 0xe8, 0xd8, 0xf7, 0xe3, 0x2c, 0x53, 0x2a,
+	0x5b, 0x61, 0x3f, 0x9d, 0x54, 0x1b, 0x4e, 0xd1, 0x51, 0xa4, 0xce, 0xb8, 0x3f, 0x2e, 0x52, 0xbd,
+	0x9e, 0x8b, 0x4e, 0x68, 0xbe, 0x9a, 0x1e, 0xf4, 0x83, 0x91, 0x59, 0xf7, 0x44, 0xa5, 0x67, 0x52,
+	0x6f, 0x5a, 0xf1, 0x10, 0x44, 0x9d, 0xdc, 0x02, 0x67, 0x5d, 0x67, 0xb2, 0x8a, 0xd5, 0x9b, 0x2c,
+	0x53, 0x16, 0x88, 0x9d, 0x5a, 0x64, 0x87, 0xa1, 0x5f, 0x00, 0x63, 0x80, 0xf8, 0xfa, 0xc0, 0x03,
+	0x95, 0x14, 0xf5, 0x29, 0xb6, 0xda, 0x62, 0xa6, 0x0a, 0xdc, 0xb5, 0xd1, 0x8d, 0x59, 0x40, 0x44,
+	0x2d, 0x6c, 0x44, 0xad, 0xf7, 0x14, 0xe8, 0x01, 0xf8, 0xa0, 0x3e, 0xf8, 0xe0, 0x8f, 0x70, 0xce,
+	0xd3, 0x54, 0x36, 0x20, 0xb6, 0xbc, 0x4d, 0x8c, 0x8f, 0x2c, 0xbd, 0x8e, 0xf2, 0x8a, 0xa9, 0x0a,
+	0x64, 0xbd, 0x72, 0x6f, 0x45, 0x86, 0xdf, 0x08, 0x35, 0xd9, 0xad, 0xa0, 0x97, 0x3e, 0x75, 0x60,
+	0x77, 0xc2, 0x06, 0xff, 0x1a, 0x0d, 0xfe, 0x3a, 0xed, 0x11, 0x1c, 0x8d, 0x8b, 0x05, 0xc7, 0x93,
+	0x1d, 0x24, 0x98, 0x3c, 0x4f, 0x62, 0x4e, 0xb1, 0x39, 0x19, 0x4f, 0x0b, 0xdb, 0x73, 0x72, 0x82,
+	0x31, 0x39, 0x5b, 0x74, 0x4a, 0x19, 0x93, 0x00, 0x3f, 0x6f, 0x83, 0x9e, 0x1b, 0x32, 0xa5, 0x34,
+	0x70, 0x5b, 0x29, 0x20, 0x3b, 0xcf, 0x94, 0x4a, 0x2f, 0x7e, 0x39, 0x1e, 0xfa, 0x05, 0x51, 0x26,
+	0x99, 0x3d, 0x43, 0x04, 0x64, 0x78, 0x2e, 0xe5, 0x07, 0xb0, 0x11, 0x33, 0x29, 0x29, 0x5a, 0x87,
+	0xce, 0xb3, 0x74, 0xb3, 0x12, 0x90, 0x7e, 0xf8, 0x67, 0xaa, 0xa2, 0x56, 0x16, 0xf0, 0x64, 0xfc,
+	0x80, 0xbe, 0xbb, 0xcc, 0xe2, 0x84, 0xa3, 0xe3, 0xa2, 0x7a, 0xb9, 0x52, 0x8d, 0xea, 0x07, 0xf3,
+	0x34, 0x99, 0x7f, 0x0a, 0xfa, 0x95, 0x11, 0x89, 0x80, 0x64, 0x88, 0x71, 0xe5, 0x8d, 0x33, 0xb0,
+	0x11, 0x5b, 0x74, 0x9e, 0x3a, 0xb4, 0x71, 0xaa, 0xf9, 0xf1, 0xb8, 0x2d, 0x90, 0x61, 0x0e, 0xca,
+	0x25, 0x37, 0x42, 0x1a, 0x26, 0x63, 0x9c, 0xf1, 0x45, 0xd3, 0x86, 0xa6, 0x9c, 0xaf, 0x53, 0x36,
+	0x87, 0x08, 0xd1, 0x54, 0x14, 0xf4, 0xf7, 0x48, 0xb7, 0x56, 0x51, 0x60, 0x85, 0x9a, 0xba, 0xc3,
+	0x6c, 0x83, 0x96, 0xa0, 0x7d, 0xf9, 0x70, 0x1d, 0x37, 0xe5, 0x2e, 0xb6, 0x31, 0xc0, 0x1c, 0x10,
+	0xa2, 0xa3, 0x0c, 0xc8, 0x83, 0xd6, 0xc1, 0xed, 0x2a, 0xd7, 0x0c, 0x16, 0x8c, 0xc7, 0x19, 0x42,
+	0xfd, 0xd6, 0x10, 0x68, 0x3a, 0x82, 0x1a, 0x13, 0x82, 0xfd, 0xcb, 0x87, 0xdf, 0xde, 0x52, 0x93,
+	0x56, 0x2f, 0x7e, 0x38, 0x11, 0x33, 0xb9, 0x3e, 0x5b, 0x64, 0x42, 0x75, 0x16, 0x30, 0x59, 0x1a,
+	0x6c, 0xf9, 0x0c, 0xec, 0x58, 0xca, 0xe0, 0xfc, 0xe7, 0xb3, 0x21, 0xd2, 0xcf, 0x7f, 0x38, 0x0d,
+	0x34, 0x57, 0x74, 0xf2, 0xa7, 0xcf, 0x2f, 0x7e, 0xbe, 0xfc, 0x29, 0x0a, 0xcc, 0x1c, 0x9b, 0x5b,
+	0xdd, 0xe8, 0x20, 0x36, 0x7d, 0x17, 0xcf, 0x71, 0x9d, 0x83, 0xef, 0xbb, 0xb9, 0xb0, 0xf4, 0xd7,
+	0xbe, 0x2b, 0xbf, 0xc1, 0x85, 0x16, 0x71, 0xeb, 0x42, 0xe3, 0xd0, 0xa7, 0xb8, 0xd0, 0x70, 0xb6,
+	0xb8, 0xd0, 0xae, 0x89, 0x1a, 0xd3, 0x73, 0x5c, 0xf8, 0x97, 0x76, 0x17, 0x5e, 0x1d, 0x72, 0xa1,
+	0xd1, 0x51, 0xba, 0x50, 0xb9, 0xc0, 0xac, 0x99, 0x4d, 0x49, 0xfa, 0x2e, 0x8b, 0x79, 0x59, 0x8f,
+	0x38, 0x86, 0x70, 0x8e, 0x22, 0xb0, 0x4b, 0xee, 0x17, 0x1f, 0x02, 0xc8, 0x18, 0x65, 0x28, 0xe4,
+	0xd1, 0x9d, 0x57, 0x8b, 0x50, 0xfe, 0x4c, 0x4f, 0xe9, 0xf4, 0xf4, 0xcc, 0xe1, 0x7a, 0x18, 0xd4,
+	0x2f, 0xad, 0x1e, 0x79, 0xda, 0x86, 0x8c, 0x6c, 0x72, 0xb5, 0xe0, 0xec, 0x3c, 0x67, 0x54, 0x90,
+	0xd4, 0x96, 0x8b, 0xc7, 0x5d, 0xb4, 0x6d, 0xe6, 0xa7, 0xad, 0x22, 0xa7, 0xd7, 0xee, 0xab, 0x9d,
+	0xb7, 0x8f, 0xbf, 0xa0, 0xd7, 0x72, 0x17, 0xf5, 0x9d, 0xd0, 0xa3, 0x41, 0x67, 0x0f, 0x9a, 0xff,
+	0xfb, 0x55, 0x9a, 0x6d, 0x6f, 0x59, 0x9e, 0xb3, 0x07, 0x2c, 0xc4, 0x20, 0x51, 0xd1, 0x46, 0x88,
+	0xf0, 0x72, 0x57, 0xa4, 0xeb, 0xb5, 0xb6, 0x10, 0xa2, 0x8b, 0x8d, 0x46, 0x8d, 0xb1, 0x57, 0xd9,
+	0x94, 0x9a, 0x26, 0xe5, 0x57, 0x59, 0x85, 0x4d, 0xbc, 0x84, 0xca, 0xd5, 0x35, 0x4e, 0xfc, 0x03,
+	0xff, 0xac, 0xba, 0x65, 0xcd, 0x87, 0x45, 0xcc, 0x04, 0x6c, 0x99, 0x92, 0xbe, 0xa5, 0x4d, 0x8b,
+	0x4a, 0x0c, 0x8e, 0x6e, 0xc6, 0x36, 0x3f, 0x5f, 0x43, 0x34, 0x9a, 0xb5, 0x1a, 0xbe, 0x6f, 0x73,
+	0xcd, 0x30, 0x5b, 0x92, 0xcd, 0x6a, 0xe8, 0x55, 0xf3, 0x80, 0xa3, 0xec, 0xb8, 0xaa, 0xc7, 0x4a,
+	0x3a, 0x14, 0xfa, 0x45, 0xd1, 0x2f, 0x0b, 0x03, 0xaf, 0xce, 0x87, 0x0a, 0xc1, 0xac, 0x7c, 0xbf,
+	0x82, 0xd0, 0x35, 0x08, 0x4b, 0xd7, 0x77, 0xac, 0xb4, 0x46, 0x80, 0x35, 0xe2, 0xcc, 0xaf, 0x06,
+	0x6a, 0x35, 0xb1, 0xd0, 0x56, 0x01, 0x3e, 0xf4, 0x00, 0x6c, 0x7b, 0x23, 0x27, 0xc2, 0x61, 0x08,
+	0x05, 0xa4, 0x3e, 0xb8, 0x02, 0xdb, 0x11, 0x85, 0x6d, 0xbd, 0xb3, 0x0d, 0x57, 0xad, 0x7d, 0x1c,
+	0x5c, 0x4c, 0xfe, 0x7d, 0xfc, 0x9f, 0xe9, 0xc5, 0xe4, 0x26, 0xee, 0x87, 0xd3, 0xde, 0x9f, 0x2f,
+	0x8e, 0xb1, 0xca, 0xb3, 0xc7, 0xc9, 0x86, 0xd5, 0x02, 0x96, 0x7b, 0x9e, 0xcc, 0x8b, 0x75, 0x26,
+	0x65, 0x0c, 0x2b, 0x9e, 0x7a, 0x92, 0xf6, 0x8e, 0x6b, 0x5a, 0xaf, 0xe3, 0x24, 0x3b, 0x7d, 0xde,
+	0xa0, 0xb0, 0x09, 0x25, 0x87, 0xc3, 0x62, 0xd9, 0x81, 0x88, 0x46, 0x92, 0xcf, 0x33, 0xd8, 0x4f,
+	0xfb, 0x9d, 0x2f, 0x8c, 0xf5, 0x7a, 0xec, 0xf9, 0xf8, 0xc5, 0x21, 0xbb, 0xe2, 0x78, 0xb5, 0xd2,
+	0xa5, 0x5c, 0x07, 0xb7, 0xbf, 0x16, 0xf6, 0x05, 0xee, 0xd5, 0x2a, 0x8e, 0x4d, 0xe1, 0xd7, 0xee,
+	0x1b, 0x2d, 0xad, 0x28, 0x0f, 0xf1, 0x86, 0x09, 0x1c, 0xec, 0x21, 0xde, 0x3c, 0xcb, 0x1d, 0xb9,
+	0x53, 0x6b, 0x10, 0x44, 0x77, 0x4c, 0x5e, 0x8b, 0xf5, 0x46, 0xc1, 0xd6, 0x31, 0xa5, 0x6c, 0xfb,
+	0x21, 0xca, 0xaf, 0x62, 0xf1, 0x0a, 0xa5, 0xfd, 0xa0, 0x95, 0xa0, 0xa4, 0xf2, 0x30, 0x18, 0xb9,
+	0x63, 0xe3, 0x4b, 0xa5, 0xf2, 0x64, 0xb6, 0x51, 0xb5, 0xe0, 0x3d, 0xdf, 0x48, 0x38, 0x1c, 0x7c,
+	0xe2, 0x0f, 0x01, 0xd4, 0x03, 0xe6, 0xf4, 0xe2, 0x6e, 0x05, 0x9e, 0x32, 0xa6, 0x04, 0xb0, 0x34,
+	0x1b, 0xbd, 0xfb, 0x0a, 0x82, 0x0c, 0xd8, 0x04, 0x6b, 0x67, 0x03, 0x31, 0x61, 0x91, 0x08, 0x88,
+	0x81, 0x27, 0x27, 0x47, 0xe5, 0x24, 0x3d, 0x1d, 0x1e, 0x7b, 0x99, 0x5b, 0x86, 0x1f, 0x6f, 0x64,
+	0xef, 0x11, 0xfe, 0x8e, 0x87, 0x4b, 0x9d, 0x55, 0xf6, 0x94, 0x24, 0x0e, 0xd3, 0xa7, 0xa8, 0x28,
+	0x99, 0x9f, 0xa1, 0x40, 0x3d, 0x51, 0xb6, 0xfa, 0xaa, 0xd8, 0x9d, 0xdc, 0x26, 0xb8, 0xd4, 0xab,
+	0xf4, 0x4c, 0x76, 0x73, 0x06, 0xea, 0x7e, 0x3c, 0x2d, 0x93, 0xb6, 0xce, 0xac, 0x2a, 0x7b, 0x9b,
+	0x6d, 0x79, 0xfe, 0x0a, 0xfa, 0xba, 0x04, 0x1c, 0x6d, 0xbd, 0x58, 0xe9, 0xba, 0x67, 0xe9, 0x86,
+	0x1f, 0x56, 0x16, 0x69, 0xa9, 0x3f, 0x9d, 0x96, 0xfc, 0x28, 0xf9, 0x1f, 0x5f, 0x1c, 0x13, 0xcd,
+	0x20, 0x07, 0x7d, 0x32, 0x03, 0xc7, 0xa7, 0xe6, 0x67, 0x7c, 0x6a, 0x42, 0x1d, 0x2c, 0xca, 0x66,
+	0xa4, 0xa9, 0x6a, 0x8f, 0x7a, 0x90, 0xe9, 0x1d, 0x0e, 0x31, 0xd5, 0x10, 0x88, 0x2e, 0xa4, 0xbc,
+	0xe2, 0xfa, 0x9a, 0x45, 0xb1, 0xb9, 0xcb, 0x3a, 0x75, 0xfb, 0x03, 0x63, 0xa5, 0x2d, 0x4f, 0x6a,
+	0xbb, 0x48, 0xf0, 0xed, 0x93, 0xef, 0x07, 0x2c, 0xef, 0xc4, 0xfe, 0xb6, 0x1c, 0xee, 0x2b, 0x11,
+	0x75, 0x9e, 0xc1, 0x38, 0x52, 0xe7, 0x28, 0x76, 0x30, 0xd0, 0x97, 0xbe, 0x5e, 0x9c, 0x77, 0x42,
+	0xbd, 0x23, 0xb7, 0x25, 0x15, 0x7d, 0x3f, 0xfa, 0x35, 0xe2, 0x3b, 0x63, 0x26, 0x6e, 0xbd, 0x49,
+	0x33, 0x06, 0x30, 0xe9, 0x08, 0xec, 0x10, 0x99, 0x7c, 0x84, 0xb3, 0x6f, 0x38, 0x98, 0x1a, 0x40,
+	0x74, 0x28, 0x4b, 0xa0, 0xb4, 0x78, 0xd7, 0x65, 0x8c, 0x10, 0x18, 0x38, 0x8a, 0x66, 0x33, 0x7f,
+	0xb4, 0x7a, 0xda, 0xe8, 0xd9, 0x8c, 0x10, 0x18, 0x38, 0x72, 0x97, 0x7e, 0x8c, 0x0d, 0x66, 0x33,
+	0x6b, 0xa4, 0x4e, 0x2c, 0x0d, 0x13, 0xf5, 0x5d, 0xf2, 0x08, 0xce, 0xcd, 0x28, 0xdf, 0x06, 0xaa,
+	0xce, 0x28, 0xb2, 0xe4, 0x33, 0x8f, 0x0a, 0xf0, 0xd8, 0xee, 0xb1, 0x95, 0x87, 0xc1, 0xb0, 0x21,
+	0x4e, 0xdf, 0x00, 0xe8, 0x89, 0x1e, 0x8c, 0xfc, 0x0f, 0xe6, 0x5c, 0xff, 0xe3, 0x34, 0x5a, 0x99,
+	0xaf, 0x17, 0x70, 0xbe, 0x75, 0x67, 0x7d, 0x7d, 0x0b, 0x50, 0x5e, 0x6f, 0x8d, 0xc9, 0x8a, 0x06,
+	0xa3, 0xa0, 0xb7, 0x42, 0x72, 0xec, 0x91, 0x63, 0x4d, 0x8e, 0xa3, 0x58, 0x8d, 0xe9, 0x43, 0x6f,
+	0x05, 0x5f, 0x5a, 0xb1, 0xfa, 0x8e, 0x8a, 0x5f, 0x58, 0xc5, 0xc8, 0x00, 0x56, 0x50, 0xa0, 0xd4,
+	0xe0, 0x03, 0xe2, 0x59, 0x45, 0xdb, 0x07, 0x0f, 0x33, 0xcd, 0xb7, 0x80, 0x17, 0x97, 0x73, 0x58,
+	0x7d, 0x5f, 0xf0, 0xfe, 0x17, 0x8a, 0xbf, 0x05, 0xbc, 0x3b, 0xf6, 0x89, 0xe7, 0xba, 0xa4, 0x6b,
+	0xc0, 0xe7, 0x62, 0x98, 0x7b, 0x48, 0x29, 0x77, 0x35, 0x12, 0x12, 0x73, 0x35, 0xbd, 0x85, 0xed,
+	0xcc, 0xbb, 0x09, 0xac, 0x7b, 0x7b, 0x03, 0xee, 0x82, 0x81, 0xa4, 0x22, 0x92, 0x67, 0x79, 0xd4,
+	0xeb, 0x99, 0xab, 0x3e, 0xdc, 0xae, 0x72, 0xda, 0x87, 0x7f, 0x3d, 0xa8, 0x42, 0xce, 0x47, 0x46,
+	0x7c, 0x46, 0x91, 0x1a, 0xe1, 0x3f, 0x6a, 0xba, 0x22, 0xf3, 0x43, 0xb3, 0xc8, 0x68, 0x80, 0xd2,
+	0x60, 0x30, 0xd0, 0x37, 0xdc, 0x09, 0x31, 0x41, 0xae, 0xd2, 0x90, 0x47, 0xf2, 0x5c, 0x44, 0x83,
+	0x41, 0x53, 0xc3, 0x00, 0x34, 0x9c, 0xb5, 0x6b, 0x18, 0x18, 0x0d, 0x83, 0x9a, 0x06, 0x08, 0xc7,
+	0x10, 0x29, 0x35, 0x4e, 0xee, 0x94, 0xb1, 0xff, 0x6a, 0x75, 0xb0, 0xab, 0x1b, 0xbc, 0xfe, 0xfd,
+	0x37, 0x9b, 0x8b, 0xdf, 0x66, 0x2c, 0xc6, 0x33, 0x9d, 0x7f, 0x7d, 0x94, 0x28, 0xf7, 0x9a, 0x03,
+	0x0a, 0x86, 0x7f, 0xf0, 0xd9, 0xaf, 0x89, 0x1a, 0x26, 0x90, 0x02, 0xa5, 0xea, 0x0a, 0x76, 0x9f,
+	0x2c, 0x99, 0xca, 0xf2, 0x70, 0x23, 0x79, 0xfe, 0x72, 0x89, 0xaf, 0x27, 0xc6, 0x6e, 0x73, 0xb7,
+	0x4f, 0x25, 0xe6, 0x05, 0x7b, 0xdd, 0x5f, 0x7f, 0x4c, 0x18, 0xa6, 0x5a, 0xd7, 0xe3, 0x3c, 0x5b,
+	0xad, 0x31, 0x80, 0x0e, 0x8d, 0xc4, 0xd2, 0x4c, 0xc0, 0x2a, 0x7e, 0x78, 0xaf, 0xb0, 0x1e, 0xf4,
+	0x6f, 0x2b, 0xd0, 0x9e, 0x2e, 0x14, 0xd1, 0xfd, 0xf1, 0x88, 0x14, 0xe6, 0xd9, 0x26, 0xcc, 0x04,
+	0xca, 0xa2, 0x75, 0xa6, 0x68, 0xff, 0xb5, 0x8d, 0x8e, 0xa3, 0x03, 0xaf, 0x27, 0xd4, 0xb3, 0xcd,
+	0x5e, 0x4e, 0xe0, 0xfa, 0xd2, 0x69, 0xd4, 0xbe, 0xd3, 0x44, 0x87, 0x9e, 0x53, 0xf6, 0xc6, 0xce,
+	0x99, 0x80, 0x7a, 0xfa, 0x72, 0x33, 0xc3, 0x77, 0x14, 0xed, 0x21, 0xed, 0xff, 0x97, 0xfa, 0xf0,
+	0x60, 0x4f, 0xf6, 0x64, 0x57, 0x6b, 0x52, 0x7f, 0xe5, 0xe2, 0x9b, 0x5b, 0xf9, 0xce, 0x84, 0x91,
+	0xfb, 0xcc, 0xad, 0xdd, 0x28, 0xd7, 0x89, 0x57, 0xbf, 0xb0, 0x74, 0x05, 0x2c, 0x95, 0x7c, 0xda,
+	0xcf, 0xfb, 0xf8, 0x7e, 0x50, 0xb8, 0xdb, 0x3d, 0x98, 0x58, 0xa6, 0x32, 0x2c, 0x68, 0xbe, 0x2e,
+	0x1b, 0xdf, 0xb0, 0xec, 0x1d, 0xa0, 0x29, 0x80, 0xcc, 0x35, 0x84, 0x13, 0x00, 0xd2, 0xa9, 0x5f,
+	0x0b, 0x1d, 0xd0, 0x1c, 0xbd, 0x87, 0x5a, 0x51, 0x2c, 0x0f, 0xaa, 0xab, 0x4d, 0x14, 0x6a, 0x03,
+	0xb9, 0x4e, 0xc1, 0x85, 0x81, 0xff, 0x8c, 0x92, 0xf7, 0x13, 0x4f, 0x38, 0xb4, 0x50, 0x32, 0x31,
+	0x4f, 0xa0, 0x87, 0xc4, 0x62, 0x46, 0x32, 0x4b, 0x2d, 0xa7, 0xbf, 0xcf, 0xfe, 0xc9, 0xe7, 0x4a,
+	0x27, 0x29, 0x98, 0x93, 0x54, 0xe8, 0x00, 0x98, 0x8e, 0xc3, 0x04, 0x9f, 0x4c, 0xdd, 0x77, 0x59,
+	0xf3, 0x95, 0xf8, 0xb4, 0x8f, 0x28, 0xbb, 0xf1, 0x39, 0xb3, 0xbc, 0xb0, 0x69, 0x16, 0x8c, 0x80,
+	0x8f, 0xd4, 0xb3, 0xc7, 0x82, 0x8d, 0x1a, 0x20, 0xf6, 0xab, 0x4a, 0x17, 0xf1, 0x02, 0xa8, 0x0a,
+	0x66, 0x3c, 0xd7, 0xbc, 0x1a, 0x95, 0x22, 0xaf, 0x70, 0xd1, 0xb3, 0x2a, 0x8a, 0xff, 0x02, 0x99,
+	0xbe, 0xb5, 0xcb, 0x92, 0x1e, 0x00, 0x00,
+};
+
+static const uint8_t kStyleCss[] =
+{
+	0x68, 0x31, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x6e, 0x74, 0x2d, 0x73, 0x69,
+	0x7a, 0x65, 0x3a, 0x20, 0x33, 0x65, 0x6d, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x74, 0x65, 0x78,
+	0x74, 0x2d, 0x61, 0x6c, 0x69, 0x67, 0x6e, 0x3a, 0x20, 0x63, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x3b,
+	0x0a, 0x7d, 0x0a, 0x0a, 0x62, 0x6f, 0x64, 0x79, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x62,
+	0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e, 0x64, 0x2d, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a,
+	0x20, 0x62, 0x6c, 0x61, 0x63, 0x6b, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x63, 0x6f, 0x6c, 0x6f,
+	0x72, 0x3a, 0x20, 0x77, 0x68, 0x69, 0x74, 0x65, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f,
+	0x6e, 0x74, 0x2d, 0x73, 0x74, 0x79, 0x6c, 0x65, 0x3a, 0x20, 0x6e, 0x6f, 0x72, 0x6d, 0x61, 0x6c,
+	0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x6e, 0x74, 0x2d, 0x66, 0x61, 0x6d, 0x69, 0x6c,
+	0x79, 0x3a, 0x20, 0x22, 0x53, 0x65, 0x67, 0x6f, 0x65, 0x20, 0x55, 0x49, 0x22, 0x2c, 0x20, 0x46,
+	0x72, 0x75, 0x74, 0x69, 0x67, 0x65, 0x72, 0x2c, 0x20, 0x22, 0x46, 0x72, 0x75, 0x74, 0x69, 0x67,
+	0x65, 0x72, 0x20, 0x4c, 0x69, 0x6e, 0x6f, 0x74, 0x79, 0x70, 0x65, 0x22, 0x2c, 0x20, 0x22, 0x44,
+	0x65, 0x6a, 0x61, 0x76, 0x75, 0x20, 0x53, 0x61, 0x6e, 0x73, 0x22, 0x2c, 0x20, 0x22, 0x48, 0x65,
+	0x6c, 0x76, 0x65, 0x74, 0x69, 0x63, 0x61, 0x20, 0x4e, 0x65, 0x75, 0x65, 0x22, 0x2c, 0x20, 0x41,
+	0x72, 0x69, 0x61, 0x6c, 0x2c, 0x20, 0x73, 0x61, 0x6e, 0x73, 0x2d, 0x73, 0x65, 0x72, 0x69, 0x66,
+	0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x6e, 0x74, 0x2d, 0x73, 0x69, 0x7a, 0x65, 0x3a,
+	0x20, 0x31, 0x36, 0x70, 0x78, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x61, 0x20, 0x7b, 0x0a, 0x20, 0x20,
+	0x20, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x77, 0x68, 0x69, 0x74, 0x65, 0x3b, 0x0a,
+	0x20, 0x20, 0x20, 0x20, 0x74, 0x65, 0x78, 0x74, 0x2d, 0x64, 0x65, 0x63, 0x6f, 0x72, 0x61, 0x74,
+	0x69, 0x6f, 0x6e, 0x3a, 0x20, 0x75, 0x6e, 0x64, 0x65, 0x72, 0x6c, 0x69, 0x6e, 0x65, 0x3b, 0x0a,
+	0x20, 0x20, 0x20, 0x20, 0x66, 0x6f, 0x6e, 0x74, 0x2d, 0x73, 0x69, 0x7a, 0x65, 0x3a, 0x20, 0x31,
+	0x36, 0x70, 0x78, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x61, 0x3a, 0x68, 0x6f, 0x76, 0x65, 0x72, 0x20,
+	0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x23, 0x63, 0x63,
+	0x63, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x20, 0x7b, 0x0a, 0x20, 0x20,
+	0x20, 0x20, 0x77, 0x69, 0x64, 0x74, 0x68, 0x3a, 0x20, 0x31, 0x30, 0x30, 0x25, 0x3b, 0x0a, 0x7d,
+	0x0a, 0x0a, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x20, 0x74, 0x68, 0x65, 0x61, 0x64, 0x20, 0x7b, 0x0a,
+	0x20, 0x20, 0x20, 0x20, 0x62, 0x61, 0x63, 0x6b, 0x67, 0x72, 0x6f, 0x75, 0x6e, 0x64, 0x2d, 0x63,
+	0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x23, 0x33, 0x33, 0x33, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20,
+	0x63, 0x6f, 0x6c, 0x6f, 0x72, 0x3a, 0x20, 0x23, 0x65, 0x65, 0x65, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a,
+	0x74, 0x61, 0x62, 0x6c, 0x65, 0x20, 0x74, 0x68, 0x20, 0x7b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x70,
+	0x61, 0x64, 0x64, 0x69, 0x6e, 0x67, 0x2d, 0x6c, 0x65, 0x66, 0x74, 0x3a, 0x20, 0x32, 0x30, 0x70,
+	0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x70, 0x61, 0x64, 0x64, 0x69, 0x6e, 0x67, 0x2d, 0x72,
+	0x69, 0x67, 0x68, 0x74, 0x20, 0x3a, 0x20, 0x32, 0x30, 0x70, 0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20,
+	0x20, 0x6d, 0x69, 0x6e, 0x2d, 0x77, 0x69, 0x64, 0x74, 0x68, 0x3a, 0x20, 0x31, 0x32, 0x30, 0x70,
+	0x78, 0x3b, 0x0a, 0x7d, 0x0a, 0x0a, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x20, 0x74, 0x64, 0x20, 0x7b,
+	0x0a, 0x20, 0x20, 0x20, 0x20, 0x70, 0x61, 0x64, 0x64, 0x69, 0x6e, 0x67, 0x2d, 0x6c, 0x65, 0x66,
+	0x74, 0x3a, 0x20, 0x35, 0x70, 0x78, 0x3b, 0x0a, 0x20, 0x20, 0x20, 0x20, 0x70, 0x61, 0x64, 0x64,
+	0x69, 0x6e, 0x67, 0x2d, 0x72, 0x69, 0x67, 0x68, 0x74, 0x3a, 0x20, 0x31, 0x30, 0x70, 0x78, 0x3b,
+	0x0a, 0x7d,
+};
+
+static const uint8_t kStyleCssGzip[] =
+{
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x7d, 0x50, 0x41, 0x4e, 0xc3, 0x30,
+	0x10, 0xbc, 0xe7, 0x15, 0xab, 0x54, 0xdc, 0x1a, 0xa9, 0x25, 0x82, 0x43, 0x72, 0x42, 0x42, 0x08,
+	0x24, 0xc4, 0xa5, 0xe2, 0x01, 0x1b, 0x7b, 0x93, 0x2c, 0x38, 0x76, 0xe5, 0x6c, 0xda, 0x06, 0xc4,
+	0xdf, 0x71, 0xd2, 0x20, 0x52, 0x28, 0xf8, 0x64, 0xcf, 0x78, 0x66, 0x67, 0xb6, 0x5e, 0xc3, 0x7b,
+	0x04, 0xe1, 0x94, 0xce, 0x4a, 0xd2, 0xf2, 0x1b, 0x65, 0x90, 0x52, 0x93, 0x8f, 0x98, 0xd0, 0x41,
+	0x12, 0x34, 0x5c, 0xd9, 0x0c, 0x14, 0x59, 0x21, 0x9f, 0x47, 0x1f, 0x51, 0x54, 0x38, 0xdd, 0x4f,
+	0xaa, 0x02, 0xd5, 0x6b, 0xe5, 0x5d, 0x67, 0x75, 0xa2, 0x9c, 0x71, 0x3e, 0x83, 0xc2, 0x04, 0xe8,
+	0x28, 0x9f, 0x90, 0x7d, 0xcd, 0x42, 0xf9, 0x6c, 0x88, 0xf4, 0x26, 0x4c, 0xb1, 0xce, 0x37, 0x68,
+	0x66, 0x78, 0x89, 0x0d, 0x9b, 0x3e, 0x83, 0x78, 0x43, 0x95, 0x23, 0x78, 0x7e, 0x88, 0x97, 0x70,
+	0xe7, 0x3b, 0xe1, 0x8a, 0xfc, 0x12, 0xe2, 0xaf, 0x2b, 0x3c, 0xb2, 0x75, 0xd2, 0x6f, 0x29, 0xd0,
+	0xf1, 0x2d, 0xbd, 0xe0, 0xae, 0x83, 0x0d, 0xda, 0x76, 0x78, 0xde, 0x93, 0xd9, 0x91, 0xb0, 0x42,
+	0x78, 0xa2, 0x6e, 0xf8, 0x70, 0xe3, 0x19, 0xcd, 0x12, 0xda, 0xc0, 0x27, 0x2d, 0x79, 0x2e, 0xf3,
+	0x9f, 0x65, 0xd7, 0xd7, 0xdb, 0xc3, 0xd8, 0x0a, 0xa7, 0x4a, 0xbf, 0x53, 0x8f, 0x6b, 0xd0, 0xa4,
+	0x9c, 0x47, 0x61, 0x17, 0x76, 0x11, 0xea, 0x92, 0x37, 0x6c, 0xe9, 0x1f, 0xb7, 0xac, 0x76, 0xbb,
+	0x10, 0xf6, 0xc4, 0x73, 0xa1, 0x94, 0x1a, 0x59, 0xc1, 0xc2, 0xd0, 0xc4, 0xed, 0x59, 0x4b, 0x1d,
+	0x94, 0xab, 0xd5, 0xc5, 0x8c, 0x93, 0x9a, 0x50, 0xff, 0xb9, 0xe4, 0x45, 0x9a, 0xa6, 0x27, 0x3b,
+	0x5e, 0x10, 0xd1, 0x89, 0x7a, 0x92, 0x6e, 0x51, 0x6b, 0xb6, 0x55, 0x62, 0xa8, 0x94, 0x0c, 0x2e,
+	0x57, 0x43, 0xba, 0x39, 0xee, 0xb9, 0xaa, 0x05, 0xe6, 0x4c, 0xc3, 0x36, 0xf9, 0x8a, 0x74, 0x44,
+	0xbf, 0x5d, 0xf5, 0x59, 0xd7, 0xab, 0xb3, 0xa6, 0x43, 0xa3, 0x51, 0xfd, 0x09, 0x94, 0x33, 0xde,
+	0x37, 0x62, 0x02, 0x00, 0x00,
+};
+
+static const EmbeddedAsset kEmbeddedAssets[] =
+{
+	{ "scripts.js", kScriptsJs, sizeof(kScriptsJs), kScriptsJsGzip, sizeof(kScriptsJsGzip) },
+	{ "style.css", kStyleCss, sizeof(kStyleCss), kStyleCssGzip, sizeof(kStyleCssGzip) },
+};
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "PrecompiledHeader.h"
 #include "Listener.h"
+#include "Utilities\Metrics.h"
 
 using namespace Tcp;
 
@@ -14,6 +15,8 @@ Listener::~Listener()
 	{
 		Stop();
 	}
+
+	Metrics::Add(Metrics::Gauge::WhitelistSize, -static_cast<int64_t>(m_IpWhitelist.size()));
 }
 
 void Listener::Stop()
@@ -27,4 +30,5 @@ void Listener::WhitelistIP(const IN6_ADDR& ip)
 {
 	CriticalSection::Lock lock(m_IpWhitelistCriticalSection);
 	m_IpWhitelist.push_back(ip);
+	Metrics::Increment(Metrics::Gauge::WhitelistSize);
 }
\ No newline at end of file
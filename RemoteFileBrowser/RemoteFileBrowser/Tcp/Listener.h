@@ -20,7 +20,7 @@ namespace Tcp
 		inline void Run(const in6_addr& address, uint16_t port, Callback callback);
 
 		template <typename Callback>
-		static inline void StartIncomingConnectionThread(Callback callback, SOCKET acceptedSocket, sockaddr_in6& clientAddress);
+		static inline void HandleIncomingConnection(Callback callback, SOCKET acceptedSocket, sockaddr_in6& clientAddress);
 
 	public:
 		Listener(bool acceptAnonymousConnections = false);
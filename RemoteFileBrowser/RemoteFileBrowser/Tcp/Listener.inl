@@ -42,7 +42,7 @@ inline SOCKET Listener::CreateListeningSocket(const in6_addr& address, uint16_t
 }
 
 template <typename Callback>
-inline void Listener::StartIncomingConnectionThread(Callback callback, SOCKET acceptedSocket, sockaddr_in6& clientAddress)
+inline void Listener::HandleIncomingConnection(Callback callback, SOCKET acceptedSocket, sockaddr_in6& clientAddress)
 {
 	const int bufferSize = 64;
 	char msgBuffer[bufferSize];
@@ -54,8 +54,8 @@ inline void Listener::StartIncomingConnectionThread(Callback callback, SOCKET ac
 	auto result = ioctlsocket(acceptedSocket, FIONBIO, &nonBlocking);
 	Utilities::Logging::LogFatalErrorIfFailed(result == SOCKET_ERROR, "Failed to set the listening socket to blocking mode: ");
 
-	std::thread t(callback, acceptedSocket, clientAddress);
-	t.detach();
+	// Callbacks only hand the connection over, so there's no need for a thread per connection
+	callback(acceptedSocket, clientAddress);
 }
 
 inline bool Listener::IsIpWhitelisted(const IN6_ADDR& ip)
@@ -89,7 +89,7 @@ void Listener::Run(const in6_addr& address, uint16_t port, Callback callback)
 		{
 			if (m_AcceptAnonymousConnections || IsIpWhitelisted(clientAddress.sin6_addr))
 			{
-				StartIncomingConnectionThread(callback, acceptedSocket, clientAddress);
+				HandleIncomingConnection(callback, acceptedSocket, clientAddress);
 			}
 			else
 			{
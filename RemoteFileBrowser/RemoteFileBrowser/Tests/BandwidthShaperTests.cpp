@@ -0,0 +1,71 @@
+#include "PrecompiledHeader.h"
+
+#if _TESTBUILD
+
+#include "CppUnitTest.h"
+#include "Utilities\BandwidthShaper.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+
+TEST_CLASS(BandwidthShaperTests)
+{
+public:
+	TEST_METHOD(DividesRateFairlyByWeight)
+	{
+		vector<BandwidthShaper::ShareRequest> requests;
+		BandwidthShaper::ShareRequest light = { 1, 0 }, heavy = { 3, 0 }, capped = { 4, 100 };
+
+		requests.push_back(light);
+		requests.push_back(heavy);
+		auto shares = BandwidthShaper::DivideFairly(1000, requests);
+		Assert::AreEqual(250ull, shares[0]);
+		Assert::AreEqual(750ull, shares[1]);
+
+		// What the capped request can't use goes to the others, in proportion to their weights
+		requests.push_back(capped);
+		shares = BandwidthShaper::DivideFairly(1000, requests);
+		Assert::AreEqual(225ull, shares[0]);
+		Assert::AreEqual(675ull, shares[1]);
+		Assert::AreEqual(100ull, shares[2]);
+
+		// Unlimited rate leaves just the caps
+		shares = BandwidthShaper::DivideFairly(0, requests);
+		Assert::AreEqual(0ull, shares[0]);
+		Assert::AreEqual(0ull, shares[1]);
+		Assert::AreEqual(100ull, shares[2]);
+	}
+
+	TEST_METHOD(ClientLimitsCapGlobalShares)
+	{
+		IN6_ADDR firstClient, secondClient;
+		ZeroMemory(&firstClient, sizeof(firstClient));
+		ZeroMemory(&secondClient, sizeof(secondClient));
+		firstClient.s6_addr[15] = 1;
+		secondClient.s6_addr[15] = 2;
+
+		BandwidthShaper::Limits limits;
+		limits.global = 900;
+		limits.perClient = 400;
+		BandwidthShaper::SetLimits(limits);
+
+		{
+			BandwidthShaper::Stream first(firstClient), second(firstClient), third(secondClient);
+
+			Assert::AreEqual(200ull, first.GetRate());
+			Assert::AreEqual(200ull, second.GetRate());
+			Assert::AreEqual(400ull, third.GetRate());
+
+			// Limits apply to streams in progress
+			limits.perConnection = 100;
+			BandwidthShaper::SetLimits(limits);
+
+			Assert::AreEqual(100ull, first.GetRate());
+			Assert::AreEqual(100ull, third.GetRate());
+		}
+
+		BandwidthShaper::SetLimits(BandwidthShaper::Limits());
+	}
+};
+
+#endif // _TESTBUILD
\ No newline at end of file
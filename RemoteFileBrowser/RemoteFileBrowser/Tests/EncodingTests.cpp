@@ -3,6 +3,9 @@
 #if _TESTBUILD
 
 #include "CppUnitTest.h"
+#include "Utilities\Base64.h"
+#include "Utilities\Escaping.h"
+#include "Utilities\Transcoding.h"
 #include "Utilities\Utilities.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
@@ -61,6 +64,93 @@ public:
 		Assert::AreEqual(reinterpret_cast<const char*>(expected), actualStr.c_str());
 	}
 
+	TEST_METHOD(TranscodersMatchWindowsOnEveryInstructionSet)
+	{
+		// ASCII runs of lengths around the vector block sizes, separated by multibyte characters of every length
+		const char* const kSeparators[] = { "\xc4\x85", "\xe6\x97\xa5", "\xf0\x9f\x98\x80" };
+		string utf8;
+
+		for (int runLength = 0; runLength < 70; runLength++)
+		{
+			utf8.append(runLength, static_cast<char>('a' + runLength % 26));
+			utf8 += kSeparators[runLength % 3];
+		}
+
+		wchar_t expectedUtf16[1024];
+		auto expectedUtf16Length = MultiByteToWideChar(CP_UTF8, 0, utf8.c_str(), static_cast<int>(utf8.length()), expectedUtf16, 1024);
+		Assert::IsTrue(expectedUtf16Length > 0);
+
+		for (int i = 0; i < static_cast<int>(Simd::InstructionSet::Count); i++)
+		{
+			auto instructionSet = static_cast<Simd::InstructionSet>(i);
+			auto utf8ToUtf16 = Transcoding::GetUtf8ToUtf16(instructionSet);
+			auto utf16ToUtf8 = Transcoding::GetUtf16ToUtf8(instructionSet);
+
+			if (!Simd::IsSupported(instructionSet) || utf8ToUtf16 == nullptr)
+				continue;
+
+			// Every prefix, so that the input ends at every position within a block
+			for (size_t length = 0; length <= utf8.length(); length++)
+			{
+				auto expectedLength = MultiByteToWideChar(CP_UTF8, 0, utf8.c_str(), static_cast<int>(length), expectedUtf16, 1024);
+
+				wchar_t utf16[1024];
+				auto utf16Length = utf8ToUtf16(utf8.c_str(), length, utf16, 1024);
+				Assert::AreEqual(static_cast<size_t>(expectedLength), utf16Length);
+				Assert::IsTrue(memcmp(expectedUtf16, utf16, utf16Length * sizeof(wchar_t)) == 0);
+
+				char roundTrip[1024];
+				auto roundTripLength = utf16ToUtf8(utf16, utf16Length, roundTrip, 1024);
+				Assert::AreEqual(string(utf8.c_str(), length), string(roundTrip, roundTripLength));
+			}
+
+			Assert::AreEqual(Transcoding::kDestinationTooSmall, utf8ToUtf16(utf8.c_str(), utf8.length(), expectedUtf16, expectedUtf16Length - 1));
+		}
+	}
+
+	TEST_METHOD(TranscodersReplaceInvalidSequences)
+	{
+		const string kPadding(40, 'x');	// Puts the invalid sequences past the first vector block
+		const struct
+		{
+			const char* utf8;
+			const wchar_t* utf16;
+		} kInvalidUtf8[] =
+		{
+			{ "a\x80z", L"a\xfffdz" },						// Lone continuation byte
+			{ "a\xc0\xafz", L"a\xfffd\xfffdz" },			// Overlong encoding
+			{ "a\xe6\x97z", L"a\xfffdz" },					// Truncated sequence
+			{ "a\xed\xa0\x80z", L"a\xfffd\xfffd\xfffdz" },	// Encoded surrogate
+			{ "a\xf4\x90\x80\x80z", L"a\xfffd\xfffd\xfffd\xfffdz" },	// Above U+10FFFF
+			{ "a\xffz", L"a\xfffdz" }
+		};
+
+		const wchar_t kLoneSurrogates[] = { L'a', 0xd800, L'b', 0xdc00, L'c', 0xd83d };
+
+		for (int i = 0; i < static_cast<int>(Simd::InstructionSet::Count); i++)
+		{
+			auto instructionSet = static_cast<Simd::InstructionSet>(i);
+			auto utf8ToUtf16 = Transcoding::GetUtf8ToUtf16(instructionSet);
+			auto utf16ToUtf8 = Transcoding::GetUtf16ToUtf8(instructionSet);
+
+			if (!Simd::IsSupported(instructionSet) || utf8ToUtf16 == nullptr)
+				continue;
+
+			for (const auto& invalid : kInvalidUtf8)
+			{
+				auto input = kPadding + invalid.utf8;
+				wchar_t utf16[128];
+
+				auto utf16Length = utf8ToUtf16(input.c_str(), input.length(), utf16, 128);
+				Assert::AreEqual(wstring(kPadding.begin(), kPadding.end()) + invalid.utf16, wstring(utf16, utf16Length));
+			}
+
+			char utf8[128];
+			auto utf8Length = utf16ToUtf8(kLoneSurrogates, sizeof(kLoneSurrogates) / sizeof(kLoneSurrogates[0]), utf8, 128);
+			Assert::AreEqual(string("a\xef\xbf\xbd" "b\xef\xbf\xbd" "c\xef\xbf\xbd"), string(utf8, utf8Length));
+		}
+	}
+
 	TEST_METHOD(CanDecodeUrl)
 	{
 		const string expected = Encoding::Utf16ToUtf8(L"http://.remoteFileBrowser.net/E:\\my docs\\C++\\memory leak.exe");
@@ -77,6 +167,54 @@ public:
 		Assert::AreEqual(expected, actual);
 	}
 
+	TEST_METHOD(CanEscapeHtml)
+	{
+		const string expected = "Tom &amp; Jerry &lt;&quot;1940&quot;&gt; &#39;Puss Gets the Boot&#39; - a long enough name to cross a vector block.avi";
+		const string actual = Encoding::EscapeHtml("Tom & Jerry <\"1940\"> 'Puss Gets the Boot' - a long enough name to cross a vector block.avi");
+
+		Assert::AreEqual(expected, actual);
+	}
+
+	TEST_METHOD(SpecialCharacterScannersMatchOnEveryInstructionSet)
+	{
+		Escaping::FindFunction (*const kGetters[])(Simd::InstructionSet) =
+		{
+			&Escaping::GetFindUrlDecodeSpecial,
+			&Escaping::GetFindUrlEncodeSpecial,
+			&Escaping::GetFindHtmlSpecial,
+			&Escaping::GetFindHeaderDelimiter
+		};
+
+		// A single special character at every position of an input long enough for a few vector blocks
+		string input(100, 'a');
+		const char kSpecialCharacters[] = { '%', '+', ' ', '/', '\\', '\x80', '\xff', '&', '<', '>', '"', '\'', '~', ':', '\r', '\n' };
+
+		for (auto getKernel : kGetters)
+		{
+			auto scalar = getKernel(Simd::InstructionSet::Scalar);
+
+			for (int i = 1; i < static_cast<int>(Simd::InstructionSet::Count); i++)
+			{
+				auto instructionSet = static_cast<Simd::InstructionSet>(i);
+				auto kernel = getKernel(instructionSet);
+
+				if (!Simd::IsSupported(instructionSet) || kernel == nullptr)
+					continue;
+
+				for (auto specialCharacter : kSpecialCharacters)
+				{
+					for (size_t position = 0; position < input.length(); position++)
+					{
+						input[position] = specialCharacter;
+						Assert::AreEqual(scalar(input.c_str(), input.length()), kernel(input.c_str(), input.length()));
+						Assert::AreEqual(scalar(input.c_str(), position), kernel(input.c_str(), position));
+						input[position] = 'a';
+					}
+				}
+			}
+		}
+	}
+
 	TEST_METHOD(CanEncodeToBase64)
 	{
 		const string expected = "UHJlcGFyZSB5b3Vyc2VsdmVzLCB0aGUgYmVsbHMgaGF2ZSB0b2xsZWQhIFNoZWx0ZXIgeW91ciB3ZWFrLCB5"
@@ -111,6 +249,114 @@ public:
 
 		Assert::AreEqual(expected, actual);
 	}
+
+	TEST_METHOD(CanDecodeBase64)
+	{
+		string decoded;
+
+		Assert::IsTrue(Encoding::DecodeBase64("", decoded));
+		Assert::AreEqual(string(), decoded);
+		Assert::IsTrue(Encoding::DecodeBase64("Zg==", decoded));
+		Assert::AreEqual(string("f"), decoded);
+		Assert::IsTrue(Encoding::DecodeBase64("Zm8=", decoded));
+		Assert::AreEqual(string("fo"), decoded);
+		Assert::IsTrue(Encoding::DecodeBase64("dXNlcjpwYXNzd29yZA==", decoded));
+		Assert::AreEqual(string("user:password"), decoded);
+
+		// Missing padding, misplaced padding, nonzero trailing bits, whitespace
+		const char* kInvalidInputs[] = { "Zg", "Zg=", "=Zg=", "Zg==Zg==", "====", "Zh==", "Zm9=", "Zm9v\r\n", "Zm 9v" };
+
+		for (auto input : kInvalidInputs)
+		{
+			Assert::IsFalse(Encoding::DecodeBase64(input, decoded));
+			Assert::AreEqual(string(), decoded);
+		}
+
+		// Streaming in uneven pieces gives the same result as the whole thing at once
+		string data;
+
+		for (int i = 0; i < 1000; i++)
+		{
+			data.push_back(static_cast<char>(i * 7919));
+		}
+
+		auto encoded = Encoding::EncodeBase64(data);
+		Base64::Encoder encoder;
+		Base64::Decoder decoder;
+		string streamEncoded, streamDecoded;
+
+		for (size_t position = 0, pieceLength = 1; position < data.length(); position += pieceLength, pieceLength = pieceLength % 13 + 1)
+		{
+			auto length = min(pieceLength, data.length() - position);
+			char buffer[64];
+			streamEncoded.append(buffer, encoder.Update(data.data() + position, length, buffer));
+		}
+
+		char finalCharacters[4];
+		streamEncoded.append(finalCharacters, encoder.Finish(finalCharacters));
+		Assert::AreEqual(encoded, streamEncoded);
+
+		for (size_t position = 0, pieceLength = 1; position < encoded.length(); position += pieceLength, pieceLength = pieceLength % 13 + 1)
+		{
+			auto length = min(pieceLength, encoded.length() - position);
+			uint8_t buffer[64];
+			size_t decodedLength;
+
+			Assert::IsTrue(decoder.Update(encoded.data() + position, length, buffer, decodedLength));
+			streamDecoded.append(reinterpret_cast<const char*>(buffer), decodedLength);
+		}
+
+		Assert::IsTrue(decoder.Finish());
+		Assert::AreEqual(data, streamDecoded);
+	}
+
+	TEST_METHOD(Base64KernelsMatchOnEveryInstructionSet)
+	{
+		// Every whole group length up to a few vector blocks, then an invalid character at every position
+		string data;
+
+		for (int i = 0; i < 300; i++)
+		{
+			data.push_back(static_cast<char>(i * 131 + 17));
+		}
+
+		auto bytes = reinterpret_cast<const uint8_t*>(data.data());
+		auto scalarEncode = Base64::GetEncode(Simd::InstructionSet::Scalar);
+
+		for (int i = 1; i < static_cast<int>(Simd::InstructionSet::Count); i++)
+		{
+			auto instructionSet = static_cast<Simd::InstructionSet>(i);
+			auto encode = Base64::GetEncode(instructionSet);
+			auto decode = Base64::GetDecode(instructionSet);
+
+			if (!Simd::IsSupported(instructionSet) || encode == nullptr)
+				continue;
+
+			string expected, actual;
+			vector<uint8_t> decoded;
+
+			for (size_t length = 0; length <= data.length(); length += 3)
+			{
+				expected.assign(length / 3 * 4, '\0');
+				actual.assign(length / 3 * 4, '\0');
+				scalarEncode(bytes, length, &expected[0]);
+				encode(bytes, length, &actual[0]);
+				Assert::AreEqual(expected, actual);
+
+				decoded.assign(length + 1, 0);
+				Assert::IsTrue(decode(expected.data(), expected.length(), decoded.data()));
+				Assert::IsTrue(equal(bytes, bytes + length, decoded.begin()));
+			}
+
+			for (size_t position = 0; position < expected.length(); position++)
+			{
+				auto character = expected[position];
+				expected[position] = position % 2 == 0 ? '=' : '\x80';
+				Assert::IsFalse(decode(expected.data(), expected.length(), decoded.data()));
+				expected[position] = character;
+			}
+		}
+	}
 };
 
 #endif // _TESTBUILD
@@ -0,0 +1,113 @@
+#include "PrecompiledHeader.h"
+
+#if _TESTBUILD
+
+#include "CppUnitTest.h"
+#include "Utilities\FileCache.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+
+TEST_CLASS(FileCacheTests)
+{
+private:
+	FileCache::Settings m_OriginalSettings;
+
+	static FileSystemProvider::File::Version MakeVersion(uint64_t size, uint64_t lastWriteTime)
+	{
+		FileSystemProvider::File::Version version = { size, lastWriteTime, 1 };
+		return version;
+	}
+
+	static FileCache::Contents MakeContents(size_t size)
+	{
+		return make_shared<vector<char>>(size, 'x');
+	}
+
+	// Requests a file the way the response handler does, caching it once it's admitted. Returns whether it was a hit
+	static bool Request(const string& path, const FileSystemProvider::File::Version& version)
+	{
+		if (FileCache::Find(path, version) != nullptr)
+		{
+			return true;
+		}
+
+		if (FileCache::ShouldAdmit(path, version.size))
+		{
+			FileCache::Insert(path, version, MakeContents(static_cast<size_t>(version.size)));
+		}
+
+		return false;
+	}
+
+public:
+	TEST_METHOD_INITIALIZE(Initialize)
+	{
+		m_OriginalSettings = FileCache::GetSettings();
+		FileCache::Clear();
+
+		FileCache::Settings settings;
+		settings.memoryBudget = 3000;
+		settings.maxFileSize = 1000;
+		settings.minRequestCount = 2;
+		FileCache::SetSettings(settings);
+	}
+
+	TEST_METHOD_CLEANUP(Cleanup)
+	{
+		FileCache::Clear();
+		FileCache::SetSettings(m_OriginalSettings);
+	}
+
+	TEST_METHOD(AdmitsFilesRequestedOftenEnough)
+	{
+		auto version = MakeVersion(100, 5);
+
+		Assert::IsFalse(Request("C:\\a.txt", version));
+		Assert::IsFalse(Request("C:\\a.txt", version));		// Admitted on this one
+		Assert::IsTrue(Request("C:\\a.txt", version));
+
+		// Too big, however popular
+		auto bigVersion = MakeVersion(1001, 5);
+
+		for (int i = 0; i < 5; i++)
+		{
+			Assert::IsFalse(Request("C:\\big.bin", bigVersion));
+		}
+	}
+
+	TEST_METHOD(MissesOnceTheFileChanges)
+	{
+		auto version = MakeVersion(100, 5);
+		Request("C:\\a.txt", version);
+		Request("C:\\a.txt", version);
+
+		Assert::IsNull(FileCache::Find("C:\\a.txt", MakeVersion(100, 6)).get());
+		Assert::IsNull(FileCache::Find("C:\\a.txt", version).get());	// The stale copy is gone for good
+	}
+
+	TEST_METHOD(EvictsLeastRecentlyUsedWithinBudget)
+	{
+		auto version = MakeVersion(1000, 5);
+		const char* kPaths[] = { "C:\\1.bin", "C:\\2.bin", "C:\\3.bin" };
+
+		for (auto path : kPaths)
+		{
+			Request(path, version);
+			Request(path, version);
+		}
+
+		// Touch the oldest, so the second is the least recently used when the fourth comes in
+		Assert::IsTrue(Request(kPaths[0], version));
+
+		Request("C:\\4.bin", version);
+		Request("C:\\4.bin", version);
+
+		Assert::IsTrue(Request(kPaths[0], version));
+		Assert::IsNull(FileCache::Find(kPaths[1], version).get());
+		Assert::IsTrue(Request(kPaths[2], version));
+		Assert::IsTrue(Request("C:\\4.bin", version));
+	}
+};
+
+#endif
\ No newline at end of file
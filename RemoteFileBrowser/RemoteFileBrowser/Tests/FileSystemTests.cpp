@@ -3,7 +3,9 @@
 #if _TESTBUILD
 
 #include "CppUnitTest.h"
+#include "Utilities\ReadaheadRing.h"
 #include "Utilities\StreamableFile.h"
+#include "Utilities\SyntheticFileSystemProvider.h"
 #include "Utilities\Utilities.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
@@ -62,6 +64,78 @@ private:
 
 		return bytes;
 	}
+
+	// The listing the providers fall back to where bulk enumeration isn't supported, which it has to match
+	static vector<FileSystem::FileInfo> EnumerateFilesWithFindFile(const wstring& path)
+	{
+		vector<FileSystem::FileInfo> result;
+		auto searchPattern = path + L"\\*.*";
+
+		WIN32_FIND_DATA findData;
+		auto findHandle = FindFirstFileExW(searchPattern.c_str(), FindExInfoBasic, &findData, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+
+		if (findHandle == INVALID_HANDLE_VALUE)
+		{
+			return result;
+		}
+
+		do
+		{
+			if (wcscmp(findData.cFileName, L".") == 0 || wcscmp(findData.cFileName, L"..") == 0)
+				continue;
+
+			auto fileStatus = (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0 ? FileSystem::FileStatus::Directory : FileSystem::FileStatus::File;
+			auto fileSize = (static_cast<uint64_t>(findData.nFileSizeHigh) << 32) | findData.nFileSizeLow;
+
+			result.emplace_back(Encoding::Utf16ToUtf8(findData.cFileName), fileStatus, FileSystem::FormatFileTime(findData.ftLastWriteTime), fileSize);
+		}
+		while (FindNextFileW(findHandle, &findData) != FALSE);
+
+		FindClose(findHandle);
+		return result;
+	}
+
+	static void SortByName(vector<FileSystem::FileInfo>& files)
+	{
+		sort(files.begin(), files.end(), [](const FileSystem::FileInfo& left, const FileSystem::FileInfo& right)
+		{
+			return left.fileName < right.fileName;
+		});
+	}
+
+	// Takes chunks up to the last one, checking each against a plain read of the same range. Position is where the chunks taken so far end.
+	// Returns false, with last error set, if reading a chunk failed
+	static bool ReceiveChunks(ReadaheadRing& ring, FileSystemProvider::File& file, uint64_t& position)
+	{
+		unique_ptr<char[]> expected(new char[StreamableFile::kMaxChunkSize]);
+
+		for (;;)
+		{
+			ReadaheadRing::Chunk chunk;
+
+			try
+			{
+				chunk = ring.AcquireChunk();
+			}
+			catch (exception)
+			{
+				return false;
+			}
+
+			uint32_t bytesRead;
+			Assert::IsTrue(file.Read(position, expected.get(), chunk.length, bytesRead));
+			Assert::IsTrue(memcmp(expected.get(), chunk.data, chunk.length) == 0);
+
+			position += chunk.length;
+			Assert::AreEqual(position == file.GetSize(), chunk.isLast);
+			ring.ReleaseChunk();
+
+			if (chunk.isLast)
+			{
+				return true;
+			}
+		}
+	}
 	
 public:
 	TEST_METHOD(CanRemoveLastPathComponent)
@@ -125,6 +199,78 @@ public:
 		Assert::IsTrue(driversFolderExists);
 	}
 
+	TEST_METHOD(BulkEnumerationMatchesFindFile)
+	{
+		wchar_t tempPath[MAX_PATH];
+		auto tempPathLength = GetTempPathW(MAX_PATH, tempPath);
+		Assert::IsTrue(tempPathLength > 0 && tempPathLength <= MAX_PATH);
+
+		auto directoryPath = wstring(tempPath) + L"RemoteFileBrowserEnumerationTests";
+		Assert::IsTrue(CreateDirectoryW(directoryPath.c_str(), nullptr) != FALSE || GetLastError() == ERROR_ALREADY_EXISTS);
+
+		// Enough long names to take several queries, with the buffer growing past its initial 64 KB. Some need surrogate pairs
+		const wchar_t* const kNameSuffixes[] =
+		{
+			L" with a plain ASCII name that is padded out to a fair length",
+			L" \u0105\u010d\u0119\u0117\u012f\u0161\u0173\u016b\u017e \u00e9\u00e8\u00ea",
+			L" \u65e5\u672c\u8a9e\u306e\u30d5\u30a1\u30a4\u30eb\u540d",
+			L" \U0001F600 outside of the basic multilingual plane"
+		};
+
+		const uint32_t kEntryCount = 2000;
+		const uint32_t kNameSuffixCount = sizeof(kNameSuffixes) / sizeof(kNameSuffixes[0]);
+		vector<wstring> entryPaths;
+
+		for (uint32_t i = 0; i < kEntryCount; i++)
+		{
+			auto entryPath = directoryPath + L"\\" + to_wstring(i) + kNameSuffixes[i % kNameSuffixCount];
+			entryPaths.push_back(entryPath);
+
+			if (i % 10 == 0)
+			{
+				Assert::IsTrue(CreateDirectoryW(entryPath.c_str(), nullptr) != FALSE || GetLastError() == ERROR_ALREADY_EXISTS);
+				continue;
+			}
+
+			// Every file gets a size of its own
+			auto fileHandle = FileSystem::CreateFilePortable(entryPath, GENERIC_WRITE, 0, CREATE_ALWAYS);
+			Assert::IsTrue(fileHandle != INVALID_HANDLE_VALUE);
+
+			LARGE_INTEGER fileSize;
+			fileSize.QuadPart = i;
+			Assert::IsTrue(SetFilePointerEx(fileHandle, fileSize, nullptr, FILE_BEGIN) != FALSE && SetEndOfFile(fileHandle) != FALSE);
+			CloseHandle(fileHandle);
+		}
+
+		auto files = FileSystem::EnumerateFiles(directoryPath);
+		auto expectedFiles = EnumerateFilesWithFindFile(directoryPath);
+
+		for (const auto& entryPath : entryPaths)
+		{
+			if (DeleteFileW(entryPath.c_str()) == FALSE)
+			{
+				RemoveDirectoryW(entryPath.c_str());
+			}
+		}
+
+		RemoveDirectoryW(directoryPath.c_str());
+
+		// Both come in directory order, which sorting takes out of the picture
+		SortByName(files);
+		SortByName(expectedFiles);
+
+		Assert::AreEqual(static_cast<size_t>(kEntryCount), expectedFiles.size());
+		Assert::AreEqual(expectedFiles.size(), files.size());
+
+		for (size_t i = 0; i < files.size(); i++)
+		{
+			Assert::AreEqual(expectedFiles[i].fileName.c_str(), files[i].fileName.c_str());
+			Assert::AreEqual(expectedFiles[i].fileStatus, files[i].fileStatus);
+			Assert::AreEqual(expectedFiles[i].dateModified.c_str(), files[i].dateModified.c_str());
+			Assert::AreEqual(expectedFiles[i].fileSize, files[i].fileSize);
+		}
+	}
+
 	TEST_METHOD(CanReadFileToVector)
 	{
 		const uint64_t kByteCount = 10456;
@@ -174,6 +320,268 @@ public:
 
 		Assert::IsTrue(DeleteFileW(kFileName.c_str()) != FALSE);
 	}
+
+	TEST_METHOD(SyntheticFileSystemIsDeterministic)
+	{
+		SyntheticFileSystemProvider::Parameters parameters;
+		SyntheticFileSystemProvider provider1(parameters), provider2(parameters);
+
+		auto files1 = provider1.EnumerateFiles(parameters.rootPath);
+		auto files2 = provider2.EnumerateFiles(parameters.rootPath + L"\\");
+
+		Assert::IsTrue(files1.size() >= parameters.minFanOut && files1.size() <= parameters.maxFanOut);
+		Assert::AreEqual(files1.size(), files2.size());
+
+		for (size_t i = 0; i < files1.size(); i++)
+		{
+			Assert::AreEqual(files1[i].fileName, files2[i].fileName);
+			Assert::AreEqual(files1[i].fileSize, files2[i].fileSize);
+			Assert::AreEqual(files1[i].dateModified, files2[i].dateModified);
+		}
+
+		parameters.seed++;
+		SyntheticFileSystemProvider provider3(parameters);
+		Assert::AreNotEqual(files1[0].fileName, provider3.EnumerateFiles(parameters.rootPath)[0].fileName);
+	}
+
+	TEST_METHOD(CancelledEnumerationStopsEarly)
+	{
+		SyntheticFileSystemProvider::Parameters parameters;
+		SyntheticFileSystemProvider provider(parameters);
+		CancellationToken cancellationToken;
+
+		Assert::IsFalse(provider.EnumerateFiles(parameters.rootPath, cancellationToken).empty());
+
+		cancellationToken.Cancel();
+		Assert::IsTrue(cancellationToken.IsCancelled());
+		Assert::IsTrue(provider.EnumerateFiles(parameters.rootPath, cancellationToken).empty());
+		Assert::IsFalse(CancellationToken::None().IsCancelled());
+	}
+
+	TEST_METHOD(CanQuerySyntheticFileSystem)
+	{
+		SyntheticFileSystemProvider::Parameters parameters;
+		parameters.directoryPercentage = 50;
+		SyntheticFileSystemProvider provider(parameters);
+
+		FileSystemProvider::SetCurrent(&provider);
+
+		// Walk down the first directory of every level, checking that listed entries resolve back to their status
+		auto path = parameters.rootPath;
+		Assert::AreEqual(FileSystem::FileStatus::Directory, FileSystem::QueryFileStatus(path));
+
+		for (int depth = 0; depth <= parameters.maxDepth; depth++)
+		{
+			auto files = FileSystem::EnumerateFiles(path);
+			Assert::IsFalse(files.empty());
+
+			wstring nextPath;
+
+			for (const auto& file : files)
+			{
+				auto filePath = path + L"\\" + Encoding::Utf8ToUtf16(file.fileName);
+				Assert::AreEqual(file.fileStatus, FileSystem::QueryFileStatus(filePath));
+
+				if (file.fileStatus == FileSystem::FileStatus::Directory && nextPath.empty())
+				{
+					nextPath = filePath;
+				}
+			}
+
+			Assert::IsTrue(depth < parameters.maxDepth || nextPath.empty());
+
+			if (nextPath.empty())
+			{
+				break;
+			}
+
+			path = nextPath;
+		}
+
+		Assert::AreEqual(FileSystem::FileStatus::FileNotFound, FileSystem::QueryFileStatus(parameters.rootPath + L"\\Nonexistent 0"));
+		Assert::AreEqual(FileSystem::FileStatus::FileNotFound, FileSystem::QueryFileStatus(parameters.rootPath + L"\\Nonexistent"));
+		Assert::AreEqual(FileSystem::FileStatus::FileNotFound, FileSystem::QueryFileStatus(L"C:\\Windows"));
+
+		FileSystemProvider::SetCurrent(nullptr);
+	}
+
+	TEST_METHOD(CanStreamSyntheticFile)
+	{
+		SyntheticFileSystemProvider::Parameters parameters;
+		parameters.maxDepth = 0;
+		parameters.minFileSize = StreamableFile::kMaxChunkSize;
+		parameters.maxFileSize = 3 * StreamableFile::kMaxChunkSize;
+		SyntheticFileSystemProvider provider(parameters);
+
+		auto files = provider.EnumerateFiles(parameters.rootPath);
+		auto filePath = parameters.rootPath + L"\\" + Encoding::Utf8ToUtf16(files[0].fileName);
+
+		FileSystemProvider::SetCurrent(&provider);
+
+		{
+			unique_ptr<char[]> buffer(new char[StreamableFile::kMaxChunkSize]);
+			StreamableFile streamableFile(filePath);
+
+			Assert::AreEqual(files[0].fileSize, streamableFile.GetFileSize());
+
+			// Positional reads of odd sizes must return the same bytes as the sequential chunks
+			auto file = provider.OpenFile(filePath);
+			Assert::IsTrue(file != nullptr);
+
+			const uint32_t kPieceSize = 1013;
+			char piece[kPieceSize];
+			uint64_t totalBytesRead = 0;
+
+			while (!streamableFile.IsEndOfFile())
+			{
+				int bytesRead;
+				streamableFile.ReadNextChunk(buffer.get(), bytesRead);
+
+				for (int offset = 0; offset < bytesRead; offset += kPieceSize)
+				{
+					uint32_t pieceBytesRead;
+					auto pieceSize = min<uint32_t>(kPieceSize, bytesRead - offset);
+
+					Assert::IsTrue(file->Read(totalBytesRead + offset, piece, pieceSize, pieceBytesRead));
+					Assert::AreEqual(pieceSize, pieceBytesRead);
+					Assert::IsTrue(memcmp(buffer.get() + offset, piece, pieceSize) == 0);
+				}
+
+				totalBytesRead += bytesRead;
+			}
+
+			Assert::AreEqual(files[0].fileSize, totalBytesRead);
+		}
+
+		FileSystemProvider::SetCurrent(nullptr);
+	}
+
+	TEST_METHOD(ReadaheadRingDeliversChunksInOrder)
+	{
+		SyntheticFileSystemProvider::Parameters parameters;
+		parameters.maxDepth = 0;
+		parameters.minFileSize = 3 * StreamableFile::kMaxChunkSize;
+		parameters.maxFileSize = 3 * StreamableFile::kMaxChunkSize;
+		SyntheticFileSystemProvider provider(parameters);
+
+		auto files = provider.EnumerateFiles(parameters.rootPath);
+		auto filePath = parameters.rootPath + L"\\" + Encoding::Utf8ToUtf16(files[0].fileName);
+
+		FileSystemProvider::SetCurrent(&provider);
+
+		{
+			StreamableFile streamableFile(filePath);
+			auto file = provider.OpenFile(filePath);
+			unique_ptr<char[]> expected(new char[StreamableFile::kMaxChunkSize]);
+
+			ReadaheadRing ring(streamableFile);
+			uint64_t position = 0;
+
+			for (;;)
+			{
+				auto chunk = ring.AcquireChunk();
+
+				// The first chunk is small, so it goes out right away
+				if (position == 0)
+				{
+					Assert::AreEqual(static_cast<uint32_t>(StreamableFile::kMinChunkSize), chunk.length);
+				}
+
+				uint32_t bytesRead;
+				Assert::IsTrue(file->Read(position, expected.get(), chunk.length, bytesRead));
+				Assert::IsTrue(memcmp(expected.get(), chunk.data, chunk.length) == 0);
+
+				position += chunk.length;
+				Assert::AreEqual(position == streamableFile.GetFileSize(), chunk.isLast);
+				ring.ReleaseChunk();
+
+				if (chunk.isLast)
+				{
+					break;
+				}
+			}
+
+			Assert::AreEqual(files[0].fileSize, position);
+		}
+
+		FileSystemProvider::SetCurrent(nullptr);
+	}
+
+	TEST_METHOD(ParallelReadersDeliverChunksInOrder)
+	{
+		SyntheticFileSystemProvider::Parameters parameters;
+		parameters.maxDepth = 0;
+		parameters.minFileSize = 32 * 1024 * 1024;
+		parameters.maxFileSize = parameters.minFileSize;
+		SyntheticFileSystemProvider provider(parameters);
+
+		auto files = provider.EnumerateFiles(parameters.rootPath);
+		auto filePath = parameters.rootPath + L"\\" + Encoding::Utf8ToUtf16(files[0].fileName);
+
+		// The same tree with slow reads streams, so sending keeps waiting on them and readers get added.
+		// The other one reads what to expect, without slowing sending down
+		parameters.readLatencyMicroseconds = 2000;
+		parameters.readBytesPerSecond = 256 * 1024 * 1024;
+		SyntheticFileSystemProvider slowProvider(parameters);
+
+		FileSystemProvider::SetCurrent(&slowProvider);
+		auto previousMaxReaders = ReadaheadRing::GetMaxReaders();
+		ReadaheadRing::SetMaxReaders(4);
+
+		{
+			StreamableFile streamableFile(filePath);
+			auto file = provider.OpenFile(filePath);
+
+			ReadaheadRing ring(streamableFile);
+			uint64_t position = 0;
+
+			Assert::IsTrue(ReceiveChunks(ring, *file, position));
+			Assert::AreEqual(files[0].fileSize, position);
+			Assert::IsTrue(ring.GetReaderCount() > 1);
+		}
+
+		ReadaheadRing::SetMaxReaders(previousMaxReaders);
+		FileSystemProvider::SetCurrent(nullptr);
+	}
+
+	TEST_METHOD(ReadaheadRingReportsReadFailuresAfterEarlierChunks)
+	{
+		SyntheticFileSystemProvider::Parameters parameters;
+		parameters.maxDepth = 0;
+		parameters.minFileSize = 32 * 1024 * 1024;
+		parameters.maxFileSize = parameters.minFileSize;
+		SyntheticFileSystemProvider provider(parameters);
+
+		auto files = provider.EnumerateFiles(parameters.rootPath);
+		auto filePath = parameters.rootPath + L"\\" + Encoding::Utf8ToUtf16(files[0].fileName);
+
+		// Slow enough for parallel reads, and failing part way through
+		parameters.readLatencyMicroseconds = 2000;
+		parameters.readBytesPerSecond = 256 * 1024 * 1024;
+		parameters.failedReadOffset = 24 * 1024 * 1024 + 1;
+		SyntheticFileSystemProvider failingProvider(parameters);
+
+		FileSystemProvider::SetCurrent(&failingProvider);
+		auto previousMaxReaders = ReadaheadRing::GetMaxReaders();
+		ReadaheadRing::SetMaxReaders(4);
+
+		{
+			StreamableFile streamableFile(filePath);
+			auto file = provider.OpenFile(filePath);
+
+			ReadaheadRing ring(streamableFile);
+			uint64_t position = 0;
+
+			// The failed range may finish while earlier ones are still being read, which still get sent first
+			Assert::IsFalse(ReceiveChunks(ring, *file, position));
+			Assert::AreEqual(static_cast<DWORD>(ERROR_NETNAME_DELETED), GetLastError());
+			Assert::IsTrue(position <= parameters.failedReadOffset);
+			Assert::IsTrue(position + StreamableFile::kMaxChunkSize > parameters.failedReadOffset);
+		}
+
+		ReadaheadRing::SetMaxReaders(previousMaxReaders);
+		FileSystemProvider::SetCurrent(nullptr);
+	}
 };
 
 #endif // _TESTBUILD
@@ -0,0 +1,123 @@
+#include "PrecompiledHeader.h"
+
+#if _TESTBUILD
+
+#include "CppUnitTest.h"
+#include "Communication\FolderSizes.h"
+#include "SyntheticShareFixture.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+using namespace Utilities;
+
+TEST_CLASS(FolderSizesTests)
+{
+private:
+	SyntheticShareFixture m_Share;
+	string m_RootPath;
+
+	static FolderSizes::Totals WalkSerially(const string& path)
+	{
+		FolderSizes::Totals totals = { 0, 0, 0 };
+
+		SyntheticShareFixture::WalkSerially(path, [&totals](const string&, const FileSystem::FileInfo& file)
+		{
+			if (file.fileStatus == FileSystem::FileStatus::Directory)
+			{
+				totals.folderCount++;
+			}
+			else
+			{
+				totals.size += file.fileSize;
+				totals.fileCount++;
+			}
+		});
+
+		return totals;
+	}
+
+public:
+	TEST_METHOD_INITIALIZE(Initialize)
+	{
+		SyntheticFileSystemProvider::Parameters parameters;
+		parameters.maxDepth = 3;
+		parameters.minFanOut = 8;
+		parameters.maxFanOut = 16;
+		parameters.directoryPercentage = 50;
+		m_Share.InstallTree(parameters);
+		m_Share.ShareRoot();
+		m_RootPath = m_Share.GetRootPath();
+
+		FolderSizes::Initialize();
+	}
+
+	TEST_METHOD_CLEANUP(Cleanup)
+	{
+		FolderSizes::Shutdown();
+		m_Share.Reset();
+	}
+
+	TEST_METHOD(ComputesTheSameTotalsAsASerialWalk)
+	{
+		auto expectedTotals = WalkSerially(m_RootPath);
+		FolderSizes::Totals totals;
+
+		Assert::IsFalse(FolderSizes::Find(m_RootPath, totals));
+		Assert::IsTrue(FolderSizes::Compute(m_RootPath, totals, CancellationToken::None()));
+		Assert::AreEqual(expectedTotals.size, totals.size);
+		Assert::AreEqual(expectedTotals.fileCount, totals.fileCount);
+		Assert::AreEqual(expectedTotals.folderCount, totals.folderCount);
+
+		// Every folder on the way is cached now
+		Assert::IsTrue(FolderSizes::Find(m_RootPath + "\\", totals));
+		Assert::AreEqual(expectedTotals.size, totals.size);
+
+		for (const auto& subfolder : m_Share.GetRootSubfolders())
+		{
+			Assert::IsTrue(FolderSizes::Find(subfolder, totals));
+			Assert::AreEqual(WalkSerially(subfolder).size, totals.size);
+		}
+	}
+
+	TEST_METHOD(ChangedFoldersOnlyInvalidateTheirAncestors)
+	{
+		auto subfolders = m_Share.GetRootSubfolders();
+		Assert::IsTrue(subfolders.size() >= 2);
+
+		FolderSizes::Totals rootTotals, changedTotals, siblingTotals, totals;
+		Assert::IsTrue(FolderSizes::Compute(m_RootPath, rootTotals, CancellationToken::None()));
+		Assert::IsTrue(FolderSizes::Find(subfolders[0], changedTotals));
+
+		// A listing finds the first subfolder holding a single file now. Since nothing on disk changed, the
+		// next walk can only see that if it reuses what the listing left instead of enumerating the folder again
+		vector<FileSystem::FileInfo> newContents;
+		newContents.emplace_back("New.txt", FileSystem::FileStatus::File, "", 1000);
+		FolderSizes::Update(subfolders[0], newContents);
+
+		Assert::IsFalse(FolderSizes::Find(m_RootPath, totals));
+		Assert::IsFalse(FolderSizes::Find(subfolders[0], totals));
+		Assert::IsTrue(FolderSizes::Find(subfolders[1], siblingTotals));
+
+		Assert::IsTrue(FolderSizes::Compute(m_RootPath, totals, CancellationToken::None()));
+		Assert::AreEqual(rootTotals.size - changedTotals.size + 1000, totals.size);
+		Assert::AreEqual(rootTotals.fileCount - changedTotals.fileCount + 1, totals.fileCount);
+		Assert::AreEqual(rootTotals.folderCount - changedTotals.folderCount, totals.folderCount);
+
+		// Invalidating drops the listing's contents too, so the walk reads the disk again
+		FolderSizes::Invalidate(subfolders[0]);
+		Assert::IsTrue(FolderSizes::Compute(m_RootPath, totals, CancellationToken::None()));
+		Assert::AreEqual(rootTotals.size, totals.size);
+	}
+
+	TEST_METHOD(CancelledComputationsFail)
+	{
+		CancellationToken cancellationToken;
+		cancellationToken.Cancel();
+
+		FolderSizes::Totals totals;
+		Assert::IsFalse(FolderSizes::Compute(m_RootPath, totals, cancellationToken));
+		Assert::IsFalse(FolderSizes::Find(m_RootPath, totals));
+	}
+};
+
+#endif
\ No newline at end of file
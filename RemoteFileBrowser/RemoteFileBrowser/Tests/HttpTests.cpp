@@ -0,0 +1,88 @@
+#include "PrecompiledHeader.h"
+
+#if _TESTBUILD
+
+#include "CppUnitTest.h"
+#include "Http\HeaderIndex.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+using namespace Http;
+using namespace Utilities;
+
+TEST_CLASS(HttpTests)
+{
+public:
+	TEST_METHOD(CanIndexHeader)
+	{
+		const string request =
+			"GET /Music/ HTTP/1.1\r\n"
+			"host: localhost:8080\r\n"
+			"User-Agent:   Mozilla/5.0 (Windows NT 10.0)  \r\n"
+			"X-Custom: a:b\n"
+			"USER-AGENT: second\r\n"
+			"\r\n"
+			"body";
+
+		HeaderIndex header;
+		Assert::IsTrue(header.Parse(request.data(), request.length()));
+
+		Assert::AreEqual(string("GET /Music/ HTTP/1.1"), header.GetRequestLine().ToString());
+		Assert::AreEqual(4, header.GetFieldCount());
+		Assert::AreEqual(string("localhost:8080"), header.Find(KnownHeader::Host).ToString());
+		Assert::AreEqual(string("Mozilla/5.0 (Windows NT 10.0)"), header.Find(KnownHeader::UserAgent).ToString());
+		Assert::AreEqual(string("X-Custom"), header.GetField(2).name.ToString());
+		Assert::AreEqual(string("a:b"), header.GetField(2).value.ToString());
+		Assert::IsTrue(header.GetField(2).knownHeader == KnownHeader::Unknown);
+		Assert::IsFalse(header.Has(KnownHeader::Cookie));
+		Assert::AreEqual(request.length() - 4, header.GetHeaderLength());
+
+		// Cut off mid-line: fields before the cut are still there
+		Assert::IsFalse(header.Parse(request.data(), 50));
+		Assert::AreEqual(string("GET /Music/ HTTP/1.1"), header.GetRequestLine().ToString());
+		Assert::AreEqual(string("localhost:8080"), header.Find(KnownHeader::Host).ToString());
+		Assert::IsFalse(header.Has(KnownHeader::UserAgent));
+		Assert::AreEqual(size_t(0), header.GetHeaderLength());
+
+		const char kNoColon[] = "GET / HTTP/1.1\r\nHost localhost\r\n\r\n";
+		Assert::IsFalse(header.Parse(kNoColon, sizeof(kNoColon) - 1));
+	}
+
+	TEST_METHOD(KnownHeadersMatchCaseInsensitively)
+	{
+		for (int i = 0; i < static_cast<int>(KnownHeader::Count); i++)
+		{
+			auto knownHeader = static_cast<KnownHeader>(i);
+			auto name = HeaderIndex::GetName(knownHeader).ToString();
+
+			Assert::IsTrue(HeaderIndex::LookupKnownHeader(name) == knownHeader);
+
+			transform(name.begin(), name.end(), name.begin(), ::tolower);
+			Assert::IsTrue(HeaderIndex::LookupKnownHeader(name) == knownHeader);
+
+			transform(name.begin(), name.end(), name.begin(), ::toupper);
+			Assert::IsTrue(HeaderIndex::LookupKnownHeader(name) == knownHeader);
+
+			name += 's';
+			Assert::IsTrue(HeaderIndex::LookupKnownHeader(name) == KnownHeader::Unknown);
+		}
+
+		Assert::IsTrue(HeaderIndex::LookupKnownHeader("Hostname") == KnownHeader::Unknown);
+		Assert::IsTrue(HeaderIndex::LookupKnownHeader("X") == KnownHeader::Unknown);
+		Assert::IsTrue(HeaderIndex::LookupKnownHeader("") == KnownHeader::Unknown);
+	}
+
+	TEST_METHOD(AcceptsEncodingHonorsQualities)
+	{
+		Assert::IsTrue(HeaderIndex::AcceptsEncoding("gzip, deflate, br", "gzip"));
+		Assert::IsTrue(HeaderIndex::AcceptsEncoding("deflate ,GZIP;q=0.5", "gzip"));
+		Assert::IsTrue(HeaderIndex::AcceptsEncoding("br, *", "gzip"));
+		Assert::IsFalse(HeaderIndex::AcceptsEncoding("", "gzip"));
+		Assert::IsFalse(HeaderIndex::AcceptsEncoding("deflate, br", "gzip"));
+		Assert::IsFalse(HeaderIndex::AcceptsEncoding("gzip;q=0, *", "gzip"));
+		Assert::IsFalse(HeaderIndex::AcceptsEncoding("*;q=0.000", "gzip"));
+		Assert::IsFalse(HeaderIndex::AcceptsEncoding("gzipped", "gzip"));
+	}
+};
+
+#endif // _TESTBUILD
\ No newline at end of file
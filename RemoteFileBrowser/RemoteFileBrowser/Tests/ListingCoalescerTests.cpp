@@ -0,0 +1,131 @@
+#include "PrecompiledHeader.h"
+
+#if _TESTBUILD
+
+#include "CppUnitTest.h"
+#include "Communication\ListingCoalescer.h"
+#include "Utilities\Event.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+
+TEST_CLASS(ListingCoalescerTests)
+{
+public:
+	TEST_METHOD(ConcurrentRequestsShareOneRendering)
+	{
+		const int kFollowerCount = 8;
+		Event renderStarted(true), renderMayFinish(true);
+		atomic<int> renderCount(0);
+
+		auto render = [&]() -> ListingCoalescer::Listing
+		{
+			renderCount++;
+			renderStarted.Set();
+			renderMayFinish.Wait();
+			return make_shared<string>("<html></html>");
+		};
+
+		ListingCoalescer::Listing leaderResult;
+		thread leader([&]()
+		{
+			leaderResult = ListingCoalescer::Render("C:\\Folder", render);
+		});
+
+		renderStarted.Wait();
+
+		vector<ListingCoalescer::Listing> followerResults(kFollowerCount);
+		vector<thread> followers;
+
+		for (int i = 0; i < kFollowerCount; i++)
+		{
+			followers.emplace_back([&, i]()
+			{
+				followerResults[i] = ListingCoalescer::Render("C:\\Folder", render);
+			});
+		}
+
+		while (ListingCoalescer::GetWaitingRequestCount("C:\\Folder") < kFollowerCount)
+		{
+			Sleep(1);
+		}
+
+		renderMayFinish.Set();
+
+		leader.join();
+
+		for (auto& follower : followers)
+		{
+			follower.join();
+		}
+
+		Assert::IsNotNull(leaderResult.get());
+
+		for (const auto& followerResult : followerResults)
+		{
+			Assert::IsTrue(followerResult == leaderResult);
+		}
+
+		Assert::AreEqual(1, renderCount.load());
+		Assert::AreEqual(0u, ListingCoalescer::GetWaitingRequestCount("C:\\Folder"));
+	}
+
+	TEST_METHOD(CancelledRenderingIsNotShared)
+	{
+		Event renderStarted(true), renderMayFinish(true);
+		atomic<int> renderCount(0);
+
+		thread leader([&]()
+		{
+			ListingCoalescer::Render("C:\\Folder", [&]() -> ListingCoalescer::Listing
+			{
+				renderCount++;
+				renderStarted.Set();
+				renderMayFinish.Wait();
+				return nullptr;
+			});
+		});
+
+		renderStarted.Wait();
+
+		ListingCoalescer::Listing followerResult;
+		thread follower([&]()
+		{
+			followerResult = ListingCoalescer::Render("C:\\Folder", [&]() -> ListingCoalescer::Listing
+			{
+				renderCount++;
+				return make_shared<string>("<html></html>");
+			});
+		});
+
+		while (ListingCoalescer::GetWaitingRequestCount("C:\\Folder") < 1)
+		{
+			Sleep(1);
+		}
+
+		renderMayFinish.Set();
+
+		leader.join();
+		follower.join();
+
+		Assert::IsNotNull(followerResult.get());
+		Assert::AreEqual(2, renderCount.load());
+	}
+
+	TEST_METHOD(DifferentPathsDontWaitForEachOther)
+	{
+		auto outer = ListingCoalescer::Render("C:\\A", []() -> ListingCoalescer::Listing
+		{
+			auto inner = ListingCoalescer::Render("C:\\B", []() -> ListingCoalescer::Listing
+			{
+				return make_shared<string>("B");
+			});
+
+			return make_shared<string>("A" + *inner);
+		});
+
+		Assert::AreEqual(string("AB"), *outer);
+	}
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,185 @@
+#include "PrecompiledHeader.h"
+
+#if _TESTBUILD
+
+#include "CppUnitTest.h"
+#include "Communication\MetadataIndex.h"
+#include "SyntheticShareFixture.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+using namespace Utilities;
+
+TEST_CLASS(MetadataIndexTests)
+{
+private:
+	SyntheticShareFixture m_Share;
+	string m_RootPath;
+	wstring m_IndexPath;
+
+	// Trees from different seeds have different entries, but their roots have the same last write time
+	void InstallProvider(uint64_t seed)
+	{
+		SyntheticFileSystemProvider::Parameters parameters;
+		parameters.seed = seed;
+		parameters.maxDepth = 1;
+		m_Share.InstallTree(parameters);
+		m_RootPath = m_Share.GetRootPath();
+	}
+
+	static vector<string> GetNames(const vector<FileSystem::FileInfo>& files)
+	{
+		vector<string> names;
+
+		for (const auto& file : files)
+		{
+			names.push_back(file.fileName);
+		}
+
+		return names;
+	}
+
+public:
+	TEST_METHOD_INITIALIZE(Initialize)
+	{
+		wchar_t tempPath[MAX_PATH];
+		auto tempPathLength = GetTempPathW(MAX_PATH, tempPath);
+		Assert::IsTrue(tempPathLength > 0 && tempPathLength <= MAX_PATH);
+
+		m_IndexPath = wstring(tempPath) + L"RemoteFileBrowserMetadataIndexTests.index";
+		DeleteFileW(m_IndexPath.c_str());
+
+		InstallProvider(42);
+		m_Share.ShareRoot();
+
+		MetadataIndex::Open(m_IndexPath);
+	}
+
+	TEST_METHOD_CLEANUP(Cleanup)
+	{
+		MetadataIndex::Close();
+		DeleteFileW(m_IndexPath.c_str());
+		m_Share.Reset();
+	}
+
+	TEST_METHOD(ListsFromTheIndexAfterReopening)
+	{
+		auto indexedNames = GetNames(SharedFiles::GetFolderContents(m_RootPath));
+
+		MetadataIndex::Close();
+		MetadataIndex::Open(m_IndexPath);
+
+		// Only the index still knows the old entries
+		InstallProvider(43);
+		Assert::IsTrue(indexedNames == GetNames(SharedFiles::GetFolderContents(m_RootPath)));
+
+		MetadataIndex::Invalidate(m_RootPath);
+		auto currentNames = GetNames(SharedFiles::GetFolderContents(m_RootPath));
+		Assert::IsTrue(indexedNames != currentNames);
+		Assert::IsTrue(currentNames == GetNames(SharedFiles::GetFolderContents(m_RootPath)));
+	}
+
+	TEST_METHOD(MissesOnceTheDirectoryChanges)
+	{
+		vector<FileSystem::FileInfo> contents, foundContents;
+		contents.emplace_back("Folder", FileSystem::FileStatus::Directory, "2015-06-01 12:00", 0);
+		contents.emplace_back("File.txt", FileSystem::FileStatus::File, "2015-06-01 12:00", 1234);
+		MetadataIndex::Store("C:\\Indexed", 5, contents);
+
+		Assert::IsFalse(MetadataIndex::Find("C:\\Indexed", 6, foundContents));
+		Assert::IsTrue(MetadataIndex::Find("c:\\indexed\\", 5, foundContents));
+
+		// Same from the file
+		MetadataIndex::Close();
+		MetadataIndex::Open(m_IndexPath);
+
+		Assert::IsFalse(MetadataIndex::Find("C:\\Indexed", 6, foundContents));
+		Assert::IsTrue(MetadataIndex::Find("C:\\Indexed", 5, foundContents));
+		Assert::AreEqual(contents.size(), foundContents.size());
+
+		for (size_t i = 0; i < contents.size(); i++)
+		{
+			Assert::AreEqual(contents[i].fileName, foundContents[i].fileName);
+			Assert::IsTrue(contents[i].fileStatus == foundContents[i].fileStatus);
+			Assert::AreEqual(contents[i].dateModified, foundContents[i].dateModified);
+			Assert::AreEqual(contents[i].fileSize, foundContents[i].fileSize);
+		}
+
+		MetadataIndex::Invalidate("C:\\Indexed");
+		Assert::IsFalse(MetadataIndex::Find("C:\\Indexed", 5, foundContents));
+
+		MetadataIndex::Close();
+		MetadataIndex::Open(m_IndexPath);
+		Assert::IsFalse(MetadataIndex::Find("C:\\Indexed", 5, foundContents));
+	}
+
+	TEST_METHOD(InvalidatedFoldersCoverWhatTheyContain)
+	{
+		vector<FileSystem::FileInfo> contents, foundContents;
+		contents.emplace_back("File.txt", FileSystem::FileStatus::File, "2015-06-01 12:00", 1234);
+
+		const char* const kPaths[] = { "C:\\Indexed", "C:\\Indexed\\Nested", "C:\\Indexed\\Nested\\Deeper", "C:\\Other" };
+
+		for (auto path : kPaths)
+		{
+			MetadataIndex::Store(path, 5, contents);
+		}
+
+		MetadataIndex::Close();
+		MetadataIndex::Open(m_IndexPath);
+
+		// Lost notifications come again and again, for folders that are already covered and for ones containing earlier ones
+		MetadataIndex::InvalidateFolder("C:\\Indexed\\Nested\\Deeper");
+		MetadataIndex::InvalidateFolder("C:\\Indexed\\Nested");
+		MetadataIndex::InvalidateFolder("C:\\Indexed\\Nested\\Deeper");
+		MetadataIndex::InvalidateFolder("C:\\Indexed\\Nested");
+
+		Assert::IsTrue(MetadataIndex::Find("C:\\Indexed", 5, foundContents));
+		Assert::IsFalse(MetadataIndex::Find("C:\\Indexed\\Nested", 5, foundContents));
+		Assert::IsFalse(MetadataIndex::Find("C:\\Indexed\\Nested\\Deeper", 5, foundContents));
+		Assert::IsTrue(MetadataIndex::Find("C:\\Other", 5, foundContents));
+
+		// Listings stored since then don't survive the folder losing notifications again
+		MetadataIndex::Store("C:\\Indexed\\Nested\\Deeper", 5, contents);
+		Assert::IsTrue(MetadataIndex::Find("C:\\Indexed\\Nested\\Deeper", 5, foundContents));
+
+		MetadataIndex::InvalidateFolder("C:\\Indexed\\Nested");
+		Assert::IsFalse(MetadataIndex::Find("C:\\Indexed\\Nested\\Deeper", 5, foundContents));
+
+		MetadataIndex::Close();
+		MetadataIndex::Open(m_IndexPath);
+
+		Assert::IsTrue(MetadataIndex::Find("C:\\Indexed", 5, foundContents));
+		Assert::IsFalse(MetadataIndex::Find("C:\\Indexed\\Nested", 5, foundContents));
+		Assert::IsFalse(MetadataIndex::Find("C:\\Indexed\\Nested\\Deeper", 5, foundContents));
+		Assert::IsTrue(MetadataIndex::Find("C:\\Other", 5, foundContents));
+	}
+
+	TEST_METHOD(StartsOverFromUnreadableFiles)
+	{
+		MetadataIndex::Close();
+
+		auto fileHandle = FileSystem::CreateFilePortable(m_IndexPath, GENERIC_WRITE, 0, CREATE_ALWAYS);
+		Assert::IsTrue(fileHandle != INVALID_HANDLE_VALUE);
+
+		const char kGarbage[] = "This is not an index, but it's long enough to have a header";
+		DWORD bytesWritten;
+		Assert::IsTrue(WriteFile(fileHandle, kGarbage, sizeof(kGarbage), &bytesWritten, nullptr) != FALSE);
+		CloseHandle(fileHandle);
+
+		MetadataIndex::Open(m_IndexPath);
+
+		vector<FileSystem::FileInfo> contents;
+		Assert::IsFalse(MetadataIndex::Find("C:\\Indexed", 5, contents));
+
+		contents.emplace_back("File.txt", FileSystem::FileStatus::File, "2015-06-01 12:00", 1234);
+		MetadataIndex::Store("C:\\Indexed", 5, contents);
+
+		MetadataIndex::Close();
+		MetadataIndex::Open(m_IndexPath);
+		Assert::IsTrue(MetadataIndex::Find("C:\\Indexed", 5, contents));
+		Assert::AreEqual(size_t(1), contents.size());
+	}
+};
+
+#endif
\ No newline at end of file
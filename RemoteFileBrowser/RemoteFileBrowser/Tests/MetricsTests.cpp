@@ -0,0 +1,123 @@
+#include "PrecompiledHeader.h"
+
+#if _TESTBUILD
+
+#include "CppUnitTest.h"
+#include "Utilities\Metrics.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+using namespace Metrics;
+
+TEST_CLASS(MetricsTests)
+{
+private:
+	// Powers of two and their neighbours, where bucket edges are, plus values in between them
+	static vector<uint64_t> GetSampleValues()
+	{
+		vector<uint64_t> values;
+		mt19937_64 random(42);
+
+		for (int i = 0; i < 64; i++)
+		{
+			auto powerOfTwo = 1ull << i;
+			values.push_back(powerOfTwo - 1);
+			values.push_back(powerOfTwo);
+			values.push_back(powerOfTwo + 1);
+			values.push_back(powerOfTwo + random() % powerOfTwo);
+		}
+
+		values.push_back(numeric_limits<uint64_t>::max());
+		return values;
+	}
+
+public:
+	TEST_METHOD(BucketsCoverEveryValueWithoutGaps)
+	{
+		for (uint64_t value = 0; value < LatencyHistogram::kSubBucketCount; value++)
+		{
+			Assert::AreEqual(static_cast<int>(value), LatencyHistogram::GetBucketIndex(value));
+		}
+
+		for (int i = 0; i + 1 < LatencyHistogram::kBucketCount; i++)
+		{
+			Assert::AreEqual(LatencyHistogram::GetBucketUpperBound(i), LatencyHistogram::GetBucketLowerBound(i + 1));
+		}
+
+		for (auto value : GetSampleValues())
+		{
+			auto bucketIndex = LatencyHistogram::GetBucketIndex(value);
+			auto lowerBound = LatencyHistogram::GetBucketLowerBound(bucketIndex);
+			auto upperBound = LatencyHistogram::GetBucketUpperBound(bucketIndex);
+
+			Assert::IsTrue(bucketIndex >= 0 && bucketIndex < LatencyHistogram::kBucketCount);
+			Assert::IsTrue(lowerBound <= value);
+			Assert::IsTrue(value < upperBound || (bucketIndex == LatencyHistogram::kBucketCount - 1 && upperBound == numeric_limits<uint64_t>::max()));
+
+			// No bucket is wider than an eighth of the values it starts at
+			Assert::IsTrue(upperBound - lowerBound <= max<uint64_t>(1, lowerBound / LatencyHistogram::kSubBucketCount));
+		}
+	}
+
+	TEST_METHOD(ExposedBoundariesEndTheirBuckets)
+	{
+		for (int i = 0; i < LatencyHistogram::kExposedBoundaryCount; i++)
+		{
+			auto boundary = LatencyHistogram::GetExposedBoundary(i);
+			Assert::AreEqual(static_cast<uint64_t>((2ull << i) - 1), boundary);
+			Assert::AreEqual(boundary + 1, LatencyHistogram::GetBucketUpperBound(LatencyHistogram::GetBucketIndex(boundary)));
+		}
+	}
+
+	TEST_METHOD(CumulativeCountsAreExactAtExposedBoundaries)
+	{
+		unique_ptr<LatencyHistogram> histogram(new LatencyHistogram);
+		auto values = GetSampleValues();
+
+		for (auto value : values)
+		{
+			histogram->Record(value);
+		}
+
+		Assert::AreEqual(static_cast<uint64_t>(values.size()), histogram->GetCount());
+
+		for (int i = 0; i < LatencyHistogram::kExposedBoundaryCount; i++)
+		{
+			auto boundary = LatencyHistogram::GetExposedBoundary(i);
+			auto expectedCount = count_if(values.begin(), values.end(), [boundary](uint64_t value) { return value <= boundary; });
+			Assert::AreEqual(static_cast<uint64_t>(expectedCount), histogram->GetCountAtOrBelow(boundary));
+		}
+	}
+
+	TEST_METHOD(QuantilesReportTheLastValueOfTheirBucket)
+	{
+		unique_ptr<LatencyHistogram> histogram(new LatencyHistogram);
+		Assert::AreEqual(static_cast<uint64_t>(0), histogram->GetValueAtQuantile(0.5));
+
+		for (uint64_t value = 1; value <= 1000; value++)
+		{
+			histogram->Record(value);
+		}
+
+		const struct
+		{
+			double quantile;
+			uint64_t value;
+		} kExpectedValues[] =
+		{
+			{ 0.0, 1 },
+			{ 0.5, 500 },
+			{ 0.9, 900 },
+			{ 0.999, 999 },
+			{ 1.0, 1000 }
+		};
+
+		for (const auto& expected : kExpectedValues)
+		{
+			auto bucketIndex = LatencyHistogram::GetBucketIndex(expected.value);
+			Assert::AreEqual(LatencyHistogram::GetBucketUpperBound(bucketIndex) - 1, histogram->GetValueAtQuantile(expected.quantile));
+		}
+	}
+};
+
+#endif
\ No newline at end of file
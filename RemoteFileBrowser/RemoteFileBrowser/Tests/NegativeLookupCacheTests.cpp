@@ -0,0 +1,86 @@
+#include "PrecompiledHeader.h"
+
+#if _TESTBUILD
+
+#include "CppUnitTest.h"
+#include "Communication\NegativeLookupCache.h"
+#include "Communication\SharedFiles.h"
+#include "Utilities\SyntheticFileSystemProvider.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+using namespace Utilities;
+
+TEST_CLASS(NegativeLookupCacheTests)
+{
+public:
+	TEST_METHOD_INITIALIZE(Initialize)
+	{
+		NegativeLookupCache::Clear();
+	}
+
+	TEST_METHOD_CLEANUP(Cleanup)
+	{
+		NegativeLookupCache::Clear();
+	}
+
+	TEST_METHOD(FindsInsertedPathsRegardlessOfCase)
+	{
+		NegativeLookupCache::Insert("C:\\Missing.txt", FileSystem::FileStatus::FileNotFound);
+		NegativeLookupCache::Insert("C:\\Secret", FileSystem::FileStatus::AccessDenied);
+
+		FileSystem::FileStatus fileStatus;
+
+		Assert::IsTrue(NegativeLookupCache::Find("c:\\missing.TXT", fileStatus));
+		Assert::IsTrue(fileStatus == FileSystem::FileStatus::FileNotFound);
+
+		Assert::IsTrue(NegativeLookupCache::Find("C:\\Secret", fileStatus));
+		Assert::IsTrue(fileStatus == FileSystem::FileStatus::AccessDenied);
+
+		Assert::IsFalse(NegativeLookupCache::Find("C:\\Other.txt", fileStatus));
+	}
+
+	TEST_METHOD(DropsOldestPathsOnceFull)
+	{
+		for (size_t i = 0; i <= NegativeLookupCache::kCapacity; i++)
+		{
+			NegativeLookupCache::Insert("C:\\" + to_string(i) + ".txt", FileSystem::FileStatus::FileNotFound);
+		}
+
+		FileSystem::FileStatus fileStatus;
+
+		Assert::IsFalse(NegativeLookupCache::Find("C:\\0.txt", fileStatus));
+		Assert::IsTrue(NegativeLookupCache::Find("C:\\1.txt", fileStatus));
+		Assert::IsTrue(NegativeLookupCache::Find("C:\\" + to_string(NegativeLookupCache::kCapacity) + ".txt", fileStatus));
+	}
+
+	TEST_METHOD(CachesOnlyQueriedPathsThatCantBeServed)
+	{
+		SyntheticFileSystemProvider::Parameters parameters;
+		SyntheticFileSystemProvider provider(parameters);
+		FileSystemProvider::SetCurrent(&provider);
+
+		auto rootPath = Encoding::Utf16ToUtf8(parameters.rootPath);
+		auto missingPath = FileSystem::CombinePaths(rootPath, "Missing.txt");
+		FileSystem::FileStatus fileStatus;
+
+		Assert::IsTrue(NegativeLookupCache::QueryFileStatus(missingPath) == FileSystem::FileStatus::FileNotFound);
+		Assert::IsTrue(NegativeLookupCache::Find(missingPath, fileStatus));
+
+		Assert::IsTrue(NegativeLookupCache::QueryFileStatus(rootPath) == FileSystem::FileStatus::Directory);
+		Assert::IsFalse(NegativeLookupCache::Find(rootPath, fileStatus));
+
+		FileSystemProvider::SetCurrent(nullptr);
+	}
+
+	TEST_METHOD(ChangingSharesEmptiesTheCache)
+	{
+		NegativeLookupCache::Insert("C:\\Missing.txt", FileSystem::FileStatus::FileNotFound);
+		SharedFiles::SetSharedFiles(SharedFiles::FileSet(), SharedFiles::FileSet(), SharedFiles::FileSet());
+
+		FileSystem::FileStatus fileStatus;
+		Assert::IsFalse(NegativeLookupCache::Find("C:\\Missing.txt", fileStatus));
+	}
+};
+
+#endif
\ No newline at end of file
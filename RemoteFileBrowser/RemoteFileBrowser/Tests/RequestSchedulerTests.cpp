@@ -0,0 +1,300 @@
+#include "PrecompiledHeader.h"
+
+#if _TESTBUILD
+
+#include "CppUnitTest.h"
+#include "Http\RequestScheduler.h"
+#include "Http\ResponseWriter.h"
+#include "Http\Server.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+using namespace Utilities;
+
+TEST_CLASS(RequestSchedulerTests)
+{
+private:
+	// A client end of a loopback connection, which reads responses one header at a time
+	class Client
+	{
+	private:
+		SOCKET m_Socket;
+		string m_Received;
+
+	public:
+		Client(SOCKET clientSocket) :
+			m_Socket(clientSocket)
+		{
+		}
+
+		~Client()
+		{
+			closesocket(m_Socket);
+		}
+
+		Client(const Client&) = delete;
+		Client& operator=(const Client&) = delete;
+
+		void SendRequests(const vector<string>& paths)
+		{
+			string requests;
+
+			for (const auto& path : paths)
+			{
+				requests += "GET /" + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+			}
+
+			Assert::AreEqual(static_cast<int>(requests.length()), send(m_Socket, requests.data(), static_cast<int>(requests.length()), 0));
+		}
+
+		// Returns an empty string once the server closes the connection
+		string ReceiveResponse()
+		{
+			for (;;)
+			{
+				auto headerEnd = m_Received.find("\r\n\r\n");
+
+				if (headerEnd != string::npos)
+				{
+					auto header = m_Received.substr(0, headerEnd + 4);
+					m_Received.erase(0, headerEnd + 4);
+					return header;
+				}
+
+				char buffer[1024];
+				auto result = recv(m_Socket, buffer, sizeof(buffer), 0);
+
+				if (result <= 0)
+				{
+					return string();
+				}
+
+				m_Received.append(buffer, result);
+			}
+		}
+	};
+
+	// Holds requests for paths starting with "wait" until released, or until the request is cancelled
+	struct HandlerState
+	{
+		CriticalSection criticalSection;
+		vector<string> executedPaths;
+		int waitingCount;
+		int cancelledCount;
+		volatile bool isReleased;
+	};
+
+	SOCKET m_ListeningSocket;
+	uint16_t m_Port;
+	shared_ptr<HandlerState> m_HandlerState;
+
+	static Http::RequestLane ClassifyRequest(const string& requestedPath)
+	{
+		return requestedPath.find("bulk") != string::npos ? Http::RequestLane::Bulk : Http::RequestLane::Interactive;
+	}
+
+	static void ExecuteRequest(const shared_ptr<HandlerState>& state, SOCKET clientSocket, const string& requestedPath, const string& httpVersion, Http::RequestContext& context)
+	{
+		{
+			CriticalSection::Lock lock(state->criticalSection);
+			state->executedPaths.push_back(requestedPath);
+		}
+
+		if (requestedPath.compare(0, 4, "wait") == 0)
+		{
+			{
+				CriticalSection::Lock lock(state->criticalSection);
+				state->waitingCount++;
+			}
+
+			while (!state->isReleased && !context.cancellationToken.IsCancelled())
+			{
+				System::Sleep(1);
+			}
+
+			if (context.cancellationToken.IsCancelled())
+			{
+				CriticalSection::Lock lock(state->criticalSection);
+				state->cancelledCount++;
+				return;
+			}
+		}
+
+		auto response = httpVersion + " 200 OK\r\nX-Path: " + requestedPath + "\r\nContent-Length: 0\r\n\r\n";
+		Http::ResponseWriter(clientSocket, context).Send(response.c_str(), response.length(), true);
+	}
+
+	void Start(int interactiveWorkers, int bulkWorkers, int bulkQueueDepth)
+	{
+		Http::RequestScheduler::Settings settings;
+		settings.lanes[static_cast<int>(Http::RequestLane::Interactive)].workerCount = interactiveWorkers;
+		settings.lanes[static_cast<int>(Http::RequestLane::Bulk)].workerCount = bulkWorkers;
+		settings.lanes[static_cast<int>(Http::RequestLane::Bulk)].queueDepth = bulkQueueDepth;
+		settings.retryAfterSeconds = 7;
+
+		Http::RequestScheduler::Initialize(settings, &ClassifyRequest);
+	}
+
+	unique_ptr<Client> Connect()
+	{
+		auto clientSocket = socket(AF_INET6, SOCK_STREAM, IPPROTO_TCP);
+		Assert::IsTrue(clientSocket != INVALID_SOCKET);
+
+		DWORD timeout = 10000;	// Fail rather than hang if a response never comes
+		setsockopt(clientSocket, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+
+		sockaddr_in6 address;
+		ZeroMemory(&address, sizeof(address));
+		address.sin6_family = AF_INET6;
+		address.sin6_addr = in6addr_loopback;
+		address.sin6_port = m_Port;
+		Assert::AreNotEqual(SOCKET_ERROR, connect(clientSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)));
+
+		sockaddr_in6 clientAddress;
+		int clientAddressLength = sizeof(clientAddress);
+		auto serverSocket = accept(m_ListeningSocket, reinterpret_cast<sockaddr*>(&clientAddress), &clientAddressLength);
+		Assert::IsTrue(serverSocket != INVALID_SOCKET);
+
+		auto state = m_HandlerState;
+		Http::Server::StartServiceClient(serverSocket, clientAddress, [state](SOCKET socket, const string& path, const string& httpVersion, Http::RequestContext& context)
+		{
+			ExecuteRequest(state, socket, path, httpVersion, context);
+		});
+
+		return unique_ptr<Client>(new Client(clientSocket));
+	}
+
+	void WaitUntil(const function<bool()>& condition)
+	{
+		auto deadline = System::GetMicroseconds() + 10 * 1000 * 1000;
+
+		while (!condition())
+		{
+			Assert::IsTrue(System::GetMicroseconds() < deadline);
+			System::Sleep(1);
+		}
+	}
+
+	int GetWaitingCount()
+	{
+		CriticalSection::Lock lock(m_HandlerState->criticalSection);
+		return m_HandlerState->waitingCount;
+	}
+
+public:
+	TEST_METHOD_INITIALIZE(Initialize)
+	{
+		WSAData wsaData;
+		Assert::AreEqual(0, WSAStartup(MAKEWORD(2, 2), &wsaData));
+
+		m_HandlerState = make_shared<HandlerState>();
+		m_HandlerState->waitingCount = 0;
+		m_HandlerState->cancelledCount = 0;
+		m_HandlerState->isReleased = false;
+
+		m_ListeningSocket = socket(AF_INET6, SOCK_STREAM, IPPROTO_TCP);
+		Assert::IsTrue(m_ListeningSocket != INVALID_SOCKET);
+
+		sockaddr_in6 address;
+		ZeroMemory(&address, sizeof(address));
+		address.sin6_family = AF_INET6;
+		address.sin6_addr = in6addr_loopback;
+		Assert::AreNotEqual(SOCKET_ERROR, ::bind(m_ListeningSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)));
+		Assert::AreNotEqual(SOCKET_ERROR, listen(m_ListeningSocket, SOMAXCONN));
+
+		int addressLength = sizeof(address);
+		Assert::AreNotEqual(SOCKET_ERROR, getsockname(m_ListeningSocket, reinterpret_cast<sockaddr*>(&address), &addressLength));
+		m_Port = address.sin6_port;
+	}
+
+	TEST_METHOD_CLEANUP(Cleanup)
+	{
+		m_HandlerState->isReleased = true;
+		Http::RequestScheduler::Shutdown();
+		closesocket(m_ListeningSocket);
+		WSACleanup();
+	}
+
+	TEST_METHOD(AnswersRequestsOnAKeptAliveConnectionInOrder)
+	{
+		Start(2, 2, 8);
+		auto client = Connect();
+
+		// Handed back after every request, which is the only way to get to the next one
+		client->SendRequests(vector<string>(1, "first"));
+		Assert::IsTrue(client->ReceiveResponse().find("X-Path: first\r\n") != string::npos);
+
+		const char* pipelinedPaths[] = { "second", "bulkthird", "fourth" };
+		client->SendRequests(vector<string>(begin(pipelinedPaths), end(pipelinedPaths)));
+
+		for (auto path : pipelinedPaths)
+		{
+			Assert::IsTrue(client->ReceiveResponse().find("X-Path: " + string(path) + "\r\n") != string::npos);
+		}
+	}
+
+	TEST_METHOD(BulkRequestsDontHoldUpInteractiveOnes)
+	{
+		Start(1, 1, 8);
+		auto bulkClient = Connect();
+		auto interactiveClient = Connect();
+
+		bulkClient->SendRequests(vector<string>(1, "waitbulk"));
+		WaitUntil([this]() { return GetWaitingCount() == 1; });
+
+		// The only interactive worker passed the download on and is free again
+		interactiveClient->SendRequests(vector<string>(1, "listing"));
+		Assert::IsTrue(interactiveClient->ReceiveResponse().find(" 200 OK\r\n") != string::npos);
+
+		m_HandlerState->isReleased = true;
+		Assert::IsTrue(bulkClient->ReceiveResponse().find("X-Path: waitbulk\r\n") != string::npos);
+	}
+
+	TEST_METHOD(ShedsRequestsThatFindTheirQueueFull)
+	{
+		Start(1, 1, 1);
+		auto runningClient = Connect();
+		auto queuedClient = Connect();
+		auto shedClient = Connect();
+
+		runningClient->SendRequests(vector<string>(1, "waitbulk"));
+		WaitUntil([this]() { return GetWaitingCount() == 1; });
+
+		queuedClient->SendRequests(vector<string>(1, "waitbulkqueued"));
+		WaitUntil([]() { return Metrics::GetValue(Metrics::Gauge::QueuedBulkRequests) == 1; });
+
+		shedClient->SendRequests(vector<string>(1, "bulkshed"));
+		auto response = shedClient->ReceiveResponse();
+		Assert::IsTrue(response.find("HTTP/1.1 503 Service Unavailable\r\n") == 0);
+		Assert::IsTrue(response.find("Retry-After: 7\r\n") != string::npos);
+		Assert::IsTrue(shedClient->ReceiveResponse().empty());
+
+		m_HandlerState->isReleased = true;
+		Assert::IsTrue(runningClient->ReceiveResponse().find(" 200 OK\r\n") != string::npos);
+		Assert::IsTrue(queuedClient->ReceiveResponse().find(" 200 OK\r\n") != string::npos);
+	}
+
+	TEST_METHOD(ShutdownStopsRunningRequestsAndDropsQueuedOnes)
+	{
+		Start(1, 1, 8);
+		auto runningClient = Connect();
+		auto queuedClient = Connect();
+
+		runningClient->SendRequests(vector<string>(1, "waitbulk"));
+		WaitUntil([this]() { return GetWaitingCount() == 1; });
+
+		queuedClient->SendRequests(vector<string>(1, "bulkqueued"));
+		WaitUntil([]() { return Metrics::GetValue(Metrics::Gauge::QueuedBulkRequests) == 1; });
+
+		Http::RequestScheduler::Shutdown();
+
+		Assert::AreEqual(static_cast<int64_t>(0), Metrics::GetValue(Metrics::Gauge::QueuedBulkRequests));
+		Assert::AreEqual(1, m_HandlerState->cancelledCount);
+		Assert::AreEqual(static_cast<size_t>(1), m_HandlerState->executedPaths.size());
+
+		Assert::IsTrue(runningClient->ReceiveResponse().empty());
+		Assert::IsTrue(queuedClient->ReceiveResponse().empty());
+	}
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,202 @@
+#include "PrecompiledHeader.h"
+
+#if _TESTBUILD
+
+#include "CppUnitTest.h"
+#include "Communication\SearchIndex.h"
+#include "SyntheticShareFixture.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+using namespace Utilities;
+
+TEST_CLASS(SearchIndexTests)
+{
+private:
+	SyntheticShareFixture m_Share;
+	string m_RootPath;
+
+	struct IndexedFile
+	{
+		string path;
+		string name;
+	};
+
+	static void WalkSerially(const string& path, vector<IndexedFile>& files)
+	{
+		SyntheticShareFixture::WalkSerially(path, [&files](const string& filePath, const FileSystem::FileInfo& file)
+		{
+			IndexedFile indexedFile = { filePath, file.fileName };
+			files.push_back(indexedFile);
+		});
+	}
+
+	static string ToLower(string str)
+	{
+		for (auto& c : str)
+		{
+			c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+		}
+
+		return str;
+	}
+
+	static vector<string> FindSerially(const vector<IndexedFile>& files, const string& query, bool isPrefix)
+	{
+		auto lowercaseQuery = ToLower(query);
+		vector<string> paths;
+
+		for (const auto& file : files)
+		{
+			auto position = ToLower(file.name).find(lowercaseQuery);
+
+			if (isPrefix ? position == 0 : position != string::npos)
+			{
+				paths.push_back(file.path);
+			}
+		}
+
+		sort(paths.begin(), paths.end());
+		return paths;
+	}
+
+	static vector<string> Search(const string& query, SearchIndex::QueryType queryType)
+	{
+		auto results = SearchIndex::Search(query, queryType, numeric_limits<size_t>::max());
+		Assert::IsFalse(results.isTruncated);
+		Assert::IsFalse(results.isIndexing);
+		Assert::AreEqual(results.matchCount, results.results.size());
+
+		vector<string> paths;
+
+		for (const auto& result : results.results)
+		{
+			paths.push_back(result.path);
+		}
+
+		sort(paths.begin(), paths.end());
+		return paths;
+	}
+
+public:
+	TEST_METHOD_INITIALIZE(Initialize)
+	{
+		SyntheticFileSystemProvider::Parameters parameters;
+		parameters.maxDepth = 2;
+		parameters.minFanOut = 8;
+		parameters.maxFanOut = 16;
+		parameters.directoryPercentage = 50;
+		m_Share.InstallTree(parameters);
+		m_Share.ShareRoot();
+		m_RootPath = m_Share.GetRootPath();
+
+		SearchIndex::Initialize();
+		SearchIndex::WaitUntilIdle();
+	}
+
+	TEST_METHOD_CLEANUP(Cleanup)
+	{
+		SearchIndex::Shutdown();
+		m_Share.Reset();
+	}
+
+	TEST_METHOD(FindsTheSameMatchesAsASerialWalk)
+	{
+		vector<IndexedFile> files;
+		WalkSerially(m_RootPath, files);
+		Assert::IsTrue(files.size() > 100);
+		Assert::AreEqual(static_cast<uint64_t>(files.size()), SearchIndex::GetStatistics().entryCount);
+
+		// Queries from the middle of names, across the index and the extension, in another case, and shorter than a trigram
+		const auto& name = files[files.size() / 2].name;
+		string queries[] = { name.substr(1, 4), " 1", "1.", ".PDF", "mkv", name, name.substr(0, 2), name.substr(0, 1), "no such name" };
+
+		for (const auto& query : queries)
+		{
+			Assert::IsTrue(FindSerially(files, query, query.length() < 3) == Search(query, SearchIndex::QueryType::Substring));
+			Assert::IsTrue(FindSerially(files, query, true) == Search(query, SearchIndex::QueryType::Prefix));
+		}
+	}
+
+	TEST_METHOD(RanksExactNamesPrefixesAndWordStartsFirst)
+	{
+		// Listings replace what the index knew about a directory
+		const char* names[] = { "Unreported.txt", "Monthly Report.txt", "MonthlyReport.txt", "report", "Reports.txt" };
+		vector<FileSystem::FileInfo> contents;
+
+		for (auto name : names)
+		{
+			contents.emplace_back(name, FileSystem::FileStatus::File, "", 1000);
+		}
+
+		SearchIndex::Update(m_RootPath, contents);
+
+		auto results = SearchIndex::Search("Report", SearchIndex::QueryType::Substring, 10);
+		const char* expectedNames[] = { "report", "Reports.txt", "MonthlyReport.txt", "Monthly Report.txt", "Unreported.txt" };
+		Assert::AreEqual(static_cast<size_t>(5), results.results.size());
+
+		for (size_t i = 0; i < results.results.size(); i++)
+		{
+			Assert::AreEqual(string(expectedNames[i]), results.results[i].name);
+			Assert::AreEqual(FileSystem::CombinePaths(m_RootPath, expectedNames[i]), results.results[i].path);
+		}
+
+		results = SearchIndex::Search("report", SearchIndex::QueryType::Prefix, 1);
+		Assert::AreEqual(static_cast<size_t>(2), results.matchCount);
+		Assert::AreEqual(static_cast<size_t>(1), results.results.size());
+		Assert::AreEqual(string("report"), results.results[0].name);
+	}
+
+	TEST_METHOD(ListingsAndInvalidationsKeepTheIndexCurrent)
+	{
+		auto subfolders = m_Share.GetRootSubfolders();
+		Assert::IsTrue(!subfolders.empty());
+
+		vector<IndexedFile> files;
+		WalkSerially(m_RootPath, files);
+
+		auto oldFile = find_if(files.begin(), files.end(), [&subfolders](const IndexedFile& file)
+		{
+			return FileSystem::RemoveLastPathComponent(file.path) == subfolders[0] + "\\";
+		});
+
+		Assert::IsTrue(oldFile != files.end());
+		auto oldName = oldFile->name;
+		auto oldPaths = FindSerially(files, oldName, true);
+		Assert::IsTrue(Search(oldName, SearchIndex::QueryType::Prefix) == oldPaths);
+
+		vector<FileSystem::FileInfo> newContents;
+		newContents.emplace_back("Quarterly numbers.xlsx", FileSystem::FileStatus::File, "", 1000);
+		SearchIndex::Update(subfolders[0], newContents);
+
+		auto paths = Search("numbers.x", SearchIndex::QueryType::Substring);
+		Assert::AreEqual(static_cast<size_t>(1), paths.size());
+		Assert::AreEqual(FileSystem::CombinePaths(subfolders[0], "Quarterly numbers.xlsx"), paths[0]);
+		paths = Search(oldName, SearchIndex::QueryType::Prefix);
+		Assert::IsTrue(find(paths.begin(), paths.end(), oldFile->path) == paths.end());
+
+		// Nothing on disk changed, so listing the folder again brings back what it had
+		SearchIndex::Invalidate(subfolders[0]);
+		SearchIndex::WaitUntilIdle();
+
+		Assert::IsTrue(Search("numbers.x", SearchIndex::QueryType::Substring).empty());
+		Assert::IsTrue(Search(oldName, SearchIndex::QueryType::Prefix) == oldPaths);
+	}
+
+	TEST_METHOD(TurningTheIndexOffDropsIt)
+	{
+		Assert::IsTrue(SearchIndex::GetStatistics().postingBytes > 0);
+
+		SearchIndex::SetEnabled(false);
+		auto statistics = SearchIndex::GetStatistics();
+		Assert::AreEqual(static_cast<uint64_t>(0), statistics.entryCount);
+		Assert::AreEqual(static_cast<uint64_t>(0), statistics.postingBytes);
+		Assert::IsTrue(SearchIndex::Search("1", SearchIndex::QueryType::Substring, 10).results.empty());
+
+		SearchIndex::SetEnabled(true);
+		SearchIndex::WaitUntilIdle();
+		Assert::IsTrue(SearchIndex::GetStatistics().entryCount > 0);
+	}
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Communication\SharedFiles.h"
+#include "Utilities\SyntheticFileSystemProvider.h"
+
+// A generated tree installed as the current file system, with its root fully shared, for tests of code that crawls shares
+class SyntheticShareFixture
+{
+private:
+	std::unique_ptr<SyntheticFileSystemProvider> m_Provider;
+	std::string m_RootPath;
+
+public:
+	SyntheticShareFixture()
+	{
+	}
+
+	SyntheticShareFixture(const SyntheticShareFixture&) = delete;
+	SyntheticShareFixture& operator=(const SyntheticShareFixture&) = delete;
+
+	// Replaces the tree without touching the shares, so whatever was cached about the old one stays cached
+	void InstallTree(const SyntheticFileSystemProvider::Parameters& parameters)
+	{
+		m_Provider.reset(new SyntheticFileSystemProvider(parameters));
+		m_RootPath = Utilities::Encoding::Utf16ToUtf8(parameters.rootPath);
+
+		FileSystemProvider::SetCurrent(m_Provider.get());
+	}
+
+	void ShareRoot() const
+	{
+		SharedFiles::FileSet fullySharedFolders;
+		fullySharedFolders.insert(m_RootPath);
+		SharedFiles::SetSharedFiles(std::move(fullySharedFolders), SharedFiles::FileSet(), SharedFiles::FileSet());
+	}
+
+	void Reset()
+	{
+		SharedFiles::SetSharedFiles(SharedFiles::FileSet(), SharedFiles::FileSet(), SharedFiles::FileSet());
+		FileSystemProvider::SetCurrent(nullptr);
+		m_Provider.reset();
+	}
+
+	inline const std::string& GetRootPath() const { return m_RootPath; }
+
+	std::vector<std::string> GetRootSubfolders() const
+	{
+		std::vector<std::string> subfolders;
+
+		for (const auto& file : Utilities::FileSystem::EnumerateFiles(Utilities::Encoding::Utf8ToUtf16(m_RootPath)))
+		{
+			if (file.fileStatus == Utilities::FileSystem::FileStatus::Directory)
+			{
+				subfolders.push_back(Utilities::FileSystem::CombinePaths(m_RootPath, file.fileName));
+			}
+		}
+
+		return subfolders;
+	}
+
+	// Lists every entry under the path one folder at a time, each before its contents, as the expected results to compare with
+	static void WalkSerially(const std::string& path, const std::function<void(const std::string& path, const Utilities::FileSystem::FileInfo& file)>& callback)
+	{
+		for (const auto& file : Utilities::FileSystem::EnumerateFiles(Utilities::Encoding::Utf8ToUtf16(path)))
+		{
+			auto filePath = Utilities::FileSystem::CombinePaths(path, file.fileName);
+			callback(filePath, file);
+
+			if (file.fileStatus == Utilities::FileSystem::FileStatus::Directory)
+			{
+				WalkSerially(filePath, callback);
+			}
+		}
+	}
+};
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "PrecompiledHeader.h"
+
+#if _TESTBUILD
+
+#include "CppUnitTest.h"
+#include "Utilities\TimerWheel.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+
+TEST_CLASS(TimerWheelTests)
+{
+public:
+	TEST_METHOD(TimersExpireOnTheirTickAcrossLevels)
+	{
+		const uint64_t kTick = 1000;
+		const uint64_t kStart = 123456 * kTick;
+		TimerWheel wheel(kTick, kStart);
+		TimerWheel::Timer soon, later, muchLater;
+
+		// One per level: within a turn of the lowest level, a few turns away, and a few turns of the second level away
+		wheel.Schedule(soon, kStart + 5 * kTick);
+		wheel.Schedule(later, kStart + 300 * kTick);
+		wheel.Schedule(muchLater, kStart + 20000 * kTick);
+
+		wheel.Advance(kStart + 4 * kTick);
+		Assert::IsNull(wheel.PopExpired());
+
+		wheel.Advance(kStart + 5 * kTick);
+		Assert::IsTrue(wheel.PopExpired() == &soon);
+		Assert::IsNull(wheel.PopExpired());
+		Assert::IsFalse(soon.IsScheduled());
+
+		for (uint64_t tick = 6; tick < 300; tick++)
+		{
+			wheel.Advance(kStart + tick * kTick);
+			Assert::IsNull(wheel.PopExpired());
+		}
+
+		wheel.Advance(kStart + 300 * kTick);
+		Assert::IsTrue(wheel.PopExpired() == &later);
+
+		wheel.Advance(kStart + 19999 * kTick);
+		Assert::IsNull(wheel.PopExpired());
+		Assert::IsTrue(muchLater.IsScheduled());
+
+		wheel.Advance(kStart + 20000 * kTick);
+		Assert::IsTrue(wheel.PopExpired() == &muchLater);
+		Assert::IsNull(wheel.PopExpired());
+	}
+
+	TEST_METHOD(CancelledAndRescheduledTimersDontFire)
+	{
+		const uint64_t kTick = 1000;
+		TimerWheel wheel(kTick, 0);
+		TimerWheel::Timer cancelled, rescheduled, past;
+
+		wheel.Schedule(cancelled, 10 * kTick);
+		wheel.Schedule(rescheduled, 10 * kTick);
+		wheel.Schedule(past, 0);
+		cancelled.Cancel();
+		wheel.Schedule(rescheduled, 1000 * kTick);
+		Assert::IsFalse(cancelled.IsScheduled());
+
+		// Deadlines that have passed fire on the next tick
+		wheel.Advance(10 * kTick);
+		Assert::IsTrue(wheel.PopExpired() == &past);
+		Assert::IsNull(wheel.PopExpired());
+
+		{
+			TimerWheel::Timer destroyed;
+			wheel.Schedule(destroyed, 500 * kTick);
+		}
+
+		wheel.Advance(1000 * kTick);
+		Assert::IsTrue(wheel.PopExpired() == &rescheduled);
+		Assert::IsNull(wheel.PopExpired());
+	}
+};
+
+#endif // _TESTBUILD
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include "PrecompiledHeader.h"
+
+#if _TESTBUILD
+
+#include "CppUnitTest.h"
+#include "Utilities\Event.h"
+#include "Utilities\WorkStealingPool.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace std;
+
+TEST_CLASS(WorkStealingPoolTests)
+{
+private:
+	// Every task submits two smaller ones, like a directory with two subfolders
+	static void SubmitTree(WorkStealingPool& pool, uint32_t depth, atomic<uint32_t>& taskCount)
+	{
+		taskCount++;
+
+		if (depth == 0)
+		{
+			return;
+		}
+
+		for (int i = 0; i < 2; i++)
+		{
+			pool.Submit([&pool, depth, &taskCount]()
+			{
+				SubmitTree(pool, depth - 1, taskCount);
+			});
+		}
+	}
+
+public:
+	TEST_METHOD(RunsTasksSubmittedByTasks)
+	{
+		const uint32_t kDepth = 12;
+		atomic<uint32_t> taskCount(0);
+
+		{
+			WorkStealingPool pool(4);
+
+			pool.Submit([&pool, &taskCount]()
+			{
+				SubmitTree(pool, kDepth, taskCount);
+			});
+		}
+
+		Assert::AreEqual((1u << (kDepth + 1)) - 1, taskCount.load());
+	}
+
+	TEST_METHOD(IdleWorkersStealFromBusyOnes)
+	{
+		const uint32_t kTaskCount = 4;
+		atomic<uint32_t> runningCount(0);
+		Event allRunningEvent(true);
+		WorkStealingPool pool(kTaskCount);
+
+		// Everything lands in the first worker's queue, and only finishes once all of it runs at the same time
+		pool.Submit([&]()
+		{
+			for (uint32_t i = 0; i < kTaskCount; i++)
+			{
+				pool.Submit([&]()
+				{
+					if (++runningCount == kTaskCount)
+					{
+						allRunningEvent.Set();
+					}
+
+					allRunningEvent.Wait();
+				});
+			}
+		});
+
+		allRunningEvent.Wait();
+	}
+
+	TEST_METHOD(RunsEveryTaskWhenSubmittedFromEverywhereAtOnce)
+	{
+		const uint32_t kRoundCount = 50;
+		const uint32_t kWorkerCount = 8;
+		const uint32_t kSubmitterCount = 4;
+		const uint32_t kTasksPerSubmitter = 500;
+		const uint32_t kDepth = 3;
+
+		// Queues keep running empty and filling up again, so workers often find their task taken by the time they get to it
+		for (uint32_t round = 0; round < kRoundCount; round++)
+		{
+			atomic<uint32_t> taskCount(0);
+
+			{
+				WorkStealingPool pool(kWorkerCount);
+				vector<thread> submitters;
+
+				for (uint32_t i = 0; i < kSubmitterCount; i++)
+				{
+					submitters.emplace_back([&pool, &taskCount]()
+					{
+						for (uint32_t j = 0; j < kTasksPerSubmitter; j++)
+						{
+							pool.Submit([&pool, &taskCount]()
+							{
+								SubmitTree(pool, kDepth, taskCount);
+							});
+						}
+					});
+				}
+
+				for (auto& submitter : submitters)
+				{
+					submitter.join();
+				}
+
+				// These only finish once all of them run at the same time, so every worker has to be still there
+				atomic<uint32_t> runningCount(0);
+				Event allRunningEvent(true);
+
+				for (uint32_t i = 0; i < kWorkerCount; i++)
+				{
+					pool.Submit([&]()
+					{
+						if (++runningCount == kWorkerCount)
+						{
+							allRunningEvent.Set();
+						}
+
+						allRunningEvent.Wait();
+					});
+				}
+
+				allRunningEvent.Wait();
+			}
+
+			Assert::AreEqual(kSubmitterCount * kTasksPerSubmitter * ((1u << (kDepth + 1)) - 1), taskCount.load());
+		}
+	}
+};
+
+#endif
\ No newline at end of file
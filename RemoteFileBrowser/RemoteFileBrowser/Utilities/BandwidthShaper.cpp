@@ -0,0 +1,245 @@
+#include "PrecompiledHeader.h"
+#include "BandwidthShaper.h"
+
+using namespace std;
+using namespace Utilities;
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+// How far a stream may run ahead of its rate. Covers timer granularity, so waking up late doesn't cost throughput
+static const uint64_t kBurstMicroseconds = 50 * 1000;
+
+// Data is handed out in slices of about this much sending time, so rate changes apply quickly and sends stay smooth
+static const uint64_t kSliceMicroseconds = 20 * 1000;
+static const uint64_t kMinSliceLength = 16 * 1024;
+
+static CriticalSection s_CriticalSection;
+static BandwidthShaper::Limits s_Limits;
+static vector<BandwidthShaper::Stream*> s_Streams;
+
+BandwidthShaper::Limits::Limits() :
+	global(0), perClient(0), perConnection(0)
+{
+}
+
+vector<uint64_t> BandwidthShaper::DivideFairly(uint64_t rate, const vector<ShareRequest>& requests)
+{
+	vector<uint64_t> shares(requests.size());
+
+	if (rate == 0)
+	{
+		for (size_t i = 0; i < requests.size(); i++)
+		{
+			shares[i] = requests[i].cap;
+		}
+
+		return shares;
+	}
+
+	// Hand out the rate starting with the requests whose cap is the smallest part of their weighted share.
+	// Once a request's cap is above an equal split of what's left, so are the caps of all that follow
+	vector<size_t> order(requests.size());
+	double remainingRate = static_cast<double>(rate);
+	double remainingWeight = 0;
+
+	for (size_t i = 0; i < requests.size(); i++)
+	{
+		Assert(requests[i].weight > 0);
+		order[i] = i;
+		remainingWeight += requests[i].weight;
+	}
+
+	sort(begin(order), end(order), [&requests](size_t left, size_t right)
+	{
+		const auto& leftRequest = requests[left];
+		const auto& rightRequest = requests[right];
+
+		if (leftRequest.cap == 0 || rightRequest.cap == 0)
+		{
+			return rightRequest.cap == 0 && leftRequest.cap != 0;
+		}
+
+		return static_cast<double>(leftRequest.cap) * rightRequest.weight < static_cast<double>(rightRequest.cap) * leftRequest.weight;
+	});
+
+	for (auto index : order)
+	{
+		const auto& request = requests[index];
+		auto share = remainingRate * request.weight / remainingWeight;
+
+		if (request.cap != 0 && request.cap < share)
+		{
+			share = static_cast<double>(request.cap);
+		}
+
+		shares[index] = max<uint64_t>(1, static_cast<uint64_t>(share));	// 0 would mean unlimited
+		remainingRate -= share;
+		remainingWeight -= request.weight;
+	}
+
+	return shares;
+}
+
+// Splits the client limits between each client's streams first, which caps what they can get out of the global limit
+static void Rebalance()
+{
+	if (s_Streams.empty())
+	{
+		return;
+	}
+
+	vector<size_t> order(s_Streams.size());
+
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		order[i] = i;
+	}
+
+	sort(begin(order), end(order), [](size_t left, size_t right)
+	{
+		return memcmp(&s_Streams[left]->GetClientAddress(), &s_Streams[right]->GetClientAddress(), sizeof(IN6_ADDR)) < 0;
+	});
+
+	vector<BandwidthShaper::ShareRequest> globalRequests(s_Streams.size());
+	vector<BandwidthShaper::ShareRequest> clientRequests;
+	size_t clientStart = 0;
+
+	while (clientStart < order.size())
+	{
+		const auto& clientAddress = s_Streams[order[clientStart]]->GetClientAddress();
+		auto clientEnd = clientStart + 1;
+
+		while (clientEnd < order.size() && memcmp(&s_Streams[order[clientEnd]]->GetClientAddress(), &clientAddress, sizeof(IN6_ADDR)) == 0)
+		{
+			clientEnd++;
+		}
+
+		clientRequests.clear();
+
+		for (auto i = clientStart; i < clientEnd; i++)
+		{
+			BandwidthShaper::ShareRequest request = { s_Streams[order[i]]->GetWeight(), s_Limits.perConnection };
+			clientRequests.push_back(request);
+		}
+
+		auto clientShares = BandwidthShaper::DivideFairly(s_Limits.perClient, clientRequests);
+
+		for (auto i = clientStart; i < clientEnd; i++)
+		{
+			BandwidthShaper::ShareRequest request = { s_Streams[order[i]]->GetWeight(), clientShares[i - clientStart] };
+			globalRequests[order[i]] = request;
+		}
+
+		clientStart = clientEnd;
+	}
+
+	auto rates = BandwidthShaper::DivideFairly(s_Limits.global, globalRequests);
+
+	for (size_t i = 0; i < s_Streams.size(); i++)
+	{
+		s_Streams[i]->SetRate(rates[i]);
+	}
+}
+
+void BandwidthShaper::SetLimits(const Limits& limits)
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+	s_Limits = limits;
+	Rebalance();
+}
+
+BandwidthShaper::Limits BandwidthShaper::GetLimits()
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+	return s_Limits;
+}
+
+BandwidthShaper::Stream::Stream(const IN6_ADDR& clientAddress, uint32_t weight) :
+	m_ClientAddress(clientAddress), m_Weight(max<uint32_t>(1, weight)), m_Rate(0), m_TheoreticalArrivalTime(0)
+{
+	// High resolution timers need Windows 10 1803, the default resolution is good enough with kBurstMicroseconds of slack
+	m_Timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_MODIFY_STATE | SYNCHRONIZE);
+
+	if (m_Timer == nullptr)
+	{
+		m_Timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_MODIFY_STATE | SYNCHRONIZE);
+	}
+
+	CriticalSection::Lock lock(s_CriticalSection);
+	s_Streams.push_back(this);
+	Rebalance();
+}
+
+BandwidthShaper::Stream::~Stream()
+{
+	{
+		CriticalSection::Lock lock(s_CriticalSection);
+		s_Streams.erase(find(begin(s_Streams), end(s_Streams), this));
+		Rebalance();
+	}
+
+	if (m_Timer != nullptr)
+	{
+		CloseHandle(m_Timer);
+	}
+}
+
+size_t BandwidthShaper::Stream::Acquire(size_t length, const CancellationToken& cancellationToken)
+{
+	auto rate = m_Rate.load(memory_order_relaxed);
+
+	if (rate == 0)
+	{
+		return length;
+	}
+
+	auto sliceLength = static_cast<size_t>(min<uint64_t>(length, max(kMinSliceLength, rate * kSliceMicroseconds / 1000000)));
+
+	// Virtual scheduling form of the token bucket: the theoretical arrival time is when everything acquired so far
+	// would be sent at exactly the rate. It never falls behind the clock, so idle time can't be saved up for a burst.
+	// Waits target it rather than the current time, which keeps oversleeping from adding up
+	auto now = System::GetMicroseconds();
+
+	if (m_TheoreticalArrivalTime < now)
+	{
+		m_TheoreticalArrivalTime = now;
+	}
+	else if (m_TheoreticalArrivalTime > now + kBurstMicroseconds && !WaitUntil(m_TheoreticalArrivalTime - kBurstMicroseconds, cancellationToken))
+	{
+		return 0;
+	}
+
+	m_TheoreticalArrivalTime += sliceLength * 1000000ull / rate;
+	return sliceLength;
+}
+
+// Returns false if cancelled first
+bool BandwidthShaper::Stream::WaitUntil(uint64_t microseconds, const CancellationToken& cancellationToken)
+{
+	auto now = System::GetMicroseconds();
+
+	if (microseconds <= now)
+	{
+		return true;
+	}
+
+	LARGE_INTEGER dueTime;
+	dueTime.QuadPart = -static_cast<LONGLONG>((microseconds - now) * 10);	// Relative, in 100 ns units
+
+	if (m_Timer == nullptr || !SetWaitableTimer(m_Timer, &dueTime, 0, nullptr, nullptr, FALSE))
+	{
+		auto milliseconds = static_cast<DWORD>((microseconds - now + 999) / 1000);
+		return WaitForSingleObjectEx(cancellationToken.GetWaitHandle(), milliseconds, FALSE) == WAIT_TIMEOUT;
+	}
+
+	HANDLE waitHandles[] = { m_Timer, cancellationToken.GetWaitHandle() };
+	return WaitForMultipleObjectsEx(sizeof(waitHandles) / sizeof(waitHandles[0]), waitHandles, FALSE, INFINITE, FALSE) == WAIT_OBJECT_0;
+}
+
+uint64_t BandwidthShaper::Stream::GetTransferTimeMilliseconds(uint64_t length) const
+{
+	auto rate = m_Rate.load(memory_order_relaxed);
+	return rate != 0 ? length * 1000 / rate : 0;
+}
\ No newline at end of file
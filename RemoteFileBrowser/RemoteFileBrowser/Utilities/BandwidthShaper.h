@@ -0,0 +1,63 @@
+#pragma once
+
+// Token bucket rate limits for downloads, per connection, per client IP and globally.
+// Rates are divided between active streams by max-min fair sharing with weights: every stream gets its weighted share
+// of its client's limit and of the global limit, and whatever a capped stream can't use goes to the others.
+// Each stream then paces itself against its own rate, so sending never takes a shared lock.
+
+namespace BandwidthShaper
+{
+	// Bytes per second, 0 means unlimited
+	struct Limits
+	{
+		uint64_t global;
+		uint64_t perClient;
+		uint64_t perConnection;
+
+		Limits();
+	};
+
+	void SetLimits(const Limits& limits);
+	Limits GetLimits();
+
+	struct ShareRequest
+	{
+		uint32_t weight;
+		uint64_t cap;		// 0 means unlimited
+	};
+
+	// Max-min fair split of rate between requests in proportion to their weights. With a rate of 0 everyone gets their cap
+	std::vector<uint64_t> DivideFairly(uint64_t rate, const std::vector<ShareRequest>& requests);
+
+	// An active download. Registers itself for its share of the bandwidth for as long as it lives
+	class Stream
+	{
+	private:
+		IN6_ADDR m_ClientAddress;
+		uint32_t m_Weight;
+		std::atomic<uint64_t> m_Rate;		// 0 when unlimited
+		uint64_t m_TheoreticalArrivalTime;	// In microseconds, see Acquire
+		HANDLE m_Timer;
+
+		bool WaitUntil(uint64_t microseconds, const CancellationToken& cancellationToken);
+
+	public:
+		Stream(const IN6_ADDR& clientAddress, uint32_t weight = 1);
+		~Stream();
+
+		Stream(const Stream&) = delete;
+		Stream& operator=(const Stream&) = delete;
+
+		// Waits until part of the data may be sent, and returns how much, or 0 if cancelled while waiting.
+		// Only the thread sending the stream may call it
+		size_t Acquire(size_t length, const CancellationToken& cancellationToken = CancellationToken::None());
+
+		// How long sending length bytes takes at the current rate, 0 if unlimited
+		uint64_t GetTransferTimeMilliseconds(uint64_t length) const;
+
+		inline const IN6_ADDR& GetClientAddress() const { return m_ClientAddress; }
+		inline uint32_t GetWeight() const { return m_Weight; }
+		inline uint64_t GetRate() const { return m_Rate.load(std::memory_order_relaxed); }
+		inline void SetRate(uint64_t rate) { m_Rate.store(rate, std::memory_order_relaxed); }
+	};
+};
\ No newline at end of file
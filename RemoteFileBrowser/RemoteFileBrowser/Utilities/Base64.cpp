@@ -0,0 +1,624 @@
+#include "PrecompiledHeader.h"
+#include "Base64.h"
+
+using namespace std;
+using namespace Simd;
+using namespace Base64;
+
+static const char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char kPadding = '=';
+static const uint8_t kInvalid = 0xFF;
+
+static const uint8_t kSextets[256] =
+{
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 62, 255, 255, 255, 63,
+	52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 255, 255, 255, 255, 255, 255,
+	255, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+	15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 255, 255, 255, 255, 255,
+	255, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+	41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+	255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255
+};
+
+static void EncodeScalar(const uint8_t* data, size_t length, char* destination)
+{
+	Assert(length % 3 == 0);
+
+	for (size_t i = 0; i < length; i += 3)
+	{
+		auto group = (static_cast<uint32_t>(data[i]) << 16) | (static_cast<uint32_t>(data[i + 1]) << 8) | data[i + 2];
+
+		destination[0] = kAlphabet[group >> 18];
+		destination[1] = kAlphabet[(group >> 12) & 0x3F];
+		destination[2] = kAlphabet[(group >> 6) & 0x3F];
+		destination[3] = kAlphabet[group & 0x3F];
+		destination += 4;
+	}
+}
+
+// Reads the whole quad before writing, so destination may trail str
+static bool DecodeScalar(const char* str, size_t length, uint8_t* destination)
+{
+	Assert(length % 4 == 0);
+
+	for (size_t i = 0; i < length; i += 4)
+	{
+		uint32_t a = kSextets[static_cast<uint8_t>(str[i])];
+		uint32_t b = kSextets[static_cast<uint8_t>(str[i + 1])];
+		uint32_t c = kSextets[static_cast<uint8_t>(str[i + 2])];
+		uint32_t d = kSextets[static_cast<uint8_t>(str[i + 3])];
+
+		if (((a | b | c | d) & 0xC0) != 0)
+		{
+			return false;
+		}
+
+		auto group = (a << 18) | (b << 12) | (c << 6) | d;
+
+		destination[0] = static_cast<uint8_t>(group >> 16);
+		destination[1] = static_cast<uint8_t>(group >> 8);
+		destination[2] = static_cast<uint8_t>(group);
+		destination += 3;
+	}
+
+	return true;
+}
+
+// The vector kernels follow Wojciech Mula's and Daniel Lemire's approach. Encoding spreads each 3 byte group
+// over a 32-bit lane and moves the four sextets into separate bytes with multiplies, then turns the sextets into
+// characters by adding a per-range offset. Decoding classifies the characters by range, which both validates
+// them and picks the offset back to sextets, and packs four sextets into three bytes with multiply-adds.
+// Decoded groups are stored exactly, never past what they decode to, so decoding in place works.
+
+#if SIMD_X86
+
+SIMD_TARGET_SSSE3 static inline __m128i SplitSextetsSsse3(__m128i bytes)
+{
+	// Bytes 0..11 become the lanes [b1 b0 b2 b1], [b4 b3 b5 b4], ...
+	auto shuffled = _mm_shuffle_epi8(bytes, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+	auto firstAndThird = _mm_mulhi_epu16(_mm_and_si128(shuffled, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+	auto secondAndFourth = _mm_mullo_epi16(_mm_and_si128(shuffled, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+	return _mm_or_si128(firstAndThird, secondAndFourth);
+}
+
+SIMD_TARGET_SSSE3 static inline __m128i SextetsToCharactersSsse3(__m128i sextets)
+{
+	// 0..25 map to 13, 26..51 to 0, 52..61 to 1..10, 62 to 11 and 63 to 12; the table holds each range's offset
+	auto ranges = _mm_subs_epu8(sextets, _mm_set1_epi8(51));
+	ranges = _mm_or_si128(ranges, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), sextets), _mm_set1_epi8(13)));
+
+	auto offsets = _mm_shuffle_epi8(_mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+		'0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0), ranges);
+	return _mm_add_epi8(sextets, offsets);
+}
+
+static inline __m128i IsInRangeSse2(__m128i bytes, char low, char high)
+{
+	return _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8(low - 1)), _mm_cmplt_epi8(bytes, _mm_set1_epi8(high + 1)));
+}
+
+static inline __m128i IsEqualSse2(__m128i bytes, char c)
+{
+	return _mm_cmpeq_epi8(bytes, _mm_set1_epi8(c));
+}
+
+// Marks the invalid characters in invalid
+static inline __m128i CharactersToSextetsSse2(__m128i characters, __m128i& invalid)
+{
+	auto upper = IsInRangeSse2(characters, 'A', 'Z');
+	auto lower = IsInRangeSse2(characters, 'a', 'z');
+	auto digit = IsInRangeSse2(characters, '0', '9');
+	auto plus = IsEqualSse2(characters, '+');
+	auto slash = IsEqualSse2(characters, '/');
+
+	auto valid = _mm_or_si128(_mm_or_si128(_mm_or_si128(upper, lower), digit), _mm_or_si128(plus, slash));
+	invalid = _mm_xor_si128(valid, _mm_set1_epi8(-1));
+
+	auto offsets = _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-'A')), _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+	offsets = _mm_or_si128(offsets, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+	offsets = _mm_or_si128(offsets, _mm_or_si128(_mm_and_si128(plus, _mm_set1_epi8(62 - '+')), _mm_and_si128(slash, _mm_set1_epi8(63 - '/'))));
+	return _mm_add_epi8(characters, offsets);
+}
+
+// Leaves the 3 bytes of each quad at the start of its 32-bit lane in the first 12 bytes
+SIMD_TARGET_SSSE3 static inline __m128i PackSextetsSsse3(__m128i sextets)
+{
+	auto pairs = _mm_maddubs_epi16(sextets, _mm_set1_epi32(0x01400140));
+	auto groups = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+	return _mm_shuffle_epi8(groups, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+static inline void Store12BytesSse2(uint8_t* destination, __m128i bytes)
+{
+	_mm_storel_epi64(reinterpret_cast<__m128i*>(destination), bytes);
+	*reinterpret_cast<uint32_t*>(destination + 8) = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(bytes, 8)));
+}
+
+SIMD_TARGET_SSSE3 static void EncodeSsse3(const uint8_t* data, size_t length, char* destination)
+{
+	Assert(length % 3 == 0);
+	size_t i = 0;
+
+	// Each block uses 12 of the 16 bytes it loads
+	for (; i + 16 <= length; i += 12)
+	{
+		auto characters = SextetsToCharactersSsse3(SplitSextetsSsse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i))));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination), characters);
+		destination += 16;
+	}
+
+	EncodeScalar(data + i, length - i, destination);
+}
+
+SIMD_TARGET_SSSE3 static bool DecodeSsse3(const char* str, size_t length, uint8_t* destination)
+{
+	Assert(length % 4 == 0);
+	size_t i = 0;
+
+	for (; i + 16 <= length; i += 16)
+	{
+		__m128i invalid;
+		auto sextets = CharactersToSextetsSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i)), invalid);
+
+		if (_mm_movemask_epi8(invalid) != 0)
+		{
+			return false;
+		}
+
+		Store12BytesSse2(destination, PackSextetsSsse3(sextets));
+		destination += 12;
+	}
+
+	return DecodeScalar(str + i, length - i, destination);
+}
+
+SIMD_TARGET_AVX2 static inline __m256i IsInRangeAvx2(__m256i bytes, char low, char high)
+{
+	return _mm256_and_si256(_mm256_cmpgt_epi8(bytes, _mm256_set1_epi8(low - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8(high + 1), bytes));
+}
+
+SIMD_TARGET_AVX2 static inline __m256i IsEqualAvx2(__m256i bytes, char c)
+{
+	return _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(c));
+}
+
+// AVX2 shuffles don't cross 128-bit lanes, so every step is the SSSE3 one done on both lanes at once
+SIMD_TARGET_AVX2 static void EncodeAvx2(const uint8_t* data, size_t length, char* destination)
+{
+	Assert(length % 3 == 0);
+	size_t i = 0;
+
+	// The upper lane loads from 12 bytes in, so each block uses 24 of the 28 bytes it reads
+	for (; i + 28 <= length; i += 24)
+	{
+		auto lowLane = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+		auto highLane = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 12));
+		auto bytes = _mm256_inserti128_si256(_mm256_castsi128_si256(lowLane), highLane, 1);
+
+		auto shuffled = _mm256_shuffle_epi8(bytes, _mm256_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+			10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+		auto firstAndThird = _mm256_mulhi_epu16(_mm256_and_si256(shuffled, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+		auto secondAndFourth = _mm256_mullo_epi16(_mm256_and_si256(shuffled, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+		auto sextets = _mm256_or_si256(firstAndThird, secondAndFourth);
+
+		auto ranges = _mm256_subs_epu8(sextets, _mm256_set1_epi8(51));
+		ranges = _mm256_or_si256(ranges, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), sextets), _mm256_set1_epi8(13)));
+
+		auto offsets = _mm256_shuffle_epi8(_mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+			'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0), ranges);
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination), _mm256_add_epi8(sextets, offsets));
+		destination += 32;
+	}
+
+	_mm256_zeroupper();
+	EncodeScalar(data + i, length - i, destination);
+}
+
+SIMD_TARGET_AVX2 static bool DecodeAvx2(const char* str, size_t length, uint8_t* destination)
+{
+	Assert(length % 4 == 0);
+	size_t i = 0;
+
+	for (; i + 32 <= length; i += 32)
+	{
+		auto characters = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + i));
+
+		auto upper = IsInRangeAvx2(characters, 'A', 'Z');
+		auto lower = IsInRangeAvx2(characters, 'a', 'z');
+		auto digit = IsInRangeAvx2(characters, '0', '9');
+		auto plus = IsEqualAvx2(characters, '+');
+		auto slash = IsEqualAvx2(characters, '/');
+		auto valid = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(upper, lower), digit), _mm256_or_si256(plus, slash));
+
+		if (static_cast<uint32_t>(_mm256_movemask_epi8(valid)) != 0xFFFFFFFF)
+		{
+			_mm256_zeroupper();
+			return false;
+		}
+
+		auto offsets = _mm256_or_si256(_mm256_and_si256(upper, _mm256_set1_epi8(-'A')), _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a')));
+		offsets = _mm256_or_si256(offsets, _mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')));
+		offsets = _mm256_or_si256(offsets, _mm256_or_si256(_mm256_and_si256(plus, _mm256_set1_epi8(62 - '+')), _mm256_and_si256(slash, _mm256_set1_epi8(63 - '/'))));
+		auto sextets = _mm256_add_epi8(characters, offsets);
+
+		auto pairs = _mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x01400140));
+		auto groups = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+		auto packed = _mm256_shuffle_epi8(groups, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+			2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+		// Close the gap between the lanes' 12 bytes, then store exactly 24
+		packed = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm256_castsi256_si128(packed));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(destination + 16), _mm256_extracti128_si256(packed, 1));
+		destination += 24;
+	}
+
+	_mm256_zeroupper();
+	return DecodeScalar(str + i, length - i, destination);
+}
+
+#endif // SIMD_X86
+
+#if SIMD_NEON
+
+// vld3/vld4 and vst3/vst4 (de)interleave the groups for free, leaving one vector per byte or sextet position
+
+static inline uint8x16_t SextetsToCharactersNeon(uint8x16_t sextets)
+{
+	auto offsets = vdupq_n_u8('A');
+	offsets = vbslq_u8(vcgeq_u8(sextets, vdupq_n_u8(26)), vdupq_n_u8('a' - 26), offsets);
+	offsets = vbslq_u8(vcgeq_u8(sextets, vdupq_n_u8(52)), vdupq_n_u8(static_cast<uint8_t>('0' - 52)), offsets);
+	offsets = vbslq_u8(vceqq_u8(sextets, vdupq_n_u8(62)), vdupq_n_u8(static_cast<uint8_t>('+' - 62)), offsets);
+	offsets = vbslq_u8(vceqq_u8(sextets, vdupq_n_u8(63)), vdupq_n_u8(static_cast<uint8_t>('/' - 63)), offsets);
+	return vaddq_u8(sextets, offsets);
+}
+
+static inline uint8x16_t IsInRangeNeon(uint8x16_t bytes, uint8_t low, uint8_t high)
+{
+	return vandq_u8(vcgeq_u8(bytes, vdupq_n_u8(low)), vcleq_u8(bytes, vdupq_n_u8(high)));
+}
+
+// Accumulates the invalid characters into invalid
+static inline uint8x16_t CharactersToSextetsNeon(uint8x16_t characters, uint8x16_t& invalid)
+{
+	auto upper = IsInRangeNeon(characters, 'A', 'Z');
+	auto lower = IsInRangeNeon(characters, 'a', 'z');
+	auto digit = IsInRangeNeon(characters, '0', '9');
+	auto plus = vceqq_u8(characters, vdupq_n_u8('+'));
+	auto slash = vceqq_u8(characters, vdupq_n_u8('/'));
+
+	auto valid = vorrq_u8(vorrq_u8(vorrq_u8(upper, lower), digit), vorrq_u8(plus, slash));
+	invalid = vorrq_u8(invalid, vmvnq_u8(valid));
+
+	auto offsets = vorrq_u8(vandq_u8(upper, vdupq_n_u8(static_cast<uint8_t>(-'A'))), vandq_u8(lower, vdupq_n_u8(static_cast<uint8_t>(26 - 'a'))));
+	offsets = vorrq_u8(offsets, vandq_u8(digit, vdupq_n_u8(static_cast<uint8_t>(52 - '0'))));
+	offsets = vorrq_u8(offsets, vorrq_u8(vandq_u8(plus, vdupq_n_u8(62 - '+')), vandq_u8(slash, vdupq_n_u8(63 - '/'))));
+	return vaddq_u8(characters, offsets);
+}
+
+static void EncodeNeon(const uint8_t* data, size_t length, char* destination)
+{
+	Assert(length % 3 == 0);
+	size_t i = 0;
+
+	for (; i + 48 <= length; i += 48)
+	{
+		auto bytes = vld3q_u8(data + i);
+		uint8x16x4_t characters;
+
+		characters.val[0] = SextetsToCharactersNeon(vshrq_n_u8(bytes.val[0], 2));
+		characters.val[1] = SextetsToCharactersNeon(vorrq_u8(vandq_u8(vshlq_n_u8(bytes.val[0], 4), vdupq_n_u8(0x30)), vshrq_n_u8(bytes.val[1], 4)));
+		characters.val[2] = SextetsToCharactersNeon(vorrq_u8(vandq_u8(vshlq_n_u8(bytes.val[1], 2), vdupq_n_u8(0x3C)), vshrq_n_u8(bytes.val[2], 6)));
+		characters.val[3] = SextetsToCharactersNeon(vandq_u8(bytes.val[2], vdupq_n_u8(0x3F)));
+
+		vst4q_u8(reinterpret_cast<uint8_t*>(destination), characters);
+		destination += 64;
+	}
+
+	EncodeScalar(data + i, length - i, destination);
+}
+
+static bool DecodeNeon(const char* str, size_t length, uint8_t* destination)
+{
+	Assert(length % 4 == 0);
+	size_t i = 0;
+
+	for (; i + 64 <= length; i += 64)
+	{
+		auto characters = vld4q_u8(reinterpret_cast<const uint8_t*>(str + i));
+		auto invalid = vdupq_n_u8(0);
+
+		auto a = CharactersToSextetsNeon(characters.val[0], invalid);
+		auto b = CharactersToSextetsNeon(characters.val[1], invalid);
+		auto c = CharactersToSextetsNeon(characters.val[2], invalid);
+		auto d = CharactersToSextetsNeon(characters.val[3], invalid);
+
+		// Same narrowing trick as in Escaping.cpp, since there's no movemask
+		if (vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(invalid), 4)), 0) != 0)
+		{
+			return false;
+		}
+
+		uint8x16x3_t bytes;
+		bytes.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+		bytes.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+		bytes.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+
+		vst3q_u8(destination, bytes);
+		destination += 48;
+	}
+
+	return DecodeScalar(str + i, length - i, destination);
+}
+
+#endif // SIMD_NEON
+
+// There's no SSE2 version: both directions need SSSE3's byte shuffle
+static const EncodeFunction kEncodeKernels[static_cast<int>(InstructionSet::Count)] =
+{
+	&EncodeScalar,
+#if SIMD_X86
+	nullptr,
+	&EncodeSsse3,
+	&EncodeAvx2,
+	nullptr
+#elif SIMD_NEON
+	nullptr,
+	nullptr,
+	nullptr,
+	&EncodeNeon
+#else
+	nullptr,
+	nullptr,
+	nullptr,
+	nullptr
+#endif
+};
+
+static const DecodeFunction kDecodeKernels[static_cast<int>(InstructionSet::Count)] =
+{
+	&DecodeScalar,
+#if SIMD_X86
+	nullptr,
+	&DecodeSsse3,
+	&DecodeAvx2,
+	nullptr
+#elif SIMD_NEON
+	nullptr,
+	nullptr,
+	nullptr,
+	&DecodeNeon
+#else
+	nullptr,
+	nullptr,
+	nullptr,
+	nullptr
+#endif
+};
+
+// Same lazy selection as in Transcoding.cpp
+static void SelectEncode(const uint8_t* data, size_t length, char* destination);
+static bool SelectDecode(const char* str, size_t length, uint8_t* destination);
+
+static EncodeFunction s_Encode = &SelectEncode;
+static DecodeFunction s_Decode = &SelectDecode;
+
+static void SelectEncode(const uint8_t* data, size_t length, char* destination)
+{
+	s_Encode = SelectKernel(kEncodeKernels);
+	s_Encode(data, length, destination);
+}
+
+static bool SelectDecode(const char* str, size_t length, uint8_t* destination)
+{
+	s_Decode = SelectKernel(kDecodeKernels);
+	return s_Decode(str, length, destination);
+}
+
+size_t Base64::Encode(const void* data, size_t length, char* destination)
+{
+	auto bytes = static_cast<const uint8_t*>(data);
+	auto wholeLength = length - length % 3;
+
+	s_Encode(bytes, wholeLength, destination);
+	auto output = destination + wholeLength / 3 * 4;
+
+	if (wholeLength < length)
+	{
+		uint32_t a = bytes[wholeLength];
+		uint32_t b = wholeLength + 1 < length ? bytes[wholeLength + 1] : 0;
+
+		output[0] = kAlphabet[a >> 2];
+		output[1] = kAlphabet[((a & 0x03) << 4) | (b >> 4)];
+		output[2] = wholeLength + 1 < length ? kAlphabet[(b & 0x0F) << 2] : kPadding;
+		output[3] = kPadding;
+		output += 4;
+	}
+
+	return static_cast<size_t>(output - destination);
+}
+
+bool Base64::Decode(const char* str, size_t length, void* destination, size_t& decodedLength)
+{
+	decodedLength = 0;
+
+	if (length % 4 != 0)
+	{
+		return false;
+	}
+
+	if (length == 0)
+	{
+		return true;
+	}
+
+	// A padded quad goes through the scalar path below; a '=' anywhere else fails in the kernel like any other invalid character
+	auto paddingLength = str[length - 1] != kPadding ? 0 : (str[length - 2] != kPadding ? 1 : 2);
+	auto wholeLength = paddingLength == 0 ? length : length - 4;
+	auto output = static_cast<uint8_t*>(destination);
+
+	if (!s_Decode(str, wholeLength, output))
+	{
+		return false;
+	}
+
+	decodedLength = wholeLength / 4 * 3;
+
+	if (paddingLength != 0)
+	{
+		auto quad = str + wholeLength;
+		uint32_t a = kSextets[static_cast<uint8_t>(quad[0])];
+		uint32_t b = kSextets[static_cast<uint8_t>(quad[1])];
+		uint32_t c = paddingLength == 1 ? kSextets[static_cast<uint8_t>(quad[2])] : 0;
+
+		// The bits past the last byte have to be zero, so that every byte string has exactly one encoding
+		auto trailingBits = paddingLength == 1 ? (c & 0x03) : (b & 0x0F);
+
+		if (a == kInvalid || b == kInvalid || c == kInvalid || trailingBits != 0)
+		{
+			return false;
+		}
+
+		output[decodedLength++] = static_cast<uint8_t>((a << 2) | (b >> 4));
+
+		if (paddingLength == 1)
+		{
+			output[decodedLength++] = static_cast<uint8_t>((b << 4) | (c >> 2));
+		}
+	}
+
+	return true;
+}
+
+Encoder::Encoder() :
+	m_PendingLength(0)
+{
+}
+
+size_t Encoder::Update(const void* data, size_t length, char* destination)
+{
+	auto bytes = static_cast<const uint8_t*>(data);
+	size_t written = 0;
+
+	if (m_PendingLength > 0)
+	{
+		if (m_PendingLength + length < 3)
+		{
+			memcpy(m_Pending + m_PendingLength, bytes, length);
+			m_PendingLength += length;
+			return 0;
+		}
+
+		uint8_t group[3];
+		memcpy(group, m_Pending, m_PendingLength);
+		memcpy(group + m_PendingLength, bytes, 3 - m_PendingLength);
+
+		s_Encode(group, 3, destination);
+		written = 4;
+
+		bytes += 3 - m_PendingLength;
+		length -= 3 - m_PendingLength;
+		m_PendingLength = 0;
+	}
+
+	auto wholeLength = length - length % 3;
+	s_Encode(bytes, wholeLength, destination + written);
+	written += wholeLength / 3 * 4;
+
+	m_PendingLength = length - wholeLength;
+	memcpy(m_Pending, bytes + wholeLength, m_PendingLength);
+	return written;
+}
+
+size_t Encoder::Finish(char* destination)
+{
+	auto written = Encode(m_Pending, m_PendingLength, destination);
+	m_PendingLength = 0;
+	return written;
+}
+
+Decoder::Decoder() :
+	m_PendingLength(0), m_HasSeenPadding(false), m_HasFailed(false)
+{
+}
+
+bool Decoder::Update(const char* str, size_t length, void* destination, size_t& decodedLength)
+{
+	auto output = static_cast<uint8_t*>(destination);
+	decodedLength = 0;
+
+	if (m_HasFailed || length == 0)
+	{
+		return !m_HasFailed;
+	}
+
+	// Nothing may follow the padded quad
+	m_HasFailed = m_HasSeenPadding;
+
+	if (!m_HasFailed && m_PendingLength > 0)
+	{
+		auto count = min(4 - m_PendingLength, length);
+		memcpy(m_Pending + m_PendingLength, str, count);
+		m_PendingLength += count;
+		str += count;
+		length -= count;
+
+		if (m_PendingLength < 4)
+		{
+			return true;
+		}
+
+		size_t quadLength;
+		m_HasFailed = !Decode(m_Pending, 4, output, quadLength);
+		m_HasSeenPadding = quadLength < 3;
+		m_PendingLength = 0;
+		decodedLength += quadLength;
+	}
+
+	auto wholeLength = length - length % 4;
+
+	if (!m_HasFailed && wholeLength > 0)
+	{
+		size_t wholeDecodedLength;
+		m_HasFailed = m_HasSeenPadding || !Decode(str, wholeLength, output + decodedLength, wholeDecodedLength);
+		m_HasSeenPadding = !m_HasFailed && wholeDecodedLength < wholeLength / 4 * 3;
+		decodedLength += m_HasFailed ? 0 : wholeDecodedLength;
+	}
+
+	if (!m_HasFailed && wholeLength < length)
+	{
+		m_HasFailed = m_HasSeenPadding;
+		m_PendingLength = length - wholeLength;
+		memcpy(m_Pending, str + wholeLength, m_PendingLength);
+	}
+
+	return !m_HasFailed;
+}
+
+bool Decoder::Finish() const
+{
+	return !m_HasFailed && m_PendingLength == 0;
+}
+
+EncodeFunction Base64::GetEncode(InstructionSet instructionSet)
+{
+	return kEncodeKernels[static_cast<int>(instructionSet)];
+}
+
+DecodeFunction Base64::GetDecode(InstructionSet instructionSet)
+{
+	return kDecodeKernels[static_cast<int>(instructionSet)];
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Simd.h"
+
+// Base64 with the standard alphabet and padding (RFC 4648). Whole 3 byte groups and 4 character quads go through
+// vector kernels. Decoding is strict: anything outside the alphabet (including whitespace), a length that isn't
+// a multiple of 4, misplaced padding and nonzero bits past the last byte are all rejected.
+
+namespace Base64
+{
+	// Kernels work on whole groups only: length is a multiple of 3 for encoding, and a multiple of 4 without padding for decoding
+	typedef void (*EncodeFunction)(const uint8_t* data, size_t length, char* destination);
+	typedef bool (*DecodeFunction)(const char* str, size_t length, uint8_t* destination);
+
+	inline size_t GetEncodedLength(size_t length) { return (length + 2) / 3 * 4; }
+	inline size_t GetMaxDecodedLength(size_t length) { return length / 4 * 3; }
+
+	// destination must hold GetEncodedLength(length) characters. No null terminator is written
+	size_t Encode(const void* data, size_t length, char* destination);
+
+	// destination must hold GetMaxDecodedLength(length) bytes, and may be str itself to decode in place.
+	// On failure destination holds garbage
+	bool Decode(const char* str, size_t length, void* destination, size_t& decodedLength);
+
+	// For input that arrives in pieces. Output is the same as encoding the concatenated input at once
+	class Encoder
+	{
+	private:
+		uint8_t m_Pending[2];
+		size_t m_PendingLength;
+
+	public:
+		Encoder();
+
+		Encoder(const Encoder&) = delete;
+		Encoder& operator=(const Encoder&) = delete;
+
+		static inline size_t GetMaxUpdateLength(size_t length) { return GetEncodedLength(length); }
+
+		// destination must hold GetMaxUpdateLength(length) characters. Returns the number written
+		size_t Update(const void* data, size_t length, char* destination);
+
+		// Encodes what's left with padding, at most 4 characters
+		size_t Finish(char* destination);
+	};
+
+	class Decoder
+	{
+	private:
+		char m_Pending[4];
+		size_t m_PendingLength;
+		bool m_HasSeenPadding;
+		bool m_HasFailed;
+
+	public:
+		Decoder();
+
+		Decoder(const Decoder&) = delete;
+		Decoder& operator=(const Decoder&) = delete;
+
+		static inline size_t GetMaxUpdateLength(size_t length) { return (length + 3) / 4 * 3; }
+
+		// destination must hold GetMaxUpdateLength(length) bytes. Once it fails, it keeps failing
+		bool Update(const char* str, size_t length, void* destination, size_t& decodedLength);
+
+		// Whether all of the input was valid and ended on a whole quad
+		bool Finish() const;
+	};
+
+	// A specific version, or nullptr if there's none for the instruction set. For tests and benchmarks
+	EncodeFunction GetEncode(Simd::InstructionSet instructionSet);
+	DecodeFunction GetDecode(Simd::InstructionSet instructionSet);
+};
\ No newline at end of file
@@ -0,0 +1,9 @@
+#include "PrecompiledHeader.h"
+#include "CancellationToken.h"
+
+static CancellationToken s_None;
+
+const CancellationToken& CancellationToken::None()
+{
+	return s_None;
+}
\ No newline at end of file
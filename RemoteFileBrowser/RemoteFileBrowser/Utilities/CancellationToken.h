@@ -0,0 +1,47 @@
+#pragma once
+
+// Tripped when whoever the work is for is gone, so it can stop early instead of running to completion.
+// IsCancelled is a plain load, cheap enough to check on every iteration of an inner loop.
+// Waits that should end on cancellation can include GetWaitHandle in a WaitForMultipleObjects.
+class CancellationToken
+{
+private:
+	std::atomic<bool> m_IsCancelled;
+	HANDLE m_CancelledEvent;
+
+public:
+	inline CancellationToken() :
+		m_IsCancelled(false),
+		m_CancelledEvent(CreateEventEx(nullptr, nullptr, CREATE_EVENT_MANUAL_RESET, EVENT_MODIFY_STATE | SYNCHRONIZE))
+	{
+	}
+
+	inline ~CancellationToken()
+	{
+		CloseHandle(m_CancelledEvent);
+	}
+
+	CancellationToken(const CancellationToken&) = delete;
+	CancellationToken& operator=(const CancellationToken&) = delete;
+
+	inline void Cancel()
+	{
+		if (!m_IsCancelled.exchange(true))
+		{
+			SetEvent(m_CancelledEvent);
+		}
+	}
+
+	inline bool IsCancelled() const
+	{
+		return m_IsCancelled.load(std::memory_order_relaxed);
+	}
+
+	inline HANDLE GetWaitHandle() const
+	{
+		return m_CancelledEvent;
+	}
+
+	// Never cancelled, for callers that don't care
+	static const CancellationToken& None();
+};
\ No newline at end of file
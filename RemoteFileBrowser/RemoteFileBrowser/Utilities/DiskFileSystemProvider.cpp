@@ -0,0 +1,615 @@
+#include "PrecompiledHeader.h"
+#include "CriticalSection.h"
+#include "DiskFileSystemProvider.h"
+
+using namespace std;
+using namespace Utilities;
+using namespace Utilities::FileSystem;
+
+// FILE_ID_INFO and its information class are only declared when targeting Windows 8
+struct FileIdInformation
+{
+	ULONGLONG volumeSerialNumber;
+	BYTE fileId[16];
+};
+
+static const FILE_INFO_BY_HANDLE_CLASS kFileIdInfo = static_cast<FILE_INFO_BY_HANDLE_CLASS>(18);
+
+// Same for FILE_FULL_DIR_INFO, the smallest directory entry that has everything listings show
+struct FileFullDirectoryInformation
+{
+	ULONG nextEntryOffset;
+	ULONG fileIndex;
+	LARGE_INTEGER creationTime;
+	LARGE_INTEGER lastAccessTime;
+	LARGE_INTEGER lastWriteTime;
+	LARGE_INTEGER changeTime;
+	LARGE_INTEGER endOfFile;
+	LARGE_INTEGER allocationSize;
+	ULONG fileAttributes;
+	ULONG fileNameLength;		// In bytes, not null terminated
+	ULONG eaSize;
+	WCHAR fileName[1];
+};
+
+static const FILE_INFO_BY_HANDLE_CLASS kFileFullDirectoryInfo = static_cast<FILE_INFO_BY_HANDLE_CLASS>(14);
+
+// Directory queries start with a buffer this big, which is plenty for most directories, and double it for as long as
+// they fill it, so huge ones take a few dozen queries instead of thousands
+static const DWORD kMinEnumerationBufferSize = 64 * 1024;
+static const DWORD kMaxEnumerationBufferSize = 1024 * 1024;
+
+#if !PHONE
+
+// PrefetchVirtualMemory needs Windows 8, so it's looked up at runtime
+struct MemoryRangeEntry
+{
+	void* virtualAddress;
+	SIZE_T numberOfBytes;
+};
+
+typedef BOOL (WINAPI *PrefetchVirtualMemoryFunction)(HANDLE process, ULONG_PTR numberOfEntries, MemoryRangeEntry* virtualAddresses, ULONG flags);
+
+static const PrefetchVirtualMemoryFunction s_PrefetchVirtualMemory =
+	reinterpret_cast<PrefetchVirtualMemoryFunction>(GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "PrefetchVirtualMemory"));
+
+#endif
+
+// A section object of a file. Downloads of the same version of a file share one, registered by path while anyone holds it.
+// Its pages are only ever touched by the kernel, while sending from them, so a file that shrinks or goes away underneath
+// (which only files on network shares can, local ones can't be truncated while mapped) fails the send instead of raising
+// an in-page error in our process
+class FileMapping
+{
+private:
+	wstring m_Path;
+	FileSystemProvider::File::Version m_Version;
+	HANDLE m_Handle;
+
+public:
+	FileMapping(const wstring& path, const FileSystemProvider::File::Version& version, HANDLE handle) :
+		m_Path(path), m_Version(version), m_Handle(handle)
+	{
+	}
+
+	~FileMapping();
+
+	FileMapping(const FileMapping&) = delete;
+	FileMapping& operator=(const FileMapping&) = delete;
+
+	inline const FileSystemProvider::File::Version& GetVersion() const { return m_Version; }
+
+	FileSystemProvider::File::View MapView(uint64_t offset, uint32_t length) const;
+};
+
+static CriticalSection s_MappingsCriticalSection;
+static unordered_map<wstring, weak_ptr<FileMapping>> s_Mappings;
+
+FileMapping::~FileMapping()
+{
+	{
+		CriticalSection::Lock lock(s_MappingsCriticalSection);
+		auto mapping = s_Mappings.find(m_Path);
+
+		// Unless a newer version of the file took the path over already
+		if (mapping != s_Mappings.end() && mapping->second.expired())
+		{
+			s_Mappings.erase(mapping);
+		}
+	}
+
+	CloseHandle(m_Handle);
+}
+
+FileSystemProvider::File::View FileMapping::MapView(uint64_t offset, uint32_t length) const
+{
+	Assert(offset % FileSystemProvider::File::kViewAlignment == 0);
+
+#if !PHONE
+	auto address = MapViewOfFile(m_Handle, FILE_MAP_READ, static_cast<DWORD>(offset >> 32), static_cast<DWORD>(offset), length);
+#else
+	auto address = MapViewOfFileFromApp(m_Handle, FILE_MAP_READ, offset, length);
+#endif
+
+	if (address == nullptr)
+	{
+		return nullptr;
+	}
+
+#if !PHONE
+	// Start reading the whole view in, so it's resident by the time it gets sent. Only a hint, failing is fine
+	if (s_PrefetchVirtualMemory != nullptr)
+	{
+		MemoryRangeEntry range = { address, length };
+		s_PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+	}
+#endif
+
+	return FileSystemProvider::File::View(static_cast<const char*>(address), [](const char* view)
+	{
+		UnmapViewOfFile(view);
+	});
+}
+
+static shared_ptr<FileMapping> AcquireFileMapping(const wstring& path, HANDLE fileHandle, const FileSystemProvider::File::Version& version)
+{
+	shared_ptr<FileMapping> mapping;	// Declared before the lock, so a stale mapping is released after it
+	CriticalSection::Lock lock(s_MappingsCriticalSection);
+
+	auto& registeredMapping = s_Mappings[path];
+	mapping = registeredMapping.lock();
+
+	if (mapping != nullptr && mapping->GetVersion() == version)
+	{
+		return mapping;
+	}
+
+#if !PHONE
+	auto handle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+#else
+	auto handle = CreateFileMappingFromApp(fileHandle, nullptr, PAGE_READONLY, 0, nullptr);
+#endif
+
+	if (handle == nullptr)
+	{
+		return nullptr;
+	}
+
+	auto newMapping = make_shared<FileMapping>(path, version, handle);
+	registeredMapping = newMapping;
+	return newMapping;
+}
+
+class DiskFile : public FileSystemProvider::File
+{
+private:
+	wstring m_Path;
+	HANDLE m_FileHandle;
+	uint64_t m_FileSize;
+	shared_ptr<FileMapping> m_Mapping;
+	bool m_IsUnbuffered;
+
+public:
+	DiskFile(const wstring& path, HANDLE fileHandle, uint64_t fileSize) :
+		m_Path(path), m_FileHandle(fileHandle), m_FileSize(fileSize), m_IsUnbuffered(false)
+	{
+	}
+
+	virtual ~DiskFile()
+	{
+		CloseHandle(m_FileHandle);
+	}
+
+	DiskFile(const DiskFile&) = delete;
+	DiskFile& operator=(const DiskFile&) = delete;
+
+	virtual uint64_t GetSize() const override
+	{
+		return m_FileSize;
+	}
+
+	virtual bool GetVersion(Version& version) const override
+	{
+		FILE_BASIC_INFO basicInfo;
+
+		if (GetFileInformationByHandleEx(m_FileHandle, FileBasicInfo, &basicInfo, sizeof(basicInfo)) == FALSE)
+		{
+			return false;
+		}
+
+		version.size = m_FileSize;
+		version.lastWriteTime = basicInfo.LastWriteTime.QuadPart;
+		version.fileId = 0;
+
+		// Needs Windows 8. Elsewhere the size and modification time have to do
+		FileIdInformation idInfo;
+
+		if (GetFileInformationByHandleEx(m_FileHandle, kFileIdInfo, &idInfo, sizeof(idInfo)) != FALSE)
+		{
+			uint64_t hash = 14695981039346656037ull ^ idInfo.volumeSerialNumber;
+
+			for (auto byte : idInfo.fileId)
+			{
+				hash = (hash ^ byte) * 1099511628211ull;
+			}
+
+			version.fileId = hash;
+		}
+
+		SetLastError(ERROR_SUCCESS);
+		return true;
+	}
+
+	virtual bool Read(uint64_t offset, char* buffer, uint32_t length, uint32_t& bytesRead) override
+	{
+		// The handle is overlapped, so reads of different ranges from different threads run in parallel instead of
+		// queueing up on the file object. Each read waits on an event of its own
+		OVERLAPPED overlapped;
+		ZeroMemory(&overlapped, sizeof(overlapped));
+
+		overlapped.Offset = static_cast<DWORD>(offset);
+		overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+		overlapped.hEvent = CreateEventEx(nullptr, nullptr, CREATE_EVENT_MANUAL_RESET, EVENT_MODIFY_STATE | SYNCHRONIZE);
+
+		if (overlapped.hEvent == nullptr)
+		{
+			return false;
+		}
+
+		// Unbuffered reads cover whole sectors, and stop short at the end of the file
+		auto readLength = length;
+
+		if (m_IsUnbuffered)
+		{
+			Assert(offset % kUnbufferedAlignment == 0 && reinterpret_cast<uintptr_t>(buffer) % kUnbufferedAlignment == 0);
+			readLength = static_cast<uint32_t>((length + kUnbufferedAlignment - 1) / kUnbufferedAlignment * kUnbufferedAlignment);
+		}
+
+		DWORD numberOfBytesRead = 0;
+		auto result = ReadFile(m_FileHandle, buffer, readLength, nullptr, &overlapped);
+
+		if (result != FALSE || GetLastError() == ERROR_IO_PENDING)
+		{
+			result = GetOverlappedResult(m_FileHandle, &overlapped, &numberOfBytesRead, TRUE);
+		}
+
+		auto lastError = GetLastError();
+		CloseHandle(overlapped.hEvent);
+		SetLastError(lastError);
+
+		bytesRead = min(static_cast<uint32_t>(numberOfBytesRead), length);
+		return result != FALSE;
+	}
+
+	virtual bool BypassCache() override
+	{
+#if !PHONE
+		auto fileHandle = ReOpenFile(m_FileHandle, GENERIC_READ, FILE_SHARE_READ, FILE_FLAG_NO_BUFFERING | FILE_FLAG_SEQUENTIAL_SCAN | FILE_FLAG_OVERLAPPED);
+
+		if (fileHandle == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		CloseHandle(m_FileHandle);
+		m_FileHandle = fileHandle;
+		m_IsUnbuffered = true;
+		return true;
+#else
+		SetLastError(ERROR_NOT_SUPPORTED);
+		return false;
+#endif
+	}
+
+	virtual View MapView(uint64_t offset, uint32_t length) override
+	{
+		if (m_Mapping == nullptr)
+		{
+			Version version;
+
+			if (!GetVersion(version))
+			{
+				return nullptr;
+			}
+
+			m_Mapping = AcquireFileMapping(m_Path, m_FileHandle, version);
+
+			if (m_Mapping == nullptr)
+			{
+				return nullptr;
+			}
+		}
+
+		return m_Mapping->MapView(offset, length);
+	}
+};
+
+FileStatus DiskFileSystemProvider::QueryFileStatus(const wstring& path)
+{
+	WIN32_FILE_ATTRIBUTE_DATA fileAttributes;
+	auto result = GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &fileAttributes);
+
+	if (result == FALSE)
+	{
+		auto lastError = GetLastError();
+		SetLastError(ERROR_SUCCESS);
+
+		return lastError == ERROR_FILE_NOT_FOUND ? FileStatus::FileNotFound : FileStatus::AccessDenied;
+	}
+
+	return (fileAttributes.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0 ? FileStatus::Directory : FileStatus::File;
+}
+
+bool DiskFileSystemProvider::QueryLastWriteTime(const wstring& path, uint64_t& lastWriteTime)
+{
+	WIN32_FILE_ATTRIBUTE_DATA fileAttributes;
+
+	if (GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &fileAttributes) == FALSE)
+	{
+		return false;
+	}
+
+	lastWriteTime = (static_cast<uint64_t>(fileAttributes.ftLastWriteTime.dwHighDateTime) << 32) | fileAttributes.ftLastWriteTime.dwLowDateTime;
+	return true;
+}
+
+static inline bool IsDotOrDotDot(const wchar_t* fileName, size_t fileNameLength)
+{
+	return fileName[0] == L'.' && (fileNameLength == 1 || (fileNameLength == 2 && fileName[1] == L'.'));
+}
+
+static inline void AddFileInfo(vector<FileInfo>& files, const wchar_t* fileName, size_t fileNameLength, DWORD fileAttributes, const FILETIME& lastWriteTime, uint64_t fileSize)
+{
+	auto fileStatus = (fileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0 ? FileStatus::Directory : FileStatus::File;
+	files.emplace_back(Encoding::Utf16ToUtf8(fileName, fileNameLength), fileStatus, FormatFileTime(lastWriteTime), fileSize);
+}
+
+// Fills whole buffers of directory entries per call, asking only for the fields listings use. Returns false, with nothing
+// enumerated, where the file system or Windows (before 8) doesn't support it
+static bool EnumerateFilesInBulk(const wstring& path, const CancellationToken& cancellationToken, vector<FileInfo>& files)
+{
+	auto directoryHandle = CreateFilePortable(path, FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS);
+
+	if (directoryHandle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	// Entries are 8 byte aligned
+	vector<uint64_t> buffer(kMinEnumerationBufferSize / sizeof(uint64_t));
+	auto isFirstQuery = true;
+
+	while (!cancellationToken.IsCancelled())
+	{
+		auto bufferSize = static_cast<DWORD>(buffer.size() * sizeof(uint64_t));
+
+		if (GetFileInformationByHandleEx(directoryHandle, kFileFullDirectoryInfo, buffer.data(), bufferSize) == FALSE)
+		{
+			if (isFirstQuery && GetLastError() != ERROR_NO_MORE_FILES)
+			{
+				CloseHandle(directoryHandle);
+				return false;
+			}
+
+			break;
+		}
+
+		isFirstQuery = false;
+
+		auto entryBytes = reinterpret_cast<const uint8_t*>(buffer.data());
+		size_t bytesUsed = 0;
+
+		for (;;)
+		{
+			auto entry = reinterpret_cast<const FileFullDirectoryInformation*>(entryBytes + bytesUsed);
+			auto fileNameLength = entry->fileNameLength / sizeof(wchar_t);
+
+			if (!IsDotOrDotDot(entry->fileName, fileNameLength))
+			{
+				FILETIME lastWriteTime;
+				lastWriteTime.dwLowDateTime = entry->lastWriteTime.LowPart;
+				lastWriteTime.dwHighDateTime = static_cast<DWORD>(entry->lastWriteTime.HighPart);
+
+				AddFileInfo(files, entry->fileName, fileNameLength, entry->fileAttributes, lastWriteTime, static_cast<uint64_t>(entry->endOfFile.QuadPart));
+			}
+
+			if (entry->nextEntryOffset == 0)
+			{
+				bytesUsed += offsetof(FileFullDirectoryInformation, fileName) + entry->fileNameLength;
+				break;
+			}
+
+			bytesUsed += entry->nextEntryOffset;
+		}
+
+		// A query that came back more than half full most likely stopped because the next entry didn't fit, so the directory is a big one
+		if (2 * bytesUsed > bufferSize && bufferSize < kMaxEnumerationBufferSize)
+		{
+			buffer.resize(2 * buffer.size());
+		}
+	}
+
+	CloseHandle(directoryHandle);
+	return true;
+}
+
+static void EnumerateFilesWithFindFile(const wstring& path, const CancellationToken& cancellationToken, vector<FileInfo>& files)
+{
+	wstring searchPattern = path;
+
+	if (searchPattern[searchPattern.length() - 1] == L'\\')
+	{
+		searchPattern += L"*.*";
+	}
+	else
+	{
+		searchPattern += L"\\*.*";
+	}
+
+	WIN32_FIND_DATA findData;
+	auto findHandle = FindFirstFileExW(searchPattern.c_str(), FindExInfoBasic, &findData, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+
+	if (findHandle == INVALID_HANDLE_VALUE)
+	{
+		return;
+	}
+
+	do
+	{
+		auto fileNameLength = wcslen(findData.cFileName);
+
+		if (IsDotOrDotDot(findData.cFileName, fileNameLength))
+			continue;
+
+		auto fileSize = (static_cast<uint64_t>(findData.nFileSizeHigh) << 32) | findData.nFileSizeLow;
+		AddFileInfo(files, findData.cFileName, fileNameLength, findData.dwFileAttributes, findData.ftLastWriteTime, fileSize);
+	}
+	while (!cancellationToken.IsCancelled() && FindNextFileW(findHandle, &findData) != FALSE);
+
+	FindClose(findHandle);
+}
+
+vector<FileInfo> DiskFileSystemProvider::EnumerateFiles(const wstring& path, const CancellationToken& cancellationToken)
+{
+	vector<FileInfo> result;
+
+	if (!EnumerateFilesInBulk(path, cancellationToken, result))
+	{
+		EnumerateFilesWithFindFile(path, cancellationToken, result);
+	}
+
+	SetLastError(ERROR_SUCCESS);
+	return result;
+}
+
+unique_ptr<FileSystemProvider::File> DiskFileSystemProvider::OpenFile(const wstring& path)
+{
+	// Files are only ever opened to be read from start to end, so the cache manager can read ahead further
+	auto fileHandle = CreateFilePortable(path, GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN | FILE_FLAG_OVERLAPPED);
+
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return nullptr;
+	}
+
+	uint64_t fileSize;
+
+	if (!GetFileSizeFromHandle(fileHandle, fileSize))
+	{
+		auto lastError = GetLastError();
+		CloseHandle(fileHandle);
+		SetLastError(lastError);
+		return nullptr;
+	}
+
+	return unique_ptr<File>(new DiskFile(path, fileHandle, fileSize));
+}
+
+#if !PHONE
+
+// Keeps one overlapped ReadDirectoryChangesW call pending on a thread of its own, so destroying the watcher can cancel it
+class DiskChangeWatcher : public FileSystemProvider::ChangeWatcher
+{
+private:
+	// Network shares fail change notifications into buffers over 64 KB
+	static const DWORD kBufferSize = 64 * 1024;
+	static const DWORD kNotifyFilter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE;
+
+	wstring m_DirectoryPath;
+	HANDLE m_DirectoryHandle;
+	bool m_WatchSubtree;
+	FileSystemProvider::ChangeCallback m_Callback;
+	HANDLE m_StopEvent;
+	thread m_Thread;
+
+	void ReportChanges(const char* buffer)
+	{
+		auto separator = m_DirectoryPath.back() == L'\\' ? L"" : L"\\";
+
+		for (;;)
+		{
+			auto notification = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(buffer);
+			m_Callback(m_DirectoryPath + separator + wstring(notification->FileName, notification->FileNameLength / sizeof(WCHAR)));
+
+			if (notification->NextEntryOffset == 0)
+			{
+				return;
+			}
+
+			buffer += notification->NextEntryOffset;
+		}
+	}
+
+	void Run()
+	{
+		vector<DWORD> buffer(kBufferSize / sizeof(DWORD));		// Notifications have to be DWORD aligned
+		OVERLAPPED overlapped;
+		ZeroMemory(&overlapped, sizeof(overlapped));
+		overlapped.hEvent = CreateEventEx(nullptr, nullptr, CREATE_EVENT_MANUAL_RESET, EVENT_MODIFY_STATE | SYNCHRONIZE);
+
+		HANDLE waitHandles[] = { m_StopEvent, overlapped.hEvent };
+
+		for (;;)
+		{
+			DWORD bytesReturned = 0;
+
+			if (ReadDirectoryChangesW(m_DirectoryHandle, buffer.data(), kBufferSize, m_WatchSubtree, kNotifyFilter, nullptr, &overlapped, nullptr) == FALSE)
+			{
+				Logging::Error(GetLastError(), "Failed to watch \"", Encoding::Utf16ToUtf8(m_DirectoryPath), "\" for changes: ");
+				m_Callback(wstring());
+				break;
+			}
+
+			if (WaitForMultipleObjects(2, waitHandles, FALSE, INFINITE) == WAIT_OBJECT_0)
+			{
+				CancelIoEx(m_DirectoryHandle, &overlapped);
+				GetOverlappedResult(m_DirectoryHandle, &overlapped, &bytesReturned, TRUE);
+				break;
+			}
+
+			// Fails once the directory goes away, in which case everything under it did change
+			if (GetOverlappedResult(m_DirectoryHandle, &overlapped, &bytesReturned, FALSE) == FALSE)
+			{
+				m_Callback(wstring());
+				break;
+			}
+
+			if (bytesReturned == 0)
+			{
+				m_Callback(wstring());		// More changes than the buffer could hold
+			}
+			else
+			{
+				ReportChanges(reinterpret_cast<const char*>(buffer.data()));
+			}
+		}
+
+		CloseHandle(overlapped.hEvent);
+	}
+
+public:
+	DiskChangeWatcher(const wstring& directoryPath, HANDLE directoryHandle, bool watchSubtree, FileSystemProvider::ChangeCallback&& callback) :
+		m_DirectoryPath(directoryPath),
+		m_DirectoryHandle(directoryHandle),
+		m_WatchSubtree(watchSubtree),
+		m_Callback(std::move(callback)),
+		m_StopEvent(CreateEventEx(nullptr, nullptr, CREATE_EVENT_MANUAL_RESET, EVENT_MODIFY_STATE | SYNCHRONIZE))
+	{
+		m_Thread = thread([this]()
+		{
+			Run();
+		});
+	}
+
+	virtual ~DiskChangeWatcher()
+	{
+		SetEvent(m_StopEvent);
+		m_Thread.join();
+
+		CloseHandle(m_StopEvent);
+		CloseHandle(m_DirectoryHandle);
+	}
+
+	DiskChangeWatcher(const DiskChangeWatcher&) = delete;
+	DiskChangeWatcher& operator=(const DiskChangeWatcher&) = delete;
+};
+
+#endif
+
+unique_ptr<FileSystemProvider::ChangeWatcher> DiskFileSystemProvider::WatchChanges(const wstring& directoryPath, bool watchSubtree, ChangeCallback&& callback)
+{
+#if !PHONE
+	auto directoryHandle = CreateFilePortable(directoryPath, FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED);
+
+	if (directoryHandle == INVALID_HANDLE_VALUE)
+	{
+		return nullptr;
+	}
+
+	return unique_ptr<ChangeWatcher>(new DiskChangeWatcher(directoryPath, directoryHandle, watchSubtree, std::move(callback)));
+#else
+	SetLastError(ERROR_NOT_SUPPORTED);
+	return nullptr;
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "FileSystemProvider.h"
+
+class DiskFileSystemProvider : public FileSystemProvider
+{
+public:
+	using FileSystemProvider::EnumerateFiles;
+
+	virtual Utilities::FileSystem::FileStatus QueryFileStatus(const std::wstring& path) override;
+	virtual bool QueryLastWriteTime(const std::wstring& path, uint64_t& lastWriteTime) override;
+	virtual std::vector<Utilities::FileSystem::FileInfo> EnumerateFiles(const std::wstring& path, const CancellationToken& cancellationToken) override;
+	virtual std::unique_ptr<File> OpenFile(const std::wstring& path) override;
+	virtual std::unique_ptr<ChangeWatcher> WatchChanges(const std::wstring& directoryPath, bool watchSubtree, ChangeCallback&& callback) override;
+};
\ No newline at end of file
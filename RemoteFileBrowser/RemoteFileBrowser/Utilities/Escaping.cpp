@@ -0,0 +1,373 @@
+#include "PrecompiledHeader.h"
+#include "Escaping.h"
+
+using namespace std;
+using namespace Simd;
+using namespace Escaping;
+
+enum CharacterClass
+{
+	kUrlDecodeSpecial = 1 << 0,
+	kUrlEncodeSpecial = 1 << 1,
+	kHtmlSpecial = 1 << 2,
+	kHeaderDelimiter = 1 << 3
+};
+
+static const uint8_t kCharacterClasses[256] =
+{
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 10, 2, 2, 10, 2, 2,
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	2, 0, 6, 2, 2, 3, 6, 4, 0, 0, 0, 3, 2, 0, 0, 2,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 10, 2, 6, 2, 6, 2,
+	2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 2, 2, 0,
+	2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 2, 2, 2,
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2
+};
+
+template <int characterClass>
+static size_t FindScalar(const char* str, size_t length)
+{
+	for (size_t i = 0; i < length; i++)
+	{
+		if ((kCharacterClasses[static_cast<uint8_t>(str[i])] & characterClass) != 0)
+		{
+			return i;
+		}
+	}
+
+	return length;
+}
+
+// Each vector version is a classifier that marks the special bytes of a block with 0xFF,
+// plugged into a loop that stops at the first block with any marked byte. The tail goes through FindScalar
+
+#if SIMD_X86
+
+static inline __m128i IsInRangeSse2(__m128i bytes, char low, char high)
+{
+	// Signed comparisons: bytes above 0x7F are negative and never in an ASCII range
+	return _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8(low - 1)), _mm_cmplt_epi8(bytes, _mm_set1_epi8(high + 1)));
+}
+
+static inline __m128i IsEqualSse2(__m128i bytes, char c)
+{
+	return _mm_cmpeq_epi8(bytes, _mm_set1_epi8(c));
+}
+
+struct UrlDecodeSse2
+{
+	static const int kCharacterClass = kUrlDecodeSpecial;
+
+	static inline __m128i Classify(__m128i bytes)
+	{
+		return _mm_or_si128(IsEqualSse2(bytes, '%'), IsEqualSse2(bytes, '+'));
+	}
+};
+
+struct UrlEncodeSse2
+{
+	static const int kCharacterClass = kUrlEncodeSpecial;
+
+	static inline __m128i Classify(__m128i bytes)
+	{
+		auto alphanumeric = _mm_or_si128(IsInRangeSse2(bytes, '0', '9'), _mm_or_si128(IsInRangeSse2(bytes, 'A', 'Z'), IsInRangeSse2(bytes, 'a', 'z')));
+		auto punctuation = _mm_or_si128(_mm_or_si128(IsEqualSse2(bytes, '-'), IsEqualSse2(bytes, '_')), _mm_or_si128(IsEqualSse2(bytes, '.'), IsEqualSse2(bytes, '!')));
+		auto safe = _mm_or_si128(_mm_or_si128(alphanumeric, punctuation), IsInRangeSse2(bytes, '\'', '*'));	// '()*
+		return _mm_xor_si128(safe, _mm_set1_epi8(-1));
+	}
+};
+
+struct HtmlSse2
+{
+	static const int kCharacterClass = kHtmlSpecial;
+
+	static inline __m128i Classify(__m128i bytes)
+	{
+		auto ampersandOrQuotes = _mm_or_si128(IsEqualSse2(bytes, '&'), _mm_or_si128(IsEqualSse2(bytes, '"'), IsEqualSse2(bytes, '\'')));
+		return _mm_or_si128(ampersandOrQuotes, _mm_or_si128(IsEqualSse2(bytes, '<'), IsEqualSse2(bytes, '>')));
+	}
+};
+
+struct HeaderDelimiterSse2
+{
+	static const int kCharacterClass = kHeaderDelimiter;
+
+	static inline __m128i Classify(__m128i bytes)
+	{
+		return _mm_or_si128(IsEqualSse2(bytes, ':'), _mm_or_si128(IsEqualSse2(bytes, '\r'), IsEqualSse2(bytes, '\n')));
+	}
+};
+
+template <typename Classifier>
+static size_t FindSse2(const char* str, size_t length)
+{
+	const size_t kBlockSize = 16;
+	size_t i = 0;
+
+	for (; i + kBlockSize <= length; i += kBlockSize)
+	{
+		auto mask = static_cast<uint32_t>(_mm_movemask_epi8(Classifier::Classify(_mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i)))));
+
+		if (mask != 0)
+		{
+			return i + CountTrailingZeros(mask);
+		}
+	}
+
+	return i + FindScalar<Classifier::kCharacterClass>(str + i, length - i);
+}
+
+SIMD_TARGET_AVX2 static inline __m256i IsInRangeAvx2(__m256i bytes, char low, char high)
+{
+	return _mm256_and_si256(_mm256_cmpgt_epi8(bytes, _mm256_set1_epi8(low - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8(high + 1), bytes));
+}
+
+SIMD_TARGET_AVX2 static inline __m256i IsEqualAvx2(__m256i bytes, char c)
+{
+	return _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(c));
+}
+
+struct UrlDecodeAvx2
+{
+	static const int kCharacterClass = kUrlDecodeSpecial;
+
+	SIMD_TARGET_AVX2 static inline __m256i Classify(__m256i bytes)
+	{
+		return _mm256_or_si256(IsEqualAvx2(bytes, '%'), IsEqualAvx2(bytes, '+'));
+	}
+};
+
+struct UrlEncodeAvx2
+{
+	static const int kCharacterClass = kUrlEncodeSpecial;
+
+	SIMD_TARGET_AVX2 static inline __m256i Classify(__m256i bytes)
+	{
+		auto alphanumeric = _mm256_or_si256(IsInRangeAvx2(bytes, '0', '9'), _mm256_or_si256(IsInRangeAvx2(bytes, 'A', 'Z'), IsInRangeAvx2(bytes, 'a', 'z')));
+		auto punctuation = _mm256_or_si256(_mm256_or_si256(IsEqualAvx2(bytes, '-'), IsEqualAvx2(bytes, '_')), _mm256_or_si256(IsEqualAvx2(bytes, '.'), IsEqualAvx2(bytes, '!')));
+		auto safe = _mm256_or_si256(_mm256_or_si256(alphanumeric, punctuation), IsInRangeAvx2(bytes, '\'', '*'));
+		return _mm256_xor_si256(safe, _mm256_set1_epi8(-1));
+	}
+};
+
+struct HtmlAvx2
+{
+	static const int kCharacterClass = kHtmlSpecial;
+
+	SIMD_TARGET_AVX2 static inline __m256i Classify(__m256i bytes)
+	{
+		auto ampersandOrQuotes = _mm256_or_si256(IsEqualAvx2(bytes, '&'), _mm256_or_si256(IsEqualAvx2(bytes, '"'), IsEqualAvx2(bytes, '\'')));
+		return _mm256_or_si256(ampersandOrQuotes, _mm256_or_si256(IsEqualAvx2(bytes, '<'), IsEqualAvx2(bytes, '>')));
+	}
+};
+
+struct HeaderDelimiterAvx2
+{
+	static const int kCharacterClass = kHeaderDelimiter;
+
+	SIMD_TARGET_AVX2 static inline __m256i Classify(__m256i bytes)
+	{
+		return _mm256_or_si256(IsEqualAvx2(bytes, ':'), _mm256_or_si256(IsEqualAvx2(bytes, '\r'), IsEqualAvx2(bytes, '\n')));
+	}
+};
+
+template <typename Classifier>
+SIMD_TARGET_AVX2 static size_t FindAvx2(const char* str, size_t length)
+{
+	const size_t kBlockSize = 32;
+	size_t i = 0;
+
+	for (; i + kBlockSize <= length; i += kBlockSize)
+	{
+		auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(Classifier::Classify(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + i)))));
+
+		if (mask != 0)
+		{
+			_mm256_zeroupper();
+			return i + CountTrailingZeros(mask);
+		}
+	}
+
+	_mm256_zeroupper();
+	return i + FindScalar<Classifier::kCharacterClass>(str + i, length - i);
+}
+
+#endif // SIMD_X86
+
+#if SIMD_NEON
+
+static inline uint8x16_t IsInRangeNeon(uint8x16_t bytes, uint8_t low, uint8_t high)
+{
+	return vandq_u8(vcgeq_u8(bytes, vdupq_n_u8(low)), vcleq_u8(bytes, vdupq_n_u8(high)));
+}
+
+static inline uint8x16_t IsEqualNeon(uint8x16_t bytes, uint8_t c)
+{
+	return vceqq_u8(bytes, vdupq_n_u8(c));
+}
+
+struct UrlDecodeNeon
+{
+	static const int kCharacterClass = kUrlDecodeSpecial;
+
+	static inline uint8x16_t Classify(uint8x16_t bytes)
+	{
+		return vorrq_u8(IsEqualNeon(bytes, '%'), IsEqualNeon(bytes, '+'));
+	}
+};
+
+struct UrlEncodeNeon
+{
+	static const int kCharacterClass = kUrlEncodeSpecial;
+
+	static inline uint8x16_t Classify(uint8x16_t bytes)
+	{
+		auto alphanumeric = vorrq_u8(IsInRangeNeon(bytes, '0', '9'), vorrq_u8(IsInRangeNeon(bytes, 'A', 'Z'), IsInRangeNeon(bytes, 'a', 'z')));
+		auto punctuation = vorrq_u8(vorrq_u8(IsEqualNeon(bytes, '-'), IsEqualNeon(bytes, '_')), vorrq_u8(IsEqualNeon(bytes, '.'), IsEqualNeon(bytes, '!')));
+		return vmvnq_u8(vorrq_u8(vorrq_u8(alphanumeric, punctuation), IsInRangeNeon(bytes, '\'', '*')));
+	}
+};
+
+struct HtmlNeon
+{
+	static const int kCharacterClass = kHtmlSpecial;
+
+	static inline uint8x16_t Classify(uint8x16_t bytes)
+	{
+		auto ampersandOrQuotes = vorrq_u8(IsEqualNeon(bytes, '&'), vorrq_u8(IsEqualNeon(bytes, '"'), IsEqualNeon(bytes, '\'')));
+		return vorrq_u8(ampersandOrQuotes, vorrq_u8(IsEqualNeon(bytes, '<'), IsEqualNeon(bytes, '>')));
+	}
+};
+
+struct HeaderDelimiterNeon
+{
+	static const int kCharacterClass = kHeaderDelimiter;
+
+	static inline uint8x16_t Classify(uint8x16_t bytes)
+	{
+		return vorrq_u8(IsEqualNeon(bytes, ':'), vorrq_u8(IsEqualNeon(bytes, '\r'), IsEqualNeon(bytes, '\n')));
+	}
+};
+
+template <typename Classifier>
+static size_t FindNeon(const char* str, size_t length)
+{
+	const size_t kBlockSize = 16;
+	size_t i = 0;
+
+	for (; i + kBlockSize <= length; i += kBlockSize)
+	{
+		auto marked = Classifier::Classify(vld1q_u8(reinterpret_cast<const uint8_t*>(str + i)));
+
+		// NEON has no movemask: shifting right by 4 while narrowing leaves 4 bits per byte in a 64-bit mask
+		auto mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(marked), 4)), 0);
+
+		if (mask != 0)
+		{
+			return i + CountTrailingZeros(static_cast<uint64_t>(mask)) / 4;
+		}
+	}
+
+	return i + FindScalar<Classifier::kCharacterClass>(str + i, length - i);
+}
+
+#endif // SIMD_NEON
+
+#if SIMD_X86
+#define ESCAPING_KERNELS(characterClass, name) { &FindScalar<characterClass>, &FindSse2<name##Sse2>, nullptr, &FindAvx2<name##Avx2>, nullptr }
+#elif SIMD_NEON
+#define ESCAPING_KERNELS(characterClass, name) { &FindScalar<characterClass>, nullptr, nullptr, nullptr, &FindNeon<name##Neon> }
+#else
+#define ESCAPING_KERNELS(characterClass, name) { &FindScalar<characterClass>, nullptr, nullptr, nullptr, nullptr }
+#endif
+
+static const FindFunction kFindUrlDecodeSpecialKernels[static_cast<int>(InstructionSet::Count)] = ESCAPING_KERNELS(kUrlDecodeSpecial, UrlDecode);
+static const FindFunction kFindUrlEncodeSpecialKernels[static_cast<int>(InstructionSet::Count)] = ESCAPING_KERNELS(kUrlEncodeSpecial, UrlEncode);
+static const FindFunction kFindHtmlSpecialKernels[static_cast<int>(InstructionSet::Count)] = ESCAPING_KERNELS(kHtmlSpecial, Html);
+static const FindFunction kFindHeaderDelimiterKernels[static_cast<int>(InstructionSet::Count)] = ESCAPING_KERNELS(kHeaderDelimiter, HeaderDelimiter);
+
+#undef ESCAPING_KERNELS
+
+// Same lazy selection as in Transcoding.cpp
+static size_t SelectFindUrlDecodeSpecial(const char* str, size_t length);
+static size_t SelectFindUrlEncodeSpecial(const char* str, size_t length);
+static size_t SelectFindHtmlSpecial(const char* str, size_t length);
+static size_t SelectFindHeaderDelimiter(const char* str, size_t length);
+
+static FindFunction s_FindUrlDecodeSpecial = &SelectFindUrlDecodeSpecial;
+static FindFunction s_FindUrlEncodeSpecial = &SelectFindUrlEncodeSpecial;
+static FindFunction s_FindHtmlSpecial = &SelectFindHtmlSpecial;
+static FindFunction s_FindHeaderDelimiter = &SelectFindHeaderDelimiter;
+
+static size_t SelectFindUrlDecodeSpecial(const char* str, size_t length)
+{
+	s_FindUrlDecodeSpecial = SelectKernel(kFindUrlDecodeSpecialKernels);
+	return s_FindUrlDecodeSpecial(str, length);
+}
+
+static size_t SelectFindUrlEncodeSpecial(const char* str, size_t length)
+{
+	s_FindUrlEncodeSpecial = SelectKernel(kFindUrlEncodeSpecialKernels);
+	return s_FindUrlEncodeSpecial(str, length);
+}
+
+static size_t SelectFindHtmlSpecial(const char* str, size_t length)
+{
+	s_FindHtmlSpecial = SelectKernel(kFindHtmlSpecialKernels);
+	return s_FindHtmlSpecial(str, length);
+}
+
+static size_t SelectFindHeaderDelimiter(const char* str, size_t length)
+{
+	s_FindHeaderDelimiter = SelectKernel(kFindHeaderDelimiterKernels);
+	return s_FindHeaderDelimiter(str, length);
+}
+
+size_t Escaping::FindUrlDecodeSpecial(const char* str, size_t length)
+{
+	return s_FindUrlDecodeSpecial(str, length);
+}
+
+size_t Escaping::FindUrlEncodeSpecial(const char* str, size_t length)
+{
+	return s_FindUrlEncodeSpecial(str, length);
+}
+
+size_t Escaping::FindHtmlSpecial(const char* str, size_t length)
+{
+	return s_FindHtmlSpecial(str, length);
+}
+
+size_t Escaping::FindHeaderDelimiter(const char* str, size_t length)
+{
+	return s_FindHeaderDelimiter(str, length);
+}
+
+FindFunction Escaping::GetFindUrlDecodeSpecial(InstructionSet instructionSet)
+{
+	return kFindUrlDecodeSpecialKernels[static_cast<int>(instructionSet)];
+}
+
+FindFunction Escaping::GetFindUrlEncodeSpecial(InstructionSet instructionSet)
+{
+	return kFindUrlEncodeSpecialKernels[static_cast<int>(instructionSet)];
+}
+
+FindFunction Escaping::GetFindHtmlSpecial(InstructionSet instructionSet)
+{
+	return kFindHtmlSpecialKernels[static_cast<int>(instructionSet)];
+}
+
+FindFunction Escaping::GetFindHeaderDelimiter(InstructionSet instructionSet)
+{
+	return kFindHeaderDelimiterKernels[static_cast<int>(instructionSet)];
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Simd.h"
+
+// Scanners that find the next byte an encoder or decoder has to transform, or a parser has to stop at,
+// so that everything in between can be copied or skipped in bulk. Each returns the index of the first such byte, or length if there's none.
+
+namespace Escaping
+{
+	typedef size_t (*FindFunction)(const char* str, size_t length);
+
+	// '%' and '+'
+	size_t FindUrlDecodeSpecial(const char* str, size_t length);
+
+	// Everything except ASCII letters, digits and -_.!*'()
+	size_t FindUrlEncodeSpecial(const char* str, size_t length);
+
+	// &<>"'
+	size_t FindHtmlSpecial(const char* str, size_t length);
+
+	// ':', '\r' and '\n', which end HTTP header field names and lines
+	size_t FindHeaderDelimiter(const char* str, size_t length);
+
+	// A specific version, or nullptr if there's none for the instruction set. For tests and benchmarks
+	FindFunction GetFindUrlDecodeSpecial(Simd::InstructionSet instructionSet);
+	FindFunction GetFindUrlEncodeSpecial(Simd::InstructionSet instructionSet);
+	FindFunction GetFindHtmlSpecial(Simd::InstructionSet instructionSet);
+	FindFunction GetFindHeaderDelimiter(Simd::InstructionSet instructionSet);
+};
\ No newline at end of file
@@ -0,0 +1,207 @@
+#include "PrecompiledHeader.h"
+#include "CriticalSection.h"
+#include "FileCache.h"
+#include "Metrics.h"
+
+using namespace std;
+
+// Count-min sketch of recent requests. 4 bit counters would do, bytes are simpler
+static const int kSketchDepth = 4;
+static const int kSketchWidth = 4096;
+static const uint8_t kMaxFrequency = 15;
+static const uint32_t kSketchSampleSize = 10 * kSketchWidth;	// Increments between halvings, so old popularity fades
+
+struct CacheEntry
+{
+	string path;
+	FileSystemProvider::File::Version version;
+	FileCache::Contents contents;
+};
+
+// Most recently used first
+typedef list<CacheEntry> EntryList;
+
+static CriticalSection s_CriticalSection;
+static FileCache::Settings s_Settings;
+static EntryList s_Entries;
+static unordered_map<string, EntryList::iterator> s_EntryIndex;
+static uint64_t s_CachedBytes;
+
+static uint8_t s_Frequencies[kSketchDepth][kSketchWidth];
+static uint32_t s_SketchIncrements;
+
+FileCache::Settings::Settings() :
+	memoryBudget(64 * 1024 * 1024), maxFileSize(1024 * 1024), minRequestCount(2)
+{
+}
+
+static inline uint32_t GetSketchIndex(size_t pathHash, int row)
+{
+	// SplitMix64 finalizer, seeded differently for every row
+	uint64_t value = static_cast<uint64_t>(pathHash) + (row + 1) * 0x9E3779B97F4A7C15ull;
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+	return static_cast<uint32_t>(value ^ (value >> 31)) & (kSketchWidth - 1);
+}
+
+static uint8_t EstimateFrequency(size_t pathHash)
+{
+	auto frequency = kMaxFrequency;
+
+	for (int row = 0; row < kSketchDepth; row++)
+	{
+		frequency = min(frequency, s_Frequencies[row][GetSketchIndex(pathHash, row)]);
+	}
+
+	return frequency;
+}
+
+static void RecordRequest(size_t pathHash)
+{
+	// Conservative update: only the smallest counters grow, which keeps collisions from inflating estimates
+	auto frequency = EstimateFrequency(pathHash);
+
+	if (frequency < kMaxFrequency)
+	{
+		for (int row = 0; row < kSketchDepth; row++)
+		{
+			auto& counter = s_Frequencies[row][GetSketchIndex(pathHash, row)];
+
+			if (counter == frequency)
+			{
+				counter++;
+			}
+		}
+	}
+
+	if (++s_SketchIncrements == kSketchSampleSize)
+	{
+		for (auto& row : s_Frequencies)
+		{
+			for (auto& counter : row)
+			{
+				counter /= 2;
+			}
+		}
+
+		s_SketchIncrements = 0;
+	}
+}
+
+static void RemoveEntry(EntryList::iterator entry)
+{
+	auto size = entry->contents->size();
+
+	s_CachedBytes -= size;
+	Metrics::Add(Metrics::Gauge::FileCacheBytes, -static_cast<int64_t>(size));
+
+	s_EntryIndex.erase(entry->path);
+	s_Entries.erase(entry);
+}
+
+static void EvictUntilWithinBudget(uint64_t budget)
+{
+	while (s_CachedBytes > budget)
+	{
+		Assert(!s_Entries.empty());
+		RemoveEntry(prev(s_Entries.end()));
+		Metrics::Increment(Metrics::Counter::FileCacheEvictions);
+	}
+}
+
+void FileCache::SetSettings(const Settings& settings)
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+	s_Settings = settings;
+	EvictUntilWithinBudget(s_Settings.memoryBudget);
+}
+
+FileCache::Settings FileCache::GetSettings()
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+	return s_Settings;
+}
+
+FileCache::Contents FileCache::Find(const string& path, const FileSystemProvider::File::Version& version)
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	if (s_Settings.memoryBudget == 0)
+	{
+		return nullptr;
+	}
+
+	RecordRequest(hash<string>()(path));
+	auto indexEntry = s_EntryIndex.find(path);
+
+	if (indexEntry != s_EntryIndex.end())
+	{
+		auto entry = indexEntry->second;
+
+		if (entry->version == version)
+		{
+			s_Entries.splice(s_Entries.begin(), s_Entries, entry);
+			Metrics::Increment(Metrics::Counter::FileCacheHits);
+			return entry->contents;
+		}
+
+		RemoveEntry(entry);		// The file changed since
+	}
+
+	Metrics::Increment(Metrics::Counter::FileCacheMisses);
+	return nullptr;
+}
+
+bool FileCache::ShouldAdmit(const string& path, uint64_t fileSize)
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	// Empty files have nothing to save
+	if (fileSize == 0 || fileSize > s_Settings.maxFileSize || fileSize > s_Settings.memoryBudget)
+	{
+		return false;
+	}
+
+	return EstimateFrequency(hash<string>()(path)) >= s_Settings.minRequestCount;
+}
+
+void FileCache::Insert(const string& path, const FileSystemProvider::File::Version& version, Contents contents)
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	if (contents->size() > s_Settings.memoryBudget)
+	{
+		return;
+	}
+
+	auto indexEntry = s_EntryIndex.find(path);
+
+	if (indexEntry != s_EntryIndex.end())
+	{
+		RemoveEntry(indexEntry->second);	// Another request read it at the same time
+	}
+
+	CacheEntry entry = { path, version, std::move(contents) };
+	auto size = entry.contents->size();
+
+	s_Entries.push_front(std::move(entry));
+	s_EntryIndex[path] = s_Entries.begin();
+
+	s_CachedBytes += size;
+	Metrics::Add(Metrics::Gauge::FileCacheBytes, static_cast<int64_t>(size));
+
+	EvictUntilWithinBudget(s_Settings.memoryBudget);
+}
+
+void FileCache::Clear()
+{
+	CriticalSection::Lock lock(s_CriticalSection);
+
+	while (!s_Entries.empty())
+	{
+		RemoveEntry(s_Entries.begin());
+	}
+
+	memset(s_Frequencies, 0, sizeof(s_Frequencies));
+	s_SketchIncrements = 0;
+}
\ No newline at end of file
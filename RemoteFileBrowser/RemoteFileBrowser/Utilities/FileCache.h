@@ -0,0 +1,34 @@
+#pragma once
+
+#include "FileSystemProvider.h"
+
+// Contents of small, frequently downloaded files, kept in memory so they go out without touching the disk.
+// Entries are keyed by path and only served while the file still has the same size, modification time and file ID.
+// A file gets in once it's been requested often enough lately, as counted by a count-min sketch whose counters
+// halve every so often, and the least recently used entries make room for it within the memory budget.
+
+namespace FileCache
+{
+	struct Settings
+	{
+		uint64_t memoryBudget;		// Bytes of file contents, 0 turns the cache off
+		uint64_t maxFileSize;
+		uint32_t minRequestCount;	// Recent requests a file needs to be admitted, counting the current one
+
+		Settings();
+	};
+
+	void SetSettings(const Settings& settings);
+	Settings GetSettings();
+
+	typedef std::shared_ptr<const std::vector<char>> Contents;
+
+	// Counts the request towards admission. Returns nullptr unless this version of the file is cached
+	Contents Find(const std::string& path, const FileSystemProvider::File::Version& version);
+
+	// Whether a file that wasn't found is worth reading into the cache
+	bool ShouldAdmit(const std::string& path, uint64_t fileSize);
+
+	void Insert(const std::string& path, const FileSystemProvider::File::Version& version, Contents contents);
+	void Clear();
+};
\ No newline at end of file
@@ -0,0 +1,17 @@
+#include "PrecompiledHeader.h"
+#include "DiskFileSystemProvider.h"
+
+using namespace std;
+
+static DiskFileSystemProvider s_DiskFileSystemProvider;
+static atomic<FileSystemProvider*> s_CurrentProvider(&s_DiskFileSystemProvider);
+
+FileSystemProvider& FileSystemProvider::GetCurrent()
+{
+	return *s_CurrentProvider.load(memory_order_acquire);
+}
+
+void FileSystemProvider::SetCurrent(FileSystemProvider* provider)
+{
+	s_CurrentProvider.store(provider != nullptr ? provider : &s_DiskFileSystemProvider, memory_order_release);
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+// Backend behind FileSystem::QueryFileStatus, FileSystem::EnumerateFiles and StreamableFile.
+// DiskFileSystemProvider is used by default; benchmarks and tests install SyntheticFileSystemProvider
+// to get huge, deterministic trees without touching the disk.
+// Providers are called concurrently from connection threads and must be thread safe.
+
+class FileSystemProvider
+{
+public:
+	class File
+	{
+	public:
+		// What a copy of the file's contents has to match to still be current
+		struct Version
+		{
+			uint64_t size;
+			uint64_t lastWriteTime;		// FILETIME, in 100 ns units since 1601
+			uint64_t fileId;			// Hash of the volume and file IDs, 0 where the file system doesn't have them
+
+			inline bool operator==(const Version& other) const
+			{
+				return size == other.size && lastWriteTime == other.lastWriteTime && fileId == other.fileId;
+			}
+		};
+
+		// Read-only view of part of the file. Unmapped when the last reference goes away
+		typedef std::shared_ptr<const char> View;
+
+		// Views have to start at a multiple of this
+		static const uint64_t kViewAlignment = 64 * 1024;
+
+		// Once a file bypasses the cache, reads have to start at a multiple of this, into buffers aligned to it
+		// with room for the length rounded up to it
+		static const uint64_t kUnbufferedAlignment = 4096;
+
+		virtual ~File() {}
+
+		virtual uint64_t GetSize() const = 0;
+
+		// Returns false and sets last error on failure
+		virtual bool GetVersion(Version& version) const = 0;
+
+		// Positional read. Returns false and sets last error on failure
+		virtual bool Read(uint64_t offset, char* buffer, uint32_t length, uint32_t& bytesRead) = 0;
+
+		// Switches to reads that bypass the file system cache, so streaming a huge file doesn't push everything else out of it.
+		// Returns false and sets last error if the provider can't
+		virtual bool BypassCache()
+		{
+			SetLastError(ERROR_NOT_SUPPORTED);
+			return false;
+		}
+
+		// Providers that can map files share one mapping between everyone viewing the same file, and so its pages.
+		// Returns nullptr and sets last error if the file can't be mapped, in which case it has to be read
+		virtual View MapView(uint64_t offset, uint32_t length)
+		{
+			SetLastError(ERROR_NOT_SUPPORTED);
+			return nullptr;
+		}
+	};
+
+	// Reports changes under a directory until it's destroyed, which waits for the callback to return
+	class ChangeWatcher
+	{
+	public:
+		virtual ~ChangeWatcher() {}
+	};
+
+	// Gets the path that changed, from a thread of the watcher's own. An empty path means changes were lost, so anything
+	// under the watched directory may have changed
+	typedef std::function<void(const std::wstring& changedPath)> ChangeCallback;
+
+	virtual ~FileSystemProvider() {}
+
+	virtual Utilities::FileSystem::FileStatus QueryFileStatus(const std::wstring& path) = 0;
+
+	// FILETIME of the last change to a file, or to the entries of a directory. Returns false and sets last error on failure
+	virtual bool QueryLastWriteTime(const std::wstring& path, uint64_t& lastWriteTime) = 0;
+
+	// Stops early once the token is cancelled, returning whatever it found until then
+	virtual std::vector<Utilities::FileSystem::FileInfo> EnumerateFiles(const std::wstring& path, const CancellationToken& cancellationToken) = 0;
+
+	inline std::vector<Utilities::FileSystem::FileInfo> EnumerateFiles(const std::wstring& path)
+	{
+		return EnumerateFiles(path, CancellationToken::None());
+	}
+
+	// Returns nullptr and sets last error on failure
+	virtual std::unique_ptr<File> OpenFile(const std::wstring& path) = 0;
+
+	// Returns nullptr and sets last error if the provider can't watch the directory
+	virtual std::unique_ptr<ChangeWatcher> WatchChanges(const std::wstring& directoryPath, bool watchSubtree, ChangeCallback&& callback)
+	{
+		SetLastError(ERROR_NOT_SUPPORTED);
+		return nullptr;
+	}
+
+	static FileSystemProvider& GetCurrent();
+
+	// The provider must outlive its installation. Pass nullptr to go back to the disk
+	static void SetCurrent(FileSystemProvider* provider);
+};
\ No newline at end of file
@@ -1,6 +1,11 @@
 #include "PrecompiledHeader.h"
 #include "Initializer.h"
 #include "Communication\AssetDatabase.h"
+#include "Communication\FolderSizes.h"
+#include "Communication\MetadataIndex.h"
+#include "Communication\RequestRouter.h"
+#include "Communication\SearchIndex.h"
+#include "Communication\ShareWatchers.h"
 
 using namespace Utilities;
 
@@ -38,16 +43,24 @@ static void ShutdownWinSock()
 	Logging::LogErrorIfFailed(cleanupResult != NO_ERROR, "Failed to cleanup WinSock: ");
 }
 
-Initializer::Initializer()
+Initializer::Initializer(const Http::RequestScheduler::Settings& schedulerSettings)
 {
 	Logging::Initialize();
 	AssetDatabase::Initialize();
+	FolderSizes::Initialize();
+	SearchIndex::Initialize();
 	InitializeWinSock();
+	Http::RequestScheduler::Initialize(schedulerSettings, &RequestRouter::ClassifyRequest);
 }
 
 
 Initializer::~Initializer()
 {
+	Http::RequestScheduler::Shutdown();
+	ShareWatchers::Shutdown();
+	SearchIndex::Shutdown();
+	FolderSizes::Shutdown();
+	MetadataIndex::Close();
 	ShutdownWinSock();
 	Logging::Shutdown();
 }
@@ -1,9 +1,11 @@
 #pragma once
 
+#include "Http\RequestScheduler.h"
+
 class Initializer
 {
 public:
-	Initializer();
+	Initializer(const Http::RequestScheduler::Settings& schedulerSettings = Http::RequestScheduler::Settings());
 	~Initializer();
 };
 
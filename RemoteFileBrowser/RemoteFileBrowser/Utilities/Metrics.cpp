@@ -0,0 +1,376 @@
+#include "PrecompiledHeader.h"
+#include "Metrics.h"
+
+using namespace std;
+using namespace Metrics;
+
+static const int kCounterCount = static_cast<int>(Counter::Count);
+static const int kGaugeCount = static_cast<int>(Gauge::Count);
+static const int kHistogramCount = static_cast<int>(Histogram::Count);
+
+// Metric descriptions. Entries that share a family name must be adjacent, so the family header is written once
+
+struct MetricDescription
+{
+	const char* family;
+	const char* labels;
+	const char* help;
+};
+
+static const MetricDescription kCounterDescriptions[kCounterCount] =
+{
+	{ "remotefilebrowser_http_requests_total", "type=\"listing\"", "HTTP requests served, by request type." },
+	{ "remotefilebrowser_http_requests_total", "type=\"file\"", nullptr },
+	{ "remotefilebrowser_http_requests_total", "type=\"builtin_asset\"", nullptr },
+	{ "remotefilebrowser_http_requests_total", "type=\"not_found\"", nullptr },
+	{ "remotefilebrowser_http_response_bytes_total", nullptr, "Bytes sent to HTTP clients." },
+	{ "remotefilebrowser_shared_files_lookups_total", "kind=\"file\"", "Share visibility lookups, by kind." },
+	{ "remotefilebrowser_shared_files_lookups_total", "kind=\"folder\"", nullptr },
+	{ "remotefilebrowser_http_requests_shed_total", "lane=\"interactive\"", "HTTP requests turned away with 503 because their lane's queue was full." },
+	{ "remotefilebrowser_http_requests_shed_total", "lane=\"bulk\"", nullptr },
+	{ "remotefilebrowser_http_connection_timeouts_total", "reason=\"header\"", "HTTP connections closed by a timeout, by what they were too slow at." },
+	{ "remotefilebrowser_http_connection_timeouts_total", "reason=\"idle\"", nullptr },
+	{ "remotefilebrowser_http_connection_timeouts_total", "reason=\"send_rate\"", nullptr },
+	{ "remotefilebrowser_file_cache_lookups_total", "result=\"hit\"", "File downloads looked up in the in-memory file cache, by result." },
+	{ "remotefilebrowser_file_cache_lookups_total", "result=\"miss\"", nullptr },
+	{ "remotefilebrowser_file_cache_evictions_total", nullptr, "Files dropped from the in-memory file cache to stay within its memory budget." },
+	{ "remotefilebrowser_negative_lookup_cache_lookups_total", "result=\"hit\"", "Status queries of shared paths answered by the cache of missing and inaccessible paths, by result." },
+	{ "remotefilebrowser_negative_lookup_cache_lookups_total", "result=\"miss\"", nullptr },
+	{ "remotefilebrowser_coalesced_listing_requests_total", nullptr, "Listing requests answered with the page an identical concurrent request rendered." },
+	{ "remotefilebrowser_metadata_index_lookups_total", "result=\"hit\"", "Directory enumerations looked up in the persistent metadata index, by result." },
+	{ "remotefilebrowser_metadata_index_lookups_total", "result=\"miss\"", nullptr }
+};
+
+static const MetricDescription kGaugeDescriptions[kGaugeCount] =
+{
+	{ "remotefilebrowser_active_connections", nullptr, "Currently open HTTP client connections." },
+	{ "remotefilebrowser_active_downloads", nullptr, "Files currently being streamed to clients." },
+	{ "remotefilebrowser_ip_whitelist_size", nullptr, "Client IPs whitelisted by the backend server." },
+	{ "remotefilebrowser_http_queued_requests", "lane=\"interactive\"", "HTTP requests waiting for a worker, by lane." },
+	{ "remotefilebrowser_http_queued_requests", "lane=\"bulk\"", nullptr },
+	{ "remotefilebrowser_file_cache_bytes", nullptr, "File contents held by the in-memory file cache." },
+	{ "remotefilebrowser_search_index_entries", nullptr, "Files and folders in the filename search index." },
+	{ "remotefilebrowser_search_index_bytes", "part=\"entries\"", "Memory held by the filename search index, by part." },
+	{ "remotefilebrowser_search_index_bytes", "part=\"names\"", nullptr },
+	{ "remotefilebrowser_search_index_bytes", "part=\"postings\"", nullptr },
+	{ "remotefilebrowser_search_index_bytes", "part=\"pending_postings\"", nullptr }
+};
+
+static const MetricDescription kHistogramDescriptions[kHistogramCount] =
+{
+	{ "remotefilebrowser_http_request_duration_seconds", nullptr, "Time from a parsed HTTP request to a fully sent response." },
+	{ "remotefilebrowser_directory_enumeration_duration_seconds", nullptr, "Time spent enumerating a shared directory." },
+	{ "remotefilebrowser_http_interactive_queue_time_seconds", nullptr, "Time listing, asset and internal requests waited for a worker." },
+	{ "remotefilebrowser_http_bulk_queue_time_seconds", nullptr, "Time download requests waited for a worker." },
+	{ "remotefilebrowser_search_duration_seconds", nullptr, "Time spent finding and ranking the matches of a filename search." }
+};
+
+// Counters are sharded by thread, so concurrent increments from different connections don't bounce a single cache line.
+// Windows thread IDs are multiples of 4, hence the shift
+
+static const int kCounterShardCount = 16;
+
+struct __declspec(align(64)) CounterShard
+{
+	atomic<uint64_t> values[kCounterCount];
+};
+
+static CounterShard s_CounterShards[kCounterShardCount];
+static atomic<int64_t> s_Gauges[kGaugeCount];
+static LatencyHistogram s_Histograms[kHistogramCount];
+
+static inline CounterShard& GetCurrentThreadShard()
+{
+	return s_CounterShards[(GetCurrentThreadId() >> 2) & (kCounterShardCount - 1)];
+}
+
+void Metrics::Increment(Counter counter, uint64_t value)
+{
+	GetCurrentThreadShard().values[static_cast<int>(counter)].fetch_add(value, memory_order_relaxed);
+}
+
+uint64_t Metrics::GetValue(Counter counter)
+{
+	uint64_t value = 0;
+
+	for (auto& shard : s_CounterShards)
+	{
+		value += shard.values[static_cast<int>(counter)].load(memory_order_relaxed);
+	}
+
+	return value;
+}
+
+void Metrics::Add(Gauge gauge, int64_t value)
+{
+	s_Gauges[static_cast<int>(gauge)].fetch_add(value, memory_order_relaxed);
+}
+
+int64_t Metrics::GetValue(Gauge gauge)
+{
+	return s_Gauges[static_cast<int>(gauge)].load(memory_order_relaxed);
+}
+
+void Metrics::Record(Histogram histogram, uint64_t microseconds)
+{
+	s_Histograms[static_cast<int>(histogram)].Record(microseconds);
+}
+
+const LatencyHistogram& Metrics::GetHistogram(Histogram histogram)
+{
+	return s_Histograms[static_cast<int>(histogram)];
+}
+
+// LatencyHistogram
+
+static inline int FindMostSignificantBit(uint64_t value)
+{
+	unsigned long index;
+
+#if _M_X64 || _M_ARM64
+	_BitScanReverse64(&index, value);
+#else
+	if (_BitScanReverse(&index, static_cast<unsigned long>(value >> 32)))
+	{
+		return static_cast<int>(index) + 32;
+	}
+
+	_BitScanReverse(&index, static_cast<unsigned long>(value));
+#endif
+
+	return static_cast<int>(index);
+}
+
+LatencyHistogram::LatencyHistogram()
+{
+	Reset();
+}
+
+void LatencyHistogram::Reset()
+{
+	for (auto& bucket : m_Buckets)
+	{
+		bucket.store(0, memory_order_relaxed);
+	}
+
+	m_Count.store(0, memory_order_relaxed);
+	m_Sum.store(0, memory_order_relaxed);
+}
+
+int LatencyHistogram::GetBucketIndex(uint64_t microseconds)
+{
+	// Values below kSubBucketCount get exact buckets, everything above
+	// is bucketed by its most significant bit and the kSubBucketBits that follow it
+	if (microseconds < kSubBucketCount)
+	{
+		return static_cast<int>(microseconds);
+	}
+
+	auto msb = FindMostSignificantBit(microseconds);
+	auto subBucket = static_cast<int>(microseconds >> (msb - kSubBucketBits)) & (kSubBucketCount - 1);
+	return (msb - kSubBucketBits + 1) * kSubBucketCount + subBucket;
+}
+
+uint64_t LatencyHistogram::GetBucketLowerBound(int bucketIndex)
+{
+	if (bucketIndex < kSubBucketCount)
+	{
+		return bucketIndex;
+	}
+
+	auto msb = bucketIndex / kSubBucketCount + kSubBucketBits - 1;
+	auto subBucket = static_cast<uint64_t>(bucketIndex % kSubBucketCount);
+	return (kSubBucketCount + subBucket) << (msb - kSubBucketBits);
+}
+
+uint64_t LatencyHistogram::GetBucketUpperBound(int bucketIndex)
+{
+	if (bucketIndex < kSubBucketCount)
+	{
+		return bucketIndex + 1;
+	}
+
+	auto msb = bucketIndex / kSubBucketCount + kSubBucketBits - 1;
+	auto upperBound = GetBucketLowerBound(bucketIndex) + (1ull << (msb - kSubBucketBits));
+	return upperBound != 0 ? upperBound : numeric_limits<uint64_t>::max();	// The very last bucket wraps around
+}
+
+uint64_t LatencyHistogram::GetExposedBoundary(int index)
+{
+	Assert(index >= 0 && index < kExposedBoundaryCount);
+	return (2ull << index) - 1;
+}
+
+void LatencyHistogram::Record(uint64_t microseconds)
+{
+	m_Buckets[GetBucketIndex(microseconds)].fetch_add(1, memory_order_relaxed);
+	m_Count.fetch_add(1, memory_order_relaxed);
+	m_Sum.fetch_add(microseconds, memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::GetCountAtOrBelow(uint64_t microseconds) const
+{
+	// Counts the whole bucket the value falls into, since the values within a bucket aren't known
+	uint64_t count = 0;
+	auto lastBucketIndex = GetBucketIndex(microseconds);
+
+	for (int i = 0; i <= lastBucketIndex; i++)
+	{
+		count += m_Buckets[i].load(memory_order_relaxed);
+	}
+
+	return count;
+}
+
+uint64_t LatencyHistogram::GetValueAtQuantile(double quantile) const
+{
+	// Buckets are read one by one while other threads keep recording, so sum them up first instead of trusting m_Count
+	uint64_t bucketCounts[kBucketCount];
+	uint64_t totalCount = 0;
+
+	for (int i = 0; i < kBucketCount; i++)
+	{
+		bucketCounts[i] = m_Buckets[i].load(memory_order_relaxed);
+		totalCount += bucketCounts[i];
+	}
+
+	if (totalCount == 0)
+	{
+		return 0;
+	}
+
+	auto exactTargetCount = quantile * totalCount;
+	auto targetCount = static_cast<uint64_t>(exactTargetCount);
+
+	if (static_cast<double>(targetCount) < exactTargetCount)
+	{
+		targetCount++;
+	}
+
+	targetCount = max<uint64_t>(1, min(targetCount, totalCount));
+
+	uint64_t count = 0;
+
+	for (int i = 0; i < kBucketCount; i++)
+	{
+		count += bucketCounts[i];
+
+		if (count >= targetCount)
+		{
+			return GetBucketUpperBound(i) - 1;	// Highest value that falls into the bucket
+		}
+	}
+
+	return GetBucketUpperBound(kBucketCount - 1) - 1;
+}
+
+// Prometheus exposition
+
+static void AppendMetricHeader(string& output, const MetricDescription& description, const char* type)
+{
+	if (description.help == nullptr)
+	{
+		return;	// Continuation of the previous family
+	}
+
+	output += "# HELP ";
+	output += description.family;
+	output += ' ';
+	output += description.help;
+	output += "\n# TYPE ";
+	output += description.family;
+	output += ' ';
+	output += type;
+	output += '\n';
+}
+
+static void AppendSample(string& output, const char* name, const char* suffix, const char* labels, const string& value)
+{
+	output += name;
+	output += suffix;
+
+	if (labels != nullptr)
+	{
+		output += '{';
+		output += labels;
+		output += '}';
+	}
+
+	output += ' ';
+	output += value;
+	output += '\n';
+}
+
+static string MicrosecondsToSecondsString(uint64_t microseconds)
+{
+	char buffer[32];
+	sprintf_s(buffer, "%llu.%06llu", microseconds / 1000000, microseconds % 1000000);
+	return buffer;
+}
+
+static void AppendHistogram(string& output, const MetricDescription& description, const LatencyHistogram& histogram)
+{
+	// Exposed with boundaries of 2^n - 1 us, from 1 us to ~2 minutes, which keeps the scrape small.
+	// Each one ends a bucket, so the cumulative counts are exact. Fine grained buckets are still used for the quantile estimates below
+	AppendMetricHeader(output, description, "histogram");
+
+	for (int i = 0; i < LatencyHistogram::kExposedBoundaryCount; i++)
+	{
+		auto boundary = LatencyHistogram::GetExposedBoundary(i);
+		auto labels = "le=\"" + MicrosecondsToSecondsString(boundary) + "\"";
+		AppendSample(output, description.family, "_bucket", labels.c_str(), to_string(histogram.GetCountAtOrBelow(boundary)));
+	}
+
+	auto count = histogram.GetCount();
+	AppendSample(output, description.family, "_bucket", "le=\"+Inf\"", to_string(count));
+	AppendSample(output, description.family, "_sum", nullptr, MicrosecondsToSecondsString(histogram.GetSum()));
+	AppendSample(output, description.family, "_count", nullptr, to_string(count));
+
+	const struct
+	{
+		double quantile;
+		const char* labels;
+	} kQuantiles[] =
+	{
+		{ 0.5, "quantile=\"0.5\"" },
+		{ 0.9, "quantile=\"0.9\"" },
+		{ 0.99, "quantile=\"0.99\"" },
+		{ 0.999, "quantile=\"0.999\"" }
+	};
+
+	string quantileFamily = description.family;
+	quantileFamily.insert(quantileFamily.length() - strlen("_seconds"), "_quantile");
+
+	output += "# HELP " + quantileFamily + " Estimated quantiles of " + description.family + ".\n";
+	output += "# TYPE " + quantileFamily + " gauge\n";
+
+	for (const auto& quantile : kQuantiles)
+	{
+		AppendSample(output, quantileFamily.c_str(), "", quantile.labels, MicrosecondsToSecondsString(histogram.GetValueAtQuantile(quantile.quantile)));
+	}
+}
+
+string Metrics::FormatPrometheusText()
+{
+	string output;
+	output.reserve(16 * 1024);
+
+	for (int i = 0; i < kCounterCount; i++)
+	{
+		AppendMetricHeader(output, kCounterDescriptions[i], "counter");
+		AppendSample(output, kCounterDescriptions[i].family, "", kCounterDescriptions[i].labels, to_string(GetValue(static_cast<Counter>(i))));
+	}
+
+	for (int i = 0; i < kGaugeCount; i++)
+	{
+		AppendMetricHeader(output, kGaugeDescriptions[i], "gauge");
+		AppendSample(output, kGaugeDescriptions[i].family, "", kGaugeDescriptions[i].labels, to_string(GetValue(static_cast<Gauge>(i))));
+	}
+
+	for (int i = 0; i < kHistogramCount; i++)
+	{
+		AppendHistogram(output, kHistogramDescriptions[i], s_Histograms[i]);
+	}
+
+	return output;
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+#pragma once
+
+namespace Metrics
+{
+	enum class Counter
+	{
+		ListingRequests,
+		FileRequests,
+		BuiltinAssetRequests,
+		NotFoundResponses,
+		BytesSent,
+		SharedFileLookups,
+		SharedFolderLookups,
+		ShedInteractiveRequests,
+		ShedBulkRequests,
+		HeaderTimeouts,
+		IdleTimeouts,
+		SendRateTimeouts,
+		FileCacheHits,
+		FileCacheMisses,
+		FileCacheEvictions,
+		NegativeLookupCacheHits,
+		NegativeLookupCacheMisses,
+		CoalescedListingRequests,
+		MetadataIndexHits,
+		MetadataIndexMisses,
+		Count
+	};
+
+	enum class Gauge
+	{
+		ActiveConnections,
+		ActiveDownloads,
+		WhitelistSize,
+		QueuedInteractiveRequests,
+		QueuedBulkRequests,
+		FileCacheBytes,
+		SearchIndexEntries,
+		SearchIndexEntryBytes,
+		SearchIndexNameBytes,
+		SearchIndexPostingBytes,
+		SearchIndexPendingPostingBytes,
+		Count
+	};
+
+	enum class Histogram
+	{
+		RequestDuration,
+		EnumerationDuration,
+		InteractiveQueueTime,
+		BulkQueueTime,
+		SearchDuration,
+		Count
+	};
+
+	// Log-linear (HDR style) histogram of microsecond values.
+	// Every power of two is split into kSubBucketCount linear buckets, so the relative error stays under 12.5%
+	class LatencyHistogram
+	{
+	public:
+		static const int kSubBucketBits = 3;
+		static const int kSubBucketCount = 1 << kSubBucketBits;
+		static const int kBucketCount = (64 - kSubBucketBits + 1) * kSubBucketCount;
+		static const int kExposedBoundaryCount = 27;
+
+	private:
+		std::atomic<uint64_t> m_Buckets[kBucketCount];
+		std::atomic<uint64_t> m_Count;
+		std::atomic<uint64_t> m_Sum;
+
+	public:
+		LatencyHistogram();
+
+		LatencyHistogram(const LatencyHistogram&) = delete;
+		LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+		void Record(uint64_t microseconds);
+		void Reset();
+
+		inline uint64_t GetCount() const { return m_Count.load(std::memory_order_relaxed); }
+		inline uint64_t GetSum() const { return m_Sum.load(std::memory_order_relaxed); }
+		uint64_t GetCountAtOrBelow(uint64_t microseconds) const;	// Exact only for the last value of a bucket, otherwise counts all of it
+		uint64_t GetValueAtQuantile(double quantile) const;
+
+		static int GetBucketIndex(uint64_t microseconds);
+		static uint64_t GetBucketLowerBound(int bucketIndex);
+		static uint64_t GetBucketUpperBound(int bucketIndex);
+
+		// Boundaries of the cumulative buckets in the Prometheus output: 2^(i + 1) - 1 us, each the last value of a bucket
+		static uint64_t GetExposedBoundary(int index);
+	};
+
+	void Increment(Counter counter, uint64_t value = 1);
+	uint64_t GetValue(Counter counter);
+
+	void Add(Gauge gauge, int64_t value);
+	inline void Increment(Gauge gauge) { Add(gauge, 1); }
+	inline void Decrement(Gauge gauge) { Add(gauge, -1); }
+	int64_t GetValue(Gauge gauge);
+
+	void Record(Histogram histogram, uint64_t microseconds);
+	const LatencyHistogram& GetHistogram(Histogram histogram);
+
+	// Prometheus text exposition format, version 0.0.4
+	std::string FormatPrometheusText();
+
+	class ScopedGauge
+	{
+	private:
+		Gauge m_Gauge;
+
+	public:
+		inline ScopedGauge(Gauge gauge) :
+			m_Gauge(gauge)
+		{
+			Increment(m_Gauge);
+		}
+
+		inline ~ScopedGauge()
+		{
+			Decrement(m_Gauge);
+		}
+
+		ScopedGauge(const ScopedGauge&) = delete;
+		ScopedGauge& operator=(const ScopedGauge&) = delete;
+	};
+
+	class ScopedTimer
+	{
+	private:
+		Histogram m_Histogram;
+		uint64_t m_StartTime;
+
+	public:
+		inline ScopedTimer(Histogram histogram) :
+			m_Histogram(histogram), m_StartTime(Utilities::System::GetMicroseconds())
+		{
+		}
+
+		inline ~ScopedTimer()
+		{
+			Record(m_Histogram, Utilities::System::GetMicroseconds() - m_StartTime);
+		}
+
+		ScopedTimer(const ScopedTimer&) = delete;
+		ScopedTimer& operator=(const ScopedTimer&) = delete;
+	};
+};
\ No newline at end of file
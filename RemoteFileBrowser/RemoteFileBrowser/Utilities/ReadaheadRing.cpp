@@ -0,0 +1,323 @@
+#include "PrecompiledHeader.h"
+#include "ReadaheadRing.h"
+#include "Tracing.h"
+
+using namespace std;
+using namespace Utilities;
+
+static const double kRateSmoothing = 0.25;
+
+// Another reader has to raise the read throughput by at least this much to be worth keeping on adding more
+static const double kMinReaderGain = 1.1;
+
+static atomic<uint32_t> s_MaxReaders(4);
+
+static inline void UpdateRate(double& rate, uint64_t bytes, uint64_t microseconds)
+{
+	auto sample = static_cast<double>(bytes) * 1000000.0 / static_cast<double>(max<uint64_t>(microseconds, 1));
+	rate = rate == 0 ? sample : rate + kRateSmoothing * (sample - rate);
+}
+
+void ReadaheadRing::SetMaxReaders(uint32_t maxReaders)
+{
+	s_MaxReaders = max(1u, min(maxReaders, kMaxReaders));
+}
+
+uint32_t ReadaheadRing::GetMaxReaders()
+{
+	return s_MaxReaders;
+}
+
+ReadaheadRing::ReadaheadRing(StreamableFile& file) :
+	m_File(file),
+	m_SlotCredits(CreateSemaphoreEx(nullptr, kMinDepth, numeric_limits<LONG>::max(), nullptr, 0, SEMAPHORE_MODIFY_STATE | SYNCHRONIZE)),
+	m_ChunkReadyEvent(false),
+	m_Depth(kMinDepth),
+	m_AcquiredSlot(kMaxDepth),
+	m_IsStopping(false),
+	m_NextReadOffset(0),
+	m_NextReadSequence(0),
+	m_NextSendSequence(0),
+	m_ChunkSize(StreamableFile::kMinChunkSize / 2),		// Doubled for the first chunk
+	m_ReadRate(0),
+	m_SendRate(0),
+	m_AcquireTime(0),
+	m_ReaderCount(1),
+	m_MaxReaders(s_MaxReaders),
+	m_IsReaderCountSettled(false),
+	m_PeriodStartTime(System::GetMicroseconds()),
+	m_PeriodBytesRead(0),
+	m_PeriodReadCount(0),
+	m_PreviousPeriodReadRate(0)
+{
+	Assert(m_File.GetFileSize() > 0);
+
+	for (uint32_t i = 0; i < kMaxDepth; i++)
+	{
+		m_Slots[i].capacity = 0;
+		m_Slots[i].state = SlotState::Free;
+		m_FreeSlots.push_back(kMaxDepth - i - 1);
+	}
+
+	StartReader();
+}
+
+ReadaheadRing::~ReadaheadRing()
+{
+	{
+		CriticalSection::Lock lock(m_CriticalSection);
+		m_IsStopping = true;
+	}
+
+	ReleaseSemaphore(m_SlotCredits, static_cast<LONG>(m_ReaderThreads.size()), nullptr);
+
+	for (auto& readerThread : m_ReaderThreads)
+	{
+		readerThread.join();
+	}
+
+	CloseHandle(m_SlotCredits);
+}
+
+void ReadaheadRing::StartReader()
+{
+	m_ReaderThreads.emplace_back([this]()
+	{
+		ReadChunks();
+	});
+}
+
+// Throughput of all readers together, assuming reads don't slow each other down. Adding readers stops once they do
+double ReadaheadRing::GetTotalReadRate() const
+{
+	return m_ReadRate * m_ReaderCount;
+}
+
+// Called with the lock held. Slow start until both rates are known, then about kTargetChunkMicroseconds worth of the slower one,
+// in multiples of the minimum size so offsets stay aligned
+uint32_t ReadaheadRing::ClaimNextRange(uint64_t& offset)
+{
+	auto chunkSize = 2 * m_ChunkSize;
+
+	if (m_ReadRate > 0 && m_SendRate > 0)
+	{
+		auto rate = min(GetTotalReadRate(), m_SendRate);
+		chunkSize = min(chunkSize, static_cast<uint64_t>(rate * kTargetChunkMicroseconds / 1000000));
+	}
+
+	chunkSize = min(chunkSize, kMaxRingBytes / m_Depth);
+	chunkSize -= chunkSize % StreamableFile::kMinChunkSize;
+	m_ChunkSize = max(StreamableFile::kMinChunkSize, min(chunkSize, StreamableFile::kMaxChunkSize));
+
+	offset = m_NextReadOffset;
+	auto length = static_cast<uint32_t>(min(m_ChunkSize, m_File.GetFileSize() - offset));
+	m_NextReadOffset += length;
+	return length;
+}
+
+void ReadaheadRing::ReadChunks()
+{
+	for (;;)
+	{
+		WaitForSingleObjectEx(m_SlotCredits, INFINITE, FALSE);
+
+		uint32_t slotIndex;
+		uint64_t offset;
+		uint32_t length;
+
+		{
+			CriticalSection::Lock lock(m_CriticalSection);
+
+			if (m_IsStopping || m_NextReadOffset == m_File.GetFileSize())
+			{
+				ReleaseSemaphore(m_SlotCredits, 1, nullptr);	// Whoever else is waiting stops too
+				return;
+			}
+
+			Assert(!m_FreeSlots.empty());
+			slotIndex = m_FreeSlots.back();
+			m_FreeSlots.pop_back();
+
+			auto& slot = m_Slots[slotIndex];
+			length = ClaimNextRange(offset);
+
+			slot.state = SlotState::Reading;
+			slot.sequence = m_NextReadSequence++;
+			slot.length = length;
+			slot.isLast = m_NextReadOffset == m_File.GetFileSize();
+			slot.failed = false;
+		}
+
+		// The slot is ours until it's marked ready
+		auto& slot = m_Slots[slotIndex];
+
+		if (slot.capacity < length)
+		{
+			// Whole multiples of the minimum chunk, which unbuffered reads may fill up to
+			auto capacity = static_cast<uint32_t>((length + StreamableFile::kMinChunkSize - 1) / StreamableFile::kMinChunkSize * StreamableFile::kMinChunkSize);
+			slot.buffer.reset(static_cast<char*>(_aligned_malloc(capacity, FileSystemProvider::File::kUnbufferedAlignment)));
+			slot.capacity = slot.buffer != nullptr ? capacity : 0;
+		}
+
+		auto readStart = System::GetMicroseconds();
+
+		try
+		{
+			TRACE_SCOPE("ReadaheadRing::ReadChunk");
+
+			if (slot.buffer == nullptr)
+			{
+				SetLastError(ERROR_NOT_ENOUGH_MEMORY);
+				throw exception();
+			}
+
+			m_File.ReadAt(offset, slot.buffer.get(), length);
+		}
+		catch (exception)
+		{
+			slot.failed = true;
+			slot.lastError = GetLastError();
+		}
+
+		auto readTime = System::GetMicroseconds() - readStart;
+
+		{
+			CriticalSection::Lock lock(m_CriticalSection);
+
+			if (!slot.failed)
+			{
+				UpdateRate(m_ReadRate, length, readTime);
+				m_PeriodBytesRead += length;
+				m_PeriodReadCount++;
+			}
+
+			slot.state = SlotState::Ready;
+
+			if (slot.failed)
+			{
+				m_IsStopping = true;	// Nothing after a failed chunk gets sent
+			}
+		}
+
+		m_ChunkReadyEvent.Set();
+	}
+}
+
+// Called with the lock held
+void ReadaheadRing::Deepen()
+{
+	if (m_Depth == kMaxDepth || (m_Depth + 1) * m_ChunkSize > kMaxRingBytes)
+	{
+		return;
+	}
+
+	m_Depth++;
+	ReleaseSemaphore(m_SlotCredits, 1, nullptr);
+}
+
+// Called with the lock held, when sending had to wait for a read. If reads keep up on average, more readahead smooths them out.
+// Otherwise they're the bottleneck, and another reader may help. Returns whether to start one
+bool ReadaheadRing::HandleStall()
+{
+	if (GetTotalReadRate() >= m_SendRate)
+	{
+		Deepen();
+		return false;
+	}
+
+	if (m_IsReaderCountSettled || m_ReaderCount == m_MaxReaders || m_PeriodReadCount < 2 * m_ReaderCount)
+	{
+		return false;
+	}
+
+	// Readers are busy all the time while sending waits on them, so what they read in the period is what they can do
+	auto now = System::GetMicroseconds();
+	auto periodReadRate = static_cast<double>(m_PeriodBytesRead) * 1000000.0 / static_cast<double>(max<uint64_t>(now - m_PeriodStartTime, 1));
+
+	if (m_ReaderCount > 1 && periodReadRate < kMinReaderGain * m_PreviousPeriodReadRate)
+	{
+		m_IsReaderCountSettled = true;
+		return false;
+	}
+
+	m_PreviousPeriodReadRate = periodReadRate;
+	m_PeriodStartTime = now;
+	m_PeriodBytesRead = 0;
+	m_PeriodReadCount = 0;
+
+	// The new reader needs a slot of its own
+	m_ReaderCount++;
+	Deepen();
+	return true;
+}
+
+ReadaheadRing::Chunk ReadaheadRing::AcquireChunk()
+{
+	TRACE_SCOPE("ReadaheadRing::AcquireChunk");
+	Assert(m_AcquiredSlot == kMaxDepth);
+
+	auto hasStalled = false;
+
+	for (;;)
+	{
+		auto startReader = false;
+
+		{
+			CriticalSection::Lock lock(m_CriticalSection);
+
+			for (uint32_t i = 0; i < kMaxDepth; i++)
+			{
+				auto& slot = m_Slots[i];
+
+				if (slot.state != SlotState::Ready || slot.sequence != m_NextSendSequence)
+				{
+					continue;
+				}
+
+				if (slot.failed)
+				{
+					SetLastError(slot.lastError);
+					throw exception();
+				}
+
+				m_AcquiredSlot = i;
+				m_AcquireTime = System::GetMicroseconds();
+
+				Chunk chunk = { slot.buffer.get(), slot.length, slot.isLast };
+				return chunk;
+			}
+
+			if (!hasStalled && m_NextSendSequence > 0)
+			{
+				hasStalled = true;
+				startReader = HandleStall();
+			}
+		}
+
+		if (startReader)
+		{
+			StartReader();
+		}
+
+		m_ChunkReadyEvent.Wait();
+	}
+}
+
+void ReadaheadRing::ReleaseChunk()
+{
+	Assert(m_AcquiredSlot < kMaxDepth);
+
+	{
+		CriticalSection::Lock lock(m_CriticalSection);
+		auto& slot = m_Slots[m_AcquiredSlot];
+
+		UpdateRate(m_SendRate, slot.length, System::GetMicroseconds() - m_AcquireTime);
+
+		slot.state = SlotState::Free;
+		m_FreeSlots.push_back(m_AcquiredSlot);
+		m_AcquiredSlot = kMaxDepth;
+		m_NextSendSequence++;
+	}
+
+	ReleaseSemaphore(m_SlotCredits, 1, nullptr);
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "CriticalSection.h"
+#include "Event.h"
+#include "StreamableFile.h"
+
+// Reads a file ahead of whoever sends it into a ring of chunk buffers, which hands chunks out in file order.
+// Chunks start small, so the first bytes go out right away, and then grow or shrink to about kTargetChunkMicroseconds
+// worth of the slower of reading and sending, so fast disks and networks get big reads and slow clients don't pin memory.
+// The ring starts double buffered and deepens when sending stalls on reads that keep up on average, to ride out latency spikes.
+// When reads can't keep up, more reader threads read upcoming ranges in parallel, which is what high latency storage
+// like network shares needs to get anywhere near its bandwidth. Readers are added one at a time for as long as each
+// one still raises the read throughput noticeably, up to the configured maximum.
+// Buffers are aligned for files that bypass the file system cache.
+
+class ReadaheadRing
+{
+public:
+	struct Chunk
+	{
+		const char* data;
+		uint32_t length;
+		bool isLast;
+	};
+
+	static const uint32_t kMinDepth = 2;
+	static const uint32_t kMaxDepth = 16;
+	static const uint32_t kMaxReaders = 8;
+	static const uint64_t kMaxRingBytes = 32 * 1024 * 1024;
+	static const uint64_t kTargetChunkMicroseconds = 100 * 1000;
+
+private:
+	struct AlignedDeleter
+	{
+		inline void operator()(char* buffer) const { _aligned_free(buffer); }
+	};
+
+	enum class SlotState
+	{
+		Free,
+		Reading,
+		Ready
+	};
+
+	struct Slot
+	{
+		std::unique_ptr<char, AlignedDeleter> buffer;
+		uint32_t capacity;
+		SlotState state;
+		uint64_t sequence;
+		uint32_t length;
+		bool isLast;
+		bool failed;
+		DWORD lastError;
+	};
+
+	StreamableFile& m_File;
+	CriticalSection m_CriticalSection;
+	HANDLE m_SlotCredits;			// Semaphore, counts slots the readers may still fill
+	Event m_ChunkReadyEvent;
+	std::vector<std::thread> m_ReaderThreads;
+
+	Slot m_Slots[kMaxDepth];
+	std::vector<uint32_t> m_FreeSlots;
+	uint32_t m_Depth;
+	uint32_t m_AcquiredSlot;
+	bool m_IsStopping;
+
+	uint64_t m_NextReadOffset;
+	uint64_t m_NextReadSequence;
+	uint64_t m_NextSendSequence;
+
+	uint64_t m_ChunkSize;
+	double m_ReadRate;				// Bytes per second of a single read and of sending, exponential moving averages. 0 until measured
+	double m_SendRate;
+	uint64_t m_AcquireTime;
+
+	// Reader count tuning. Read throughput is measured over the period since the last reader was added
+	uint32_t m_ReaderCount;
+	uint32_t m_MaxReaders;
+	bool m_IsReaderCountSettled;
+	uint64_t m_PeriodStartTime;
+	uint64_t m_PeriodBytesRead;
+	uint32_t m_PeriodReadCount;
+	double m_PreviousPeriodReadRate;
+
+	void ReadChunks();
+	uint32_t ClaimNextRange(uint64_t& offset);
+	double GetTotalReadRate() const;
+	bool HandleStall();
+	void Deepen();
+	void StartReader();
+
+public:
+	// The file must not be empty
+	ReadaheadRing(StreamableFile& file);
+	~ReadaheadRing();
+
+	ReadaheadRing(const ReadaheadRing&) = delete;
+	ReadaheadRing& operator=(const ReadaheadRing&) = delete;
+
+	// Waits for the next chunk, which stays valid until it's released. Throws, with last error set, if reading it failed
+	Chunk AcquireChunk();
+	void ReleaseChunk();
+
+	inline uint64_t GetChunkSize() const { return m_ChunkSize; }
+	inline uint32_t GetDepth() const { return m_Depth; }
+	inline uint32_t GetReaderCount() const { return m_ReaderCount; }
+
+	// Upper bound for the reader count of rings created afterwards, 1 turns parallel reads off. 4 by default
+	static void SetMaxReaders(uint32_t maxReaders);
+	static uint32_t GetMaxReaders();
+};
@@ -0,0 +1,142 @@
+#include "PrecompiledHeader.h"
+#include "Simd.h"
+
+using namespace std;
+using namespace Simd;
+
+#if SIMD_X86
+
+enum CpuFeature
+{
+	kCpuFeaturesDetected = 1 << 0,
+	kCpuFeatureSse2 = 1 << 1,
+	kCpuFeatureSsse3 = 1 << 2,
+	kCpuFeatureAvx2 = 1 << 3
+};
+
+static LONG DetectCpuFeatures()
+{
+	LONG features = kCpuFeaturesDetected;
+	int info[4];
+
+	__cpuid(info, 0);
+	auto maxLeaf = info[0];
+
+	__cpuid(info, 1);
+
+	if ((info[3] & (1 << 26)) != 0)
+	{
+		features |= kCpuFeatureSse2;
+	}
+
+	if ((info[2] & (1 << 9)) != 0)
+	{
+		features |= kCpuFeatureSsse3;
+	}
+
+	// AVX2 also needs the OS to save the upper halves of YMM registers on context switches
+	auto avx = (info[2] & (1 << 28)) != 0;
+	auto osSavesYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
+
+	if (maxLeaf >= 7 && avx && osSavesYmm)
+	{
+		__cpuidex(info, 7, 0);
+
+		if ((info[1] & (1 << 5)) != 0)
+		{
+			features |= kCpuFeatureAvx2;
+		}
+	}
+
+	return features;
+}
+
+// Zero initialized rather than dynamically initialized, so kernels can be used from other static initializers.
+// Threads racing on the first detection all store the same value
+static volatile LONG s_CpuFeatures;
+
+static LONG GetCpuFeatures()
+{
+	auto features = s_CpuFeatures;
+
+	if (features == 0)
+	{
+		features = DetectCpuFeatures();
+		InterlockedExchange(&s_CpuFeatures, features);
+	}
+
+	return features;
+}
+
+bool Simd::IsSupported(InstructionSet instructionSet)
+{
+	switch (instructionSet)
+	{
+	case InstructionSet::Scalar:
+		return true;
+
+	case InstructionSet::Sse2:
+		return (GetCpuFeatures() & kCpuFeatureSse2) != 0;
+
+	case InstructionSet::Ssse3:
+		return (GetCpuFeatures() & kCpuFeatureSsse3) != 0;
+
+	case InstructionSet::Avx2:
+		return (GetCpuFeatures() & kCpuFeatureAvx2) != 0;
+
+	default:
+		return false;
+	}
+}
+
+#else
+
+bool Simd::IsSupported(InstructionSet instructionSet)
+{
+#if SIMD_NEON
+	// NEON is a baseline requirement of Windows on ARM
+	return instructionSet == InstructionSet::Scalar || instructionSet == InstructionSet::Neon;
+#else
+	return instructionSet == InstructionSet::Scalar;
+#endif
+}
+
+#endif
+
+InstructionSet Simd::GetBestInstructionSet()
+{
+	for (int i = static_cast<int>(InstructionSet::Count) - 1; i > 0; i--)
+	{
+		if (IsSupported(static_cast<InstructionSet>(i)))
+		{
+			return static_cast<InstructionSet>(i);
+		}
+	}
+
+	return InstructionSet::Scalar;
+}
+
+const char* Simd::GetName(InstructionSet instructionSet)
+{
+	switch (instructionSet)
+	{
+	case InstructionSet::Scalar:
+		return "Scalar";
+
+	case InstructionSet::Sse2:
+		return "SSE2";
+
+	case InstructionSet::Ssse3:
+		return "SSSE3";
+
+	case InstructionSet::Avx2:
+		return "AVX2";
+
+	case InstructionSet::Neon:
+		return "NEON";
+
+	default:
+		Assert(false);
+		return "Unknown";
+	}
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+// Instruction set detection for the vectorized kernels. Each kernel comes in a scalar version plus one per
+// instruction set it has been written for, and picks the best one supported by the CPU on first use.
+
+#if _M_IX86 || _M_X64
+#define SIMD_X86 1
+#elif _M_ARM || _M_ARM64
+#define SIMD_NEON 1
+#endif
+
+// MSVC lets any function use SSSE3 and AVX2 intrinsics, GCC and Clang need them enabled per function
+#if SIMD_X86 && defined(__GNUC__)
+#define SIMD_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SIMD_TARGET_SSSE3
+#define SIMD_TARGET_AVX2
+#endif
+
+namespace Simd
+{
+	enum class InstructionSet
+	{
+		Scalar,
+		Sse2,
+		Ssse3,
+		Avx2,
+		Neon,
+		Count
+	};
+
+	bool IsSupported(InstructionSet instructionSet);
+	InstructionSet GetBestInstructionSet();
+	const char* GetName(InstructionSet instructionSet);
+
+	// Index of the lowest set bit, which turns a byte mask into the position of the first matching byte. value must be nonzero
+	inline int CountTrailingZeros(uint32_t value);
+	inline int CountTrailingZeros(uint64_t value);
+
+	// Kernel dispatch: Function is a function pointer type, kernels[] is indexed by InstructionSet
+	// and holds nullptr for instruction sets the kernel has no version for
+	template <typename Function>
+	Function SelectKernel(const Function (&kernels)[static_cast<int>(InstructionSet::Count)]);
+};
+
+#include "Simd.inl"
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+inline int Simd::CountTrailingZeros(uint32_t value)
+{
+	Assert(value != 0);
+
+	unsigned long index;
+	_BitScanForward(&index, value);
+	return static_cast<int>(index);
+}
+
+inline int Simd::CountTrailingZeros(uint64_t value)
+{
+	Assert(value != 0);
+	unsigned long index;
+
+#if _M_X64 || _M_ARM64
+	_BitScanForward64(&index, value);
+#else
+	if (_BitScanForward(&index, static_cast<unsigned long>(value)))
+	{
+		return static_cast<int>(index);
+	}
+
+	_BitScanForward(&index, static_cast<unsigned long>(value >> 32));
+	index += 32;
+#endif
+
+	return static_cast<int>(index);
+}
+
+template <typename Function>
+Function Simd::SelectKernel(const Function (&kernels)[static_cast<int>(InstructionSet::Count)])
+{
+	for (int i = static_cast<int>(InstructionSet::Count) - 1; i > 0; i--)
+	{
+		if (kernels[i] != nullptr && IsSupported(static_cast<InstructionSet>(i)))
+		{
+			return kernels[i];
+		}
+	}
+
+	Assert(kernels[static_cast<int>(InstructionSet::Scalar)] != nullptr);
+	return kernels[static_cast<int>(InstructionSet::Scalar)];
+}
\ No newline at end of file
@@ -1,40 +1,70 @@
 #include "PrecompiledHeader.h"
 #include "StreamableFile.h"
+#include "Tracing.h"
 
 using namespace std;
 
+static atomic<uint64_t> s_MinUnbufferedFileSize;
+
 StreamableFile::StreamableFile(const std::wstring& filePath) :
-	m_FilePosition(0)
+	m_File(FileSystemProvider::GetCurrent().OpenFile(filePath)), m_FilePosition(0)
 {
-	bool succeeded = false;
-	m_FileHandle = Utilities::FileSystem::CreateFilePortable(filePath, GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING);
-
-	if (m_FileHandle == INVALID_HANDLE_VALUE)
+	if (m_File == nullptr)
 	{
 		throw exception();
 	}
 
-	if (Utilities::FileSystem::GetFileSizeFromHandle(m_FileHandle, m_FileSize) == FALSE)
-	{
-		CloseHandle(m_FileHandle);
-		throw exception();
-	}
+	m_FileSize = m_File->GetSize();
 }
 
 StreamableFile::~StreamableFile()
 {
-	CloseHandle(m_FileHandle);
 }
 
 void StreamableFile::ReadNextChunk(char* buffer, int& bytesRead)
 {
-	DWORD numberOfBytesToRead = static_cast<DWORD>(min(m_FileSize - m_FilePosition, kMaxChunkSize));
+	TRACE_SCOPE("StreamableFile::ReadNextChunk");
+	auto numberOfBytesToRead = static_cast<uint32_t>(min(m_FileSize - m_FilePosition, kMaxChunkSize));
+
+	ReadAt(m_FilePosition, buffer, numberOfBytesToRead);
 
-	if (ReadFile(m_FileHandle, buffer, numberOfBytesToRead, reinterpret_cast<DWORD*>(&bytesRead), nullptr) == FALSE ||
-		bytesRead != numberOfBytesToRead)
+	bytesRead = static_cast<int>(numberOfBytesToRead);
+	m_FilePosition += bytesRead;
+}
+
+void StreamableFile::ReadAt(uint64_t offset, char* buffer, uint32_t length)
+{
+	uint32_t numberOfBytesRead;
+
+	if (!m_File->Read(offset, buffer, length, numberOfBytesRead) || numberOfBytesRead != length)
 	{
 		throw exception();
 	}
+}
 
-	m_FilePosition += bytesRead;
+void StreamableFile::SetMinUnbufferedFileSize(uint64_t size)
+{
+	s_MinUnbufferedFileSize = size;
+}
+
+bool StreamableFile::ShouldBypassCache(uint64_t fileSize)
+{
+	auto minSize = s_MinUnbufferedFileSize.load();
+	return minSize != 0 && fileSize >= minSize;
+}
+
+FileSystemProvider::File::View StreamableFile::MapNextChunk(uint32_t& length)
+{
+	TRACE_SCOPE("StreamableFile::MapNextChunk");
+	static_assert(kMaxChunkSize % FileSystemProvider::File::kViewAlignment == 0, "Chunks have to keep views aligned");
+
+	length = static_cast<uint32_t>(min(m_FileSize - m_FilePosition, kMaxChunkSize));
+	auto view = m_File->MapView(m_FilePosition, length);
+
+	if (view != nullptr)
+	{
+		m_FilePosition += length;
+	}
+
+	return view;
 }
\ No newline at end of file
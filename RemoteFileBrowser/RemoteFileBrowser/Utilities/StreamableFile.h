@@ -1,9 +1,11 @@
 #pragma once
 
+#include "FileSystemProvider.h"
+
 class StreamableFile
 {
 private:
-	HANDLE m_FileHandle;
+	std::unique_ptr<FileSystemProvider::File> m_File;
 	uint64_t m_FileSize;
 	uint64_t m_FilePosition;
 
@@ -11,10 +13,27 @@ public:
 	StreamableFile(const std::wstring& filePath);
 	~StreamableFile();
 
-	static const uint64_t kMaxChunkSize = 8 * 1024 * 1024; // 8 MB at a time
+	static const uint64_t kMaxChunkSize = 16 * 1024 * 1024; // 16 MB at a time
+	static const uint64_t kMinChunkSize = 64 * 1024;		// Chunk sizes are multiples of this
+
+	// Files this big are sent from mapped views where the provider can map them, so concurrent downloads share their pages
+	static const uint64_t kMinMappedFileSize = 64 * 1024 * 1024;
 
 	bool IsEndOfFile() const { return m_FilePosition == m_FileSize; }
 	inline uint64_t GetFileSize() const { return m_FileSize; }
+	inline bool GetVersion(FileSystemProvider::File::Version& version) const { return m_File->GetVersion(version); }
 	void ReadNextChunk(char* buffer, int& bytesRead);
+
+	// Positional read of exactly length bytes, which doesn't move the current position. Throws on failure
+	void ReadAt(uint64_t offset, char* buffer, uint32_t length);
+
+	// Files at least this big bypass the file system cache while streaming. 0, the default, turns that off
+	static void SetMinUnbufferedFileSize(uint64_t size);
+	static bool ShouldBypassCache(uint64_t fileSize);
+	inline bool BypassCache() { return m_File->BypassCache(); }
+
+	// Maps the next chunk instead of reading it. Returns nullptr, without moving on, if it can't be mapped.
+	// Only valid while every chunk so far has been mapped, so views stay aligned
+	FileSystemProvider::File::View MapNextChunk(uint32_t& length);
 };
 
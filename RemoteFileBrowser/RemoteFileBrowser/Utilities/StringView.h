@@ -0,0 +1,80 @@
+#pragma once
+
+namespace Utilities
+{
+	// Non-owning view of a run of characters, for parsers that index into a buffer they don't own.
+	// Mirrors the parts of std::string_view we need until the toolset has it
+	class StringView
+	{
+	private:
+		const char* m_Data;
+		size_t m_Length;
+
+	public:
+		static const size_t npos = static_cast<size_t>(-1);
+
+		inline StringView() :
+			m_Data(nullptr), m_Length(0)
+		{
+		}
+
+		inline StringView(const char* data, size_t length) :
+			m_Data(data), m_Length(length)
+		{
+		}
+
+		template <size_t length>
+		inline StringView(const char (&str)[length]) :
+			m_Data(str), m_Length(length - 1)
+		{
+		}
+
+		inline StringView(const std::string& str) :
+			m_Data(str.data()), m_Length(str.length())
+		{
+		}
+
+		inline const char* data() const { return m_Data; }
+		inline size_t length() const { return m_Length; }
+		inline bool empty() const { return m_Length == 0; }
+		inline char operator[](size_t index) const { Assert(index < m_Length); return m_Data[index]; }
+
+		inline StringView substr(size_t position, size_t count = npos) const
+		{
+			Assert(position <= m_Length);
+			return StringView(m_Data + position, std::min(count, m_Length - position));
+		}
+
+		inline size_t find(char character, size_t position = 0) const
+		{
+			if (position >= m_Length)
+			{
+				return npos;
+			}
+
+			auto found = static_cast<const char*>(memchr(m_Data + position, character, m_Length - position));
+			return found != nullptr ? static_cast<size_t>(found - m_Data) : npos;
+		}
+
+		inline bool operator==(const StringView& other) const
+		{
+			return m_Length == other.m_Length && (m_Length == 0 || memcmp(m_Data, other.m_Data, m_Length) == 0);
+		}
+
+		inline bool operator!=(const StringView& other) const
+		{
+			return !(*this == other);
+		}
+
+		// ASCII only, which is all HTTP field names can hold
+		inline bool EqualsIgnoreCase(const StringView& other) const
+		{
+			return m_Length == other.m_Length && (m_Length == 0 || _strnicmp(m_Data, other.m_Data, m_Length) == 0);
+		}
+
+		inline std::string ToString() const
+		{
+			return std::string(m_Data, m_Length);
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,370 @@
+#include "PrecompiledHeader.h"
+#include "SyntheticFileSystemProvider.h"
+
+using namespace std;
+using namespace Utilities;
+using namespace Utilities::FileSystem;
+
+// Names mix ASCII with a few multibyte UTF-8 letters, so encoding conversions get exercised too
+static const char* const kNameCharacters[] =
+{
+	"a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k", "l", "m", "n", "o", "p", "q", "r", "s", "t", "u", "v", "w", "x", "y", "z",
+	"A", "B", "C", "D", "E", "F", "G", "H", "I", "J", "K", "L", "M", "N", "O", "P", "Q", "R", "S", "T", "U", "V", "W", "X", "Y", "Z",
+	"0", "1", "2", "3", "4", "5", "6", "7", "8", "9", " ", "_", "-", "(", ")",
+	"\xc4\x85", "\xc4\x8d", "\xc5\xbe", "\xc3\xa9"
+};
+
+static const int kNameCharacterCount = sizeof(kNameCharacters) / sizeof(kNameCharacters[0]);
+
+static const char* const kExtensions[] = { ".jpg", ".png", ".pdf", ".docx", ".mp3", ".mkv", ".zip", ".txt", ".cpp", ".bin" };
+static const int kExtensionCount = sizeof(kExtensions) / sizeof(kExtensions[0]);
+
+static const uint64_t kFileTimeJanuary2010 = 129068352000000000;		// In 100 ns units since 1601
+static const uint64_t kFileTimeFiveYears = 5ull * 365 * 24 * 3600 * 10000000;
+
+// SplitMix64 finalizer
+static inline uint64_t Mix(uint64_t value)
+{
+	value += 0x9E3779B97F4A7C15ull;
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+	return value ^ (value >> 31);
+}
+
+static inline double ToUnitInterval(uint64_t value)
+{
+	return static_cast<double>(value >> 11) / static_cast<double>(1ull << 53);
+}
+
+static void InjectLatency(uint32_t microseconds)
+{
+	if (microseconds == 0)
+	{
+		return;
+	}
+
+	// Sleep only covers the whole milliseconds, spin for the rest to keep short latencies accurate
+	auto deadline = System::GetMicroseconds() + microseconds;
+
+	if (microseconds >= 2000)
+	{
+		System::Sleep(microseconds / 1000 - 1);
+	}
+
+	while (System::GetMicroseconds() < deadline)
+	{
+		YieldProcessor();
+	}
+}
+
+class SyntheticFile : public FileSystemProvider::File
+{
+private:
+	uint64_t m_Seed;
+	uint64_t m_Size;
+	uint64_t m_LastWriteTime;
+	uint32_t m_ReadLatencyMicroseconds;
+	uint64_t m_ReadBytesPerSecond;
+	uint64_t m_FailedReadOffset;
+
+public:
+	SyntheticFile(uint64_t seed, uint64_t size, uint64_t lastWriteTime, uint32_t readLatencyMicroseconds, uint64_t readBytesPerSecond, uint64_t failedReadOffset) :
+		m_Seed(seed), m_Size(size), m_LastWriteTime(lastWriteTime), m_ReadLatencyMicroseconds(readLatencyMicroseconds), m_ReadBytesPerSecond(readBytesPerSecond),
+		m_FailedReadOffset(failedReadOffset)
+	{
+	}
+
+	virtual uint64_t GetSize() const override
+	{
+		return m_Size;
+	}
+
+	// The seed determines the contents, so it stands in for the file ID
+	virtual bool GetVersion(Version& version) const override
+	{
+		version.size = m_Size;
+		version.lastWriteTime = m_LastWriteTime;
+		version.fileId = m_Seed;
+		return true;
+	}
+
+	virtual bool Read(uint64_t offset, char* buffer, uint32_t length, uint32_t& bytesRead) override
+	{
+		bytesRead = offset < m_Size ? static_cast<uint32_t>(min<uint64_t>(length, m_Size - offset)) : 0;
+
+		auto transferMicroseconds = m_ReadBytesPerSecond != 0 ? bytesRead * 1000000ull / m_ReadBytesPerSecond : 0;
+		InjectLatency(static_cast<uint32_t>(min<uint64_t>(m_ReadLatencyMicroseconds + transferMicroseconds, numeric_limits<uint32_t>::max())));
+
+		if (offset + bytesRead > m_FailedReadOffset)
+		{
+			bytesRead = 0;
+			SetLastError(ERROR_NETNAME_DELETED);
+			return false;
+		}
+
+		SyntheticFileSystemProvider::GenerateFileContents(m_Seed, offset, buffer, bytesRead);
+		return true;
+	}
+};
+
+SyntheticFileSystemProvider::Parameters::Parameters() :
+	seed(42), rootPath(L"S:\\Synthetic"),
+	maxDepth(3), minFanOut(10), maxFanOut(100), directoryPercentage(20),
+	minNameLength(4), maxNameLength(24), minFileSize(0), maxFileSize(1ull << 32),
+	queryLatencyMicroseconds(0), enumerationLatencyMicroseconds(0), readLatencyMicroseconds(0), readBytesPerSecond(0),
+	failedReadOffset(numeric_limits<uint64_t>::max())
+{
+}
+
+SyntheticFileSystemProvider::SyntheticFileSystemProvider(const Parameters& parameters) :
+	m_Parameters(parameters)
+{
+	Assert(m_Parameters.minFanOut <= m_Parameters.maxFanOut);
+	Assert(m_Parameters.minNameLength <= m_Parameters.maxNameLength);
+	Assert(m_Parameters.minFileSize <= m_Parameters.maxFileSize);
+
+	// Lookups compare against the root without a trailing separator
+	while (m_Parameters.rootPath.length() > 1 && m_Parameters.rootPath.back() == L'\\')
+	{
+		m_Parameters.rootPath.pop_back();
+	}
+
+	m_Root.seed = Mix(m_Parameters.seed);
+	m_Root.size = 0;
+	m_Root.lastWriteTime = kFileTimeJanuary2010;
+	m_Root.depth = 0;
+	m_Root.isDirectory = true;
+}
+
+uint32_t SyntheticFileSystemProvider::GetFanOut(const Entry& directory) const
+{
+	auto range = static_cast<uint64_t>(m_Parameters.maxFanOut - m_Parameters.minFanOut) + 1;
+	return m_Parameters.minFanOut + static_cast<uint32_t>(Mix(directory.seed ^ 0xFA) % range);
+}
+
+void SyntheticFileSystemProvider::GenerateEntry(const Entry& directory, uint32_t index, Entry& entry) const
+{
+	auto hash = Mix(directory.seed ^ Mix(index));
+
+	entry.seed = hash;
+	entry.depth = directory.depth + 1;
+	entry.isDirectory = directory.depth < m_Parameters.maxDepth && Mix(hash + 1) % 100 < m_Parameters.directoryPercentage;
+	entry.lastWriteTime = kFileTimeJanuary2010 + Mix(hash + 2) % kFileTimeFiveYears;
+
+	if (entry.isDirectory)
+	{
+		entry.size = 0;
+	}
+	else
+	{
+		auto logMin = log2(static_cast<double>(m_Parameters.minFileSize) + 1);
+		auto logMax = log2(static_cast<double>(m_Parameters.maxFileSize) + 1);
+		auto size = exp2(logMin + ToUnitInterval(Mix(hash + 3)) * (logMax - logMin)) - 1;
+		entry.size = min(max(static_cast<uint64_t>(size), m_Parameters.minFileSize), m_Parameters.maxFileSize);
+	}
+
+	// Name: random characters, then " <index>" so lookups can find the entry again, then the extension
+
+	auto nameLengthRange = m_Parameters.maxNameLength - m_Parameters.minNameLength + 1;
+	auto nameLength = m_Parameters.minNameLength + static_cast<uint32_t>(Mix(hash + 4) % nameLengthRange);
+
+	entry.name.clear();
+	uint64_t characterBits = 0;
+
+	for (uint32_t i = 0; i < nameLength; i++)
+	{
+		if (i % 8 == 0)
+		{
+			characterBits = Mix(hash + 5 + i);
+		}
+
+		entry.name += kNameCharacters[(characterBits & 0xFF) % kNameCharacterCount];
+		characterBits >>= 8;
+	}
+
+	entry.name += ' ';
+	entry.name += to_string(index);
+
+	if (!entry.isDirectory)
+	{
+		entry.name += kExtensions[Mix(hash + 6) % kExtensionCount];
+	}
+}
+
+bool SyntheticFileSystemProvider::ResolvePath(const wstring& path, Entry& entry) const
+{
+	const auto& rootPath = m_Parameters.rootPath;
+
+	if (path.length() < rootPath.length() || _wcsnicmp(path.c_str(), rootPath.c_str(), rootPath.length()) != 0)
+	{
+		return false;
+	}
+
+	if (path.length() > rootPath.length() && path[rootPath.length()] != L'\\')
+	{
+		return false;	// Some sibling of the root that merely starts with the same name
+	}
+
+	auto relativePath = Encoding::Utf16ToUtf8(path.substr(rootPath.length()));
+	entry = m_Root;
+
+	size_t componentStart = 0;
+
+	while (componentStart < relativePath.length())
+	{
+		if (relativePath[componentStart] == '\\')
+		{
+			componentStart++;
+			continue;
+		}
+
+		if (!entry.isDirectory)
+		{
+			return false;
+		}
+
+		auto componentEnd = relativePath.find('\\', componentStart);
+
+		if (componentEnd == string::npos)
+		{
+			componentEnd = relativePath.length();
+		}
+
+		auto component = relativePath.substr(componentStart, componentEnd - componentStart);
+		componentStart = componentEnd;
+
+		// Recover the index from the " <index>" suffix, then regenerate that entry and make sure the whole name matches
+
+		auto indexStart = component.find_last_of(' ');
+
+		if (indexStart == string::npos || indexStart + 1 == component.length() || !isdigit(static_cast<uint8_t>(component[indexStart + 1])))
+		{
+			return false;
+		}
+
+		auto index = strtoull(component.c_str() + indexStart + 1, nullptr, 10);
+
+		if (index >= GetFanOut(entry))
+		{
+			return false;
+		}
+
+		Entry child;
+		GenerateEntry(entry, static_cast<uint32_t>(index), child);
+
+		if (_stricmp(child.name.c_str(), component.c_str()) != 0)
+		{
+			return false;
+		}
+
+		entry = std::move(child);
+	}
+
+	return true;
+}
+
+FileStatus SyntheticFileSystemProvider::QueryFileStatus(const wstring& path)
+{
+	InjectLatency(m_Parameters.queryLatencyMicroseconds);
+
+	Entry entry;
+
+	if (!ResolvePath(path, entry))
+	{
+		return FileStatus::FileNotFound;
+	}
+
+	return entry.isDirectory ? FileStatus::Directory : FileStatus::File;
+}
+
+bool SyntheticFileSystemProvider::QueryLastWriteTime(const wstring& path, uint64_t& lastWriteTime)
+{
+	InjectLatency(m_Parameters.queryLatencyMicroseconds);
+
+	Entry entry;
+
+	if (!ResolvePath(path, entry))
+	{
+		SetLastError(ERROR_FILE_NOT_FOUND);
+		return false;
+	}
+
+	lastWriteTime = entry.lastWriteTime;
+	return true;
+}
+
+vector<FileInfo> SyntheticFileSystemProvider::EnumerateFiles(const wstring& path, const CancellationToken& cancellationToken)
+{
+	InjectLatency(m_Parameters.enumerationLatencyMicroseconds);
+
+	vector<FileInfo> result;
+	Entry directory;
+
+	if (!ResolvePath(path, directory) || !directory.isDirectory)
+	{
+		SetLastError(ERROR_PATH_NOT_FOUND);
+		return result;
+	}
+
+	auto fanOut = GetFanOut(directory);
+	result.reserve(fanOut);
+
+	Entry entry;
+
+	for (uint32_t i = 0; i < fanOut && !cancellationToken.IsCancelled(); i++)
+	{
+		GenerateEntry(directory, i, entry);
+
+		FILETIME lastWriteTime;
+		lastWriteTime.dwLowDateTime = static_cast<DWORD>(entry.lastWriteTime);
+		lastWriteTime.dwHighDateTime = static_cast<DWORD>(entry.lastWriteTime >> 32);
+
+		result.emplace_back(entry.name, entry.isDirectory ? FileStatus::Directory : FileStatus::File, FormatFileTime(lastWriteTime), entry.size);
+	}
+
+	SetLastError(ERROR_SUCCESS);
+	return result;
+}
+
+unique_ptr<FileSystemProvider::File> SyntheticFileSystemProvider::OpenFile(const wstring& path)
+{
+	InjectLatency(m_Parameters.queryLatencyMicroseconds);
+
+	Entry entry;
+
+	if (!ResolvePath(path, entry))
+	{
+		SetLastError(ERROR_FILE_NOT_FOUND);
+		return nullptr;
+	}
+
+	if (entry.isDirectory)
+	{
+		SetLastError(ERROR_ACCESS_DENIED);	// What CreateFile reports for directories
+		return nullptr;
+	}
+
+	return unique_ptr<File>(new SyntheticFile(entry.seed, entry.size, entry.lastWriteTime, m_Parameters.readLatencyMicroseconds, m_Parameters.readBytesPerSecond,
+		m_Parameters.failedReadOffset));
+}
+
+void SyntheticFileSystemProvider::GenerateFileContents(uint64_t fileSeed, uint64_t offset, char* buffer, uint32_t length)
+{
+	// Every aligned 8 byte block is a hash of the seed and the block index
+	uint32_t i = 0;
+
+	while (i < length)
+	{
+		auto position = offset + i;
+		auto block = Mix(fileSeed ^ (position / 8));
+		auto byteInBlock = static_cast<uint32_t>(position % 8);
+		auto count = min(8 - byteInBlock, length - i);
+
+		for (uint32_t j = 0; j < count; j++)
+		{
+			buffer[i + j] = static_cast<char>(block >> (8 * (byteInBlock + j)));
+		}
+
+		i += count;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "FileSystemProvider.h"
+
+// In-memory file system whose trees are generated from a seed. Nothing is stored: every directory's contents
+// are derived from a hash of its parent and its index, so arbitrarily large trees cost nothing until listed.
+// Entry names end with " <index>" (plus an extension for files), which lets path lookups regenerate just
+// the entries along the path instead of whole listings.
+
+class SyntheticFileSystemProvider : public FileSystemProvider
+{
+public:
+	struct Parameters
+	{
+		uint64_t seed;
+		std::wstring rootPath;				// Synthetic paths live under it, for example L"S:\\Synthetic"
+
+		int maxDepth;						// Directories this deep below the root contain only files
+		uint32_t minFanOut;
+		uint32_t maxFanOut;
+		uint32_t directoryPercentage;		// Share of the entries above maxDepth that are directories
+
+		uint32_t minNameLength;				// In characters, not counting the index and the extension
+		uint32_t maxNameLength;
+		uint64_t minFileSize;				// File sizes are log-uniformly distributed between these
+		uint64_t maxFileSize;
+
+		uint32_t queryLatencyMicroseconds;
+		uint32_t enumerationLatencyMicroseconds;
+		uint32_t readLatencyMicroseconds;	// Per Read call
+		uint64_t readBytesPerSecond;		// Of a single Read call, like one request to a network share. 0 is unlimited
+		uint64_t failedReadOffset;			// Reads that reach past it fail, like a network share dropping out midway. Never by default
+
+		Parameters();
+	};
+
+private:
+	struct Entry
+	{
+		std::string name;
+		uint64_t seed;
+		uint64_t size;
+		uint64_t lastWriteTime;
+		int depth;
+		bool isDirectory;
+	};
+
+	Parameters m_Parameters;
+	Entry m_Root;
+
+	uint32_t GetFanOut(const Entry& directory) const;
+	void GenerateEntry(const Entry& directory, uint32_t index, Entry& entry) const;
+	bool ResolvePath(const std::wstring& path, Entry& entry) const;
+
+public:
+	SyntheticFileSystemProvider(const Parameters& parameters);
+
+	SyntheticFileSystemProvider(const SyntheticFileSystemProvider&) = delete;
+	SyntheticFileSystemProvider& operator=(const SyntheticFileSystemProvider&) = delete;
+
+	using FileSystemProvider::EnumerateFiles;
+
+	virtual Utilities::FileSystem::FileStatus QueryFileStatus(const std::wstring& path) override;
+	virtual bool QueryLastWriteTime(const std::wstring& path, uint64_t& lastWriteTime) override;
+	virtual std::vector<Utilities::FileSystem::FileInfo> EnumerateFiles(const std::wstring& path, const CancellationToken& cancellationToken) override;
+	virtual std::unique_ptr<File> OpenFile(const std::wstring& path) override;
+
+	inline const Parameters& GetParameters() const { return m_Parameters; }
+
+	// Contents of synthetic files are a pure function of the file seed and the offset
+	static void GenerateFileContents(uint64_t fileSeed, uint64_t offset, char* buffer, uint32_t length);
+};
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include "PrecompiledHeader.h"
+#include "TimerWheel.h"
+
+using namespace std;
+
+TimerWheel::TimerWheel(uint64_t tickMicroseconds, uint64_t now) :
+	m_TickMicroseconds(tickMicroseconds), m_CurrentTick(now / tickMicroseconds)
+{
+	Assert(tickMicroseconds > 0);
+
+	for (auto& level : m_Slots)
+	{
+		for (auto& slot : level)
+		{
+			InitializeList(slot);
+		}
+	}
+
+	InitializeList(m_Expired);
+}
+
+// Timers that outlive the wheel just end up unscheduled
+TimerWheel::~TimerWheel()
+{
+	auto detach = [](Node& list)
+	{
+		auto node = list.next;
+
+		while (node != &list)
+		{
+			auto next = node->next;
+			node->previous = node->next = nullptr;
+			node = next;
+		}
+	};
+
+	for (auto& level : m_Slots)
+	{
+		for (auto& slot : level)
+		{
+			detach(slot);
+		}
+	}
+
+	detach(m_Expired);
+}
+
+inline void TimerWheel::InitializeList(Node& list)
+{
+	list.previous = list.next = &list;
+}
+
+inline void TimerWheel::Append(Node& list, Node& node)
+{
+	node.previous = list.previous;
+	node.next = &list;
+	list.previous->next = &node;
+	list.previous = &node;
+}
+
+void TimerWheel::Schedule(Timer& timer, uint64_t deadline)
+{
+	timer.Cancel();
+
+	// Ticks up to the current one have been collected already
+	timer.m_DeadlineTick = max((deadline + m_TickMicroseconds - 1) / m_TickMicroseconds, m_CurrentTick + 1);
+	Insert(timer);
+}
+
+// A timer goes to the lowest level that reaches its deadline, in the slot its deadline falls in.
+// Slots a whole turn ahead alias the current one, which is fine: they were just collected, and are next collected exactly a turn later
+void TimerWheel::Insert(Timer& timer)
+{
+	static const uint64_t kMaxDelta = (1ull << (kSlotBits * kLevelCount)) - 1;
+	auto delta = timer.m_DeadlineTick - m_CurrentTick;
+
+	if (delta > kMaxDelta)
+	{
+		timer.m_DeadlineTick = m_CurrentTick + kMaxDelta;
+		delta = kMaxDelta;
+	}
+
+	int level = 0;
+
+	while (delta >= 1ull << (kSlotBits * (level + 1)))
+	{
+		level++;
+	}
+
+	auto slot = (timer.m_DeadlineTick >> (kSlotBits * level)) & (kSlotCount - 1);
+	Append(m_Slots[level][slot], timer);
+}
+
+void TimerWheel::Advance(uint64_t now)
+{
+	auto tick = now / m_TickMicroseconds;
+
+	while (m_CurrentTick < tick)
+	{
+		m_CurrentTick++;
+
+		// Whenever a level turns over, the slot of the level above that covers the coming turn gets spread over the levels below
+		for (int level = 1; level < kLevelCount; level++)
+		{
+			if ((m_CurrentTick & ((1ull << (kSlotBits * level)) - 1)) != 0)
+			{
+				break;
+			}
+
+			auto& slot = m_Slots[level][(m_CurrentTick >> (kSlotBits * level)) & (kSlotCount - 1)];
+
+			while (slot.next != &slot)
+			{
+				auto& timer = static_cast<Timer&>(*slot.next);
+				timer.Cancel();
+				Insert(timer);
+			}
+		}
+
+		auto& due = m_Slots[0][m_CurrentTick & (kSlotCount - 1)];
+
+		while (due.next != &due)
+		{
+			auto& timer = static_cast<Timer&>(*due.next);
+			timer.Cancel();
+			Append(m_Expired, timer);
+		}
+	}
+}
+
+TimerWheel::Timer* TimerWheel::PopExpired()
+{
+	if (m_Expired.next == &m_Expired)
+	{
+		return nullptr;
+	}
+
+	auto& timer = static_cast<Timer&>(*m_Expired.next);
+	timer.Cancel();
+	return &timer;
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+// Hierarchical timing wheel: kLevelCount wheels of kSlotCount slots, each level's slot spanning a whole turn of the level below.
+// Timers are intrusive list nodes, so scheduling and cancelling are O(1) and never allocate. Advancing costs O(1) per tick
+// plus O(1) per timer that expires or moves down a level, no matter how many timers are scheduled.
+// Not thread safe: it's meant to be owned by a single thread, along with the timers scheduled on it.
+class TimerWheel
+{
+public:
+	struct Node
+	{
+		Node* previous;
+		Node* next;
+	};
+
+	class Timer : private Node
+	{
+	private:
+		uint64_t m_DeadlineTick;
+
+		friend class TimerWheel;
+
+	public:
+		inline Timer()
+		{
+			previous = next = nullptr;
+		}
+
+		inline ~Timer()
+		{
+			Cancel();
+		}
+
+		Timer(const Timer&) = delete;
+		Timer& operator=(const Timer&) = delete;
+
+		// Scheduled until it's popped as expired
+		inline bool IsScheduled() const { return next != nullptr; }
+
+		inline void Cancel()
+		{
+			if (next != nullptr)
+			{
+				previous->next = next;
+				next->previous = previous;
+				previous = next = nullptr;
+			}
+		}
+	};
+
+	static const int kSlotBits = 6;
+	static const int kSlotCount = 1 << kSlotBits;
+	static const int kLevelCount = 4;
+
+private:
+	Node m_Slots[kLevelCount][kSlotCount];
+	Node m_Expired;
+	uint64_t m_TickMicroseconds;
+	uint64_t m_CurrentTick;
+
+	static inline void InitializeList(Node& list);
+	static inline void Append(Node& list, Node& node);
+	void Insert(Timer& timer);
+
+public:
+	TimerWheel(uint64_t tickMicroseconds, uint64_t now);
+	~TimerWheel();
+
+	TimerWheel(const TimerWheel&) = delete;
+	TimerWheel& operator=(const TimerWheel&) = delete;
+
+	// Times are in microseconds, on the same clock as now. Deadlines are rounded up to whole ticks,
+	// ones in the past expire on the next Advance, and ones further than the wheel reaches are clamped
+	void Schedule(Timer& timer, uint64_t deadline);
+
+	// Collects the timers that are due by now
+	void Advance(uint64_t now);
+
+	// Next timer collected by Advance, nullptr once there are none left. It's no longer scheduled,
+	// so it may be rescheduled or destroyed right away
+	Timer* PopExpired();
+};
\ No newline at end of file
@@ -0,0 +1,234 @@
+#include "PrecompiledHeader.h"
+#include "Tracing.h"
+
+using namespace std;
+using namespace Utilities;
+
+atomic<bool> Tracing::s_Enabled;
+
+#if ENABLE_TRACING
+
+struct TraceEvent
+{
+	const char* name;
+	uint64_t startTicks;
+	uint64_t endTicks;
+};
+
+// Each thread writes only to its own buffer, so recording needs no locks. Buffers are handed back to the pool
+// when their thread exits (via the FLS destructor) and reused by the next thread, keeping the old events until they're overwritten.
+// The write index keeps counting across threads, and every change of owner is recorded with the index it started writing at.
+
+struct ThreadTraceBuffer
+{
+	static const uint64_t kCapacity = 16 * 1024;
+
+	vector<pair<uint64_t, DWORD>> owners;	// First write index and thread ID of each thread that used the buffer
+	bool inUse;
+	atomic<uint64_t> writeIndex;
+	TraceEvent events[kCapacity];
+};
+
+static CriticalSection s_BufferCriticalSection;
+static vector<unique_ptr<ThreadTraceBuffer>> s_Buffers;
+static DWORD s_FlsIndex = FLS_OUT_OF_INDEXES;
+
+static void WINAPI ReleaseThreadBuffer(void* data)
+{
+	CriticalSection::Lock lock(s_BufferCriticalSection);
+	static_cast<ThreadTraceBuffer*>(data)->inUse = false;
+}
+
+static ThreadTraceBuffer* AcquireThreadBuffer()
+{
+	CriticalSection::Lock lock(s_BufferCriticalSection);
+	ThreadTraceBuffer* buffer = nullptr;
+
+	for (auto& existingBuffer : s_Buffers)
+	{
+		if (!existingBuffer->inUse)
+		{
+			buffer = existingBuffer.get();
+			break;
+		}
+	}
+
+	if (buffer == nullptr)
+	{
+		s_Buffers.emplace_back(new ThreadTraceBuffer);
+		buffer = s_Buffers.back().get();
+		buffer->writeIndex.store(0, memory_order_relaxed);
+	}
+
+	auto writeIndex = buffer->writeIndex.load(memory_order_relaxed);
+
+	// Forget owners whose events have all been overwritten
+	while (buffer->owners.size() > 1 && buffer->owners[1].first + ThreadTraceBuffer::kCapacity <= writeIndex)
+	{
+		buffer->owners.erase(buffer->owners.begin());
+	}
+
+	buffer->owners.emplace_back(writeIndex, GetCurrentThreadId());
+	buffer->inUse = true;
+
+	FlsSetValue(s_FlsIndex, buffer);
+	return buffer;
+}
+
+void Tracing::SetEnabled(bool enabled)
+{
+	{
+		CriticalSection::Lock lock(s_BufferCriticalSection);
+
+		if (enabled && s_FlsIndex == FLS_OUT_OF_INDEXES)
+		{
+			s_FlsIndex = FlsAlloc(&ReleaseThreadBuffer);
+			Logging::LogErrorIfFailed(s_FlsIndex == FLS_OUT_OF_INDEXES, "Failed to allocate trace buffer FLS index: ");
+
+			if (s_FlsIndex == FLS_OUT_OF_INDEXES)
+			{
+				return;
+			}
+		}
+	}
+
+	s_Enabled.store(enabled, memory_order_release);
+	Logging::Log(enabled ? "Tracing enabled." : "Tracing disabled.");
+}
+
+void Tracing::RecordSpan(const char* name, uint64_t startTicks, uint64_t endTicks)
+{
+	auto buffer = static_cast<ThreadTraceBuffer*>(FlsGetValue(s_FlsIndex));
+
+	if (buffer == nullptr)
+	{
+		buffer = AcquireThreadBuffer();
+	}
+
+	auto index = buffer->writeIndex.load(memory_order_relaxed);
+	auto& traceEvent = buffer->events[index % ThreadTraceBuffer::kCapacity];
+
+	traceEvent.name = name;
+	traceEvent.startTicks = startTicks;
+	traceEvent.endTicks = endTicks;
+
+	buffer->writeIndex.store(index + 1, memory_order_release);
+}
+
+static void CopyBufferEvents(const ThreadTraceBuffer& buffer, vector<pair<DWORD, vector<TraceEvent>>>& threadEvents)
+{
+	// The owning thread keeps writing while we copy, so afterwards drop whatever it could have overwritten in the meantime
+	auto endIndex = buffer.writeIndex.load(memory_order_acquire);
+	auto startIndex = endIndex > ThreadTraceBuffer::kCapacity ? endIndex - ThreadTraceBuffer::kCapacity : 0;
+	vector<TraceEvent> events;
+
+	for (auto i = startIndex; i < endIndex; i++)
+	{
+		events.push_back(buffer.events[i % ThreadTraceBuffer::kCapacity]);
+	}
+
+	auto indexAfterCopy = buffer.writeIndex.load(memory_order_acquire) + 1;	// + 1 for a write that may be in progress
+	auto overwrittenCount = indexAfterCopy > ThreadTraceBuffer::kCapacity + startIndex ? indexAfterCopy - ThreadTraceBuffer::kCapacity - startIndex : 0;
+	overwrittenCount = min<uint64_t>(overwrittenCount, events.size());
+
+	events.erase(events.begin(), events.begin() + static_cast<size_t>(overwrittenCount));
+	startIndex += overwrittenCount;
+
+	// Split the events between the threads that owned the buffer when they were recorded
+	for (size_t i = 0; i < buffer.owners.size(); i++)
+	{
+		auto ownerStartIndex = max(buffer.owners[i].first, startIndex);
+		auto ownerEndIndex = i + 1 < buffer.owners.size() ? min(buffer.owners[i + 1].first, endIndex) : endIndex;
+
+		if (ownerStartIndex < ownerEndIndex)
+		{
+			auto eventsBegin = events.begin() + static_cast<size_t>(ownerStartIndex - startIndex);
+			auto eventsEnd = events.begin() + static_cast<size_t>(ownerEndIndex - startIndex);
+			threadEvents.emplace_back(buffer.owners[i].second, vector<TraceEvent>(eventsBegin, eventsEnd));
+		}
+	}
+}
+
+bool Tracing::DumpToFile(const wstring& path)
+{
+	vector<pair<DWORD, vector<TraceEvent>>> threadEvents;
+
+	{
+		CriticalSection::Lock lock(s_BufferCriticalSection);
+
+		for (const auto& buffer : s_Buffers)
+		{
+			CopyBufferEvents(*buffer, threadEvents);
+		}
+	}
+
+	// Rebase timestamps on the oldest recorded span to keep them short
+	auto firstTicks = numeric_limits<uint64_t>::max();
+
+	for (const auto& thread : threadEvents)
+	{
+		for (const auto& traceEvent : thread.second)
+		{
+			firstTicks = min(firstTicks, traceEvent.startTicks);
+		}
+	}
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+
+	auto processId = GetCurrentProcessId();
+	bool isFirstEvent = true;
+	string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+	for (const auto& thread : threadEvents)
+	{
+		for (const auto& traceEvent : thread.second)
+		{
+			// Chrome trace timestamps are in microseconds
+			auto start = static_cast<double>(traceEvent.startTicks - firstTicks) * 1000000.0 / frequency.QuadPart;
+			auto duration = static_cast<double>(traceEvent.endTicks - traceEvent.startTicks) * 1000000.0 / frequency.QuadPart;
+
+			char eventBuffer[256];
+			sprintf_s(eventBuffer, "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%lu,\"tid\":%lu}",
+				isFirstEvent ? "" : ",\n", traceEvent.name, start, duration, processId, thread.first);
+
+			json += eventBuffer;
+			isFirstEvent = false;
+		}
+	}
+
+	json += "\n]}\n";
+
+	auto fileHandle = FileSystem::CreateFilePortable(path, GENERIC_WRITE, 0, CREATE_ALWAYS);
+
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		Logging::Error(GetLastError(), "Failed to create trace file \"", Encoding::Utf16ToUtf8(path), "\": ");
+		return false;
+	}
+
+	DWORD bytesWritten;
+	auto result = WriteFile(fileHandle, json.data(), static_cast<DWORD>(json.length()), &bytesWritten, nullptr);
+	Logging::LogErrorIfFailed(result == FALSE, "Failed to write trace file: ");
+
+	CloseHandle(fileHandle);
+	return result != FALSE && bytesWritten == json.length();
+}
+
+#else
+
+void Tracing::SetEnabled(bool enabled)
+{
+	Logging::Log("Tracing is compiled out of this build.");
+}
+
+void Tracing::RecordSpan(const char* name, uint64_t startTicks, uint64_t endTicks)
+{
+}
+
+bool Tracing::DumpToFile(const wstring& path)
+{
+	return false;
+}
+
+#endif // ENABLE_TRACING
\ No newline at end of file
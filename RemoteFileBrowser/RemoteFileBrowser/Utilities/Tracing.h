@@ -0,0 +1,68 @@
+#pragma once
+
+// Scoped timing spans, recorded into per-thread ring buffers and dumped as Chrome trace event JSON
+// (loadable in chrome://tracing and the Perfetto UI).
+// With ENABLE_TRACING set to 0 TRACE_SCOPE expands to nothing. Otherwise a span costs one
+// relaxed load while tracing is disabled at runtime, and two timestamps plus a ring buffer write while it's enabled.
+
+#ifndef ENABLE_TRACING
+#if DESKTOP
+#define ENABLE_TRACING 1
+#else
+#define ENABLE_TRACING 0
+#endif
+#endif
+
+namespace Tracing
+{
+	extern std::atomic<bool> s_Enabled;
+
+	void SetEnabled(bool enabled);
+	inline bool IsEnabled() { return s_Enabled.load(std::memory_order_relaxed); }
+
+	void RecordSpan(const char* name, uint64_t startTicks, uint64_t endTicks);
+	bool DumpToFile(const std::wstring& path);
+
+	inline uint64_t GetTicks()
+	{
+		LARGE_INTEGER counter;
+		QueryPerformanceCounter(&counter);
+		return counter.QuadPart;
+	}
+
+	class Span
+	{
+	private:
+		const char* m_Name;
+		uint64_t m_StartTicks;
+
+	public:
+		inline Span(const char* name) :
+			m_Name(name), m_StartTicks(IsEnabled() ? GetTicks() : 0)
+		{
+		}
+
+		inline ~Span()
+		{
+			if (m_StartTicks != 0)
+			{
+				RecordSpan(m_Name, m_StartTicks, GetTicks());
+			}
+		}
+
+		Span(const Span&) = delete;
+		Span& operator=(const Span&) = delete;
+	};
+};
+
+#if ENABLE_TRACING
+
+#define TRACE_CONCATENATE_IMPL(left, right) left##right
+#define TRACE_CONCATENATE(left, right) TRACE_CONCATENATE_IMPL(left, right)
+#define TRACE_SCOPE(name) Tracing::Span TRACE_CONCATENATE(traceSpan, __LINE__)(name)
+
+#else
+
+#define TRACE_SCOPE(name)
+
+#endif
\ No newline at end of file
@@ -0,0 +1,492 @@
+#include "PrecompiledHeader.h"
+#include "Transcoding.h"
+
+using namespace std;
+using namespace Simd;
+using namespace Transcoding;
+
+static_assert(sizeof(wchar_t) == sizeof(uint16_t), "Transcoding assumes UTF-16 wchar_t.");
+
+static const wchar_t kReplacementCharacter = 0xFFFD;
+
+// Scalar conversion. Both functions convert the sequences that start before end, reading past it if a sequence
+// straddles it, and advance position and outputPosition. They return false if the destination is too small.
+
+static inline bool IsContinuationByte(uint8_t byte)
+{
+	return (byte & 0xC0) == 0x80;
+}
+
+static bool ConvertUtf8ToUtf16Scalar(const uint8_t* str, size_t strLength, size_t end, size_t& position,
+	wchar_t* destination, size_t destinationLength, size_t& outputPosition)
+{
+	auto i = position;
+	auto o = outputPosition;
+
+	while (i < end)
+	{
+		if (o == destinationLength)
+		{
+			position = i;
+			outputPosition = o;
+			return false;
+		}
+
+		uint32_t lead = str[i];
+
+		if (lead < 0x80)
+		{
+			destination[o++] = static_cast<wchar_t>(lead);
+			i++;
+			continue;
+		}
+
+		// Count how many bytes of the sequence are valid. The allowed range of the second byte rules out
+		// overlong encodings, surrogates and code points above U+10FFFF
+		uint32_t sequenceLength;
+		uint8_t secondMin = 0x80, secondMax = 0xBF;
+
+		if (lead < 0xC2)
+		{
+			sequenceLength = 0;
+		}
+		else if (lead < 0xE0)
+		{
+			sequenceLength = 2;
+		}
+		else if (lead < 0xF0)
+		{
+			sequenceLength = 3;
+			if (lead == 0xE0) secondMin = 0xA0;
+			if (lead == 0xED) secondMax = 0x9F;
+		}
+		else if (lead < 0xF5)
+		{
+			sequenceLength = 4;
+			if (lead == 0xF0) secondMin = 0x90;
+			if (lead == 0xF4) secondMax = 0x8F;
+		}
+		else
+		{
+			sequenceLength = 0;
+		}
+
+		uint32_t validLength = sequenceLength == 0 ? 0 : 1;
+
+		if (validLength == 1 && i + 1 < strLength && str[i + 1] >= secondMin && str[i + 1] <= secondMax)
+		{
+			validLength = 2;
+
+			while (validLength < sequenceLength && i + validLength < strLength && IsContinuationByte(str[i + validLength]))
+			{
+				validLength++;
+			}
+		}
+
+		if (sequenceLength == 0 || validLength < sequenceLength)
+		{
+			// The maximal invalid subpart is replaced by a single character
+			destination[o++] = kReplacementCharacter;
+			i += max(validLength, 1u);
+			continue;
+		}
+
+		switch (sequenceLength)
+		{
+		case 2:
+			destination[o++] = static_cast<wchar_t>(((lead & 0x1F) << 6) | (str[i + 1] & 0x3F));
+			break;
+
+		case 3:
+			destination[o++] = static_cast<wchar_t>(((lead & 0x0F) << 12) | ((str[i + 1] & 0x3F) << 6) | (str[i + 2] & 0x3F));
+			break;
+
+		case 4:
+			{
+				if (o + 1 == destinationLength)
+				{
+					position = i;
+					outputPosition = o;
+					return false;
+				}
+
+				auto codePoint = ((lead & 0x07) << 18) | ((str[i + 1] & 0x3F) << 12) | ((str[i + 2] & 0x3F) << 6) | (str[i + 3] & 0x3F);
+				codePoint -= 0x10000;
+				destination[o++] = static_cast<wchar_t>(0xD800 | (codePoint >> 10));
+				destination[o++] = static_cast<wchar_t>(0xDC00 | (codePoint & 0x3FF));
+			}
+			break;
+		}
+
+		i += sequenceLength;
+	}
+
+	position = i;
+	outputPosition = o;
+	return true;
+}
+
+static bool ConvertUtf16ToUtf8Scalar(const uint16_t* wstr, size_t wstrLength, size_t end, size_t& position,
+	uint8_t* destination, size_t destinationLength, size_t& outputPosition)
+{
+	auto i = position;
+	auto o = outputPosition;
+
+	while (i < end)
+	{
+		uint32_t codePoint = wstr[i];
+		uint32_t inputLength = 1;
+
+		if (codePoint >= 0xD800 && codePoint < 0xE000)
+		{
+			if (codePoint < 0xDC00 && i + 1 < wstrLength && wstr[i + 1] >= 0xDC00 && wstr[i + 1] < 0xE000)
+			{
+				codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (wstr[i + 1] - 0xDC00);
+				inputLength = 2;
+			}
+			else
+			{
+				codePoint = kReplacementCharacter;
+			}
+		}
+
+		auto outputLength = codePoint < 0x80 ? 1u : codePoint < 0x800 ? 2u : codePoint < 0x10000 ? 3u : 4u;
+
+		if (destinationLength - o < outputLength)
+		{
+			position = i;
+			outputPosition = o;
+			return false;
+		}
+
+		switch (outputLength)
+		{
+		case 1:
+			destination[o] = static_cast<uint8_t>(codePoint);
+			break;
+
+		case 2:
+			destination[o] = static_cast<uint8_t>(0xC0 | (codePoint >> 6));
+			destination[o + 1] = static_cast<uint8_t>(0x80 | (codePoint & 0x3F));
+			break;
+
+		case 3:
+			destination[o] = static_cast<uint8_t>(0xE0 | (codePoint >> 12));
+			destination[o + 1] = static_cast<uint8_t>(0x80 | ((codePoint >> 6) & 0x3F));
+			destination[o + 2] = static_cast<uint8_t>(0x80 | (codePoint & 0x3F));
+			break;
+
+		case 4:
+			destination[o] = static_cast<uint8_t>(0xF0 | (codePoint >> 18));
+			destination[o + 1] = static_cast<uint8_t>(0x80 | ((codePoint >> 12) & 0x3F));
+			destination[o + 2] = static_cast<uint8_t>(0x80 | ((codePoint >> 6) & 0x3F));
+			destination[o + 3] = static_cast<uint8_t>(0x80 | (codePoint & 0x3F));
+			break;
+		}
+
+		i += inputLength;
+		o += outputLength;
+	}
+
+	position = i;
+	outputPosition = o;
+	return true;
+}
+
+// Vector versions share the structure: convert whole blocks while they're pure ASCII, and hand
+// blocks that aren't to the scalar code, which continues until the end of the block
+
+#define TRANSCODING_FINISH_UTF8_TO_UTF16() \
+	if (!ConvertUtf8ToUtf16Scalar(input, strLength, strLength, i, destination, destinationLength, o)) \
+		return kDestinationTooSmall; \
+	return o;
+
+#define TRANSCODING_FINISH_UTF16_TO_UTF8() \
+	if (!ConvertUtf16ToUtf8Scalar(input, wstrLength, wstrLength, i, output, destinationLength, o)) \
+		return kDestinationTooSmall; \
+	return o;
+
+static size_t Utf8ToUtf16Scalar(const char* str, size_t strLength, wchar_t* destination, size_t destinationLength)
+{
+	auto input = reinterpret_cast<const uint8_t*>(str);
+	size_t i = 0, o = 0;
+	TRANSCODING_FINISH_UTF8_TO_UTF16();
+}
+
+static size_t Utf16ToUtf8Scalar(const wchar_t* wstr, size_t wstrLength, char* destination, size_t destinationLength)
+{
+	auto input = reinterpret_cast<const uint16_t*>(wstr);
+	auto output = reinterpret_cast<uint8_t*>(destination);
+	size_t i = 0, o = 0;
+	TRANSCODING_FINISH_UTF16_TO_UTF8();
+}
+
+#if SIMD_X86
+
+static size_t Utf8ToUtf16Sse2(const char* str, size_t strLength, wchar_t* destination, size_t destinationLength)
+{
+	const size_t kBlockSize = 16;
+	auto input = reinterpret_cast<const uint8_t*>(str);
+	size_t i = 0, o = 0;
+	auto zero = _mm_setzero_si128();
+
+	while (i + kBlockSize <= strLength)
+	{
+		auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+
+		if (_mm_movemask_epi8(bytes) == 0 && destinationLength - o >= kBlockSize)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + o), _mm_unpacklo_epi8(bytes, zero));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + o + 8), _mm_unpackhi_epi8(bytes, zero));
+			i += kBlockSize;
+			o += kBlockSize;
+		}
+		else if (!ConvertUtf8ToUtf16Scalar(input, strLength, i + kBlockSize, i, destination, destinationLength, o))
+		{
+			return kDestinationTooSmall;
+		}
+	}
+
+	TRANSCODING_FINISH_UTF8_TO_UTF16();
+}
+
+static size_t Utf16ToUtf8Sse2(const wchar_t* wstr, size_t wstrLength, char* destination, size_t destinationLength)
+{
+	const size_t kBlockSize = 16;
+	auto input = reinterpret_cast<const uint16_t*>(wstr);
+	auto output = reinterpret_cast<uint8_t*>(destination);
+	size_t i = 0, o = 0;
+	auto nonAsciiMask = _mm_set1_epi16(static_cast<short>(0xFF80));
+
+	while (i + kBlockSize <= wstrLength)
+	{
+		auto low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+		auto high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i + 8));
+		auto nonAscii = _mm_and_si128(_mm_or_si128(low, high), nonAsciiMask);
+
+		if (_mm_movemask_epi8(_mm_cmpeq_epi16(nonAscii, _mm_setzero_si128())) == 0xFFFF && destinationLength - o >= kBlockSize)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(output + o), _mm_packus_epi16(low, high));
+			i += kBlockSize;
+			o += kBlockSize;
+		}
+		else if (!ConvertUtf16ToUtf8Scalar(input, wstrLength, i + kBlockSize, i, output, destinationLength, o))
+		{
+			return kDestinationTooSmall;
+		}
+	}
+
+	TRANSCODING_FINISH_UTF16_TO_UTF8();
+}
+
+SIMD_TARGET_AVX2 static size_t Utf8ToUtf16Avx2(const char* str, size_t strLength, wchar_t* destination, size_t destinationLength)
+{
+	const size_t kBlockSize = 32;
+	auto input = reinterpret_cast<const uint8_t*>(str);
+	size_t i = 0, o = 0;
+
+	while (i + kBlockSize <= strLength)
+	{
+		auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+
+		if (_mm256_movemask_epi8(bytes) == 0 && destinationLength - o >= kBlockSize)
+		{
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + o), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(bytes)));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + o + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(bytes, 1)));
+			i += kBlockSize;
+			o += kBlockSize;
+		}
+		else if (!ConvertUtf8ToUtf16Scalar(input, strLength, i + kBlockSize, i, destination, destinationLength, o))
+		{
+			return kDestinationTooSmall;
+		}
+	}
+
+	_mm256_zeroupper();
+	TRANSCODING_FINISH_UTF8_TO_UTF16();
+}
+
+SIMD_TARGET_AVX2 static size_t Utf16ToUtf8Avx2(const wchar_t* wstr, size_t wstrLength, char* destination, size_t destinationLength)
+{
+	const size_t kBlockSize = 32;
+	auto input = reinterpret_cast<const uint16_t*>(wstr);
+	auto output = reinterpret_cast<uint8_t*>(destination);
+	size_t i = 0, o = 0;
+	auto nonAsciiMask = _mm256_set1_epi16(static_cast<short>(0xFF80));
+
+	while (i + kBlockSize <= wstrLength)
+	{
+		auto low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+		auto high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i + 16));
+
+		if (_mm256_testz_si256(_mm256_or_si256(low, high), nonAsciiMask) && destinationLength - o >= kBlockSize)
+		{
+			// packus works within 128-bit lanes, so its result has the middle two quarters swapped
+			auto packed = _mm256_packus_epi16(low, high);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(output + o), _mm256_permute4x64_epi64(packed, 0xD8));
+			i += kBlockSize;
+			o += kBlockSize;
+		}
+		else if (!ConvertUtf16ToUtf8Scalar(input, wstrLength, i + kBlockSize, i, output, destinationLength, o))
+		{
+			return kDestinationTooSmall;
+		}
+	}
+
+	_mm256_zeroupper();
+	TRANSCODING_FINISH_UTF16_TO_UTF8();
+}
+
+#endif // SIMD_X86
+
+#if SIMD_NEON
+
+static inline bool IsAsciiNeon(uint8x16_t bytes)
+{
+	auto halves = vreinterpretq_u64_u8(bytes);
+	return ((vgetq_lane_u64(halves, 0) | vgetq_lane_u64(halves, 1)) & 0x8080808080808080ull) == 0;
+}
+
+static size_t Utf8ToUtf16Neon(const char* str, size_t strLength, wchar_t* destination, size_t destinationLength)
+{
+	const size_t kBlockSize = 16;
+	auto input = reinterpret_cast<const uint8_t*>(str);
+	auto output = reinterpret_cast<uint16_t*>(destination);
+	size_t i = 0, o = 0;
+
+	while (i + kBlockSize <= strLength)
+	{
+		auto bytes = vld1q_u8(input + i);
+
+		if (IsAsciiNeon(bytes) && destinationLength - o >= kBlockSize)
+		{
+			vst1q_u16(output + o, vmovl_u8(vget_low_u8(bytes)));
+			vst1q_u16(output + o + 8, vmovl_u8(vget_high_u8(bytes)));
+			i += kBlockSize;
+			o += kBlockSize;
+		}
+		else if (!ConvertUtf8ToUtf16Scalar(input, strLength, i + kBlockSize, i, destination, destinationLength, o))
+		{
+			return kDestinationTooSmall;
+		}
+	}
+
+	TRANSCODING_FINISH_UTF8_TO_UTF16();
+}
+
+static size_t Utf16ToUtf8Neon(const wchar_t* wstr, size_t wstrLength, char* destination, size_t destinationLength)
+{
+	const size_t kBlockSize = 16;
+	auto input = reinterpret_cast<const uint16_t*>(wstr);
+	auto output = reinterpret_cast<uint8_t*>(destination);
+	size_t i = 0, o = 0;
+
+	while (i + kBlockSize <= wstrLength)
+	{
+		auto low = vld1q_u16(input + i);
+		auto high = vld1q_u16(input + i + 8);
+
+		// Everything above 0x7F leaves a nonzero byte after shifting out the low 7 bits
+		auto highBits = vqmovn_u16(vshrq_n_u16(vorrq_u16(low, high), 7));
+
+		if (vget_lane_u64(vreinterpret_u64_u8(highBits), 0) == 0 && destinationLength - o >= kBlockSize)
+		{
+			vst1q_u8(output + o, vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+			i += kBlockSize;
+			o += kBlockSize;
+		}
+		else if (!ConvertUtf16ToUtf8Scalar(input, wstrLength, i + kBlockSize, i, output, destinationLength, o))
+		{
+			return kDestinationTooSmall;
+		}
+	}
+
+	TRANSCODING_FINISH_UTF16_TO_UTF8();
+}
+
+#endif // SIMD_NEON
+
+#undef TRANSCODING_FINISH_UTF8_TO_UTF16
+#undef TRANSCODING_FINISH_UTF16_TO_UTF8
+
+static const Utf8ToUtf16Function kUtf8ToUtf16Kernels[static_cast<int>(InstructionSet::Count)] =
+{
+	&Utf8ToUtf16Scalar,
+#if SIMD_X86
+	&Utf8ToUtf16Sse2,
+	nullptr,
+	&Utf8ToUtf16Avx2,
+	nullptr
+#elif SIMD_NEON
+	nullptr,
+	nullptr,
+	nullptr,
+	&Utf8ToUtf16Neon
+#else
+	nullptr,
+	nullptr,
+	nullptr,
+	nullptr
+#endif
+};
+
+static const Utf16ToUtf8Function kUtf16ToUtf8Kernels[static_cast<int>(InstructionSet::Count)] =
+{
+	&Utf16ToUtf8Scalar,
+#if SIMD_X86
+	&Utf16ToUtf8Sse2,
+	nullptr,
+	&Utf16ToUtf8Avx2,
+	nullptr
+#elif SIMD_NEON
+	nullptr,
+	nullptr,
+	nullptr,
+	&Utf16ToUtf8Neon
+#else
+	nullptr,
+	nullptr,
+	nullptr,
+	nullptr
+#endif
+};
+
+// The selected kernels start out as functions that select the kernel on first use. They're plain pointers
+// so they are usable during static initialization; racing threads store the same value
+static size_t SelectUtf8ToUtf16(const char* str, size_t strLength, wchar_t* destination, size_t destinationLength);
+static size_t SelectUtf16ToUtf8(const wchar_t* wstr, size_t wstrLength, char* destination, size_t destinationLength);
+
+static Utf8ToUtf16Function s_Utf8ToUtf16 = &SelectUtf8ToUtf16;
+static Utf16ToUtf8Function s_Utf16ToUtf8 = &SelectUtf16ToUtf8;
+
+static size_t SelectUtf8ToUtf16(const char* str, size_t strLength, wchar_t* destination, size_t destinationLength)
+{
+	s_Utf8ToUtf16 = SelectKernel(kUtf8ToUtf16Kernels);
+	return s_Utf8ToUtf16(str, strLength, destination, destinationLength);
+}
+
+static size_t SelectUtf16ToUtf8(const wchar_t* wstr, size_t wstrLength, char* destination, size_t destinationLength)
+{
+	s_Utf16ToUtf8 = SelectKernel(kUtf16ToUtf8Kernels);
+	return s_Utf16ToUtf8(wstr, wstrLength, destination, destinationLength);
+}
+
+size_t Transcoding::Utf8ToUtf16(const char* str, size_t strLength, wchar_t* destination, size_t destinationLength)
+{
+	return s_Utf8ToUtf16(str, strLength, destination, destinationLength);
+}
+
+size_t Transcoding::Utf16ToUtf8(const wchar_t* wstr, size_t wstrLength, char* destination, size_t destinationLength)
+{
+	return s_Utf16ToUtf8(wstr, wstrLength, destination, destinationLength);
+}
+
+Utf8ToUtf16Function Transcoding::GetUtf8ToUtf16(InstructionSet instructionSet)
+{
+	return kUtf8ToUtf16Kernels[static_cast<int>(instructionSet)];
+}
+
+Utf16ToUtf8Function Transcoding::GetUtf16ToUtf8(InstructionSet instructionSet)
+{
+	return kUtf16ToUtf8Kernels[static_cast<int>(instructionSet)];
+}
\ No newline at end of file
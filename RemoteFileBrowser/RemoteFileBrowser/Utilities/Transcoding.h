@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Simd.h"
+
+// Validating UTF-8 <-> UTF-16 converters behind Encoding::Utf8ToUtf16 and Encoding::Utf16ToUtf8.
+// Runs of ASCII are converted with vector instructions, everything else by a scalar decoder.
+// Invalid input is converted the way MultiByteToWideChar and WideCharToMultiByte do it: every maximal
+// invalid UTF-8 subsequence and every unpaired surrogate becomes U+FFFD.
+
+namespace Transcoding
+{
+	// Converters return this when the destination can't hold the whole result
+	static const size_t kDestinationTooSmall = static_cast<size_t>(-1);
+
+	// Neither converter writes a null terminator
+	typedef size_t (*Utf8ToUtf16Function)(const char* str, size_t strLength, wchar_t* destination, size_t destinationLength);
+	typedef size_t (*Utf16ToUtf8Function)(const wchar_t* wstr, size_t wstrLength, char* destination, size_t destinationLength);
+
+	// Best version for this CPU
+	size_t Utf8ToUtf16(const char* str, size_t strLength, wchar_t* destination, size_t destinationLength);
+	size_t Utf16ToUtf8(const wchar_t* wstr, size_t wstrLength, char* destination, size_t destinationLength);
+
+	// A specific version, or nullptr if there's none for the instruction set. For tests and benchmarks
+	Utf8ToUtf16Function GetUtf8ToUtf16(Simd::InstructionSet instructionSet);
+	Utf16ToUtf8Function GetUtf16ToUtf8(Simd::InstructionSet instructionSet);
+
+	// Upper bounds of the converted lengths
+	inline size_t GetMaxUtf16Length(size_t utf8Length) { return utf8Length; }
+	inline size_t GetMaxUtf8Length(size_t utf16Length) { return 3 * utf16Length; }
+};
\ No newline at end of file
@@ -1,4 +1,9 @@
 #include "PrecompiledHeader.h"
+#include "Base64.h"
+#include "Escaping.h"
+#include "FileSystemProvider.h"
+#include "Transcoding.h"
+#include "Tracing.h"
 
 using namespace std;
 using namespace Utilities;
@@ -116,16 +121,17 @@ void Logging::Terminate(int errorCode)
 
 size_t Encoding::Utf8ToUtf16Inline(const char* str, size_t strLength, wchar_t* destination, size_t destinationLength)
 {
-	Assert(destinationLength >= strLength);
-	Assert(strLength < static_cast<size_t>(std::numeric_limits<int>::max()));
-	Assert(destinationLength < static_cast<size_t>(std::numeric_limits<int>::max()));
+	Assert(destinationLength > 0);
 
-	auto length = MultiByteToWideChar(CP_UTF8, 0, str, static_cast<int>(strLength), destination, static_cast<int>(destinationLength));
-	Assert(length > 0);
+	auto length = Transcoding::Utf8ToUtf16(str, strLength, destination, destinationLength - 1);
+	Assert(length != Transcoding::kDestinationTooSmall);
 
-	Assert(static_cast<size_t>(length) < destinationLength);
-	destination[length] = '\0';
+	if (length == Transcoding::kDestinationTooSmall)
+	{
+		length = 0;
+	}
 
+	destination[length] = '\0';
 	return length;
 }
 
@@ -133,28 +139,29 @@ wstring Encoding::Utf8ToUtf16(const char* str, size_t strLength)
 {
 	if (strLength == 0) return wstring();
 
-	auto bufferSize = 4 * strLength;
-	std::unique_ptr<wchar_t[]> buffer(new wchar_t[bufferSize]);
+	// Convert straight into the result, the only allocation
+	wstring result(Transcoding::GetMaxUtf16Length(strLength), L'\0');
 
-	Assert(strLength < static_cast<size_t>(std::numeric_limits<int>::max()));
-	Assert(bufferSize < static_cast<size_t>(std::numeric_limits<int>::max()));
+	auto length = Transcoding::Utf8ToUtf16(str, strLength, &result[0], result.length());
+	Assert(length != Transcoding::kDestinationTooSmall);
 
-	auto length = Utf8ToUtf16Inline(str, strLength, buffer.get(), bufferSize);
-	return wstring(buffer.get(), length);
+	result.resize(length);
+	return result;
 }
 
 size_t Encoding::Utf16ToUtf8Inline(const wchar_t* wstr, size_t wstrLength, char* destination, size_t destinationLength)
 {
-	Assert(destinationLength >= wstrLength);
-	Assert(wstrLength < static_cast<size_t>(std::numeric_limits<int>::max()));
-	Assert(destinationLength < static_cast<size_t>(std::numeric_limits<int>::max()));
+	Assert(destinationLength > 0);
 
-	auto length = WideCharToMultiByte(CP_UTF8, 0, wstr, static_cast<int>(wstrLength), destination, static_cast<int>(destinationLength), nullptr, nullptr);
-	Assert(length > 0);
+	auto length = Transcoding::Utf16ToUtf8(wstr, wstrLength, destination, destinationLength - 1);
+	Assert(length != Transcoding::kDestinationTooSmall);
 
-	Assert(static_cast<size_t>(length) < destinationLength);
-	destination[length] = '\0';
+	if (length == Transcoding::kDestinationTooSmall)
+	{
+		length = 0;
+	}
 
+	destination[length] = '\0';
 	return length;
 }
 
@@ -162,11 +169,13 @@ string Encoding::Utf16ToUtf8(const wchar_t* wstr, size_t wstrLength)
 {
 	if (wstrLength == 0) return string();
 
-	auto bufferSize = 8 * wstrLength;
-	std::unique_ptr<char[]> buffer(new char[bufferSize]);
+	string result(Transcoding::GetMaxUtf8Length(wstrLength), '\0');
+
+	auto length = Transcoding::Utf16ToUtf8(wstr, wstrLength, &result[0], result.length());
+	Assert(length != Transcoding::kDestinationTooSmall);
 
-	auto length = Utf16ToUtf8Inline(wstr, wstrLength, buffer.get(), bufferSize);
-	return string(buffer.get(), length);
+	result.resize(length);
+	return result;
 }
 
 static char HexCharToNumber(char c)
@@ -205,20 +214,30 @@ static char HexDigitToHexChar(uint8_t digit)
 void Encoding::DecodeUrlInline(string& url)
 {
 	auto urlLength = url.length();
-	unsigned int i = 0;
-	unsigned int decodedLength = 0;
+	size_t i = 0;
+	size_t decodedLength = 0;
 		
 	while (i < urlLength)
 	{
-		if (url[i] == '+')
+		// Everything up to the next '%' or '+' stays as it is, so move it in one go
+		auto runLength = Escaping::FindUrlDecodeSpecial(&url[i], urlLength - i);
+
+		if (decodedLength != i)
 		{
-			url[decodedLength++] = ' ';
-			i++;
-			continue;
+			memmove(&url[decodedLength], &url[i], runLength);
 		}
-		else if (url[i] != '%')
+
+		i += runLength;
+		decodedLength += runLength;
+
+		if (i == urlLength)
+		{
+			break;
+		}
+
+		if (url[i] == '+')
 		{
-			url[decodedLength++] = url[i];
+			url[decodedLength++] = ' ';
 			i++;
 			continue;
 		}
@@ -235,140 +254,130 @@ void Encoding::DecodeUrlInline(string& url)
 	url.resize(decodedLength);
 }
 
-static bool NeedsUrlEncoding(char c)
+void Encoding::AppendEncodedUrl(string& output, const char* str, size_t length)
 {
-	if ((c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z'))
+	size_t i = 0;
+
+	while (i < length)
 	{
-		return false;
+		auto runLength = Escaping::FindUrlEncodeSpecial(str + i, length - i);
+		output.append(str + i, runLength);
+		i += runLength;
+
+		if (i == length)
+		{
+			break;
+		}
+
+		char encoded[3] = { '%', HexDigitToHexChar(static_cast<uint8_t>(str[i]) >> 4), HexDigitToHexChar(static_cast<uint8_t>(str[i]) & 0xf) };
+		output.append(encoded, 3);
+		i++;
 	}
+}
+
+void Encoding::EncodeUrlInline(string& url)
+{
+	auto firstSpecial = Escaping::FindUrlEncodeSpecial(url.c_str(), url.length());
 
-	switch (c)
+	if (firstSpecial == url.length())
 	{
-	case '-':
-	case '_':
-	case '.':
-	case '!':
-	case '*':
-	case '\'':
-	case '(':
-	case ')':
-		return false;
+		return;
 	}
 
-	return true;
+	// Growing in place would need a second pass to count the special characters, an upper bound does with one
+	string encoded;
+	encoded.reserve(firstSpecial + 3 * (url.length() - firstSpecial));
+	encoded.append(url, 0, firstSpecial);
+
+	AppendEncodedUrl(encoded, url.c_str() + firstSpecial, url.length() - firstSpecial);
+	url.swap(encoded);
 }
 
-void Encoding::EncodeUrlInline(string& url)
+void Encoding::AppendEscapedHtml(string& output, const char* str, size_t length)
 {
-	// First count resulting string length, then encode
-
-	size_t encodedLength = 0;
-	bool needsEncoding = false;
+	size_t i = 0;
 
-	for (auto& c : url)
+	while (i < length)
 	{
-		if (!NeedsUrlEncoding(c))
+		auto runLength = Escaping::FindHtmlSpecial(str + i, length - i);
+		output.append(str + i, runLength);
+		i += runLength;
+
+		if (i == length)
 		{
-			encodedLength++;
+			break;
 		}
-		else
+
+		switch (str[i])
 		{
-			encodedLength += 3;
-			needsEncoding = true;
+		case '&':
+			output.append("&amp;", 5);
+			break;
+
+		case '<':
+			output.append("&lt;", 4);
+			break;
+
+		case '>':
+			output.append("&gt;", 4);
+			break;
+
+		case '"':
+			output.append("&quot;", 6);
+			break;
+
+		case '\'':
+			output.append("&#39;", 5);
+			break;
 		}
-	}
 
-	if (encodedLength == url.length())
-	{
-		return;
+		i++;
 	}
+}
 
-	int index = static_cast<int>(url.length() - 1);
-	auto encodedIndex = encodedLength - 1;
-	url.resize(encodedLength);
+void Encoding::AppendEscapedJson(string& output, const string& str)
+{
+	static const char kHexDigits[] = "0123456789abcdef";
 
-	for (; index > -1; index--)
+	for (auto c : str)
 	{
-		auto c = url[index];
-		
-		if (!NeedsUrlEncoding(c))
+		if (c == '"' || c == '\\')
+		{
+			output += '\\';
+			output += c;
+		}
+		else if (static_cast<unsigned char>(c) < 0x20)
 		{
-			url[encodedIndex--] = c;
+			output += "\\u00";
+			output += kHexDigits[c >> 4];
+			output += kHexDigits[c & 0xF];
 		}
 		else
 		{
-			url[encodedIndex--] = HexDigitToHexChar(static_cast<uint8_t>(c) & 0xf);
-			url[encodedIndex--] = HexDigitToHexChar(static_cast<uint8_t>(c) >> 4);
-			url[encodedIndex--] = '%';
+			output += c;
 		}
 	}
 }
 
-static const char s_Base64Table[64] = { 'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P', 
-										  'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f', 
-										  'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 
-										  'w', 'x', 'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/' };
-
 void Encoding::EncodeBase64Inline(std::string& data)
 {
-	Assert(data.length() < static_cast<size_t>(std::numeric_limits<int>::max()));
-	int dataLength = static_cast<int>(data.length());
-	if (dataLength == 0) return;
-
-	int remainder = dataLength % 3;
-	int blockCount = dataLength / 3 + (remainder == 0 ? 0 : 1);
-	data.resize(4 * blockCount);
-
-	int i;
-
-	// Handle padding
-	if (remainder > 0)
-	{
-		auto lastByte = static_cast<uint8_t>(data[dataLength - 1]);
-
-		if (remainder == 1)
-		{
-			// bbbbbb'bb 0000'0000 00'000000
-			data[data.length() - 1] = '=';
-			data[data.length() - 2] = '=';
-			data[data.length() - 3] = s_Base64Table[lastByte & 0x03];
-			data[data.length() - 4] = s_Base64Table[(lastByte & 0xFC) >> 2];
-		}
-		else if (remainder == 2)
-		{
-			// bbbbbb'bb bbbb'bbbb 00'000000
-			auto preLastByte = static_cast<uint8_t>(data[dataLength - 2]);
+	string encoded(Base64::GetEncodedLength(data.length()), '\0');
+	Base64::Encode(data.data(), data.length(), &encoded[0]);
+	data.swap(encoded);
+}
 
-			data[data.length() - 1] = '=';
-			data[data.length() - 2] = s_Base64Table[(lastByte & 0x0F) << 2];
-			data[data.length() - 3] = s_Base64Table[((preLastByte & 0x03) << 4) | ((lastByte & 0xF0) >> 4)];
-			data[data.length() - 4] = s_Base64Table[(preLastByte & 0xFC) >> 2];
-		}
+bool Encoding::DecodeBase64Inline(std::string& data)
+{
+	size_t decodedLength;
 
-		i = blockCount - 2;
-	}
-	else
+	if (!Base64::Decode(data.data(), data.length(), &data[0], decodedLength))
 	{
-		i = blockCount - 1;
+		data.clear();
+		return false;
 	}
 
-	// Encode main blocks
-	for (; i > -1; i--)
-	{
-		//     a         b         c
-		// bbbbbb'bb bbbb'bbbb bb'bbbbbb
-
-		auto dataIndex = 3 * i;
-		auto resultIndex = 4 * i;
-		auto a = static_cast<uint8_t>(data[dataIndex]);
-		auto b = static_cast<uint8_t>(data[dataIndex + 1]);
-		auto c = static_cast<uint8_t>(data[dataIndex + 2]);
-
-		data[resultIndex] = s_Base64Table[(a & 0xFC) >> 2];
-		data[resultIndex + 1] = s_Base64Table[((a & 0x03) << 4) | ((b & 0xF0) >> 4)];
-		data[resultIndex + 2] = s_Base64Table[((b & 0x0F) << 2) | ((c & 0xC0) >> 6)];
-		data[resultIndex + 3] = s_Base64Table[c & 0x3F];
-	}
+	data.resize(decodedLength);
+	return true;
 }
 
 // File system
@@ -478,72 +487,32 @@ FileSystem::FileInfo& FileSystem::FileInfo::operator=(FileInfo&& other)
 
 FileSystem::FileStatus FileSystem::QueryFileStatus(const wstring& path)
 {
-	WIN32_FILE_ATTRIBUTE_DATA fileAttributes;
-	auto result = GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &fileAttributes);
-
-	if (result == FALSE)
-	{
-		auto lastError = GetLastError();
-		SetLastError(ERROR_SUCCESS);
-
-		return lastError == ERROR_FILE_NOT_FOUND ? FileStatus::FileNotFound : FileStatus::AccessDenied;
-	}
-
-	return (fileAttributes.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0 ? FileStatus::Directory : FileStatus::File;
+	TRACE_SCOPE("FileSystem::QueryFileStatus");
+	return FileSystemProvider::GetCurrent().QueryFileStatus(path);
 }
 
-vector<FileSystem::FileInfo> FileSystem::EnumerateFiles(wstring path)
+bool FileSystem::QueryLastWriteTime(const wstring& path, uint64_t& lastWriteTime)
 {
-	using namespace Encoding;
-	using namespace FileSystem;
-
-	vector<FileInfo> result;
-
-	if (path[path.length() - 1] == L'\\')
-	{
-		path += L"*.*";
-	}
-	else
-	{
-		path += L"\\*.*";
-	}
-
-	WIN32_FIND_DATA findData;
-	auto findHandle = FindFirstFileExW(path.c_str(), FindExInfoBasic, &findData, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
-
-	if (findHandle == INVALID_HANDLE_VALUE)
-	{
-		return result;
-	}
-
-	do
-	{
-		if (wcscmp(findData.cFileName, L".") == 0 || wcscmp(findData.cFileName, L"..") == 0)
-			continue;
-
-		auto fileNameLength = wcslen(findData.cFileName);
-		string fileName(Utf16ToUtf8(findData.cFileName, fileNameLength));
-
-		SYSTEMTIME modifiedTime;
-		FileTimeToSystemTime(&findData.ftLastWriteTime, &modifiedTime);
-		string dateModified(Utf16ToUtf8(SystemTimeToString(&modifiedTime)));
-
-		auto fileStatus = ((findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0) ? FileStatus::Directory : FileStatus::File;
-		auto fileSize = (static_cast<uint64_t>(findData.nFileSizeHigh) << 32) | findData.nFileSizeLow;
-
-		result.emplace_back(std::move(fileName), fileStatus, std::move(dateModified), fileSize);
-	}
-	while (FindNextFileW(findHandle, &findData) != FALSE);
-
-	FindClose(findHandle);
-	SetLastError(ERROR_SUCCESS);
+	TRACE_SCOPE("FileSystem::QueryLastWriteTime");
+	return FileSystemProvider::GetCurrent().QueryLastWriteTime(path, lastWriteTime);
+}
 
+vector<FileSystem::FileInfo> FileSystem::EnumerateFiles(wstring path, const CancellationToken& cancellationToken)
+{
+	TRACE_SCOPE("FileSystem::EnumerateFiles");
+	return FileSystemProvider::GetCurrent().EnumerateFiles(path, cancellationToken);
+}
 
-	return result;
+string FileSystem::FormatFileTime(const FILETIME& fileTime)
+{
+	SYSTEMTIME systemTime;
+	FileTimeToSystemTime(&fileTime, &systemTime);
+	return Encoding::Utf16ToUtf8(SystemTimeToString(&systemTime));
 }
 
 void FileSystem::SortFiles(std::vector<Utilities::FileSystem::FileInfo>& files)
 {
+	TRACE_SCOPE("FileSystem::SortFiles");
 	// Sort by name, but place directories first
 	sort(begin(files), end(files), [](FileInfo& left, FileInfo& right) -> bool
 	{
@@ -707,6 +676,25 @@ void System::Sleep(int milliseconds)
 #endif
 }
 
+static uint64_t GetPerformanceFrequency()
+{
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	return frequency.QuadPart;
+}
+
+uint64_t System::GetMicroseconds()
+{
+	static const uint64_t s_Frequency = GetPerformanceFrequency();
+
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+
+	// Split the conversion so that multiplying by a million doesn't overflow after a few days of uptime
+	auto ticks = static_cast<uint64_t>(counter.QuadPart);
+	return (ticks / s_Frequency) * 1000000 + (ticks % s_Frequency) * 1000000 / s_Frequency;
+}
+
 /*
 * Copyright (c) 1996,1999 by Internet Software Consortium.
 *
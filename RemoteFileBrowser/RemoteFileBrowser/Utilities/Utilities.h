@@ -1,5 +1,6 @@
 #pragma once
 
+#include "CancellationToken.h"
 #include "CriticalSection.h"
 
 namespace Utilities
@@ -78,11 +79,25 @@ namespace Utilities
 		inline std::string DecodeUrl(const std::string& url);
 
 		void EncodeUrlInline(std::string& url);
+		void AppendEncodedUrl(std::string& output, const char* str, size_t length);
+		inline void AppendEncodedUrl(std::string& output, const std::string& str);
 		inline std::string EncodeUrl(const std::string& url);
 
+		// Escapes &<>"' for use in HTML text and quoted attribute values
+		void AppendEscapedHtml(std::string& output, const char* str, size_t length);
+		inline void AppendEscapedHtml(std::string& output, const std::string& str);
+		inline std::string EscapeHtml(const std::string& str);
+
+		// Escapes quotes, backslashes and control characters for use in a JSON string
+		void AppendEscapedJson(std::string& output, const std::string& str);
+
 		void EncodeBase64Inline(std::string& data);
 		inline std::string EncodeBase64(const std::string& data);
 
+		// Strict, see Base64.h. Leaves data empty when it isn't valid Base64
+		bool DecodeBase64Inline(std::string& data);
+		inline bool DecodeBase64(const std::string& data, std::string& decoded);
+
 		template <size_t bufferLength>
 		inline void IpToString(int ipFamily, void* ipAddress, char (&buffer)[bufferLength]);
 
@@ -118,14 +133,17 @@ namespace Utilities
 
 		void RemoveLastPathComponentInline(std::string& path);
 		inline std::string RemoveLastPathComponent(const std::string& path);
+		inline bool IsInFolder(const std::string& path, const std::string& folderPath);		// Including the folder itself
 
 		std::string CombinePaths(const std::string& left, const std::string& right);
 
 		std::string FormatFileSizeString(uint64_t size);
+		std::string FormatFileTime(const FILETIME& fileTime);
 
 		FileStatus QueryFileStatus(const std::wstring& path);
+		bool QueryLastWriteTime(const std::wstring& path, uint64_t& lastWriteTime);
 		bool GetFileSizeFromHandle(HANDLE fileHandle, uint64_t& fileSize);
-		std::vector<FileInfo> EnumerateFiles(std::wstring path);
+		std::vector<FileInfo> EnumerateFiles(std::wstring path, const CancellationToken& cancellationToken = CancellationToken::None());
 		void SortFiles(std::vector<Utilities::FileSystem::FileInfo>& files);
 		std::vector<std::string> EnumerateSystemVolumes();
 
@@ -134,7 +152,7 @@ namespace Utilities
 
 		std::vector<uint8_t> ReadFileToVector(const std::wstring& path);
 
-		inline HANDLE CreateFilePortable(const std::wstring& path, DWORD desiredAccess, DWORD shareMode, DWORD creationDisposition);
+		inline HANDLE CreateFilePortable(const std::wstring& path, DWORD desiredAccess, DWORD shareMode, DWORD creationDisposition, DWORD flagsAndAttributes = FILE_ATTRIBUTE_NORMAL);
 	}
 
 	namespace String
@@ -156,6 +174,7 @@ namespace Utilities
 	{
 		const std::string& GetUniqueSystemId();
 		void Sleep(int milliseconds);
+		uint64_t GetMicroseconds();
 	}
 };
 
@@ -165,6 +165,11 @@ inline std::string Utilities::Encoding::DecodeUrl(const std::string& url)
 	return result;
 }
 
+inline void Utilities::Encoding::AppendEncodedUrl(std::string& output, const std::string& str)
+{
+	AppendEncodedUrl(output, str.c_str(), str.length());
+}
+
 inline std::string Utilities::Encoding::EncodeUrl(const std::string& url)
 {
 	std::string result = url;
@@ -172,6 +177,19 @@ inline std::string Utilities::Encoding::EncodeUrl(const std::string& url)
 	return result;
 }
 
+inline void Utilities::Encoding::AppendEscapedHtml(std::string& output, const std::string& str)
+{
+	AppendEscapedHtml(output, str.c_str(), str.length());
+}
+
+inline std::string Utilities::Encoding::EscapeHtml(const std::string& str)
+{
+	std::string result;
+	result.reserve(str.length());
+	AppendEscapedHtml(result, str);
+	return result;
+}
+
 inline std::string Utilities::Encoding::EncodeBase64(const std::string& data)
 {
 	std::string result = data;
@@ -179,6 +197,12 @@ inline std::string Utilities::Encoding::EncodeBase64(const std::string& data)
 	return result;
 }
 
+inline bool Utilities::Encoding::DecodeBase64(const std::string& data, std::string& decoded)
+{
+	decoded = data;
+	return DecodeBase64Inline(decoded);
+}
+
 template <size_t bufferLength>
 void Utilities::Encoding::IpToString(int ipFamily, void* ipAddress, char (&buffer)[bufferLength])
 {
@@ -200,6 +224,18 @@ inline std::string Utilities::FileSystem::RemoveLastPathComponent(const std::str
 	return result;
 }
 
+inline bool Utilities::FileSystem::IsInFolder(const std::string& path, const std::string& folderPath)
+{
+	auto folderLength = String::PathLength(folderPath);
+
+	if (path.length() < folderLength || _strnicmp(path.c_str(), folderPath.c_str(), folderLength) != 0)
+	{
+		return false;
+	}
+
+	return path.length() == folderLength || path[folderLength] == '\\' || folderPath[folderLength - 1] == '\\';
+}
+
 template <typename WideStr>
 inline std::vector<Utilities::FileSystem::FileInfo> Utilities::FileSystem::EnumerateAndSortFiles(WideStr&& path)
 {
@@ -208,12 +244,18 @@ inline std::vector<Utilities::FileSystem::FileInfo> Utilities::FileSystem::Enume
 	return files;
 }
 
-inline HANDLE Utilities::FileSystem::CreateFilePortable(const std::wstring& path, DWORD desiredAccess, DWORD shareMode, DWORD creationDisposition)
+inline HANDLE Utilities::FileSystem::CreateFilePortable(const std::wstring& path, DWORD desiredAccess, DWORD shareMode, DWORD creationDisposition, DWORD flagsAndAttributes)
 {
 #if !PHONE
-	return CreateFileW(path.c_str(), desiredAccess, shareMode, nullptr, creationDisposition, FILE_ATTRIBUTE_NORMAL, nullptr);
+	return CreateFileW(path.c_str(), desiredAccess, shareMode, nullptr, creationDisposition, flagsAndAttributes, nullptr);
 #else
-	return CreateFile2(path.c_str(), desiredAccess, shareMode, creationDisposition, nullptr);
+	CREATEFILE2_EXTENDED_PARAMETERS parameters;
+	ZeroMemory(&parameters, sizeof(parameters));
+
+	parameters.dwSize = sizeof(parameters);
+	parameters.dwFileAttributes = flagsAndAttributes & 0x0000FFFF;
+	parameters.dwFileFlags = flagsAndAttributes & 0xFFF00000;
+	return CreateFile2(path.c_str(), desiredAccess, shareMode, creationDisposition, &parameters);
 #endif
 }
 
@@ -0,0 +1,132 @@
+#include "PrecompiledHeader.h"
+#include "WorkStealingPool.h"
+
+using namespace std;
+
+WorkStealingPool::WorkStealingPool(uint32_t workerCount) :
+	m_TaskCredits(CreateSemaphoreEx(nullptr, 0, numeric_limits<LONG>::max(), nullptr, 0, SEMAPHORE_MODIFY_STATE | SYNCHRONIZE)),
+	m_NextQueue(0),
+	m_IsStopping(false)
+{
+	Assert(workerCount > 0);
+
+	for (uint32_t i = 0; i < workerCount; i++)
+	{
+		m_Queues.emplace_back(new WorkerQueue);
+	}
+
+	// Tasks can only come once the constructor returns, so workers never look at the thread list while it grows
+	m_WorkerThreads.reserve(workerCount);
+
+	for (uint32_t i = 0; i < workerCount; i++)
+	{
+		m_WorkerThreads.emplace_back([this, i]()
+		{
+			RunWorker(i);
+		});
+	}
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+	m_IsStopping = true;
+	ReleaseSemaphore(m_TaskCredits, static_cast<LONG>(m_WorkerThreads.size()), nullptr);
+
+	for (auto& workerThread : m_WorkerThreads)
+	{
+		workerThread.join();
+	}
+
+	CloseHandle(m_TaskCredits);
+}
+
+// Workers are few, so a linear search is as fast as anything
+uint32_t WorkStealingPool::GetCurrentWorkerIndex() const
+{
+	auto currentThreadId = this_thread::get_id();
+
+	for (size_t i = 0; i < m_WorkerThreads.size(); i++)
+	{
+		if (m_WorkerThreads[i].get_id() == currentThreadId)
+		{
+			return static_cast<uint32_t>(i);
+		}
+	}
+
+	return static_cast<uint32_t>(m_WorkerThreads.size());
+}
+
+void WorkStealingPool::Submit(Task&& task)
+{
+	auto workerIndex = GetCurrentWorkerIndex();
+
+	if (workerIndex == m_WorkerThreads.size())
+	{
+		workerIndex = m_NextQueue++ % static_cast<uint32_t>(m_Queues.size());
+	}
+
+	{
+		auto& queue = *m_Queues[workerIndex];
+		CriticalSection::Lock lock(queue.criticalSection);
+		queue.tasks.push_back(std::move(task));
+	}
+
+	ReleaseSemaphore(m_TaskCredits, 1, nullptr);
+}
+
+bool WorkStealingPool::TakeTask(uint32_t workerIndex, Task& task)
+{
+	{
+		auto& ownQueue = *m_Queues[workerIndex];
+		CriticalSection::Lock lock(ownQueue.criticalSection);
+
+		if (!ownQueue.tasks.empty())
+		{
+			task = std::move(ownQueue.tasks.back());
+			ownQueue.tasks.pop_back();
+			return true;
+		}
+	}
+
+	auto queueCount = static_cast<uint32_t>(m_Queues.size());
+
+	for (uint32_t i = 1; i < queueCount; i++)
+	{
+		auto& victimQueue = *m_Queues[(workerIndex + i) % queueCount];
+		CriticalSection::Lock lock(victimQueue.criticalSection);
+
+		if (!victimQueue.tasks.empty())
+		{
+			task = std::move(victimQueue.tasks.front());
+			victimQueue.tasks.pop_front();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Every credit stands for a queued task, but scanning the queues isn't atomic: other workers can take the tasks this one
+// hasn't reached yet and submit new ones to queues it has already passed, so it looks again until it finds one.
+// Once stopping, finding nothing means it's time to go, as whichever worker is left last still sees every queued task
+void WorkStealingPool::RunWorker(uint32_t workerIndex)
+{
+	for (;;)
+	{
+		WaitForSingleObjectEx(m_TaskCredits, INFINITE, FALSE);
+
+		Task task;
+
+		while (!TakeTask(workerIndex, task))
+		{
+			if (m_IsStopping)
+			{
+				return;
+			}
+
+			YieldProcessor();
+		}
+
+		task();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CriticalSection.h"
+
+// Runs tasks on a fixed set of worker threads, each with a queue of its own. Tasks submitted from a worker go to the back
+// of its queue, and it takes its next task from the back too, so recursive work like walking a directory tree goes depth first
+// and stays close to what was just read. Idle workers steal from the front of other queues, where the oldest and usually
+// biggest pieces of work are. Tasks submitted from other threads are spread over the queues in turn.
+
+class WorkStealingPool
+{
+public:
+	typedef std::function<void()> Task;
+
+private:
+	struct WorkerQueue
+	{
+		CriticalSection criticalSection;
+		std::deque<Task> tasks;
+	};
+
+	std::vector<std::unique_ptr<WorkerQueue>> m_Queues;
+	std::vector<std::thread> m_WorkerThreads;
+	HANDLE m_TaskCredits;			// Semaphore, counts queued tasks, plus one per worker once stopping
+	std::atomic<uint32_t> m_NextQueue;
+	std::atomic<bool> m_IsStopping;
+
+	void RunWorker(uint32_t workerIndex);
+	bool TakeTask(uint32_t workerIndex, Task& task);
+	uint32_t GetCurrentWorkerIndex() const;
+
+public:
+	WorkStealingPool(uint32_t workerCount);
+
+	// Runs whatever was submitted until then, including the tasks those submit, before returning
+	~WorkStealingPool();
+
+	WorkStealingPool(const WorkStealingPool&) = delete;
+	WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+	void Submit(Task&& task);
+
+	inline uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_WorkerThreads.size()); }
+};
\ No newline at end of file
@@ -72,5 +72,12 @@ namespace RemoteFileBrowser.Interop
 
         [DllImport("RemoteFileBrowser.dll")]
         extern internal static void StopSharingFiles(ref IntPtr sharingContext);
+
+        [DllImport("RemoteFileBrowser.dll")]
+        extern internal static void SetTracingEnabled([MarshalAs(UnmanagedType.U1)] bool enabled);
+
+        [DllImport("RemoteFileBrowser.dll", CharSet = CharSet.Unicode)]
+        [return: MarshalAs(UnmanagedType.U1)]
+        extern internal static bool DumpTrace(string path);
     }
 }